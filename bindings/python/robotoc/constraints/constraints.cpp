@@ -25,6 +25,9 @@ PYBIND11_MODULE(constraints, m) {
           py::arg("barrier_param"))
     .def("set_fraction_to_boundary_rule", &Constraints::setFractionToBoundaryRule,
           py::arg("fraction_to_boundary_rule"))
+    .def("set_active_set_screening", &Constraints::setActiveSetScreening,
+          py::arg("threshold"), py::arg("revalidation_interval")=10)
+    .def("is_active_set_screening_enabled", &Constraints::isActiveSetScreeningEnabled)
     .def("get_barrier_param", &Constraints::getBarrierParam)
     .def("get_fraction_to_boundary_rule", &Constraints::getFractionToBoundaryRule)
     DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(Constraints);
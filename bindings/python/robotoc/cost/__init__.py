@@ -16,3 +16,4 @@ from .periodic_com_ref_6d import *
 from .discrete_time_swing_foot_ref import *
 from .discrete_time_com_ref import *
 from .foot_ref import *
+from .consensus_cost import *
@@ -0,0 +1,30 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+
+#include "robotoc/cost/consensus_cost.hpp"
+#include "robotoc/utils/pybind11_macros.hpp"
+
+
+namespace robotoc {
+namespace python {
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(consensus_cost, m) {
+  py::class_<ConsensusCost, CostFunctionComponentBase,
+             std::shared_ptr<ConsensusCost>>(m, "ConsensusCost")
+    .def(py::init<const Robot&, const double>(),
+          py::arg("robot"), py::arg("penalty"))
+    .def(py::init<>())
+    .def("set_penalty", &ConsensusCost::set_penalty,
+          py::arg("penalty"))
+    .def("set_targets", &ConsensusCost::set_targets,
+          py::arg("times"), py::arg("q_targets"), py::arg("v_targets"))
+    .def("clear_targets", &ConsensusCost::clear_targets)
+    DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(ConsensusCost);
+}
+
+} // namespace python
+} // namespace robotoc
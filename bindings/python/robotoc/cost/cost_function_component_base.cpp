@@ -121,7 +121,8 @@ PYBIND11_MODULE(cost_function_component_base, m) {
           py::arg("grid_info"), py::arg("s"), py::arg("kkt_residual"))
     .def("evalImpactCostHessian", &CostFunctionComponentBase::evalImpactCostHessian,
           py::arg("robot"), py::arg("impact_status"), py::arg("data"), 
-          py::arg("grid_info"), py::arg("s"), py::arg("kkt_matrix"));
+          py::arg("grid_info"), py::arg("s"), py::arg("kkt_matrix"))
+    .def("has_constant_hessian", &CostFunctionComponentBase::hasConstantHessian);
 
 }
 
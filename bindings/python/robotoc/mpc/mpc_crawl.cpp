@@ -14,13 +14,15 @@ namespace py = pybind11;
 
 PYBIND11_MODULE(mpc_crawl, m) {
   py::class_<MPCCrawl>(m, "MPCCrawl")
-    .def(py::init<const Robot&, const double, const int>(),
-         py::arg("robot"), py::arg("T"), py::arg("N"))
+    .def(py::init<const Robot&, const double, const int, const double>(),
+         py::arg("robot"), py::arg("T"), py::arg("N"), py::arg("grading_ratio")=1.0)
     .def("set_gait_pattern", &MPCCrawl::setGaitPattern,
          py::arg("planner"), py::arg("swing_height"), py::arg("swing_time"), 
          py::arg("stance_time"), py::arg("swing_start_time"))
     .def("init", &MPCCrawl::init,
-          py::arg("t"), py::arg("q"), py::arg("v"), py::arg("solver_options"))
+          py::arg("t"), py::arg("q"), py::arg("v"), py::arg("solver_options"),
+          py::arg("warm_start_library")=nullptr, 
+          py::arg("command")=Eigen::VectorXd())
     .def("reset", 
           static_cast<void (MPCCrawl::*)()>(&MPCCrawl::reset))
     .def("reset", 
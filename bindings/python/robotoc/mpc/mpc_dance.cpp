@@ -24,7 +24,9 @@ PYBIND11_MODULE(mpc_dance, m) {
          py::arg("q_array"), py::arg("x3d_LF_array"), py::arg("x3d_LH_array"),py::arg("x3d_RF_array"), py::arg("x3d_RH_array"),
          py::arg("LF_inMotion"), py::arg("LH_inMotion"),py::arg("RF_inMotion"),py::arg("RH_inMotion"),py::arg("size"))
     .def("init", &MPCDance::init,
-          py::arg("t"), py::arg("q"), py::arg("v"), py::arg("solver_options"))
+          py::arg("t"), py::arg("q"), py::arg("v"), py::arg("solver_options"),
+          py::arg("warm_start_library")=nullptr, 
+          py::arg("command")=Eigen::VectorXd())
     .def("reset", 
           static_cast<void (MPCDance::*)()>(&MPCDance::reset))
     .def("reset", 
@@ -14,13 +14,15 @@ namespace py = pybind11;
 
 PYBIND11_MODULE(mpc_trot, m) {
   py::class_<MPCTrot>(m, "MPCTrot")
-    .def(py::init<const Robot&, const double, const int>(),
-         py::arg("quadruped_robot"), py::arg("T"), py::arg("N"))
+    .def(py::init<const Robot&, const double, const int, const double>(),
+         py::arg("quadruped_robot"), py::arg("T"), py::arg("N"), py::arg("grading_ratio")=1.0)
     .def("set_gait_pattern", &MPCTrot::setGaitPattern,
          py::arg("planner"), py::arg("swing_height"), py::arg("swing_time"), 
          py::arg("stance_time"), py::arg("swing_start_time"))
     .def("init", &MPCTrot::init,
-          py::arg("t"), py::arg("q"), py::arg("v"), py::arg("solver_options"))
+          py::arg("t"), py::arg("q"), py::arg("v"), py::arg("solver_options"),
+          py::arg("warm_start_library")=nullptr, 
+          py::arg("command")=Eigen::VectorXd())
     .def("reset", 
           static_cast<void (MPCTrot::*)()>(&MPCTrot::reset))
     .def("reset", 
@@ -1,4 +1,5 @@
 from .grid_info import *
 from .discretization_method import * 
+from .hessian_approximation import *
 from .time_discretization import *
 from .ocp import *
\ No newline at end of file
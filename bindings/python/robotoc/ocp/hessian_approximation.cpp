@@ -0,0 +1,19 @@
+#include <pybind11/pybind11.h>
+
+#include "robotoc/ocp/hessian_approximation.hpp"
+
+
+namespace robotoc {
+namespace python {
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(hessian_approximation, m) {
+  py::enum_<HessianApproximation>(m, "HessianApproximation", py::arithmetic())
+    .value("GaussNewton",  HessianApproximation::GaussNewton)
+    .value("BFGS", HessianApproximation::BFGS)
+    .export_values();
+}
+
+} // namespace python
+} // namespace robotoc
@@ -17,18 +17,18 @@ PYBIND11_MODULE(ocp, m) {
                   const std::shared_ptr<STOCostFunction>&, 
                   const std::shared_ptr<STOConstraints>&, 
                   const std::shared_ptr<ContactSequence>&, 
-                  const double, const int, const int>(),
+                  const double, const int, const int, const double>(),
           py::arg("robot"), py::arg("cost"), py::arg("constraints"), 
           py::arg("sto_cost"), py::arg("sto_constraints"),  
           py::arg("contact_sequence"), py::arg("T"), py::arg("N"), 
-          py::arg("reserved_num_discrete_events")=0)
+          py::arg("reserved_num_discrete_events")=0, py::arg("grading_ratio")=1.0)
     .def(py::init<const Robot&, const std::shared_ptr<CostFunction>&,
                   const std::shared_ptr<Constraints>&, 
                   const std::shared_ptr<ContactSequence>&, 
-                  const double, const int, const int>(),
+                  const double, const int, const int, const double>(),
           py::arg("robot"), py::arg("cost"), py::arg("constraints"), 
           py::arg("contact_sequence"), py::arg("T"), py::arg("N"),
-          py::arg("reserved_num_discrete_events")=0)
+          py::arg("reserved_num_discrete_events")=0, py::arg("grading_ratio")=1.0)
     .def(py::init<const Robot&, const std::shared_ptr<CostFunction>&,
                   const std::shared_ptr<Constraints>&, 
                   const double, const int>(),
@@ -44,6 +44,7 @@ PYBIND11_MODULE(ocp, m) {
     .def_readwrite("T", &OCP::T)
     .def_readwrite("N", &OCP::N)
     .def_readwrite("reserved_num_discrete_events", &OCP::reserved_num_discrete_events)
+    .def_readwrite("grading_ratio", &OCP::grading_ratio)
     DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(OCP)
     DEFINE_ROBOTOC_PYBIND11_CLASS_PRINT(OCP);
 }
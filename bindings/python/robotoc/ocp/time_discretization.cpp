@@ -15,9 +15,13 @@ namespace py = pybind11;
 
 PYBIND11_MODULE(time_discretization, m) {
   py::class_<TimeDiscretization>(m, "TimeDiscretization")
-    .def(py::init<const double, const int, const int>(), 
-          py::arg("T"), py::arg("N"), py::arg("reserved_num_discrete_events")=0)
+    .def(py::init<const double, const int, const int, const double>(), 
+          py::arg("T"), py::arg("N"), py::arg("reserved_num_discrete_events")=0,
+          py::arg("grading_ratio")=1.0)
     .def("N", &TimeDiscretization::N)
+    .def("grading_ratio", &TimeDiscretization::gradingRatio)
+    .def("nominal_time_step", &TimeDiscretization::nominalTimeStep,
+          py::arg("k"))
     .def("size", &TimeDiscretization::size) 
     .def("grid", &TimeDiscretization::grid,
           py::arg("i")) 
@@ -30,6 +34,7 @@ PYBIND11_MODULE(time_discretization, m) {
         return self.size();
      })
     .def("max_time_step", &TimeDiscretization::maxTimeStep)
+    .def("max_time_step_in_sto_phases", &TimeDiscretization::maxTimeStepInSTOPhases)
     .def("discretize", &TimeDiscretization::discretize,
           py::arg("contact_sequence"), py::arg("t")) 
     .def("correct_time_steps", &TimeDiscretization::correctTimeSteps,
@@ -135,6 +135,8 @@ PYBIND11_MODULE(contact_status, m) {
           static_cast<double (ContactStatus::*)(const std::string&) const>(&ContactStatus::frictionCoefficient),
           py::arg("contact_frame_name"))
     .def("friction_coefficients", &ContactStatus::frictionCoefficients)
+    .def("friction_cone", &ContactStatus::frictionCone,
+          py::arg("contact_index"))
     .def("find_contact_index", &ContactStatus::findContactIndex,
           py::arg("contact_frame_name"))
      DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(ContactStatus)
@@ -74,6 +74,8 @@ PYBIND11_MODULE(impact_status, m) {
           static_cast<double (ImpactStatus::*)(const std::string&) const>(&ImpactStatus::frictionCoefficient),
           py::arg("contact_frame_name"))
     .def("friction_coefficients", &ImpactStatus::frictionCoefficients)
+    .def("friction_cone", &ImpactStatus::frictionCone,
+          py::arg("contact_index"))
      DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(ImpactStatus)
      DEFINE_ROBOTOC_PYBIND11_CLASS_PRINT(ImpactStatus);
 }
@@ -147,6 +147,11 @@ PYBIND11_MODULE(robot, m) {
     .def("robot_properties", &Robot::robotProperties)
     .def("set_robot_properties", &Robot::setRobotProperties,
           py::arg("properties"))
+    .def("generate_codegen_kernels", &Robot::generateCodeGenKernels,
+          py::arg("library_name"), py::arg("compiler")="/usr/bin/gcc")
+    .def("load_codegen_kernels", &Robot::loadCodeGenKernels,
+          py::arg("library_name"))
+    .def("has_codegen_kernels", &Robot::hasCodeGenKernels)
      DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(Robot)
      DEFINE_ROBOTOC_PYBIND11_CLASS_PRINT(Robot);
 }
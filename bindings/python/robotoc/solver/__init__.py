@@ -3,4 +3,6 @@ from .solver_options import *
 from .solver_statistics import *
 from .ocp_solver import *
 from .unconstr_ocp_solver import *
-from .unconstr_parnmpc_solver import *
\ No newline at end of file
+from .unconstr_parnmpc_solver import *
+from .sliding_window_ocp_solver import *
+from .warm_start_library import *
@@ -40,6 +40,8 @@ PYBIND11_MODULE(ocp_solver, m) {
     .def("set_solution", 
           static_cast<void (OCPSolver::*)(const std::string&, const Eigen::VectorXd&)>(&OCPSolver::setSolution),
           py::arg("name"), py::arg("value"))
+    .def("interpolate_solution", &OCPSolver::interpolateSolution,
+          py::arg("time_discretization"), py::arg("s"))
     .def("KKT_error", 
           static_cast<double (OCPSolver::*)(const double, const Eigen::VectorXd&, const Eigen::VectorXd&)>(&OCPSolver::KKTError),
           py::arg("t"), py::arg("q"), py::arg("v"))
@@ -48,6 +50,10 @@ PYBIND11_MODULE(ocp_solver, m) {
     .def("get_time_discretization", &OCPSolver::getTimeDiscretization)
     .def("set_robot_properties", &OCPSolver::setRobotProperties,
           py::arg("properties"))
+    .def("save_solver_state", &OCPSolver::saveSolverState,
+          py::arg("filename"))
+    .def("load_solver_state", &OCPSolver::loadSolverState,
+          py::arg("filename"))
     DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(OCPSolver)
     DEFINE_ROBOTOC_PYBIND11_CLASS_PRINT(OCPSolver);
 }
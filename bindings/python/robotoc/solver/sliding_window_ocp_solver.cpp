@@ -0,0 +1,47 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+
+#include "robotoc/solver/sliding_window_ocp_solver.hpp"
+#include "robotoc/utils/pybind11_macros.hpp"
+
+
+namespace robotoc {
+namespace python {
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(sliding_window_ocp_solver, m) {
+  py::class_<SlidingWindowSettings>(m, "SlidingWindowSettings")
+    .def(py::init<>())
+    .def_readwrite("num_overlap_grids", &SlidingWindowSettings::num_overlap_grids)
+    .def_readwrite("max_admm_iter", &SlidingWindowSettings::max_admm_iter)
+    .def_readwrite("admm_penalty", &SlidingWindowSettings::admm_penalty)
+    .def_readwrite("admm_tol", &SlidingWindowSettings::admm_tol)
+    .def_readwrite("nthreads", &SlidingWindowSettings::nthreads)
+    DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(SlidingWindowSettings);
+
+  py::class_<SlidingWindowOCPSolver>(m, "SlidingWindowOCPSolver")
+    .def(py::init<const OCP&, const SolverOptions&, const SlidingWindowSettings&>(),
+          py::arg("ocp"), py::arg("solver_options")=SolverOptions(),
+          py::arg("settings")=SlidingWindowSettings())
+    .def("set_solver_options", &SlidingWindowOCPSolver::setSolverOptions,
+          py::arg("solver_options"))
+    .def("set_settings", &SlidingWindowOCPSolver::setSettings,
+          py::arg("settings"))
+    .def("solve", &SlidingWindowOCPSolver::solve,
+          py::arg("t"), py::arg("q"), py::arg("v"), py::arg("clip_length"))
+    .def("get_solution", &SlidingWindowOCPSolver::getSolution,
+          py::arg("name"), py::arg("option")="")
+    .def("get_times", &SlidingWindowOCPSolver::getTimes)
+    .def("get_window_solver", &SlidingWindowOCPSolver::getWindowSolver,
+          py::arg("window"))
+    .def("num_windows", &SlidingWindowOCPSolver::numWindows)
+    .def("admm_iter", &SlidingWindowOCPSolver::admmIter)
+    .def("primal_residual", &SlidingWindowOCPSolver::primalResidual)
+    .def("dual_residual", &SlidingWindowOCPSolver::dualResidual);
+}
+
+} // namespace python
+} // namespace robotoc
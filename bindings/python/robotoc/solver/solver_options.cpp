@@ -13,6 +13,7 @@ PYBIND11_MODULE(solver_options, m) {
   py::class_<SolverOptions>(m, "SolverOptions")
     .def(py::init<>())
     .def_readwrite("nthreads", &SolverOptions::nthreads)
+    .def_readwrite("enable_thread_pinning", &SolverOptions::enable_thread_pinning)
     .def_readwrite("max_iter", &SolverOptions::max_iter)
     .def_readwrite("kkt_tol", &SolverOptions::kkt_tol)
     .def_readwrite("mu_init", &SolverOptions::mu_init)
@@ -23,6 +24,8 @@ PYBIND11_MODULE(solver_options, m) {
     .def_readwrite("enable_line_search", &SolverOptions::enable_line_search)
     .def_readwrite("line_search_settings", &SolverOptions::line_search_settings)
     .def_readwrite("discretization_method", &SolverOptions::discretization_method)
+    .def_readwrite("move_blocking_size", &SolverOptions::move_blocking_size)
+    .def_readwrite("hessian_approximation", &SolverOptions::hessian_approximation)
     .def_readwrite("initial_sto_reg_iter", &SolverOptions::initial_sto_reg_iter)
     .def_readwrite("initial_sto_reg", &SolverOptions::initial_sto_reg)
     .def_readwrite("kkt_tol_mesh", &SolverOptions::kkt_tol_mesh)
@@ -31,6 +34,7 @@ PYBIND11_MODULE(solver_options, m) {
     .def_readwrite("enable_solution_interpolation", &SolverOptions::enable_solution_interpolation)
     .def_readwrite("interpolation_order", &SolverOptions::interpolation_order)
     .def_readwrite("enable_benchmark", &SolverOptions::enable_benchmark)
+    .def_readwrite("time_budget", &SolverOptions::time_budget)
     DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(SolverOptions)
     DEFINE_ROBOTOC_PYBIND11_CLASS_PRINT(SolverOptions);
 }
@@ -17,12 +17,15 @@ PYBIND11_MODULE(solver_statistics, m) {
   py::class_<SolverStatistics>(m, "SolverStatistics")
     .def(py::init<>())
     .def_readonly("convergence", &SolverStatistics::convergence)
+    .def_readonly("budget_exhausted", &SolverStatistics::budget_exhausted)
+    .def_readonly("best_iterate_restored", &SolverStatistics::best_iterate_restored)
     .def_readonly("iter", &SolverStatistics::iter)
     .def_readonly("performance_index", &SolverStatistics::performance_index)
     .def_readonly("primal_step_size", &SolverStatistics::primal_step_size)
     .def_readonly("dual_step_size", &SolverStatistics::dual_step_size)
     .def_readonly("ts", &SolverStatistics::ts)
     .def_readonly("mesh_refinement_iter", &SolverStatistics::mesh_refinement_iter)
+    .def_readonly("screened_constraints_ratio", &SolverStatistics::screened_constraints_ratio)
     .def_readonly("cpu_time", &SolverStatistics::cpu_time)
     DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(SolverStatistics)
     DEFINE_ROBOTOC_PYBIND11_CLASS_PRINT(SolverStatistics);
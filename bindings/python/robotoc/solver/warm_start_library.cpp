@@ -0,0 +1,55 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+
+#include "robotoc/solver/warm_start_library.hpp"
+#include "robotoc/utils/pybind11_macros.hpp"
+
+
+namespace robotoc {
+namespace python {
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(warm_start_library, m) {
+  py::class_<WarmStartKey>(m, "WarmStartKey")
+    .def(py::init<>())
+    .def(py::init<const std::string&, const std::vector<bool>&, const Eigen::VectorXd&>(),
+          py::arg("gait"), py::arg("contact_pattern"), py::arg("command"))
+    .def_readwrite("gait", &WarmStartKey::gait)
+    .def_readwrite("contact_pattern", &WarmStartKey::contact_pattern)
+    .def_readwrite("command", &WarmStartKey::command)
+    DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(WarmStartKey);
+
+  py::class_<WarmStartLibrary, std::shared_ptr<WarmStartLibrary>>(m, "WarmStartLibrary")
+    .def(py::init<const Robot&>(),
+          py::arg("robot"))
+    .def(py::init<>())
+    .def("set_max_command_distance", &WarmStartLibrary::setMaxCommandDistance,
+          py::arg("max_command_distance"))
+    .def("add", 
+          static_cast<void (WarmStartLibrary::*)(const WarmStartKey&, const TimeDiscretization&, const Solution&)>(&WarmStartLibrary::add),
+          py::arg("key"), py::arg("time_discretization"), py::arg("s"))
+    .def("add", 
+          static_cast<void (WarmStartLibrary::*)(const WarmStartKey&, const OCPSolver&)>(&WarmStartLibrary::add),
+          py::arg("key"), py::arg("ocp_solver"))
+    .def("find_nearest", &WarmStartLibrary::findNearest,
+          py::arg("key"))
+    .def("warm_start", &WarmStartLibrary::warmStart,
+          py::arg("key"), py::arg("t"), py::arg("q"), py::arg("ocp_solver"))
+    .def("key", &WarmStartLibrary::key,
+          py::arg("index"))
+    .def("size", &WarmStartLibrary::size)
+    .def("clear", &WarmStartLibrary::clear)
+    .def("save", &WarmStartLibrary::save,
+          py::arg("filename"))
+    .def("load", &WarmStartLibrary::load,
+          py::arg("filename"))
+    .def_static("contact_pattern", &WarmStartLibrary::contactPattern,
+          py::arg("contact_sequence"))
+    DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(WarmStartLibrary);
+}
+
+} // namespace python
+} // namespace robotoc
@@ -1,4 +1,5 @@
 from .trajectory_viewer import *
 from .plot import *
 from .adjust_video_duration import *
-from .rotation import *
\ No newline at end of file
+from .rotation import *
+from .batched_inverse_kinematics import *
@@ -0,0 +1,42 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/eigen.h>
+
+#include "robotoc/utils/batched_inverse_kinematics.hpp"
+#include "robotoc/utils/pybind11_macros.hpp"
+
+
+namespace robotoc {
+namespace python {
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(batched_inverse_kinematics, m) {
+  py::class_<InverseKinematicsSettings>(m, "InverseKinematicsSettings")
+    .def(py::init<>())
+    .def_readwrite("max_iter", &InverseKinematicsSettings::max_iter)
+    .def_readwrite("tol", &InverseKinematicsSettings::tol)
+    .def_readwrite("damping", &InverseKinematicsSettings::damping)
+    .def_readwrite("chunk_size", &InverseKinematicsSettings::chunk_size)
+    DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(InverseKinematicsSettings);
+
+  py::class_<BatchedInverseKinematics>(m, "BatchedInverseKinematics")
+    .def(py::init<const Robot&, const int, const int>(),
+          py::arg("robot"), py::arg("base_frame_id"), py::arg("nthreads")=1)
+    .def(py::init<const Robot&, const std::string&, const int>(),
+          py::arg("robot"), py::arg("base_frame_name"), py::arg("nthreads")=1)
+    .def("set_settings", &BatchedInverseKinematics::setSettings,
+          py::arg("settings"))
+    .def("set_nthreads", &BatchedInverseKinematics::setNumThreads,
+          py::arg("nthreads"))
+    .def("solve", [](BatchedInverseKinematics& self, const Eigen::VectorXd& q0,
+                     const std::vector<SE3>& base_array,
+                     const std::vector<std::vector<Eigen::Vector3d>>& contact_position_arrays) {
+        return self.solve(q0, base_array, contact_position_arrays);
+      }, py::arg("q0"), py::arg("base_array"), py::arg("contact_position_arrays"))
+    .def("get_errors", &BatchedInverseKinematics::getErrors)
+    DEFINE_ROBOTOC_PYBIND11_CLASS_CLONE(BatchedInverseKinematics);
+}
+
+} // namespace python
+} // namespace robotoc
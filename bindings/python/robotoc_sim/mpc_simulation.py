@@ -33,7 +33,7 @@ class MPCSimulation(object):
             if feedback_delay:
                 u = mpc.get_initial_control_input().copy()
             mpc.update_solution(t, dt, q, v)
-            kkt_error = mpc.KKT_error(t, q, v) 
+            kkt_error = mpc.KKT_error()
             if verbose:
                 print('KKT error = {:.6g}'.format(kkt_error))
                 print('')
@@ -0,0 +1,75 @@
+#include <memory>
+#include <iostream>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/mpc/mpc_trot.hpp"
+#include "robotoc/mpc/trot_foot_step_planner.hpp"
+#include "robotoc/solver/solver_options.hpp"
+
+#include "robotoc/utils/penalty_contact_simulator.hpp"
+#include "robotoc/utils/mpc_benchmarker.hpp"
+#include "robotoc/utils/tracer.hpp"
+
+
+int main () {
+  // Create a robot with contacts.
+  robotoc::RobotModelInfo model_info;
+  model_info.urdf_path = "../anymal_b_simple_description/urdf/anymal.urdf";
+  model_info.base_joint_type = robotoc::BaseJointType::FloatingBase;
+  const double baumgarte_time_step = 0.05;
+  model_info.point_contacts = {robotoc::ContactModelInfo("LF_FOOT", baumgarte_time_step),
+                               robotoc::ContactModelInfo("LH_FOOT", baumgarte_time_step),
+                               robotoc::ContactModelInfo("RF_FOOT", baumgarte_time_step),
+                               robotoc::ContactModelInfo("RH_FOOT", baumgarte_time_step)};
+  robotoc::Robot robot(model_info);
+
+  // Create the MPC of the trotting gait.
+  const Eigen::Vector3d step_length = {0.15, 0, 0};
+  const double step_yaw = 0;
+  const double swing_height = 0.1;
+  const double swing_time = 0.25;
+  const double stance_time = 0.0;
+  const double swing_start_time = 0.5;
+  const double T = 0.5;
+  const int N = 20;
+  robotoc::MPCTrot mpc(robot, T, N);
+  auto planner = std::make_shared<robotoc::TrotFootStepPlanner>(robot);
+  planner->setGaitPattern(step_length, (step_yaw*swing_time), (stance_time > 0.));
+  mpc.setGaitPattern(planner, swing_height, swing_time, stance_time, swing_start_time);
+
+  const double t0 = 0.0;
+  Eigen::VectorXd q0(robot.dimq());
+  q0 << 0, 0, 0.4842, 0, 0, 0, 1, 
+        -0.1,  0.7, -1.0, 
+        -0.1, -0.7,  1.0, 
+         0.1,  0.7, -1.0, 
+         0.1, -0.7,  1.0;
+  const Eigen::VectorXd v0 = Eigen::VectorXd::Zero(robot.dimv());
+  auto option_init = robotoc::SolverOptions();
+  option_init.max_iter = 10;
+  option_init.nthreads = 4;
+  mpc.init(t0, q0, v0, option_init);
+  auto option_mpc = robotoc::SolverOptions();
+  option_mpc.max_iter = 1; // MPC iterations
+  option_mpc.nthreads = 4;
+  mpc.setSolverOptions(option_mpc);
+
+  // Run the closed-loop simulation.
+  const double time_step = 0.0025; // 400 Hz MPC
+  robotoc::PenaltyContactSimulator simulator(robot, time_step);
+  const double simulation_time = 5.0;
+  const bool feedback_delay = true;
+  const auto statistics = robotoc::benchmark::ClosedLoop(mpc, simulator, t0, q0, v0, 
+                                                         simulation_time, feedback_delay);
+  std::cout << statistics << std::endl;
+
+  // Export the timeline of the last ticks if robotoc is built with ENABLE_TRACE.
+  // The JSON can be opened by chrome://tracing or https://ui.perfetto.dev.
+  if (robotoc::Tracer::isEnabled()) {
+    robotoc::Tracer::exportChromeTrace("mpc_benchmark_trace.json");
+  }
+
+  return 0;
+}
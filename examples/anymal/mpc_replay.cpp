@@ -0,0 +1,107 @@
+#include <memory>
+#include <iostream>
+#include <string>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/mpc/mpc_trot.hpp"
+#include "robotoc/mpc/trot_foot_step_planner.hpp"
+#include "robotoc/solver/solver_options.hpp"
+
+#include "robotoc/utils/penalty_contact_simulator.hpp"
+#include "robotoc/utils/mpc_recorder.hpp"
+#include "robotoc/utils/mpc_benchmarker.hpp"
+
+
+// Usage:
+//   ./mpc_replay record [log]  runs the closed-loop simulation and records
+//                              the input stream of MPC to the log.
+//   ./mpc_replay replay [log]  replays the log against this build and checks
+//                              the divergence from the recorded solution.
+int main (int argc, char* argv[]) {
+  const std::string mode = (argc > 1) ? argv[1] : "replay";
+  const std::string log = (argc > 2) ? argv[2] : "mpc_trot_log.bin";
+  if (mode != "record" && mode != "replay") {
+    std::cerr << "Usage: " << argv[0] << " [record|replay] [log]" << std::endl;
+    return 1;
+  }
+
+  // Create a robot with contacts.
+  robotoc::RobotModelInfo model_info;
+  model_info.urdf_path = "../anymal_b_simple_description/urdf/anymal.urdf";
+  model_info.base_joint_type = robotoc::BaseJointType::FloatingBase;
+  const double baumgarte_time_step = 0.05;
+  model_info.point_contacts = {robotoc::ContactModelInfo("LF_FOOT", baumgarte_time_step),
+                               robotoc::ContactModelInfo("LH_FOOT", baumgarte_time_step),
+                               robotoc::ContactModelInfo("RF_FOOT", baumgarte_time_step),
+                               robotoc::ContactModelInfo("RH_FOOT", baumgarte_time_step)};
+  robotoc::Robot robot(model_info);
+
+  // Create the MPC of the trotting gait. The construction must be the same in
+  // the record and the replay.
+  const double swing_height = 0.1;
+  const double swing_time = 0.25;
+  const double stance_time = 0.0;
+  const double swing_start_time = 0.5;
+  const double T = 0.5;
+  const int N = 20;
+  robotoc::MPCTrot mpc(robot, T, N);
+  auto planner = std::make_shared<robotoc::TrotFootStepPlanner>(robot);
+  // The gait command is (step length, step yaw).
+  auto apply_command = [&](const Eigen::VectorXd& command) {
+    planner->setGaitPattern(command.head<3>(), command.coeff(3), (stance_time > 0.));
+  };
+  Eigen::VectorXd command(4);
+  command << 0.15, 0, 0, 0;
+  apply_command(command);
+  mpc.setGaitPattern(planner, swing_height, swing_time, stance_time, swing_start_time);
+
+  if (mode == "replay") {
+    robotoc::MPCRecorder recorder;
+    recorder.load(log);
+    const auto statistics = robotoc::benchmark::Replay(mpc, recorder, apply_command);
+    std::cout << statistics << std::endl;
+    return statistics.isConsistent() ? 0 : 2;
+  }
+
+  const double t0 = 0.0;
+  Eigen::VectorXd q0(robot.dimq());
+  q0 << 0, 0, 0.4842, 0, 0, 0, 1,
+        -0.1,  0.7, -1.0,
+        -0.1, -0.7,  1.0,
+         0.1,  0.7, -1.0,
+         0.1, -0.7,  1.0;
+  const Eigen::VectorXd v0 = Eigen::VectorXd::Zero(robot.dimv());
+  robotoc::MPCRecorder recorder;
+  recorder.recordCommand(command);
+  auto option_init = robotoc::SolverOptions();
+  option_init.max_iter = 10;
+  option_init.nthreads = 4;
+  recorder.init(mpc, t0, q0, v0, option_init);
+  auto option_mpc = robotoc::SolverOptions();
+  option_mpc.max_iter = 1; // MPC iterations
+  option_mpc.nthreads = 4;
+  recorder.setSolverOptions(mpc, option_mpc);
+
+  // Run the closed-loop simulation with a turning command in the middle.
+  const double time_step = 0.0025; // 400 Hz MPC
+  robotoc::PenaltyContactSimulator simulator(robot, time_step);
+  simulator.init(t0, q0, v0);
+  const double simulation_time = 5.0;
+  const int num_ticks = static_cast<int>(simulation_time/time_step);
+  recorder.reserve(num_ticks+4);
+  for (int k=0; k<num_ticks; ++k) {
+    if (k == num_ticks/2) {
+      command << 0.1, 0, 0, 0.1;
+      recorder.recordCommand(command);
+      apply_command(command);
+    }
+    recorder.updateSolution(mpc, simulator.t(), time_step, simulator.q(), simulator.v());
+    simulator.step(mpc.getInitialControlInput());
+  }
+  recorder.save(log);
+  std::cout << "Recorded " << recorder.size() << " records to " << log << std::endl;
+
+  return 0;
+}
@@ -243,6 +243,20 @@ int main(int argc, char *argv[]) {
   std::cout << "KKT error after convergence: " << ocp_solver.KKTError(t, q, v) << std::endl;
   std::cout << ocp_solver.getSolverStatistics() << std::endl;
 
+  // Solves the OCP with the BFGS approximation of the Hessian of the stage 
+  // cost to compare the number of iterations.
+  solver_options.hessian_approximation = robotoc::HessianApproximation::BFGS;
+  solver_options.enable_benchmark = true;
+  robotoc::OCPSolver ocp_solver_bfgs(ocp, solver_options);
+  ocp_solver_bfgs.discretize(t);
+  ocp_solver_bfgs.setSolution("q", q);
+  ocp_solver_bfgs.setSolution("v", v);
+  ocp_solver_bfgs.setSolution("f", f_init);
+  ocp_solver_bfgs.initConstraints();
+  ocp_solver_bfgs.solve(t, q, v);
+  std::cout << "KKT error after convergence (BFGS): " << ocp_solver_bfgs.KKTError(t, q, v) << std::endl;
+  std::cout << ocp_solver_bfgs.getSolverStatistics() << std::endl;
+
   // const int num_iteration = 10000;
   // robotoc::benchmark::CPUTime(ocp_solver, t, q, v, num_iteration);
 
@@ -83,5 +83,18 @@ int main() {
   const int num_iteration_CPU = 10000;
   robotoc::benchmark::CPUTime(ocp_solver, t, q, v, num_iteration_CPU);
 
+  // Solves the OCP and measures CPU timing with the BFGS approximation of 
+  // the Hessian of the stage cost.
+  solver_options.hessian_approximation = robotoc::HessianApproximation::BFGS;
+  robotoc::OCPSolver ocp_solver_bfgs(ocp, solver_options);
+  ocp_solver_bfgs.discretize(t);
+  ocp_solver_bfgs.setSolution("q", q);
+  ocp_solver_bfgs.setSolution("v", v);
+  ocp_solver_bfgs.initConstraints();
+  ocp_solver_bfgs.solve(t, q, v);
+  std::cout << "KKT error after convergence (BFGS): " << ocp_solver_bfgs.KKTError(t, q, v) << std::endl;
+  std::cout << ocp_solver_bfgs.getSolverStatistics() << std::endl;
+  robotoc::benchmark::CPUTime(ocp_solver_bfgs, t, q, v, num_iteration_CPU);
+
   return 0;
 }
\ No newline at end of file
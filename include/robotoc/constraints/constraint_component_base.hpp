@@ -1,6 +1,8 @@
 #ifndef ROBOTOC_CONSTRAINT_COMPONENT_BASE_HPP_
 #define ROBOTOC_CONSTRAINT_COMPONENT_BASE_HPP_
 
+#include <memory>
+
 #include "Eigen/Core"
 
 #include "robotoc/robot/robot.hpp"
@@ -73,6 +75,15 @@ public:
   ///
   virtual KinematicsLevel kinematicsLevel() const = 0;
 
+  ///
+  /// @brief Creates a deep copy of this constraint component, e.g., for 
+  /// solvers that set the barrier parameter of each copy independently. 
+  /// The default implementation throws std::runtime_error; the components 
+  /// of robotoc override it.
+  /// @return Shared pointer to the copy.
+  ///
+  virtual std::shared_ptr<ConstraintComponentBase> clone() const;
+
   ///
   /// @brief Allocates extra data in ConstraintComponentData.
   /// @param[in] data Constraint component data.
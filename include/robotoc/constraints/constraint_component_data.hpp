@@ -5,6 +5,8 @@
 
 #include "Eigen/Core"
 
+#include "robotoc/utils/binary_archive.hpp"
+
 
 namespace robotoc {
 
@@ -101,6 +103,19 @@ public:
   ///
   double log_barrier;
 
+  ///
+  /// @brief Flag if the condensing of the constraint is skipped by the 
+  /// active-set screening in the current evaluation. See 
+  /// Constraints::setActiveSetScreening().
+  ///
+  bool is_screened;
+
+  ///
+  /// @brief Number of the consecutive evaluations skipped by the active-set 
+  /// screening. -1 until the constraint is linearized for the first time. 
+  ///
+  int num_screened;
+
   ///
   /// @brief std vector of Eigen::VectorXd used to store residual temporaly. 
   /// Only be allocated in ConstraintComponentBase::allocateExtraData().
@@ -175,6 +190,22 @@ public:
   ///
   bool isApprox(const ConstraintComponentData& other) const;
 
+  ///
+  /// @brief Saves the slack and dual variables into a binary archive. The 
+  /// other members are not saved because they are recomputed from the slack 
+  /// and dual variables in the evaluation of the KKT system.
+  /// @param[in, out] ar Output archive.
+  ///
+  void save(BinaryOutputArchive& ar) const;
+
+  ///
+  /// @brief Loads the slack and dual variables saved by 
+  /// ConstraintComponentData::save(). Throws std::runtime_error if the stored 
+  /// dimension is not ConstraintComponentData::dimc().
+  /// @param[in, out] ar Input archive.
+  ///
+  void load(BinaryInputArchive& ar);
+
 private:
   int dimc_;
 
@@ -87,6 +87,15 @@ public:
   ///
   void clear();
 
+  ///
+  /// @brief Creates a deep copy of the constraints, i.e., the constraint 
+  /// components are also copied by their clone(). The barrier parameter of 
+  /// the copy can be set independently of this object, whereas the copy 
+  /// constructor shares the components.
+  /// @return Shared pointer to the copy.
+  ///
+  std::shared_ptr<Constraints> clone() const;
+
   ///
   /// @brief Creates ConstraintsData according to robot model and constraint 
   /// components. 
@@ -192,6 +201,36 @@ public:
                             ConstraintsData& data, const SplitSolution& s,
                             SplitKKTResidual& kkt_residual) const;
 
+  ///
+  /// @brief Evaluates the constraints and adds the products of the Jacobian 
+  /// of the constraints and Lagrange multipliers in the same way as 
+  /// linearizeConstraints(), but does not change the state of the active-set 
+  /// screening. Used to evaluate the KKT residual without the condensing.
+  /// @param[in] robot Robot model.
+  /// @param[in] contact_status Contact status.
+  /// @param[in] data Constraints data. 
+  /// @param[in] s Split solution.
+  /// @param[out] kkt_residual KKT residual.
+  ///
+  void evalKKTResidual(Robot& robot, const ContactStatus& contact_status, 
+                       ConstraintsData& data, const SplitSolution& s, 
+                       SplitKKTResidual& kkt_residual) const;
+
+  ///
+  /// @brief Evaluates the constraints and adds the products of the Jacobian 
+  /// of the constraints and Lagrange multipliers in the same way as 
+  /// linearizeConstraints(), but does not change the state of the active-set 
+  /// screening. Used to evaluate the KKT residual without the condensing.
+  /// @param[in] robot Robot model.
+  /// @param[in] impact_status Impact status.
+  /// @param[in] data Constraints data. 
+  /// @param[in] s Split solution.
+  /// @param[out] kkt_residual KKT residual.
+  ///
+  void evalKKTResidual(Robot& robot, const ImpactStatus& impact_status, 
+                       ConstraintsData& data, const SplitSolution& s,
+                       SplitKKTResidual& kkt_residual) const;
+
   ///
   /// @brief Condenses the slack and dual variables. linearizeConstraints() must 
   /// be called before this function.
@@ -286,6 +325,34 @@ public:
   ///
   void setFractionToBoundaryRule(const double fraction_to_boundary_rule);
 
+  ///
+  /// @brief Sets the active-set screening. In condenseSlackAndDual(), the 
+  /// condensing of the constraint components whose dual variables and ratios 
+  /// of the dual to slack variables are all below the threshold, i.e., whose 
+  /// contributions to the condensed KKT system are negligible, is skipped. 
+  /// The screened components are determined in linearizeConstraints(). Each 
+  /// screened component is revalidated by the full condensing after 
+  /// revalidation_interval consecutive screened evaluations. The number of 
+  /// the screened components is given by ConstraintsData::numScreened().
+  /// @param[in] threshold Threshold of the screening. Must be non-negative. 
+  /// 0 disables the screening. Default is 0.
+  /// @param[in] revalidation_interval Maximum number of the consecutive 
+  /// screened evaluations of each component. Must be positive. Default is 10.
+  /// @note The screening drops the condensed Hessians and residuals of the 
+  /// screened components from the Newton system, so the Newton direction is 
+  /// an approximation whose error is controlled by the threshold. The KKT 
+  /// residual, and therefore the KKT error, is exact because the products of 
+  /// the Jacobians and the dual variables are always evaluated.
+  ///
+  void setActiveSetScreening(const double threshold, 
+                             const int revalidation_interval=10);
+
+  ///
+  /// @brief Checks whether the active-set screening is enabled.
+  /// @return true if the active-set screening is enabled. false otherwise.
+  ///
+  bool isActiveSetScreeningEnabled() const;
+
   ///
   /// @brief Gets the barrier parameter.
   /// @return Barrier parameter. 
@@ -303,7 +370,8 @@ private:
                                           velocity_level_constraints_, 
                                           acceleration_level_constraints_;
   std::vector<ImpactConstraintComponentBasePtr> impact_level_constraints_;
-  double barrier_, fraction_to_boundary_rule_;
+  double barrier_, fraction_to_boundary_rule_, screening_threshold_;
+  int screening_interval_;
 };
 
 } // namespace robotoc
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "robotoc/constraints/constraint_component_data.hpp"
+#include "robotoc/utils/binary_archive.hpp"
 
 
 namespace robotoc {
@@ -106,6 +107,20 @@ public:
   ///
   double logBarrier() const;
 
+  ///
+  /// @brief Returns the number of the constraint components skipped by the 
+  /// active-set screening in the last evaluation. See 
+  /// Constraints::setActiveSetScreening().
+  /// @return Number of the screened constraint components. 
+  ///
+  int numScreened() const;
+
+  ///
+  /// @brief Returns the number of the valid constraint components. 
+  /// @return Number of the valid constraint components. 
+  ///
+  int numComponents() const;
+
   ///
   /// @brief Returns the lp norm of the primal feasibility, i.e., the constraint 
   /// violation. Default norm is l1-norm. You can also specify l-infty norm by 
@@ -126,6 +141,22 @@ public:
   template <int p=1>
   double dualFeasibility() const;
 
+  ///
+  /// @brief Saves the slack and dual variables of all the constraint 
+  /// components into a binary archive.
+  /// @param[in, out] ar Output archive.
+  ///
+  void save(BinaryOutputArchive& ar) const;
+
+  ///
+  /// @brief Loads the slack and dual variables saved by 
+  /// ConstraintsData::save(). The data must be allocated beforehand by 
+  /// Constraints::createConstraintsData(). Throws std::runtime_error if the 
+  /// stored components are not consistent with the allocated ones.
+  /// @param[in, out] ar Input archive.
+  ///
+  void load(BinaryInputArchive& ar);
+
   ///
   /// @brief The collection of the position-level constraints data. 
   ///
@@ -58,6 +58,50 @@ inline double ConstraintsData::logBarrier() const {
 }
 
 
+inline int ConstraintsData::numScreened() const {
+  int num = 0;
+  if (isPositionLevelValid()) {
+    for (const auto& data : position_level_data) {
+      if (data.is_screened) ++num;
+    }
+  }
+  if (isVelocityLevelValid()) {
+    for (const auto& data : velocity_level_data) {
+      if (data.is_screened) ++num;
+    }
+  }
+  if (isAccelerationLevelValid()) {
+    for (const auto& data : acceleration_level_data) {
+      if (data.is_screened) ++num;
+    }
+  }
+  if (isImpactLevelValid()) {
+    for (const auto& data : impact_level_data) {
+      if (data.is_screened) ++num;
+    }
+  }
+  return num;
+}
+
+
+inline int ConstraintsData::numComponents() const {
+  int num = 0;
+  if (isPositionLevelValid()) {
+    num += position_level_data.size();
+  }
+  if (isVelocityLevelValid()) {
+    num += velocity_level_data.size();
+  }
+  if (isAccelerationLevelValid()) {
+    num += acceleration_level_data.size();
+  }
+  if (isImpactLevelValid()) {
+    num += impact_level_data.size();
+  }
+  return num;
+}
+
+
 template <int p>
 inline double ConstraintsData::primalFeasibility() const {
   double feasibility = 0.0;
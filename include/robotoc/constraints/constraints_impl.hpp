@@ -78,20 +78,56 @@ void evalConstraint(
 ///
 /// @brief Evaluates the constraints (i.e., calls evalConstraint()) and adds 
 /// the products of the Jacobian of the constraints and Lagrange multipliers.
+/// The components screened by isScreenable() are flagged so that their 
+/// condensing is skipped.
 /// @param[in] constraints Vector of the constraint components. 
 /// @param[in] robot Robot model.
 /// @param[in] contact_status Contact status.
 /// @param[in, out] data Vector of the constraints data.
 /// @param[in] s Split solution.
 /// @param[in, out] kkt_residual Split KKT residual.
+/// @param[in] screening_threshold Threshold of the active-set screening. 
+/// 0 disables the screening.
+/// @param[in] screening_interval Maximum number of the consecutive screened 
+/// evaluations of each component.
 ///
 template <typename ConstraintComponentBaseTypePtr, typename ContactStatusType>
 void linearizeConstraints(
+    const std::vector<ConstraintComponentBaseTypePtr>& constraints,
+    Robot& robot, const ContactStatusType& contact_status, 
+    std::vector<ConstraintComponentData>& data, const SplitSolution& s, 
+    SplitKKTResidual& kkt_residual, const double screening_threshold, 
+    const int screening_interval);
+
+///
+/// @brief Evaluates the constraints (i.e., calls evalConstraint()) and adds 
+/// the products of the Jacobian of the constraints and Lagrange multipliers
+/// without changing the state of the active-set screening.
+/// @param[in] constraints Vector of the constraint components. 
+/// @param[in] robot Robot model.
+/// @param[in] contact_status Contact status.
+/// @param[in, out] data Vector of the constraints data.
+/// @param[in] s Split solution.
+/// @param[in, out] kkt_residual Split KKT residual.
+///
+template <typename ConstraintComponentBaseTypePtr, typename ContactStatusType>
+void evalKKTResidual(
     const std::vector<ConstraintComponentBaseTypePtr>& constraints,
     Robot& robot, const ContactStatusType& contact_status, 
     std::vector<ConstraintComponentData>& data, const SplitSolution& s, 
     SplitKKTResidual& kkt_residual);
 
+///
+/// @brief Checks whether the condensing contribution of a constraint 
+/// component is negligible, i.e., all the dual variables and all the ratios 
+/// of the dual to slack variables are below the threshold.
+/// @param[in] data Constraint component data.
+/// @param[in] screening_threshold Threshold of the active-set screening. 
+/// @return true if the condensing can be skipped. 
+///
+bool isScreenable(const ConstraintComponentData& data, 
+                  const double screening_threshold);
+
 ///
 /// @brief Condenses the slack and dual variables. linearizeConstraints() must 
 /// be called before this function.
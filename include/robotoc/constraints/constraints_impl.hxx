@@ -80,6 +80,41 @@ inline void evalConstraint(
 
 template <typename ConstraintComponentBaseTypePtr, typename ContactStatusType>
 inline void linearizeConstraints(
+    const std::vector<ConstraintComponentBaseTypePtr>& constraints,
+    Robot& robot, const ContactStatusType& contact_status, 
+    std::vector<ConstraintComponentData>& data, const SplitSolution& s, 
+    SplitKKTResidual& kkt_residual, const double screening_threshold, 
+    const int screening_interval) {
+  assert(constraints.size() == data.size());
+  assert(screening_threshold >= 0);
+  for (int i=0; i<constraints.size(); ++i) {
+    assert(data[i].dimc() == constraints[i]->dimc());
+    assert(data[i].checkDimensionalConsistency());
+    data[i].residual.setZero();
+    data[i].cmpl.setZero();
+    constraints[i]->evalConstraint(robot, contact_status, data[i], s);
+    // The derivatives are evaluated also for the screened components so that 
+    // the KKT residual contains all the products of the Jacobians and the 
+    // dual variables. The screened components are revalidated after 
+    // screening_interval consecutive evaluations.
+    constraints[i]->evalDerivatives(robot, contact_status, data[i], s, 
+                                    kkt_residual);
+    data[i].is_screened = (screening_threshold > 0 
+                            && data[i].num_screened >= 0
+                            && data[i].num_screened < screening_interval
+                            && isScreenable(data[i], screening_threshold));
+    if (data[i].is_screened) {
+      ++data[i].num_screened;
+    }
+    else {
+      data[i].num_screened = 0;
+    }
+  }
+}
+
+
+template <typename ConstraintComponentBaseTypePtr, typename ContactStatusType>
+inline void evalKKTResidual(
     const std::vector<ConstraintComponentBaseTypePtr>& constraints,
     Robot& robot, const ContactStatusType& contact_status, 
     std::vector<ConstraintComponentData>& data, const SplitSolution& s, 
@@ -97,6 +132,13 @@ inline void linearizeConstraints(
 }
 
 
+inline bool isScreenable(const ConstraintComponentData& data, 
+                         const double screening_threshold) {
+  return ((data.dual.array() < screening_threshold).all()
+          && (data.dual.array() < screening_threshold*data.slack.array()).all());
+}
+
+
 template <typename ConstraintComponentBaseTypePtr, typename ContactStatusType>
 inline void condenseSlackAndDual(
     const std::vector<ConstraintComponentBaseTypePtr>& constraints, 
@@ -107,6 +149,7 @@ inline void condenseSlackAndDual(
   for (int i=0; i<constraints.size(); ++i) {
     assert(data[i].dimc() == constraints[i]->dimc());
     assert(data[i].checkDimensionalConsistency());
+    if (data[i].is_screened) continue;
     constraints[i]->condenseSlackAndDual(contact_status, data[i], kkt_matrix, 
                                          kkt_residual);
   }
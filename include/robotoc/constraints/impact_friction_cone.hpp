@@ -61,6 +61,8 @@ public:
 
   KinematicsLevel kinematicsLevel() const override;
 
+  std::shared_ptr<ImpactConstraintComponentBase> clone() const override;
+
   void allocateExtraData(ConstraintComponentData& data) const override;
 
   bool isFeasible(Robot& robot, const ImpactStatus& impact_status, 
@@ -157,16 +159,6 @@ private:
     return data.J[3*max_num_contacts_+contact_idx];
   }
 
-  Eigen::MatrixXd& cone_local(ConstraintComponentData& data, 
-                              const int contact_idx) const {
-    return data.J[4*max_num_contacts_+contact_idx];
-  }
-
-  Eigen::MatrixXd& cone_world(ConstraintComponentData& data, 
-                              const int contact_idx) const {
-    return data.J[5*max_num_contacts_+contact_idx];
-  }
-
 };
 
 } // namespace robotoc
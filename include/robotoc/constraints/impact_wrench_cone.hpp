@@ -67,6 +67,8 @@ public:
 
   KinematicsLevel kinematicsLevel() const override;
 
+  std::shared_ptr<ImpactConstraintComponentBase> clone() const override;
+
   void allocateExtraData(ConstraintComponentData& data) const override;
 
   bool isFeasible(Robot& robot, const ImpactStatus& impact_status, 
@@ -62,6 +62,8 @@ public:
 
   KinematicsLevel kinematicsLevel() const override;
 
+  std::shared_ptr<ConstraintComponentBase> clone() const override;
+
   void allocateExtraData(ConstraintComponentData& data) const override {}
 
   bool isFeasible(Robot& robot, const ContactStatus& contact_status, 
@@ -5,6 +5,7 @@
 
 #include "robotoc/core/split_solution.hpp"
 #include "robotoc/utils/aligned_vector.hpp"
+#include "robotoc/utils/binary_archive.hpp"
 
 
 namespace robotoc {
@@ -15,6 +16,21 @@ namespace robotoc {
 ///
 using Solution = aligned_vector<SplitSolution>;
 
+///
+/// @brief Saves the solution into a binary archive.
+/// @param[in, out] ar Output archive.
+/// @param[in] s Solution.
+///
+void save(BinaryOutputArchive& ar, const Solution& s);
+
+///
+/// @brief Loads the solution saved by save(). The solution is resized to the
+/// stored number of the stages.
+/// @param[in, out] ar Input archive.
+/// @param[out] s Solution.
+///
+void load(BinaryInputArchive& ar, Solution& s);
+
 std::ostream& operator<<(std::ostream& os, const Solution& s);
 
 } // namespace robotoc
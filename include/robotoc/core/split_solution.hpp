@@ -9,6 +9,7 @@
 #include "robotoc/robot/robot.hpp"
 #include "robotoc/robot/contact_status.hpp"
 #include "robotoc/core/split_direction.hpp"
+#include "robotoc/utils/binary_archive.hpp"
 
 
 namespace robotoc {
@@ -333,6 +334,20 @@ public:
                               const ContactStatus& contact_status,
                               const ImpactStatus& impact_status);
 
+  ///
+  /// @brief Saves the split solution including the contact status into a 
+  /// binary archive.
+  /// @param[in, out] ar Output archive.
+  ///
+  void save(BinaryOutputArchive& ar) const;
+
+  ///
+  /// @brief Loads the split solution saved by SplitSolution::save(). All the
+  /// members including the contact status are overwritten.
+  /// @param[in, out] ar Input archive.
+  ///
+  void load(BinaryInputArchive& ar);
+
   ///
   /// @brief Displays the split solution onto a ostream.
   ///
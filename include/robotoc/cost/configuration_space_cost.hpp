@@ -215,6 +215,41 @@ public:
     }
   }
 
+  ///
+  /// @brief Adds the Hessian of the configuration cost of a floating-base 
+  /// robot, i.e., coeff * J_qdiff^T * diag(q_weight) * J_qdiff, to Qqq. 
+  /// If all the joints except for the floating base have the same dimensions 
+  /// of the configuration and velocity, J_qdiff is block diagonal with the 
+  /// identity for the joints and only the block of the floating base is 
+  /// computed densely. 
+  /// @param[in] coeff Coefficient.
+  /// @param[in] q_weight Weight on the configuration.
+  /// @param[in] data Cost funciton data.
+  /// @param[in, out] kkt_matrix Split KKT matrix.
+  ///
+  void addConfigDiffHessian(const double coeff, const Eigen::VectorXd& q_weight,
+                            const CostFunctionData& data, 
+                            SplitKKTMatrix& kkt_matrix) const {
+    if (dimq_ == dimv_+1) {
+      kkt_matrix.Qqq().template topLeftCorner<6, 6>().noalias()
+          += coeff * data.J_qdiff.template topLeftCorner<6, 6>().transpose() 
+                   * q_weight.template head<6>().asDiagonal() 
+                   * data.J_qdiff.template topLeftCorner<6, 6>();
+      kkt_matrix.Qqq().diagonal().tail(dimv_-6).noalias() 
+          += coeff * q_weight.tail(dimv_-6);
+    }
+    else {
+      kkt_matrix.Qqq().noalias()
+          += coeff * data.J_qdiff.transpose() * q_weight.asDiagonal() * data.J_qdiff;
+    }
+  }
+
+  ///
+  /// @brief The Hessians are constant unless the configuration cost is 
+  /// enabled for a floating-base robot or with a time-varying reference.
+  ///
+  bool hasConstantHessian() const override;
+
   double evalStageCost(Robot& robot, const ContactStatus& contact_status, 
                        CostFunctionData& data, const GridInfo& grid_info, 
                        const SplitSolution& s) const override;
@@ -256,6 +291,7 @@ public:
 
 private:
   int dimq_, dimv_, dimu_;
+  bool has_floating_base_;
   Eigen::VectorXd q_ref_, v_ref_, u_ref_, 
                   q_weight_, v_weight_, a_weight_, u_weight_,
                   q_weight_terminal_, v_weight_terminal_, 
@@ -0,0 +1,160 @@
+#ifndef ROBOTOC_CONSENSUS_COST_HPP_
+#define ROBOTOC_CONSENSUS_COST_HPP_
+
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/robot/contact_status.hpp"
+#include "robotoc/robot/impact_status.hpp"
+#include "robotoc/core/split_solution.hpp"
+#include "robotoc/core/split_kkt_residual.hpp"
+#include "robotoc/core/split_kkt_matrix.hpp"
+#include "robotoc/cost/cost_function_component_base.hpp"
+#include "robotoc/cost/cost_function_data.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class ConsensusCost
+/// @brief Quadratic penalty on the deviation of the state from the targets 
+/// at specified time points, i.e., the augmented Lagrangian term of the 
+/// consensus ADMM. The penalty is not scaled by the time step and is imposed 
+/// only on the intermediate and terminal grids whose time coincides with one
+/// of the time points. 
+///
+class ConsensusCost final : public CostFunctionComponentBase {
+public:
+  ///
+  /// @brief Constructor. 
+  /// @param[in] robot Robot model.
+  /// @param[in] penalty Penalty parameter. Must be non-negative.
+  ///
+  ConsensusCost(const Robot& robot, const double penalty);
+
+  ///
+  /// @brief Default constructor. 
+  ///
+  ConsensusCost();
+
+  ///
+  /// @brief Destructor. 
+  ///
+  ~ConsensusCost();
+
+  ///
+  /// @brief Default copy constructor. 
+  ///
+  ConsensusCost(const ConsensusCost&) = default;
+
+  ///
+  /// @brief Default copy operator. 
+  ///
+  ConsensusCost& operator=(const ConsensusCost&) = default;
+
+  ///
+  /// @brief Default move constructor. 
+  ///
+  ConsensusCost(ConsensusCost&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator. 
+  ///
+  ConsensusCost& operator=(ConsensusCost&&) noexcept = default;
+
+  ///
+  /// @brief Sets the penalty parameter. 
+  /// @param[in] penalty Penalty parameter. Must be non-negative.
+  ///
+  void set_penalty(const double penalty);
+
+  ///
+  /// @brief Sets the time points and the targets. 
+  /// @param[in] times Time points. 
+  /// @param[in] q_targets Target configurations. Size of each element must be 
+  /// Robot::dimq().
+  /// @param[in] v_targets Target velocities. Size of each element must be 
+  /// Robot::dimv().
+  ///
+  void set_targets(const std::vector<double>& times, 
+                   const std::vector<Eigen::VectorXd>& q_targets,
+                   const std::vector<Eigen::VectorXd>& v_targets);
+
+  ///
+  /// @brief Clears the time points and the targets. 
+  ///
+  void clear_targets();
+
+  ///
+  /// @brief Finds the target of the grid. 
+  /// @param[in] grid_info Grid info.
+  /// @return Index of the target. -1 if the cost is inactive at the grid.
+  ///
+  int findTarget(const GridInfo& grid_info) const;
+
+  double evalStageCost(Robot& robot, const ContactStatus& contact_status, 
+                       CostFunctionData& data, const GridInfo& grid_info, 
+                       const SplitSolution& s) const override;
+
+  void evalStageCostDerivatives(Robot& robot, const ContactStatus& contact_status, 
+                                CostFunctionData& data, const GridInfo& grid_info,
+                                const SplitSolution& s, 
+                                SplitKKTResidual& kkt_residual) const override;
+
+  void evalStageCostHessian(Robot& robot, const ContactStatus& contact_status, 
+                            CostFunctionData& data, const GridInfo& grid_info,  
+                            const SplitSolution& s, 
+                            SplitKKTMatrix& kkt_matrix) const override;
+
+  double evalTerminalCost(Robot& robot, CostFunctionData& data, 
+                          const GridInfo& grid_info, 
+                          const SplitSolution& s) const override;
+
+  void evalTerminalCostDerivatives(Robot& robot, CostFunctionData& data, 
+                                   const GridInfo& grid_info, 
+                                   const SplitSolution& s, 
+                                   SplitKKTResidual& kkt_residual) const override;
+
+  void evalTerminalCostHessian(Robot& robot, CostFunctionData& data, 
+                               const GridInfo& grid_info, 
+                               const SplitSolution& s, 
+                               SplitKKTMatrix& kkt_matrix) const override;
+
+  double evalImpactCost(Robot& robot, const ImpactStatus& impact_status, 
+                        CostFunctionData& data, const GridInfo& grid_info, 
+                        const SplitSolution& s) const override;
+
+  void evalImpactCostDerivatives(Robot& robot, const ImpactStatus& impact_status, 
+                                 CostFunctionData& data, const GridInfo& grid_info,
+                                 const SplitSolution& s, 
+                                 SplitKKTResidual& kkt_residual) const override;
+
+  void evalImpactCostHessian(Robot& robot, const ImpactStatus& impact_status, 
+                             CostFunctionData& data, const GridInfo& grid_info,
+                             const SplitSolution& s, 
+                             SplitKKTMatrix& kkt_matrix) const override;
+
+private:
+  int dimq_, dimv_;
+  double penalty_;
+  std::vector<double> times_;
+  std::vector<Eigen::VectorXd> q_targets_, v_targets_;
+
+  double evalCost(Robot& robot, CostFunctionData& data, 
+                  const GridInfo& grid_info, const SplitSolution& s) const;
+
+  void evalCostDerivatives(Robot& robot, CostFunctionData& data, 
+                           const GridInfo& grid_info, const SplitSolution& s, 
+                           SplitKKTResidual& kkt_residual) const;
+
+  void evalCostHessian(Robot& robot, CostFunctionData& data, 
+                       const GridInfo& grid_info, const SplitSolution& s, 
+                       SplitKKTMatrix& kkt_matrix) const;
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_CONSENSUS_COST_HPP_
@@ -0,0 +1,114 @@
+#ifndef ROBOTOC_CONSTANT_COST_HESSIAN_HPP_
+#define ROBOTOC_CONSTANT_COST_HESSIAN_HPP_
+
+#include <atomic>
+#include <mutex>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/core/split_kkt_matrix.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class ConstantCostHessian
+/// @brief Sum of the constant Hessians of the cost function components, i.e.,
+/// those with CostFunctionComponentBase::hasConstantHessian() true, of a 
+/// grid type. CostFunction holds one of this per grid type and shares it 
+/// among all the stages to skip the re-evaluation of the constant Hessians. 
+/// update() may be called concurrently by the stages evaluated in parallel.
+///
+class ConstantCostHessian {
+public:
+  ///
+  /// @brief Default constructor. The storage is allocated in the first 
+  /// update().
+  ///
+  ConstantCostHessian();
+
+  ///
+  /// @brief Default destructor. 
+  ///
+  ~ConstantCostHessian() = default;
+
+  ///
+  /// @brief Copy constructor. The mutex is not copied.
+  ///
+  ConstantCostHessian(const ConstantCostHessian& other);
+
+  ///
+  /// @brief Copy operator. The mutex is not copied.
+  ///
+  ConstantCostHessian& operator=(const ConstantCostHessian& other);
+
+  ///
+  /// @brief Move constructor. The mutex is not moved.
+  ///
+  ConstantCostHessian(ConstantCostHessian&& other) noexcept;
+
+  ///
+  /// @brief Move assign operator. The mutex is not moved.
+  ///
+  ConstantCostHessian& operator=(ConstantCostHessian&& other) noexcept;
+
+  ///
+  /// @brief Checks whether the stored Hessians are up to date.
+  /// @param[in] revision Current revision of the constant Hessians.
+  /// @return true if the stored Hessians are valid and false if not.
+  ///
+  bool isValid(const unsigned long long revision) const {
+    return (revision_.load(std::memory_order_acquire) == revision);
+  }
+
+  ///
+  /// @brief Re-evaluates the stored Hessians if they are not up to date. 
+  /// Only one of the calling threads evaluates the Hessians and the others
+  /// wait for it.
+  /// @param[in] robot Robot model.
+  /// @param[in] revision Current revision of the constant Hessians.
+  /// @param[in] eval_hessian Callable with the signature 
+  /// void(SplitKKTMatrix&) that adds the constant Hessians to the zero 
+  /// matrix passed to it.
+  ///
+  template <typename EvalHessian>
+  void update(const Robot& robot, const unsigned long long revision, 
+              const EvalHessian& eval_hessian) {
+    if (isValid(revision)) return;
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (isValid(revision)) return;
+    eval_hessian(workspace(robot));
+    set(revision);
+  }
+
+  ///
+  /// @brief Adds the stored Hessians multiplied by a coefficient to the 
+  /// KKT matrix.
+  /// @param[in] coeff Coefficient, e.g., GridInfo::dt for the stage cost.
+  /// @param[in, out] kkt_matrix Split KKT matrix.
+  ///
+  void addTo(const double coeff, SplitKKTMatrix& kkt_matrix) const;
+
+private:
+  enum class Structure { Zero, Diagonal, Dense };
+
+  SplitKKTMatrix hessian_;
+  Structure Qxx_, Qxu_, Quu_, Qaa_, Qdvdv_;
+  std::atomic<unsigned long long> revision_;
+  std::mutex mtx_;
+
+  SplitKKTMatrix& workspace(const Robot& robot);
+
+  void set(const unsigned long long revision);
+
+  static Structure detectStructure(const Eigen::MatrixXd& mat);
+
+  static void add(const Structure structure, const double coeff, 
+                  const Eigen::MatrixXd& src, Eigen::MatrixXd& dst);
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_CONSTANT_COST_HESSIAN_HPP_ 
@@ -16,6 +16,7 @@
 #include "robotoc/ocp/grid_info.hpp"
 #include "robotoc/cost/cost_function_component_base.hpp"
 #include "robotoc/cost/cost_function_data.hpp"
+#include "robotoc/cost/constant_cost_hessian.hpp"
 
 
 namespace robotoc {
@@ -112,6 +113,17 @@ public:
   ///
   CostFunctionData createCostFunctionData(const Robot& robot) const;
 
+  ///
+  /// @brief Gets the revision of the constant Hessians of the cost function 
+  /// components (see CostFunctionComponentBase::hasConstantHessian()). The 
+  /// revision is renewed when a component is appended or removed, or when the
+  /// constant Hessians of a component are invalidated. The constant Hessians 
+  /// cached in this object, one per grid type, are re-evaluated if the 
+  /// revision is renewed.
+  /// @return Revision of the constant Hessians.
+  ///
+  unsigned long long constantHessianRevision() const;
+
   ///
   /// @brief Computes the stage cost. 
   /// @param[in] robot Robot model.
@@ -264,6 +276,12 @@ private:
 
   double discount_factor_, discount_time_step_;
   bool discounted_cost_;
+  unsigned long long constant_hessian_revision_;
+  // Constant Hessians of the stage, terminal, and impact costs shared by all 
+  // the stages.
+  mutable ConstantCostHessian constant_stage_hessian_, 
+                              constant_terminal_hessian_, 
+                              constant_impact_hessian_;
 };
 
 } // namespace robotoc
@@ -1,6 +1,8 @@
 #ifndef ROBOTOC_COST_FUNCTION_COMPONENT_BASE_HPP_
 #define ROBOTOC_COST_FUNCTION_COMPONENT_BASE_HPP_
 
+#include <atomic>
+
 #include "Eigen/Core"
 
 #include "robotoc/robot/robot.hpp"
@@ -24,7 +26,8 @@ public:
   ///
   /// @brief Default constructor. 
   ///
-  CostFunctionComponentBase() {}
+  CostFunctionComponentBase() 
+    : constant_hessian_revision_(newConstantHessianRevision()) {}
 
   ///
   /// @brief Destructor. 
@@ -53,6 +56,38 @@ public:
   CostFunctionComponentBase& operator=(CostFunctionComponentBase&&) noexcept 
       = default;
 
+  ///
+  /// @brief Checks whether the Hessians of this cost are constant, i.e., 
+  /// independent of the robot state, the solution, the contact status, and 
+  /// the time. The Hessian of the stage cost may be proportional to 
+  /// GridInfo::dt. If true, CostFunction evaluates evalStageCostHessian(), 
+  /// evalTerminalCostHessian(), and evalImpactCostHessian() only once and 
+  /// reuses the results until constantHessianRevision() changes. The Hessians 
+  /// then must be added only to the blocks Qxx, Qxu, Quu, Qaa, and Qdvdv of 
+  /// SplitKKTMatrix. Default is false.
+  /// @return true if the Hessians are constant and false if not.
+  ///
+  virtual bool hasConstantHessian() const { return false; }
+
+  ///
+  /// @brief Gets the revision of the constant Hessians. The revision is 
+  /// renewed by invalidateConstantHessian().
+  /// @return Revision of the constant Hessians.
+  ///
+  unsigned long long constantHessianRevision() const {
+    return constant_hessian_revision_;
+  }
+
+  ///
+  /// @brief Issues a new revision, which is larger than all the revisions 
+  /// issued before.
+  /// @return New revision.
+  ///
+  static unsigned long long newConstantHessianRevision() {
+    static std::atomic<unsigned long long> revision(0);
+    return ++revision;
+  }
+
   ///
   /// @brief Computes the stage cost. 
   /// @param[in] robot Robot model.
@@ -200,6 +235,19 @@ public:
                                       const SplitSolution& s, 
                                       SplitKKTMatrix& kkt_matrix) const = 0; 
 
+protected:
+  ///
+  /// @brief Invalidates the constant Hessians cached by CostFunction. Must be 
+  /// called when a parameter that affects the Hessians or 
+  /// hasConstantHessian() is changed.
+  ///
+  void invalidateConstantHessian() {
+    constant_hessian_revision_ = newConstantHessianRevision();
+  }
+
+private:
+  unsigned long long constant_hessian_revision_;
+
 };
 
 } // namespace robotoc
@@ -5,6 +5,7 @@
 
 #include "robotoc/robot/robot.hpp"
 #include "robotoc/robot/se3.hpp"
+#include "robotoc/cost/quasi_newton_cost_hessian.hpp"
 
 
 namespace robotoc {
@@ -144,6 +145,12 @@ public:
   ///
   Eigen::MatrixXd JJ_6d;
 
+  ///
+  /// @brief Quasi-Newton approximation of the Hessian of the stage cost used 
+  /// with HessianApproximation::BFGS. 
+  ///
+  QuasiNewtonCostHessian quasi_newton_hessian;
+
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW 
 };
 
@@ -0,0 +1,141 @@
+#ifndef ROBOTOC_QUASI_NEWTON_COST_HESSIAN_HPP_
+#define ROBOTOC_QUASI_NEWTON_COST_HESSIAN_HPP_
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/core/split_solution.hpp"
+#include "robotoc/core/split_kkt_residual.hpp"
+#include "robotoc/core/split_kkt_matrix.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class QuasiNewtonCostHessian
+/// @brief Quasi-Newton approximation of the Hessian of the stage cost. 
+/// The Hessian is approximated by the block-diagonal matrix composed of the 
+/// blocks w.r.t. (x, u), a, and f, each of which is updated by the damped 
+/// BFGS formula from the change of the solution and the gradient of the 
+/// stage cost. 
+///
+class QuasiNewtonCostHessian {
+public:
+  ///
+  /// @brief Constructor. 
+  /// @param[in] robot Robot model. 
+  ///
+  QuasiNewtonCostHessian(const Robot& robot);
+
+  ///
+  /// @brief Default constructor. 
+  ///
+  QuasiNewtonCostHessian();
+
+  ///
+  /// @brief Default destructor. 
+  ///
+  ~QuasiNewtonCostHessian() = default;
+
+  ///
+  /// @brief Default copy constructor. 
+  ///
+  QuasiNewtonCostHessian(const QuasiNewtonCostHessian&) = default;
+
+  ///
+  /// @brief Default copy operator. 
+  ///
+  QuasiNewtonCostHessian& operator=(const QuasiNewtonCostHessian&) = default;
+
+  ///
+  /// @brief Default move constructor. 
+  ///
+  QuasiNewtonCostHessian(QuasiNewtonCostHessian&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator. 
+  ///
+  QuasiNewtonCostHessian& operator=(QuasiNewtonCostHessian&&) noexcept = default;
+
+  ///
+  /// @brief Checks whether the approximation is initialized for the 
+  /// dimension of the contact forces.
+  /// @param[in] dimf Dimension of the contact forces.
+  /// @return true if the approximation can be updated and false if not.
+  ///
+  bool isInitialized(const int dimf) const {
+    return (initialized_ && dimf_ == dimf);
+  }
+
+  ///
+  /// @brief Discards the approximation.
+  ///
+  void reset();
+
+  ///
+  /// @brief Initializes the approximation by the exact Hessian of the stage 
+  /// cost. The memory is allocated at the first call.
+  /// @param[in] dt Time step of the stage.
+  /// @param[in] s Split solution.
+  /// @param[in] kkt_residual Split KKT residual containing only the gradient 
+  /// of the stage cost.
+  /// @param[in] kkt_matrix Split KKT matrix containing only the Hessian of 
+  /// the stage cost.
+  ///
+  void init(const double dt, const SplitSolution& s, 
+            const SplitKKTResidual& kkt_residual, 
+            const SplitKKTMatrix& kkt_matrix);
+
+  ///
+  /// @brief Updates the approximation. If the time step is changed from the 
+  /// previous update, the approximation is scaled by the ratio of the time 
+  /// steps beforehand.
+  /// @param[in] robot Robot model. 
+  /// @param[in] dt Time step of the stage.
+  /// @param[in] s Split solution.
+  /// @param[in] kkt_residual Split KKT residual containing only the gradient 
+  /// of the stage cost.
+  ///
+  void update(const Robot& robot, const double dt, const SplitSolution& s, 
+              const SplitKKTResidual& kkt_residual);
+
+  ///
+  /// @brief Adds the approximated Hessian to the KKT matrix.
+  /// @param[in, out] kkt_matrix Split KKT matrix.
+  ///
+  void addTo(SplitKKTMatrix& kkt_matrix) const;
+
+  ///
+  /// @brief Performs the damped BFGS update B <- B - (B s s^T B) / (s^T B s) 
+  /// + (r r^T) / (s^T r), where r = theta * y + (1 - theta) * B s and theta 
+  /// is chosen such that s^T r >= 0.2 * s^T B s. 
+  /// @param[in] s Change of the variables.
+  /// @param[in] y Change of the gradient.
+  /// @param[in, out] B Approximated Hessian.
+  /// @param[out] Bs Workspace. Size must be the same as s.
+  ///
+  static void dampedBFGSUpdate(const Eigen::Ref<const Eigen::VectorXd>& s, 
+                               const Eigen::Ref<const Eigen::VectorXd>& y,
+                               Eigen::Ref<Eigen::MatrixXd> B, 
+                               Eigen::Ref<Eigen::VectorXd> Bs);
+
+private:
+  Eigen::MatrixXd Bxu_, Baa_, Bff_;
+  // The previous (v, u), a, and f are overwritten in place by the changes 
+  // s, and the previous gradients by the changes y, in update().
+  Eigen::VectorXd q_prev_, a_prev_, f_prev_, lxu_prev_, la_prev_, lf_prev_, 
+                  sxu_, Bs_;
+  double dt_prev_;
+  int dimv_, dimu_, max_dimf_, dimf_;
+  bool initialized_;
+
+  void allocate();
+
+  void store(const double dt, const SplitSolution& s, 
+             const SplitKKTResidual& kkt_residual);
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_QUASI_NEWTON_COST_HESSIAN_HPP_ 
@@ -13,6 +13,7 @@
 #include "robotoc/cost/cost_function.hpp"
 #include "robotoc/constraints/constraints.hpp"
 #include "robotoc/solver/solver_options.hpp"
+#include "robotoc/solver/warm_start_library.hpp"
 #include "robotoc/mpc/contact_planner_base.hpp"
 #include "robotoc/cost/configuration_space_cost.hpp"
 #include "robotoc/cost/task_space_3d_cost.hpp"
@@ -111,11 +112,18 @@ public:
   /// @param[in] q Initial configuration. Size must be Robot::dimq().
   /// @param[in] v Initial velocity. Size must be Robot::dimv().
   /// @param[in] solver_options Solver options for the initialization. 
+  /// @param[in] warm_start_library Library of the converged solutions. If 
+  /// given, the solver is warm-started by the nearest entry of the gait "dance"
+  /// and the converged solution is added to the library. Default is nullptr.
+  /// @param[in] command Command of the gait used as WarmStartKey::command, 
+  /// e.g., the velocity command. Default is an empty vector.
   /// @remark The linear and angular velocities of the floating base are assumed
   /// to be expressed in the body local coordinate.
   ///
   void init(const double t, const Eigen::VectorXd& q, const Eigen::VectorXd& v, 
-            const SolverOptions& solver_options);
+            const SolverOptions& solver_options,
+            const std::shared_ptr<WarmStartLibrary>& warm_start_library=nullptr,
+            const Eigen::VectorXd& command=Eigen::VectorXd());
 
   ///
   /// @brief Resets the optimal control problem solover via the solution 
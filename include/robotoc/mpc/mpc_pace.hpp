@@ -43,8 +43,11 @@ public:
   /// @param[in] quadruped_robot Quadruped robot model. 
   /// @param[in] T Length of the horizon. 
   /// @param[in] N Number of the discretization grids of the horizon. 
+  /// @param[in] grading_ratio Ratio between the consecutive time steps of the 
+  /// discretization grids. Default is 1, i.e., the uniform grids.
   ///
-  MPCPace(const Robot& quadruped_robot, const double T, const int N);
+  MPCPace(const Robot& quadruped_robot, const double T, const int N, 
+           const double grading_ratio=1.0);
 
   ///
   /// @brief Default constructor. 
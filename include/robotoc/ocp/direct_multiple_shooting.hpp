@@ -8,6 +8,9 @@
 
 #include "robotoc/robot/robot.hpp"
 #include "robotoc/utils/aligned_vector.hpp"
+#include "robotoc/utils/thread_pool.hpp"
+#include "robotoc/utils/parallel_reduction.hpp"
+#include "robotoc/utils/binary_archive.hpp"
 #include "robotoc/ocp/ocp.hpp"
 #include "robotoc/core/solution.hpp"
 #include "robotoc/core/direction.hpp"
@@ -73,8 +76,19 @@ public:
   /// @brief Sets the number of threads of the parallel computations.
   /// @param[in] nthreads Number of the threads of the parallel computations.
   /// Must be positive. 
+  /// @param[in] enable_thread_pinning If true, the worker threads are pinned 
+  /// to the CPU cores. Default is false.
   ///
-  void setNumThreads(const int nthreads);
+  void setNumThreads(const int nthreads, 
+                     const bool enable_thread_pinning=false);
+
+  ///
+  /// @brief Sets the approximation of the Hessian of the stage cost of the 
+  /// intermediate stages. The impact and terminal stages always use the 
+  /// Hessians of the cost function components.
+  /// @param[in] hessian_approximation Hessian approximation.
+  ///
+  void setHessianApproximation(const HessianApproximation hessian_approximation);
 
   ///
   /// @brief Initializes the priaml-dual interior point method for inequality 
@@ -127,6 +141,25 @@ public:
                const Solution& s, KKTMatrix& kkt_matrix, 
                KKTResidual& kkt_residual);
 
+  ///
+  /// @brief Computes only the first-order KKT residual to evaluate the KKT 
+  /// error, i.e., skips the Hessians and the condensing of evalKKT(). The 
+  /// resultant KKT matrix and residual cannot be used to compute the Newton 
+  /// direction.
+  /// @param[in, out] robots aligned_vector of Robot for paralle computing.
+  /// @param[in] time_discretization Time discretization. 
+  /// @param[in] q Initial configuration.
+  /// @param[in] v Initial generalized velocity.
+  /// @param[in] s Solution. 
+  /// @param[in, out] kkt_matrix KKT matrix. Only used as the workspace.
+  /// @param[in, out] kkt_residual KKT residual. 
+  ///
+  void evalKKTResidual(aligned_vector<Robot>& robots, 
+                       const TimeDiscretization& time_discretization, 
+                       const Eigen::VectorXd& q, const Eigen::VectorXd& v, 
+                       const Solution& s, KKTMatrix& kkt_matrix, 
+                       KKTResidual& kkt_residual);
+
   ///
   /// @brief Computes the initial state direction. 
   /// @param[in] robot Robot model.
@@ -146,6 +179,13 @@ public:
   ///
   const PerformanceIndex& getEval() const;
 
+  ///
+  /// @brief Sets the performance index, e.g., that evaluated at an iterate 
+  /// restored by DirectMultipleShooting::setConstraintsData(). 
+  /// @param[in] performance_index Performance index.
+  ///
+  void setEval(const PerformanceIndex& performance_index);
+
   ///
   /// @brief Computes the step sizes via the fraction-to-boundary-rule.
   /// @param[in] time_discretization Time discretization. 
@@ -166,6 +206,17 @@ public:
   ///
   double maxDualStepSize() const;
 
+  ///
+  /// @brief Gets the ratio of the constraint components skipped by the 
+  /// active-set screening in the last evaluation of the KKT system over the 
+  /// horizon. See Constraints::setActiveSetScreening().
+  /// @param[in] time_discretization Time discretization. 
+  /// @return Ratio of the screened constraint components. 0 if there are no 
+  /// constraint components.
+  ///
+  double screenedConstraintsRatio(
+      const TimeDiscretization& time_discretization) const;
+
   ///
   /// @brief Computes the initial state direction. 
   /// @param[in, out] robots aligned_vector of Robot for paralle computing.
@@ -189,14 +240,61 @@ public:
   ///
   void resizeData(const TimeDiscretization& time_discretization);
 
+  ///
+  /// @brief Saves the slack and dual variables of the inequality constraints
+  /// over the horizon into a binary archive.
+  /// @param[in, out] ar Output archive.
+  /// @param[in] time_discretization Time discretization. 
+  ///
+  void saveConstraintsData(BinaryOutputArchive& ar, 
+                           const TimeDiscretization& time_discretization) const;
+
+  ///
+  /// @brief Loads the slack and dual variables of the inequality constraints
+  /// saved by DirectMultipleShooting::saveConstraintsData(). 
+  /// DirectMultipleShooting::initConstraints() must be called with the same 
+  /// time discretization beforehand.
+  /// @param[in, out] ar Input archive.
+  /// @param[in] time_discretization Time discretization. 
+  ///
+  void loadConstraintsData(BinaryInputArchive& ar, 
+                           const TimeDiscretization& time_discretization);
+
+  ///
+  /// @brief Copies the data of the inequality constraints, e.g., the slack 
+  /// and dual variables, over the horizon. 
+  /// @param[in] time_discretization Time discretization. 
+  /// @param[out] constraints_data Data of the inequality constraints. Resized
+  /// to time_discretization.size().
+  ///
+  void getConstraintsData(const TimeDiscretization& time_discretization, 
+                          std::vector<ConstraintsData>& constraints_data) const;
+
+  ///
+  /// @brief Sets the data of the inequality constraints copied by 
+  /// DirectMultipleShooting::getConstraintsData() with the same time 
+  /// discretization.
+  /// @param[in] time_discretization Time discretization. 
+  /// @param[in] constraints_data Data of the inequality constraints. 
+  ///
+  void setConstraintsData(const TimeDiscretization& time_discretization, 
+                          const std::vector<ConstraintsData>& constraints_data);
+
 private:
-  int nthreads_;
   aligned_vector<OCPData> ocp_data_;
   IntermediateStage intermediate_stage_;
   ImpactStage impact_stage_;
   TerminalStage terminal_stage_;
   PerformanceIndex performance_index_; 
-  Eigen::VectorXd max_primal_step_sizes_, max_dual_step_sizes_;
+  double max_primal_step_size_, max_dual_step_size_;
+  Eigen::VectorXd lu_block_;
+  ParallelReduction<bool> is_feasible_;
+  ParallelReduction<PerformanceIndex> performance_index_sum_;
+  ParallelReduction<double> min_primal_step_size_, min_dual_step_size_;
+  ThreadPool thread_pool_;
+
+  void evalMoveBlockingKKTError(const TimeDiscretization& time_discretization);
+
 };
 
 } // namespace robotoc 
@@ -3,6 +3,8 @@
 
 #include <iostream>
 
+#include "robotoc/utils/binary_archive.hpp"
+
 
 namespace robotoc {
 
@@ -92,6 +94,12 @@ struct GridInfo {
   ///
   bool switching_constraint = false;
 
+  ///
+  /// @brief Flag if the control input of this stage is blocked with that of 
+  /// the previous stage, i.e., the two stages share the same control input. 
+  ///
+  bool move_blocked = false;
+
   ///
   /// @brief Sets random. 
   ///
@@ -102,6 +110,18 @@ struct GridInfo {
   ///
   static GridInfo Random();
 
+  ///
+  /// @brief Saves the grid info into a binary archive.
+  /// @param[in, out] ar Output archive.
+  ///
+  void save(BinaryOutputArchive& ar) const;
+
+  ///
+  /// @brief Loads the grid info saved by GridInfo::save().
+  /// @param[in, out] ar Input archive.
+  ///
+  void load(BinaryInputArchive& ar);
+
   ///
   /// @brief Displays the grid info onto a ostream.
   ///
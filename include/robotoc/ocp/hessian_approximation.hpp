@@ -0,0 +1,21 @@
+#ifndef ROBOTOC_HESSIAN_APPROXIMATION_HPP_ 
+#define ROBOTOC_HESSIAN_APPROXIMATION_HPP_
+
+namespace robotoc {
+
+/// 
+/// @enum HessianApproximation
+/// @brief Approximation of the Hessian of the stage cost.
+/// @note GaussNewton evaluates the Hessians of the cost function components 
+/// at every iteration. The second-order derivatives of the kinematics and 
+/// dynamics are neglected. BFGS evaluates them only at the first iteration 
+/// and then updates them by the damped BFGS formula.
+///
+enum class HessianApproximation {
+  GaussNewton,
+  BFGS
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_HESSIAN_APPROXIMATION_HPP_ 
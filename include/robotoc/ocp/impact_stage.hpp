@@ -121,6 +121,26 @@ public:
                const SplitSolution& s_next, OCPData& data,
                SplitKKTMatrix& kkt_matrix, SplitKKTResidual& kkt_residual) const;
 
+  ///
+  /// @brief Computes only the first-order KKT residual of this stage to 
+  /// evaluate the KKT error. The Hessians are not computed and the KKT system 
+  /// is not condensed.
+  /// @param[in, out] robot Robot model. 
+  /// @param[in] grid_info Grid info of this stage.
+  /// @param[in] q_prev Configuration at the previous stage.
+  /// @param[in] s Split solution of this stage.
+  /// @param[in] s_next Split solution of the next stage.
+  /// @param[in, out] data Data of this stage. 
+  /// @param[in, out] kkt_matrix KKT matrix of this stage. Only used as the 
+  /// workspace of the Jacobians of the dynamics.
+  /// @param[in, out] kkt_residual KKT residual of this stage. 
+  ///
+  void evalKKTResidual(Robot& robot, const GridInfo& grid_info, 
+                       const Eigen::VectorXd& q_prev, const SplitSolution& s, 
+                       const SplitSolution& s_next, OCPData& data,
+                       SplitKKTMatrix& kkt_matrix, 
+                       SplitKKTResidual& kkt_residual) const;
+
   ///
   /// @brief Expands the condensed primal variables, i.e., computes the Newton 
   /// direction of the condensed primal variables of this stage.
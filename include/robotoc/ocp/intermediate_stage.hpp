@@ -16,6 +16,7 @@
 #include "robotoc/planner/contact_sequence.hpp"
 #include "robotoc/ocp/grid_info.hpp"
 #include "robotoc/ocp/ocp_data.hpp"
+#include "robotoc/ocp/hessian_approximation.hpp"
 
 
 namespace robotoc {
@@ -66,6 +67,13 @@ public:
   ///
   IntermediateStage& operator=(IntermediateStage&&) noexcept = default;
 
+  ///
+  /// @brief Sets the approximation of the Hessian of the stage cost.
+  /// @param[in] hessian_approximation Hessian approximation. Default is 
+  /// HessianApproximation::GaussNewton.
+  ///
+  void setHessianApproximation(const HessianApproximation hessian_approximation);
+
   ///
   /// @brief Creates the data.
   /// @param[in] robot Robot model. 
@@ -121,6 +129,27 @@ public:
                const SplitSolution& s_next, OCPData& data,
                SplitKKTMatrix& kkt_matrix, SplitKKTResidual& kkt_residual) const;
 
+  ///
+  /// @brief Computes only the first-order KKT residual of this stage to 
+  /// evaluate the KKT error. The Hessians are not computed and the KKT system 
+  /// is not condensed. The sensitivities w.r.t. the switching times are not
+  /// computed.
+  /// @param[in, out] robot Robot model. 
+  /// @param[in] grid_info Grid info of this stage.
+  /// @param[in] q_prev Configuration at the previous stage.
+  /// @param[in] s Split solution of this stage.
+  /// @param[in] s_next Split solution of the next stage.
+  /// @param[in, out] data Data of this stage. 
+  /// @param[in, out] kkt_matrix KKT matrix of this stage. Only used as the 
+  /// workspace of the Jacobians of the dynamics.
+  /// @param[in, out] kkt_residual KKT residual of this stage. 
+  ///
+  void evalKKTResidual(Robot& robot, const GridInfo& grid_info, 
+                       const Eigen::VectorXd& q_prev, const SplitSolution& s, 
+                       const SplitSolution& s_next, OCPData& data,
+                       SplitKKTMatrix& kkt_matrix, 
+                       SplitKKTResidual& kkt_residual) const;
+
   ///
   /// @brief Expands the condensed primal variables, i.e., computes the Newton 
   /// direction of the condensed primal variables of this stage.
@@ -181,6 +210,7 @@ private:
   std::shared_ptr<CostFunction> cost_;
   std::shared_ptr<Constraints> constraints_;
   std::shared_ptr<ContactSequence> contact_sequence_;
+  HessianApproximation hessian_approximation_;
 };
 
 ///
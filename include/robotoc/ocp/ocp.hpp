@@ -33,13 +33,17 @@ struct OCP {
   /// Must be positive.
   /// @param[in] reserved_num_discrete_events Reserved size of the 
   /// discrete-event data. Must be non-negative. Default is 0.
+  /// @param[in] grading_ratio Ratio between the consecutive time steps of the
+  /// discretization grids. 1 gives the uniform grids and a value larger than 
+  /// 1 gives the geometrically graded grids. Must be positive. Default is 1.
   ///
   OCP(const Robot& robot, const std::shared_ptr<CostFunction>& cost, 
       const std::shared_ptr<Constraints>& constraints, 
       const std::shared_ptr<STOCostFunction>& sto_cost, 
       const std::shared_ptr<STOConstraints>& sto_constraints, 
       const std::shared_ptr<ContactSequence>& contact_sequence, 
-      const double T, const int N, const int reserved_num_discrete_events=0);
+      const double T, const int N, const int reserved_num_discrete_events=0,
+      const double grading_ratio=1.0);
 
   ///
   /// @brief Construct the optiaml control problem. 
@@ -52,11 +56,15 @@ struct OCP {
   /// Must be positive.
   /// @param[in] reserved_num_discrete_events Reserved size of the 
   /// discrete-event data. Must be non-negative. Default is 0.
+  /// @param[in] grading_ratio Ratio between the consecutive time steps of the
+  /// discretization grids. 1 gives the uniform grids and a value larger than 
+  /// 1 gives the geometrically graded grids. Must be positive. Default is 1.
   ///
   OCP(const Robot& robot, const std::shared_ptr<CostFunction>& cost, 
       const std::shared_ptr<Constraints>& constraints,  
       const std::shared_ptr<ContactSequence>& contact_sequence,
-      const double T, const int N, const int reserved_num_discrete_events=0);
+      const double T, const int N, const int reserved_num_discrete_events=0,
+      const double grading_ratio=1.0);
 
   ///
   /// @brief Construct the optiaml control problem. 
@@ -146,6 +154,12 @@ struct OCP {
   ///
   int reserved_num_discrete_events = 0;
 
+  ///
+  /// @brief Ratio between the consecutive time steps of the discretization 
+  /// grids. Default is 1, i.e., the uniform grids.
+  ///
+  double grading_ratio = 1.0;
+
   void disp(std::ostream& os) const;
 
   friend std::ostream& operator<<(std::ostream& os, const OCP& ocp);
@@ -46,6 +46,13 @@ struct OCPData {
   ///
   SwitchingConstraintData switching_constraint_data;
 
+  ///
+  /// @brief Residual of the stationarity condition w.r.t. the control input 
+  /// before the condensing. Used to evaluate the KKT error of the 
+  /// move-blocked stages.
+  ///
+  Eigen::VectorXd lu;
+
   ///
   /// @brief Returns the lp norm of the primal feasibility, i.e., the constraint 
   /// violation. Default norm is l1-norm. You can also specify l-infty norm by 
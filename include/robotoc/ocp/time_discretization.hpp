@@ -9,6 +9,7 @@
 
 #include "robotoc/planner/contact_sequence.hpp"
 #include "robotoc/ocp/grid_info.hpp"
+#include "robotoc/utils/binary_archive.hpp"
 
 
 namespace robotoc {
@@ -27,9 +28,15 @@ public:
   /// @param[in] reserved_num_discrete_events Reserved size of each discrete 
   /// events (impact and lift) to avoid dynamic memory allocation. Must be 
   /// non-negative. Default is 0.
+  /// @param[in] grading_ratio Ratio between the consecutive time steps of the
+  /// discretization grids. If 1, the horizon is discretized uniformly. If 
+  /// larger than 1, the time steps are geometrically graded from fine steps 
+  /// near the initial time to coarse steps toward the end of the horizon. 
+  /// Must be positive. Default is 1.
   ///
   TimeDiscretization(const double T, const int N, 
-                     const int reserved_num_discrete_events=0);
+                     const int reserved_num_discrete_events=0,
+                     const double grading_ratio=1.0);
 
   ///
   /// @brief Default constructor. 
@@ -68,6 +75,23 @@ public:
     return N_;
   }
 
+  ///
+  /// @brief Returns the ratio between the consecutive time steps of the 
+  /// discretization grids.
+  /// @return The grading ratio.
+  ///
+  double gradingRatio() const {
+    return grading_ratio_;
+  }
+
+  ///
+  /// @brief Returns the nominal time step of the discretization grid, i.e., 
+  /// the time step without the discrete events.
+  /// @param[in] k Index of the nominal grid. Must be in [0, N).
+  /// @return The nominal time step of the k-th grid.
+  ///
+  double nominalTimeStep(const int k) const;
+
   ///
   /// @brief Returns the number of grids. 
   /// @return The number of grids..
@@ -126,6 +150,39 @@ public:
     return max_dt;
   }
 
+  ///
+  /// @brief Gets the maximum time step over the phases whose switching times
+  /// are optimized.
+  /// @return The maximum time step over the STO phases. Returns 0 if there is 
+  /// no STO phase.
+  ///
+  double maxTimeStepInSTOPhases() const {
+    double max_dt = 0.0;
+    for (int i=0; i<num_grids_; ++i) {
+      if (grid_[i].sto) {
+        max_dt = std::max(grid_[i].dt, max_dt);
+      }
+    }
+    return max_dt;
+  }
+
+  ///
+  /// @brief Sets the number of the consecutive intermediate stages sharing 
+  /// the same control input (move blocking). The flags GridInfo::move_blocked
+  /// are updated at the next call of discretize() or correctTimeSteps().
+  /// @param[in] move_blocking_size Number of the stages in each block. 
+  /// Must be positive. 1 disables the move blocking.
+  ///
+  void setMoveBlockingSize(const int move_blocking_size);
+
+  ///
+  /// @return Number of the consecutive intermediate stages sharing the same 
+  /// control input.
+  ///
+  int moveBlockingSize() const {
+    return move_blocking_size_;
+  }
+
   ///
   /// @brief Reserve the discrete-event data. 
   /// @param[in] reserved_num_discrete_events Reserved size of discrete events  
@@ -147,13 +204,39 @@ public:
   void discretize(const std::shared_ptr<ContactSequence>& contact_sequence, const double t);
 
   ///
-  /// @brief Discretizes the finite horizon taking into account the discrete 
-  /// events.
+  /// @brief Corrects the time steps so that the grids in each phase are 
+  /// distributed between the discrete events. The grids in the phases whose 
+  /// switching times are optimized are distributed uniformly. Those in the 
+  /// other phases follow the same geometric grading of the whole horizon as 
+  /// discretize(), i.e., they are distributed uniformly in the (fractional) 
+  /// index of the graded grids. If the discrete events lie on the graded 
+  /// grids, the grids of discretize() are therefore recovered.
   /// @param[in] contact_sequence Shared ptr to the contact sequence.
   /// @param[in] t Initial time of the horizon.
   ///
   void correctTimeSteps(const std::shared_ptr<ContactSequence>& contact_sequence, const double t);
 
+  ///
+  /// @brief Shifts the time of all the grids, e.g., to map the grids onto 
+  /// another horizon. The time steps are unchanged.
+  /// @param[in] time_offset Offset added to the time of all the grids.
+  ///
+  void shiftTime(const double time_offset);
+
+  ///
+  /// @brief Saves the time discretization into a binary archive.
+  /// @param[in, out] ar Output archive.
+  ///
+  void save(BinaryOutputArchive& ar) const;
+
+  ///
+  /// @brief Loads the time discretization saved by 
+  /// TimeDiscretization::save(). All the settings and the grids are 
+  /// overwritten.
+  /// @param[in, out] ar Input archive.
+  ///
+  void load(BinaryInputArchive& ar);
+
   ///
   /// @brief Displays the time discretization onto a ostream.
   ///
@@ -163,10 +246,12 @@ public:
                                   const TimeDiscretization& discretization);
 
 private:
-  double T_, max_dt_, eps_;
-  int N_, num_grids_, reserved_num_discrete_events_;
+  double T_, max_dt_, eps_, grading_ratio_;
+  int N_, num_grids_, reserved_num_discrete_events_, move_blocking_size_;
   std::vector<GridInfo> grid_;
   std::vector<bool> sto_event_, sto_phase_;
+
+  void setMoveBlockedFlags();
 };
 
 } // namespace robotoc
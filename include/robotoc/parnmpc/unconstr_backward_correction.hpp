@@ -7,6 +7,8 @@
 
 #include "robotoc/robot/robot.hpp"
 #include "robotoc/utils/aligned_vector.hpp"
+#include "robotoc/utils/thread_pool.hpp"
+#include "robotoc/utils/parallel_reduction.hpp"
 #include "robotoc/core/split_kkt_matrix.hpp"
 #include "robotoc/core/split_kkt_residual.hpp"
 #include "robotoc/core/split_solution.hpp"
@@ -74,8 +76,11 @@ public:
   /// @brief Sets the number of threads of the parallel computations.
   /// @param[in] nthreads Number of the threads of the parallel computations.
   /// Must be positive. 
+  /// @param[in] enable_thread_pinning If true, the worker threads are pinned 
+  /// to the CPU cores. Default is false.
   ///
-  void setNumThreads(const int nthreads);
+  void setNumThreads(const int nthreads, 
+                     const bool enable_thread_pinning=false);
 
   ///
   /// @brief Initializes the auxiliary matrices by the terminal cost Hessian 
@@ -196,7 +201,7 @@ public:
                          const double dual_step_size, Direction& d, Solution& s);
 
 private:
-  int nthreads_;
+  ThreadPool thread_pool_;
   OCP ocp_;
   ParNMPCIntermediateStage intermediate_stage_;
   ParNMPCTerminalStage terminal_stage_;
@@ -205,7 +210,9 @@ private:
   aligned_vector<UnconstrSplitBackwardCorrection> corrector_;
   Solution s_new_;
   std::vector<Eigen::MatrixXd> aux_mat_;
-  Eigen::VectorXd primal_step_sizes_, dual_step_sizes_;
+  double primal_step_size_, dual_step_size_;
+  ParallelReduction<PerformanceIndex> performance_index_sum_;
+  ParallelReduction<double> min_primal_step_size_, min_dual_step_size_;
 
 };
 
@@ -1,7 +1,7 @@
 #ifndef ROBOTOC_CONTACT_SEQUENCE_HPP_
 #define ROBOTOC_CONTACT_SEQUENCE_HPP_ 
 
-#include <deque>
+#include <vector>
 #include <iostream>
 #include <memory>
 #include <cassert>
@@ -9,9 +9,11 @@
 #include "robotoc/robot/robot.hpp"
 #include "robotoc/robot/se3.hpp"
 #include "robotoc/utils/aligned_vector.hpp"
+#include "robotoc/utils/ring_buffer.hpp"
 #include "robotoc/robot/contact_status.hpp"
 #include "robotoc/robot/impact_status.hpp"
 #include "robotoc/planner/discrete_event.hpp"
+#include "robotoc/utils/binary_archive.hpp"
 
 
 namespace robotoc {
@@ -19,6 +21,9 @@ namespace robotoc {
 ///
 /// @class ContactSequence
 /// @brief The sequence of contact status and discrete events (impact and lift). 
+/// The sequence is stored in RingBuffer with the capacity of the reserved 
+/// number of the discrete events so that push_back() and pop_front() do not 
+/// allocate memory in MPC.
 ///
 class ContactSequence {
 public:
@@ -282,7 +287,7 @@ public:
   /// @brief Returns the event times of each event. 
   /// @return const reference to the event times.
   ///
-  const std::deque<double>& eventTimes() const {
+  const RingBuffer<double>& eventTimes() const {
     return event_time_;
   }
 
@@ -298,6 +303,20 @@ public:
   ///
   int reservedNumDiscreteEvents() const;
 
+  ///
+  /// @brief Saves the contact sequence into a binary archive.
+  /// @param[in, out] ar Output archive.
+  ///
+  void save(BinaryOutputArchive& ar) const;
+
+  ///
+  /// @brief Loads the contact sequence saved by ContactSequence::save(). The 
+  /// current contact sequence is discarded and the loaded one is rebuilt by 
+  /// ContactSequence::init() and ContactSequence::push_back().
+  /// @param[in, out] ar Input archive.
+  ///
+  void load(BinaryInputArchive& ar);
+
   ///
   /// @brief Displays the contact sequence onto a ostream.
   ///
@@ -313,11 +332,11 @@ public:
 private:
   int reserved_num_discrete_events_;
   ContactStatus default_contact_status_;
-  std::deque<ContactStatus> contact_statuses_;
-  std::deque<DiscreteEvent> impact_events_;
-  std::deque<int> event_index_impact_, event_index_lift_;
-  std::deque<double> event_time_, impact_time_, lift_time_;
-  std::deque<bool> is_impact_event_, sto_impact_, sto_lift_;
+  RingBuffer<ContactStatus> contact_statuses_;
+  RingBuffer<DiscreteEvent> impact_events_;
+  RingBuffer<int> event_index_impact_, event_index_lift_;
+  RingBuffer<double> event_time_, impact_time_, lift_time_;
+  RingBuffer<bool> is_impact_event_, sto_impact_, sto_lift_;
 
   void clear();
 };
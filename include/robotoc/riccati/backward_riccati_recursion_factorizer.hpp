@@ -72,6 +72,25 @@ public:
                           SplitKKTMatrix& kkt_matrix,  
                           SplitKKTResidual& kkt_residual);
 
+  ///
+  /// @brief Folds the reduced Hessian and gradient w.r.t. the control input 
+  /// of the next time stage into those of this time stage, where the two 
+  /// stages share the same control input by the move blocking. 
+  /// @param[in] kkt_matrix_next Split KKT matrix of the next time stage. 
+  /// kkt_matrix_next.Qxu and kkt_matrix_next.Quu must be the reduced Hessians 
+  /// w.r.t. the shared control input.
+  /// @param[in] kkt_residual_next Split KKT residual of the next time stage.
+  /// kkt_residual_next.lu must be the reduced gradient w.r.t. the shared 
+  /// control input.
+  /// @param[in, out] kkt_matrix Split KKT matrix of this time stage.
+  /// @param[in, out] kkt_residual Split KKT residual of this time stage.
+  /// @note Please call factorizeKKTMatrix() before this function.
+  ///
+  void factorizeMoveBlocking(const SplitKKTMatrix& kkt_matrix_next, 
+                             const SplitKKTResidual& kkt_residual_next,
+                             SplitKKTMatrix& kkt_matrix,  
+                             SplitKKTResidual& kkt_residual);
+
   ///
   /// @brief Factorizes the derivatives of the Hamiltonian of a time stage for 
   /// the backward Riccati recursion.
@@ -157,7 +176,7 @@ public:
 private:
   int dimv_, dimu_;
   MatrixXdRowMajor AtP_, BtP_;
-  Eigen::MatrixXd GK_;
+  Eigen::MatrixXd GK_, BtH_;
   Eigen::VectorXd Pf_;
 
 };
@@ -4,6 +4,7 @@
 #include "Eigen/Core"
 
 #include "robotoc/robot/robot.hpp"
+#include "robotoc/utils/binary_archive.hpp"
 
 
 namespace robotoc {
@@ -121,6 +122,32 @@ public:
     return true;
   }
 
+  ///
+  /// @brief Saves the LQR policy into a binary archive.
+  /// @param[in, out] ar Output archive.
+  ///
+  void save(BinaryOutputArchive& ar) const {
+    ar.write(dimv_);
+    ar.write(dimu_);
+    ar.write(K);
+    ar.write(k);
+    ar.write(T);
+    ar.write(W);
+  }
+
+  ///
+  /// @brief Loads the LQR policy saved by LQRPolicy::save().
+  /// @param[in, out] ar Input archive.
+  ///
+  void load(BinaryInputArchive& ar) {
+    ar.read(dimv_);
+    ar.read(dimu_);
+    ar.read(K);
+    ar.read(k);
+    ar.read(T);
+    ar.read(W);
+  }
+
 private:
   int dimv_, dimu_;
 
@@ -145,6 +145,45 @@ public:
                                 SplitRiccatiFactorization& riccati,
                                 const bool sto);
 
+  ///
+  /// @brief Performs the backward Riccati recursion of a stage whose control 
+  /// input is shared with the next stage by the move blocking. 
+  /// @param[in] riccati_next Riccati factorization of the next stage. 
+  /// @param[in] kkt_matrix_next Split KKT matrix of the next stage. 
+  /// @param[in] kkt_residual_next Split KKT residual of the next stage. 
+  /// @param[in, out] kkt_matrix Split KKT matrix of this stage. 
+  /// @param[in, out] kkt_residual Split KKT residual of this stage. 
+  /// @param[in, out] riccati Riccati factorization of this stage. 
+  /// @param[in, out] lqr_policy LQR policy of this stage. 
+  /// @param[in] move_blocked If true, the control input of this stage is also
+  /// shared with the previous stage. Then the control input is not eliminated 
+  /// at this stage and lqr_policy is not computed; instead, kkt_matrix.Qxu, 
+  /// kkt_matrix.Quu, and kkt_residual.lu are overwritten by the reduced 
+  /// Hessians and gradient w.r.t. the shared control input.
+  ///
+  void backwardRiccatiRecursionMoveBlocking(
+      const SplitRiccatiFactorization& riccati_next, 
+      const SplitKKTMatrix& kkt_matrix_next, 
+      const SplitKKTResidual& kkt_residual_next, SplitKKTMatrix& kkt_matrix, 
+      SplitKKTResidual& kkt_residual, SplitRiccatiFactorization& riccati, 
+      LQRPolicy& lqr_policy, const bool move_blocked);
+
+  ///
+  /// @brief Performs the backward Riccati recursion of the last stage of a 
+  /// block, whose control input is shared with the previous stage by the move
+  /// blocking. The control input is not eliminated at this stage; instead, 
+  /// kkt_matrix.Qxu, kkt_matrix.Quu, and kkt_residual.lu are overwritten by 
+  /// the reduced Hessians and gradient w.r.t. the shared control input.
+  /// @param[in] riccati_next Riccati factorization of the next stage. 
+  /// @param[in, out] kkt_matrix Split KKT matrix of this stage. 
+  /// @param[in, out] kkt_residual Split KKT residual of this stage. 
+  /// @param[in, out] riccati Riccati factorization of this stage. 
+  ///
+  void backwardRiccatiRecursionMoveBlocking(
+      const SplitRiccatiFactorization& riccati_next, 
+      SplitKKTMatrix& kkt_matrix, SplitKKTResidual& kkt_residual, 
+      SplitRiccatiFactorization& riccati);
+
 private:
   bool has_floating_base_;
   int dimv_, dimu_;
@@ -220,6 +259,35 @@ void computeCostateDirection(const SplitRiccatiFactorization& riccati,
 void computeCostateDirection(const SplitRiccatiFactorization& riccati, 
                              SplitDirection& d, const bool sto);
 
+///
+/// @brief Computes the Newton direction of the state of the next stage for a
+/// stage whose control input is shared with the previous stage by the move 
+/// blocking. 
+/// @param[in] kkt_matrix Split KKT matrix of this stage. 
+/// @param[in] kkt_residual Split KKT residual of this stage. 
+/// @param[in] d_prev Split direction of the previous stage. 
+/// @param[in, out] d Split direction of this stage. 
+/// @param[in, out] d_next Split direction of the next stage. 
+///
+void forwardRiccatiRecursionMoveBlocking(const SplitKKTMatrix& kkt_matrix, 
+                                         const SplitKKTResidual& kkt_residual,
+                                         const SplitDirection& d_prev, 
+                                         SplitDirection& d, 
+                                         SplitDirection& d_next);
+
+///
+/// @brief Computes the Newton direction of the costate of a stage whose 
+/// control input is shared with the previous stage by the move blocking. 
+/// @param[in] riccati Riccati factorization of this stage. 
+/// @param[in] kkt_matrix Split KKT matrix of this stage, where kkt_matrix.Qxu
+/// is the reduced Hessian computed by 
+/// RiccatiFactorizer::backwardRiccatiRecursionMoveBlocking().
+/// @param[in, out] d Split direction of this stage. 
+///
+void computeCostateDirectionMoveBlocking(
+    const SplitRiccatiFactorization& riccati, const SplitKKTMatrix& kkt_matrix,
+    SplitDirection& d);
+
 ///
 /// @brief Computes the Newton direction of the Lagrange multiplier with 
 /// respect to the switching constraint. 
@@ -7,6 +7,7 @@
 #include "robotoc/core/kkt_matrix.hpp"
 #include "robotoc/core/kkt_residual.hpp"
 #include "robotoc/utils/aligned_vector.hpp"
+#include "robotoc/utils/binary_archive.hpp"
 #include "robotoc/riccati/riccati_factorization.hpp"
 #include "robotoc/riccati/split_riccati_factorization.hpp"
 #include "robotoc/riccati/lqr_policy.hpp"
@@ -101,15 +102,44 @@ public:
   ///
   /// @brief Gets of the LQR policies over the horizon. 
   /// @return const reference to the LQR policies.
+  /// @note The stages whose control inputs are blocked with the previous 
+  /// stages (GridInfo::move_blocked) hold the policy of the first stage of 
+  /// the block.
   ///
   const aligned_vector<LQRPolicy>& getLQRPolicy() const;
 
+  ///
+  /// @brief Sets the LQR policies over the horizon, e.g., those copied from 
+  /// RiccatiRecursion::getLQRPolicy() at an earlier iterate. 
+  /// @param[in] time_discretization Time discretization. 
+  /// @param[in] lqr_policy LQR policies. Size must be at least 
+  /// time_discretization.size().
+  ///
+  void setLQRPolicy(const TimeDiscretization& time_discretization,
+                    const aligned_vector<LQRPolicy>& lqr_policy);
+
   ///
   /// @brief Resizes the internal data. 
   /// @param[in] time_discretization Time discretization. 
   ///
   void resizeData(const TimeDiscretization& time_discretization);
 
+  ///
+  /// @brief Saves the LQR policies over the horizon into a binary archive.
+  /// @param[in, out] ar Output archive.
+  /// @param[in] time_discretization Time discretization. 
+  ///
+  void saveLQRPolicy(BinaryOutputArchive& ar, 
+                     const TimeDiscretization& time_discretization) const;
+
+  ///
+  /// @brief Loads the LQR policies saved by RiccatiRecursion::saveLQRPolicy().
+  /// @param[in, out] ar Input archive.
+  /// @param[in] time_discretization Time discretization. 
+  ///
+  void loadLQRPolicy(BinaryInputArchive& ar, 
+                     const TimeDiscretization& time_discretization);
+
 private:
   RiccatiFactorizer factorizer_;
   aligned_vector<LQRPolicy> lqr_policy_;
@@ -61,28 +61,34 @@ public:
 
   int dims() const;
 
-  Eigen::Block<Eigen::MatrixXd> DGinv();
+  ///
+  /// @brief Product of the inverse of the Hessian w.r.t. the control input 
+  /// and the transpose of the switching constraint Jacobian w.r.t. the control
+  /// input, i.e., G^{-1} D^T. Computed by the triangular solves with the 
+  /// Cholesky factor of G and G^{-1} itself is never formed.
+  /// @return Reference to G^{-1} D^T. Size is Robot::dimu() x dims().
+  ///
+  Eigen::Block<Eigen::MatrixXd> GinvDt();
 
-  const Eigen::Block<const Eigen::MatrixXd> DGinv() const; 
+  ///
+  /// @brief const version of SplitConstrainedRiccatiFactorization::GinvDt().
+  ///
+  const Eigen::Block<const Eigen::MatrixXd> GinvDt() const; 
 
+  ///
+  /// @brief Schur complement of the switching constraint, i.e., 
+  /// D G^{-1} D^T.
+  /// @return Reference to the Schur complement. Size is dims() x dims().
+  ///
   Eigen::Block<Eigen::MatrixXd> S();
 
+  ///
+  /// @brief const version of SplitConstrainedRiccatiFactorization::S().
+  ///
   const Eigen::Block<const Eigen::MatrixXd> S() const;
 
-  Eigen::Block<Eigen::MatrixXd> Sinv();
-
-  const Eigen::Block<const Eigen::MatrixXd> Sinv() const;
-
-  Eigen::Block<Eigen::MatrixXd> SinvDGinv();
-
-  const Eigen::Block<const Eigen::MatrixXd> SinvDGinv() const; 
-
-  Eigen::MatrixXd Ginv;
-
   Eigen::MatrixXd DtM;
 
-  Eigen::MatrixXd KtDtM;
-
   bool isApprox(const SplitConstrainedRiccatiFactorization& other) const;
 
   bool hasNaN() const;
@@ -96,7 +102,7 @@ public:
       std::ostream& os, const SplitConstrainedRiccatiFactorization& c_riccati);
 
 private:
-  Eigen::MatrixXd DGinv_full_, S_full_, Sinv_full_, SinvDGinv_full_;
+  Eigen::MatrixXd GinvDt_full_, S_full_;
   int dimv_, dimx_, dimu_, dims_;
 
 };
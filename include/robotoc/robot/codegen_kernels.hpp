@@ -0,0 +1,164 @@
+#ifndef ROBOTOC_CODEGEN_KERNELS_HPP_
+#define ROBOTOC_CODEGEN_KERNELS_HPP_
+
+#include <string>
+#include <memory>
+
+#include "Eigen/Core"
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/container/aligned-vector.hpp"
+#include "pinocchio/spatial/force.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class CodeGenKernels
+/// @brief Dynamics kernels of a fixed robot model, i.e., the inverse dynamics
+/// (RNEA) with the joint forces of the contacts and its partial derivatives
+/// for the intermediate and impact stages, generated and compiled into a
+/// shared library by CppADCodeGen through pinocchio. The library is generated
+/// once for a URDF by CodeGenKernels::generate() and is loaded at runtime by
+/// CodeGenKernels::load(). Requires robotoc built with ENABLE_CODEGEN, which
+/// is only supported on Linux. Otherwise, CodeGenKernels::generate() and
+/// CodeGenKernels::load() throw an exception.
+///
+class CodeGenKernels {
+public:
+  ///
+  /// @brief Default constructor. No kernel is loaded.
+  ///
+  CodeGenKernels();
+
+  ///
+  /// @brief Destructor.
+  ///
+  ~CodeGenKernels();
+
+  ///
+  /// @brief Copy constructor. The copy shares the loaded library but has its
+  /// own kernel instances and buffers so that the copies can be used in the
+  /// different threads.
+  ///
+  CodeGenKernels(const CodeGenKernels& other);
+
+  ///
+  /// @brief Copy assign operator. See the copy constructor.
+  ///
+  CodeGenKernels& operator=(const CodeGenKernels& other);
+
+  ///
+  /// @brief Default move constructor.
+  ///
+  CodeGenKernels(CodeGenKernels&&) noexcept;
+
+  ///
+  /// @brief Default move assign operator.
+  ///
+  CodeGenKernels& operator=(CodeGenKernels&&) noexcept;
+
+  ///
+  /// @brief Generates the C source codes of the kernels and compiles them into
+  /// the shared library library_name + ".so".
+  /// @param[in] model Model of the robot.
+  /// @param[in] impact_model Model of the robot used in the impact stages,
+  /// i.e., the model without the gravity.
+  /// @param[in] library_name Name of the library including the directory.
+  /// @param[in] compiler Path to the C compiler.
+  ///
+  static void generate(const pinocchio::Model& model,
+                       const pinocchio::Model& impact_model,
+                       const std::string& library_name,
+                       const std::string& compiler);
+
+  ///
+  /// @brief Loads the kernels generated by CodeGenKernels::generate(). All 
+  /// the kernels are validated against pinocchio at a random point with 
+  /// random external forces, and an exception is thrown if the library is 
+  /// generated for other models.
+  /// @param[in] model Model of the robot.
+  /// @param[in] impact_model Model of the robot used in the impact stages,
+  /// i.e., the model without the gravity.
+  /// @param[in] library_name Name of the library including the directory.
+  ///
+  void load(const pinocchio::Model& model, const pinocchio::Model& impact_model,
+            const std::string& library_name);
+
+  ///
+  /// @brief Unloads the kernels.
+  ///
+  void unload();
+
+  ///
+  /// @brief Checks if the kernels are loaded.
+  /// @return true if the kernels are loaded. false if not.
+  ///
+  bool isLoaded() const {
+    return static_cast<bool>(impl_);
+  }
+
+  ///
+  /// @brief Gets the name of the loaded library.
+  /// @return const reference to the name of the library. Empty if the kernels
+  /// are not loaded.
+  ///
+  const std::string& libraryName() const {
+    return library_name_;
+  }
+
+  ///
+  /// @brief Computes the inverse dynamics. Equivalent to pinocchio::rnea()
+  /// with the external forces.
+  ///
+  void RNEA(const Eigen::Ref<const Eigen::VectorXd>& q,
+            const Eigen::Ref<const Eigen::VectorXd>& v,
+            const Eigen::Ref<const Eigen::VectorXd>& a,
+            const pinocchio::container::aligned_vector<pinocchio::Force>& fext,
+            Eigen::Ref<Eigen::VectorXd> tau);
+
+  ///
+  /// @brief Computes the partial derivatives of the inverse dynamics.
+  /// Equivalent to pinocchio::computeRNEADerivatives() with the external
+  /// forces, i.e., only the upper triangular part of dRNEA_partial_da is
+  /// filled.
+  ///
+  void RNEADerivatives(
+      const Eigen::Ref<const Eigen::VectorXd>& q,
+      const Eigen::Ref<const Eigen::VectorXd>& v,
+      const Eigen::Ref<const Eigen::VectorXd>& a,
+      const pinocchio::container::aligned_vector<pinocchio::Force>& fext,
+      Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_dq,
+      Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_dv,
+      Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_da);
+
+  ///
+  /// @brief Computes the impact dynamics, i.e., the inverse dynamics of the
+  /// impact model with zero velocity.
+  ///
+  void RNEAImpact(
+      const Eigen::Ref<const Eigen::VectorXd>& q,
+      const Eigen::Ref<const Eigen::VectorXd>& dv,
+      const pinocchio::container::aligned_vector<pinocchio::Force>& fext,
+      Eigen::Ref<Eigen::VectorXd> res);
+
+  ///
+  /// @brief Computes the partial derivatives of the impact dynamics. Only the
+  /// upper triangular part of dRNEA_partial_ddv is filled.
+  ///
+  void RNEAImpactDerivatives(
+      const Eigen::Ref<const Eigen::VectorXd>& q,
+      const Eigen::Ref<const Eigen::VectorXd>& dv,
+      const pinocchio::container::aligned_vector<pinocchio::Force>& fext,
+      Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_dq,
+      Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_ddv);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+  std::string library_name_;
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_CODEGEN_KERNELS_HPP_
@@ -11,6 +11,7 @@
 #include "robotoc/robot/se3.hpp"
 #include "robotoc/utils/aligned_vector.hpp"
 #include "robotoc/utils/aligned_unordered_map.hpp"
+#include "robotoc/utils/binary_archive.hpp"
 
 
 namespace robotoc {
@@ -442,6 +443,17 @@ public:
   ///
   const std::vector<double>& frictionCoefficients() const;
 
+  ///
+  /// @brief Gets the linearized friction cone of the contact, which maps the 
+  /// contact force expressed in the world frame to the residual of the 
+  /// friction cone constraint. This is precomputed from the contact rotation 
+  /// and friction coefficient when they are set, so that it is shared by all 
+  /// the stages of the contact phase.
+  /// @param[in] contact_index Index of the contact.
+  /// @return const reference to the linearized friction cone. 
+  ///
+  const Eigen::Matrix<double, 5, 3>& frictionCone(const int contact_index) const;
+
   ///
   /// @brief Finds the contact index correspoinding to the input contact frame name.
   /// @param[in] contact_frame_name Name of the contact frame.
@@ -454,6 +466,19 @@ public:
   ///
   void setRandom();
 
+  ///
+  /// @brief Saves the contact status into a binary archive.
+  /// @param[in, out] ar Output archive.
+  ///
+  void save(BinaryOutputArchive& ar) const;
+
+  ///
+  /// @brief Loads the contact status saved by ContactStatus::save(). All the 
+  /// members including the contact types and frame names are overwritten.
+  /// @param[in, out] ar Input archive.
+  ///
+  void load(BinaryInputArchive& ar);
+
   ///
   /// @brief Displays the contact status onto a ostream.
   ///
@@ -472,11 +497,14 @@ private:
   std::vector<Eigen::Vector3d> contact_positions_;
   std::vector<Eigen::Matrix3d> contact_rotations_;
   std::vector<double> friction_coefficients_;
+  std::vector<Eigen::Matrix<double, 5, 3>> friction_cones_;
   int dimf_, max_contacts_, max_num_contacts_;
   bool has_active_contacts_;
 
   void setHasActiveContacts();
 
+  void updateFrictionCone(const int contact_index);
+
 };
 
 } // namespace robotoc
@@ -7,6 +7,7 @@
 #include <cassert>
 #include <random>
 #include <chrono>
+#include <cmath>
 
 
 namespace robotoc {
@@ -22,6 +23,7 @@ inline ContactStatus::ContactStatus(
     contact_positions_(contact_types.size(), Eigen::Vector3d::Zero()),
     contact_rotations_(contact_types.size(), Eigen::Matrix3d::Identity()),
     friction_coefficients_(contact_types.size(), 0.7),
+    friction_cones_(contact_types.size()),
     dimf_(0),
     max_contacts_(contact_types.size()),
     max_num_contacts_(contact_types.size()),
@@ -33,6 +35,9 @@ inline ContactStatus::ContactStatus(
   if (default_friction_coefficients <= 0.0) {
     throw std::invalid_argument("[ContactStatus] invalid argument: 'default_friction_coefficients' must be positive!");
   }
+  for (int i=0; i<max_num_contacts_; ++i) {
+    updateFrictionCone(i);
+  }
 }
 
 
@@ -44,6 +49,7 @@ inline ContactStatus::ContactStatus()
     contact_positions_(),
     contact_rotations_(),
     friction_coefficients_(),
+    friction_cones_(),
     dimf_(0),
     max_contacts_(0),
     max_num_contacts_(0),
@@ -241,6 +247,7 @@ inline void ContactStatus::setContactPlacement(
   contact_positions_[contact_index] = contact_position;
   contact_rotations_[contact_index] = contact_rotation;
   contact_placements_[contact_index] = SE3(contact_rotation, contact_position);
+  updateFrictionCone(contact_index);
 }
 
 
@@ -260,6 +267,7 @@ inline void ContactStatus::setContactPlacement(const int contact_index,
   contact_positions_[contact_index] = contact_placement.translation();
   contact_rotations_[contact_index] = contact_placement.rotation();
   contact_placements_[contact_index] = contact_placement;
+  updateFrictionCone(contact_index);
 }
 
 
@@ -396,6 +404,7 @@ inline void ContactStatus::setFrictionCoefficient(const int contact_index,
   assert(contact_index >= 0);
   assert(contact_index < max_num_contacts_);
   friction_coefficients_[contact_index] = friction_coefficient;
+  updateFrictionCone(contact_index);
 }
 
 
@@ -441,6 +450,14 @@ inline const std::vector<double>& ContactStatus::frictionCoefficients() const {
 }
 
 
+inline const Eigen::Matrix<double, 5, 3>& ContactStatus::frictionCone(
+    const int contact_index) const {
+  assert(contact_index >= 0);
+  assert(contact_index < max_num_contacts_);
+  return friction_cones_[contact_index];
+}
+
+
 inline int ContactStatus::findContactIndex(
     const std::string& contact_frame_name) const {
   if (contact_frame_names_.empty()) {
@@ -474,6 +491,20 @@ inline void ContactStatus::setHasActiveContacts() {
 }
 
 
+inline void ContactStatus::updateFrictionCone(const int contact_index) {
+  // Friction cone in the local frame of the contact surface.
+  const double mu = friction_coefficients_[contact_index] / std::sqrt(2);
+  Eigen::Matrix<double, 5, 3> cone_surface;
+  cone_surface <<  0,  0, -1, 
+                   1,  0, -mu,
+                  -1,  0, -mu,
+                   0,  1, -mu,
+                   0, -1, -mu;
+  friction_cones_[contact_index].noalias() 
+      = cone_surface * contact_rotations_[contact_index].transpose();
+}
+
+
 } // namespace robotoc
 
 #endif // ROBOTOC_CONTACT_STATUS_HXX_ 
\ No newline at end of file
@@ -296,6 +296,14 @@ public:
   ///
   const std::vector<double>& frictionCoefficients() const;
 
+  ///
+  /// @brief Gets the linearized friction cone of the contact. See 
+  /// ContactStatus::frictionCone().
+  /// @param[in] contact_index Index of the contact.
+  /// @return const reference to the linearized friction cone. 
+  ///
+  const Eigen::Matrix<double, 5, 3>& frictionCone(const int contact_index) const;
+
   ///
   /// @brief Fills impact status randomly.
   ///
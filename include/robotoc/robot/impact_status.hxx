@@ -213,6 +213,12 @@ inline const std::vector<double>& ImpactStatus::frictionCoefficients() const {
 }
 
 
+inline const Eigen::Matrix<double, 5, 3>& ImpactStatus::frictionCone(
+    const int contact_index) const {
+  return contact_status_.frictionCone(contact_index);
+}
+
+
 inline void ImpactStatus::setRandom() {
   contact_status_.setRandom();
 }
@@ -19,6 +19,7 @@
 #include "robotoc/robot/contact_status.hpp"
 #include "robotoc/robot/impact_status.hpp"
 #include "robotoc/robot/robot_properties.hpp"
+#include "robotoc/robot/codegen_kernels.hpp"
 #include "robotoc/utils/aligned_vector.hpp"
 
 
@@ -597,6 +598,23 @@ public:
                        const Eigen::MatrixBase<MatrixType2>& dRNEA_partial_dv, 
                        const Eigen::MatrixBase<MatrixType3>& dRNEA_partial_da);
 
+  ///
+  /// @brief Computes the forward dynamics, i.e., the generalized acceleration
+  /// for the given generalized torques, by the articulated body algorithm 
+  /// (ABA). If the robot has contacts, update contact forces via 
+  /// setContactForces() before calling this function.
+  /// @param[in] q Configuration. Size must be Robot::dimq().
+  /// @param[in] v Generalized velocity. Size must be Robot::dimv().
+  /// @param[in] tau Generalized torques. Size must be Robot::dimv().
+  /// @param[out] a Generalized acceleration. Size must be Robot::dimv().
+  ///
+  template <typename ConfigVectorType, typename TangentVectorType1, 
+            typename TangentVectorType2, typename TangentVectorType3>
+  void ABA(const Eigen::MatrixBase<ConfigVectorType>& q, 
+           const Eigen::MatrixBase<TangentVectorType1>& v, 
+           const Eigen::MatrixBase<TangentVectorType2>& tau, 
+           const Eigen::MatrixBase<TangentVectorType3>& a);
+
   ///
   /// @brief Computes the residual of the impact dynamics for given 
   /// configuration and impact change in the generalized velocity, and impact 
@@ -899,6 +917,34 @@ public:
   ///
   void setRobotProperties(const RobotProperties& properties);
 
+  ///
+  /// @brief Generates the dynamics kernels of this robot model by 
+  /// CppADCodeGen, compiles them into the shared library 
+  /// library_name + ".so", and loads the library. See CodeGenKernels. 
+  /// Requires robotoc built with ENABLE_CODEGEN.
+  /// @param[in] library_name Name of the library including the directory.
+  /// @param[in] compiler Path to the C compiler. Default is "/usr/bin/gcc".
+  ///
+  void generateCodeGenKernels(const std::string& library_name, 
+                              const std::string& compiler="/usr/bin/gcc");
+
+  ///
+  /// @brief Loads the dynamics kernels generated by 
+  /// Robot::generateCodeGenKernels() for the same URDF, e.g., in the previous 
+  /// run. Robot::RNEA(), Robot::RNEADerivatives(), Robot::RNEAImpact(), and 
+  /// Robot::RNEAImpactDerivatives() dispatch to the kernels afterwards.
+  /// Requires robotoc built with ENABLE_CODEGEN.
+  /// @param[in] library_name Name of the library including the directory.
+  ///
+  void loadCodeGenKernels(const std::string& library_name);
+
+  ///
+  /// @brief Checks if the dynamics kernels generated by CppADCodeGen are 
+  /// loaded.
+  /// @return true if the kernels are loaded. false if not.
+  ///
+  bool hasCodeGenKernels() const;
+
   ///
   /// @brief Displays the robot model onto a ostream.
   ///
@@ -916,6 +962,8 @@ private:
   pinocchio::Data data_, impact_data_;
   pinocchio::container::aligned_vector<pinocchio::Force> fjoint_;
   Eigen::MatrixXd dimpact_dv_; 
+  // Dynamics kernels generated by CppADCodeGen
+  CodeGenKernels codegen_kernels_;
   // Contact models
   aligned_vector<PointContact> point_contacts_;
   aligned_vector<SurfaceContact> surface_contacts_;
@@ -529,7 +529,12 @@ inline void Robot::RNEA(const Eigen::MatrixBase<ConfigVectorType>& q,
   assert(v.size() == dimv_);
   assert(a.size() == dimv_);
   assert(tau.size() == dimv_);
-  if (max_num_contacts_) {
+  if (codegen_kernels_.isLoaded()) {
+    codegen_kernels_.RNEA(
+        q, v, a, fjoint_, 
+        const_cast<Eigen::MatrixBase<TangentVectorType3>&>(tau).derived());
+  }
+  else if (max_num_contacts_) {
     const_cast<Eigen::MatrixBase<TangentVectorType3>&>(tau)
         = pinocchio::rnea(model_, data_, q, v, a, fjoint_);
   }
@@ -563,7 +568,14 @@ inline void Robot::RNEADerivatives(
   assert(dRNEA_partial_dv.rows() == dimv_);
   assert(dRNEA_partial_da.cols() == dimv_);
   assert(dRNEA_partial_da.rows() == dimv_);
-  if (max_num_contacts_) {
+  if (codegen_kernels_.isLoaded()) {
+    codegen_kernels_.RNEADerivatives(
+        q, v, a, fjoint_,
+        const_cast<Eigen::MatrixBase<MatrixType1>&>(dRNEA_partial_dq).derived(),
+        const_cast<Eigen::MatrixBase<MatrixType2>&>(dRNEA_partial_dv).derived(),
+        const_cast<Eigen::MatrixBase<MatrixType3>&>(dRNEA_partial_da).derived());
+  }
+  else if (max_num_contacts_) {
     pinocchio::computeRNEADerivatives(
         model_, data_, q, v, a, fjoint_,
         const_cast<Eigen::MatrixBase<MatrixType1>&>(dRNEA_partial_dq),
@@ -584,6 +596,27 @@ inline void Robot::RNEADerivatives(
 }
 
 
+template <typename ConfigVectorType, typename TangentVectorType1, 
+          typename TangentVectorType2, typename TangentVectorType3>
+inline void Robot::ABA(const Eigen::MatrixBase<ConfigVectorType>& q, 
+                       const Eigen::MatrixBase<TangentVectorType1>& v, 
+                       const Eigen::MatrixBase<TangentVectorType2>& tau, 
+                       const Eigen::MatrixBase<TangentVectorType3>& a) {
+  assert(q.size() == dimq_);
+  assert(v.size() == dimv_);
+  assert(tau.size() == dimv_);
+  assert(a.size() == dimv_);
+  if (max_num_contacts_) {
+    const_cast<Eigen::MatrixBase<TangentVectorType3>&>(a)
+        = pinocchio::aba(model_, data_, q, v, tau, fjoint_);
+  }
+  else {
+    const_cast<Eigen::MatrixBase<TangentVectorType3>&>(a)
+        = pinocchio::aba(model_, data_, q, v, tau);
+  }
+}
+
+
 template <typename ConfigVectorType, typename TangentVectorType1, 
           typename TangentVectorType2>
 inline void Robot::RNEAImpact(
@@ -593,6 +626,12 @@ inline void Robot::RNEAImpact(
   assert(q.size() == dimq_);
   assert(dv.size() == dimv_);
   assert(res.size() == dimv_);
+  if (codegen_kernels_.isLoaded()) {
+    codegen_kernels_.RNEAImpact(
+        q, dv, fjoint_, 
+        const_cast<Eigen::MatrixBase<TangentVectorType2>&>(res).derived());
+    return;
+  }
   const_cast<Eigen::MatrixBase<TangentVectorType2>&>(res)
       = pinocchio::rnea(impact_model_, impact_data_, q, 
                         Eigen::VectorXd::Zero(dimv_),  dv, fjoint_);
@@ -612,11 +651,19 @@ inline void Robot::RNEAImpactDerivatives(
   assert(dRNEA_partial_dq.rows() == dimv_);
   assert(dRNEA_partial_ddv.cols() == dimv_);
   assert(dRNEA_partial_ddv.rows() == dimv_);
-  pinocchio::computeRNEADerivatives(
-      impact_model_, impact_data_, q, Eigen::VectorXd::Zero(dimv_), dv, 
-      fjoint_, const_cast<Eigen::MatrixBase<MatrixType1>&>(dRNEA_partial_dq),
-      dimpact_dv_,
-      const_cast<Eigen::MatrixBase<MatrixType2>&>(dRNEA_partial_ddv));
+  if (codegen_kernels_.isLoaded()) {
+    codegen_kernels_.RNEAImpactDerivatives(
+        q, dv, fjoint_, 
+        const_cast<Eigen::MatrixBase<MatrixType1>&>(dRNEA_partial_dq).derived(),
+        const_cast<Eigen::MatrixBase<MatrixType2>&>(dRNEA_partial_ddv).derived());
+  }
+  else {
+    pinocchio::computeRNEADerivatives(
+        impact_model_, impact_data_, q, Eigen::VectorXd::Zero(dimv_), dv, 
+        fjoint_, const_cast<Eigen::MatrixBase<MatrixType1>&>(dRNEA_partial_dq),
+        dimpact_dv_,
+        const_cast<Eigen::MatrixBase<MatrixType2>&>(dRNEA_partial_ddv));
+  }
   (const_cast<Eigen::MatrixBase<MatrixType2>&>(dRNEA_partial_ddv)) 
       .template triangularView<Eigen::StrictlyLower>() 
       = (const_cast<Eigen::MatrixBase<MatrixType2>&>(dRNEA_partial_ddv)).transpose()
@@ -2,6 +2,7 @@
 #define ROBOTOC_OCP_SOLVER_HPP_
 
 #include <vector>
+#include <array>
 #include <memory>
 #include <iostream>
 
@@ -170,22 +171,44 @@ public:
   ///
   void setSolution(const std::string& name, const Eigen::VectorXd& value);
 
+  ///
+  /// @brief Sets the solution guess by interpolating a solution defined on 
+  /// another time discretization, e.g., a cached solution of a similar 
+  /// problem. The solution is also stored as the source of the solution 
+  /// interpolation in the next call of solve() with init_solver=true. Call 
+  /// discretize() beforehand.
+  /// @param[in] time_discretization Time discretization of the solution. 
+  /// @param[in] s Solution. Size must be at least time_discretization.size().
+  ///
+  void interpolateSolution(const TimeDiscretization& time_discretization, 
+                           const Solution& s);
+
   ///
   /// @brief Computes the KKT residual of the optimal control problem and 
   /// returns the KKT error, that is, the l2-norm of the KKT residual. 
+  /// Only the first-order residual is evaluated, i.e., the Hessians are not 
+  /// computed and the KKT system is not condensed, unless the switching time 
+  /// optimization is enabled. The current KKT matrix and residual are 
+  /// overwritten.
   /// @param[in] t Initial time of the horizon. 
   /// @param[in] q Initial configuration. Size must be Robot::dimq().
   /// @param[in] v Initial velocity. Size must be Robot::dimv().
   /// @return The KKT error, that is, the l2-norm of the KKT residual.
   /// @remark The linear and angular velocities of the floating base are assumed
   /// to be expressed in the body local coordinate.
+  /// @remark Use KKTError() without arguments to get the KKT error computed 
+  /// in the last iteration of OCPSolver::solve() without additional cost.
   ///
   double KKTError(const double t, const Eigen::VectorXd& q, 
                   const Eigen::VectorXd& v);
 
   ///
   /// @brief Returns the l2-norm of the KKT residuals using the results of 
-  /// OCPsolver::updateSolution() or OCPsolver::solve().
+  /// OCPsolver::updateSolution() or OCPsolver::solve(). This is the by-product
+  /// of the last iteration, that is, the KKT error evaluated before the last 
+  /// update of the solution, and hence does not require any computation.
+  /// If the best iterate is restored (SolverStatistics::best_iterate_restored),
+  /// this is the KKT error evaluated at the restored iterate.
   /// @return The l2-norm of the KKT residual.
   ///
   double KKTError() const;
@@ -203,6 +226,24 @@ public:
   ///
   void setRobotProperties(const RobotProperties& properties);
 
+  ///
+  /// @brief Saves the solver state, i.e., the contact sequence, the time 
+  /// discretization, the solution, the slack and dual variables of the 
+  /// inequality constraints, and the LQR policies, into a binary file. 
+  /// @param[in] filename Name of the file.
+  ///
+  void saveSolverState(const std::string& filename) const;
+
+  ///
+  /// @brief Loads the solver state saved by saveSolverState() for a warm 
+  /// start. The contact sequence shared with this solver is overwritten. Call
+  /// solve() with init_solver=false afterwards to continue the iterations 
+  /// from the loaded state. Throws std::runtime_error if the file is not 
+  /// consistent with the optimal control problem of this solver.
+  /// @param[in] filename Name of the file.
+  ///
+  void loadSolverState(const std::string& filename);
+
   ///
   /// @brief Displays the optimal control problem solver onto a ostream.
   ///
@@ -228,7 +269,24 @@ private:
   SolutionInterpolator solution_interpolator_;
   SolverOptions solver_options_;
   SolverStatistics solver_statistics_;
-  Timer timer_;
+  Timer timer_, budget_timer_, phase_timer_;
+  std::array<double, 4> phase_time_average_;
+  Solution s_prev_, s_best_;
+  std::vector<ConstraintsData> constraints_data_prev_, constraints_data_best_;
+  aligned_vector<LQRPolicy> lqr_policy_best_;
+  PerformanceIndex best_performance_index_;
+  double best_kkt_error_;
+
+  ///
+  /// @brief Phases of an iteration whose computational times are averaged
+  /// to predict the time of the next iteration under the time budget.
+  ///
+  enum BudgetPhase {
+    EvalKKT = 0,
+    Riccati = 1,
+    StepSize = 2,
+    Integration = 3,
+  };
 
   ///
   /// @brief Performs single Newton-type iteration and updates the solution.
@@ -243,6 +301,49 @@ private:
 
   void resizeData();
 
+  ///
+  /// @brief Sets the control inputs of the move-blocked stages to that of 
+  /// the head of each block.
+  ///
+  void synchronizeMoveBlockedInputs();
+
+  ///
+  /// @brief Checks whether the next iteration is predicted to finish within 
+  /// the time budget. The time of the next iteration is predicted by the sum
+  /// of the running averages of the times of the phases of the iterations.
+  /// @return true if the next iteration is predicted to exceed the budget.
+  ///
+  bool isBudgetExhausted();
+
+  ///
+  /// @brief Starts measuring the time of a phase of the iteration if the 
+  /// time budget is enabled.
+  ///
+  void tickBudgetPhase();
+
+  ///
+  /// @brief Stops measuring the time of a phase of the iteration and updates
+  /// its running average if the time budget is enabled.
+  /// @param[in] phase Phase.
+  ///
+  void tockBudgetPhase(const BudgetPhase phase);
+
+  ///
+  /// @brief Stores the iterate whose KKT error is evaluated in the current 
+  /// iteration, i.e., the solution, the slack and dual variables, the LQR 
+  /// policies, and the performance index, if it is the best one so far under
+  /// the time budget.
+  /// @param[in] kkt_error KKT error of the iterate.
+  ///
+  void updateBestIterate(const double kkt_error);
+
+  ///
+  /// @brief Restores the best iterate stored by updateBestIterate() when the
+  /// iterations are terminated without convergence under the time budget. 
+  /// See SolverOptions::time_budget.
+  ///
+  void restoreBestIterate();
+
 };
 
 } // namespace robotoc 
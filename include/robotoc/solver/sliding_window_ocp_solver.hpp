@@ -0,0 +1,216 @@
+#ifndef ROBOTOC_SLIDING_WINDOW_OCP_SOLVER_HPP_
+#define ROBOTOC_SLIDING_WINDOW_OCP_SOLVER_HPP_
+
+#include <vector>
+#include <memory>
+#include <string>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/cost/consensus_cost.hpp"
+#include "robotoc/solver/ocp_solver.hpp"
+#include "robotoc/solver/solver_options.hpp"
+#include "robotoc/utils/thread_pool.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class SlidingWindowSettings
+/// @brief Settings of SlidingWindowOCPSolver.
+///
+struct SlidingWindowSettings {
+  ///
+  /// @brief Number of the grids overlapped by the consecutive windows. 
+  /// Must be positive and smaller than OCP::N / 2. Default is 5.
+  ///
+  int num_overlap_grids = 5;
+
+  ///
+  /// @brief Maximum number of the ADMM iterations. Must be non-negative. 
+  /// Default is 10.
+  ///
+  int max_admm_iter = 10;
+
+  ///
+  /// @brief Penalty parameter of the ADMM. Must be positive. Default is 100.
+  ///
+  double admm_penalty = 1.0e02;
+
+  ///
+  /// @brief Tolerance of the primal and dual residuals of the ADMM.
+  /// Must be positive. Default is 1.0e-04.
+  ///
+  double admm_tol = 1.0e-04;
+
+  ///
+  /// @brief Total number of the threads, i.e., the number of the windows 
+  /// solved concurrently times SolverOptions::nthreads of each window. The 
+  /// windows are solved by max(nthreads/SolverOptions::nthreads, 1) threads 
+  /// so that the cores are not oversubscribed. Must be positive. Default 
+  /// is 1. 
+  ///
+  int nthreads = 1;
+};
+
+///
+/// @class SlidingWindowOCPSolver
+/// @brief Offline trajectory optimization of a clip longer than the horizon 
+/// of the OCP. The clip is split into overlapping windows of the horizon of 
+/// the OCP, which are solved concurrently by the separate OCPSolver instances.
+/// The windows are stitched by the consensus ADMM on the states of the 
+/// overlapping grids: each window penalizes its overlapping states by 
+/// ConsensusCost, and the initial state of each window is taken from the 
+/// solution of the previous window. 
+/// @remark The cost function, constraints, and contact sequence of the OCP 
+/// are shared by the windows, i.e., must not be modified during solve(). 
+/// The switching time optimization and the graded grids are not supported.
+///
+class SlidingWindowOCPSolver {
+public:
+  ///
+  /// @brief Construct the solver.
+  /// @param[in] ocp Optimal control problem of each window. 
+  /// @param[in] solver_options Solver options of each window. 
+  /// Default is SolverOptions().
+  /// @param[in] settings Settings of the sliding windows. 
+  /// Default is SlidingWindowSettings().
+  ///
+  SlidingWindowOCPSolver(const OCP& ocp, 
+                         const SolverOptions& solver_options=SolverOptions(),
+                         const SlidingWindowSettings& settings=SlidingWindowSettings());
+
+  ///
+  /// @brief Default constructor. 
+  ///
+  SlidingWindowOCPSolver();
+
+  ///
+  /// @brief Default destructor. 
+  ///
+  ~SlidingWindowOCPSolver() = default;
+
+  ///
+  /// @brief Default copy constructor. 
+  ///
+  SlidingWindowOCPSolver(const SlidingWindowOCPSolver&) = default;
+
+  ///
+  /// @brief Default copy assign operator. 
+  ///
+  SlidingWindowOCPSolver& operator=(const SlidingWindowOCPSolver&) = default;
+
+  ///
+  /// @brief Default move constructor. 
+  ///
+  SlidingWindowOCPSolver(SlidingWindowOCPSolver&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator. 
+  ///
+  SlidingWindowOCPSolver& operator=(SlidingWindowOCPSolver&&) noexcept = default;
+
+  ///
+  /// @brief Sets the solver options of each window. 
+  /// @param[in] solver_options Solver options.  
+  ///
+  void setSolverOptions(const SolverOptions& solver_options);
+
+  ///
+  /// @brief Sets the settings of the sliding windows. 
+  /// @param[in] settings Settings.  
+  ///
+  void setSettings(const SlidingWindowSettings& settings);
+
+  ///
+  /// @brief Solves the trajectory optimization of the clip. 
+  /// @param[in] t Initial time of the clip. 
+  /// @param[in] q Initial configuration. Size must be Robot::dimq().
+  /// @param[in] v Initial velocity. Size must be Robot::dimv().
+  /// @param[in] clip_length Length of the clip. Must not be smaller than 
+  /// OCP::T. The last window may exceed the end of the clip.
+  ///
+  void solve(const double t, const Eigen::VectorXd& q, const Eigen::VectorXd& v,
+             const double clip_length);
+
+  ///
+  /// @brief Gets the stitched solution over the clip. 
+  /// @param[in] name Name of the variable. See OCPSolver::getSolution().
+  /// @param[in] option Option for the solution. See OCPSolver::getSolution().
+  /// @return Solution vector.
+  ///
+  std::vector<Eigen::VectorXd> getSolution(const std::string& name,
+                                           const std::string& option="") const;
+
+  ///
+  /// @brief Gets the time points of the stitched solution. 
+  /// @return Time points.
+  ///
+  std::vector<double> getTimes() const;
+
+  ///
+  /// @brief Gets the solver of a window. 
+  /// @param[in] window Index of the window.
+  /// @return Const reference to the solver.
+  ///
+  const OCPSolver& getWindowSolver(const int window) const;
+
+  ///
+  /// @brief Gets the number of the windows of the last solve(). 
+  /// @return Number of the windows.
+  ///
+  int numWindows() const;
+
+  ///
+  /// @brief Gets the number of the ADMM iterations of the last solve(). 
+  /// @return Number of the ADMM iterations.
+  ///
+  int admmIter() const;
+
+  ///
+  /// @brief Gets the primal residual of the ADMM, i.e., the maximum 
+  /// inconsistency of the overlapping states of the consecutive windows. 
+  /// @return Primal residual.
+  ///
+  double primalResidual() const;
+
+  ///
+  /// @brief Gets the dual residual of the ADMM. 
+  /// @return Dual residual.
+  ///
+  double dualResidual() const;
+
+private:
+  OCP ocp_;
+  Robot robot_;
+  SolverOptions solver_options_;
+  SlidingWindowSettings settings_;
+  std::vector<OCPSolver> window_solvers_;
+  std::vector<std::shared_ptr<ConsensusCost>> consensus_costs_;
+  std::vector<double> window_times_;
+  std::vector<Eigen::VectorXd> q0_, v0_;
+  // Consensus and scaled dual variables of the overlapping grids. Overlap k
+  // is shared by the windows k (l) and k+1 (r).
+  std::vector<std::vector<Eigen::VectorXd>> zq_, zv_, yq_l_, yv_l_, yq_r_, yv_r_;
+  Eigen::VectorXd qdiff_, wq_l_, wq_r_;
+  ThreadPool thread_pool_;
+  double dt_, primal_residual_, dual_residual_;
+  int num_windows_, admm_iter_;
+
+  void resizeWindows(const int num_windows);
+
+  void setConsensusTargets();
+
+  void updateConsensus();
+
+  int findGrid(const int window, const double t) const;
+
+  bool isOwnedGrid(const int window, const double t) const;
+
+};
+
+} // namespace robotoc 
+
+#endif // ROBOTOC_SLIDING_WINDOW_OCP_SOLVER_HPP_ 
@@ -4,8 +4,10 @@
 #include <iostream>
 
 #include "robotoc/ocp/discretization_method.hpp"
+#include "robotoc/ocp/hessian_approximation.hpp"
 #include "robotoc/line_search/line_search_settings.hpp"
 #include "robotoc/solver/interpolation_order.hpp"
+#include "robotoc/utils/binary_archive.hpp"
 
 
 namespace robotoc {
@@ -21,6 +23,14 @@ struct SolverOptions {
   ///
   int nthreads = 1;
 
+  ///
+  /// @brief If true, the worker threads of the parallel computations are 
+  /// pinned to the CPU cores so that the data of each stage stays in the 
+  /// cache of the same core over the iterations. Only supported in Linux. 
+  /// Default is false.
+  ///
+  bool enable_thread_pinning = false;
+
   ///
   /// @brief Maximum number of iterations. Must be non-negative. 
   /// Default is 100. 
@@ -83,6 +93,30 @@ struct SolverOptions {
   ///
   DiscretizationMethod discretization_method = DiscretizationMethod::GridBased;
 
+  ///
+  /// @brief Number of the consecutive intermediate stages sharing the same 
+  /// control input (move blocking). The stages in each phase are grouped from 
+  /// the beginning of the phase and the control input is eliminated only once
+  /// per group in the Riccati recursion. The stages around the discrete 
+  /// events and in the phases whose switching times are optimized are not 
+  /// blocked. Must be positive. Default is 1 (that is, no move blocking).
+  /// @note Move blocking restricts the control inputs and therefore trades 
+  /// the optimality for the reduction of the factorization cost.
+  ///
+  int move_blocking_size = 1;
+
+  ///
+  /// @brief Approximation of the Hessian of the stage cost. 
+  /// HessianApproximation::BFGS skips the evaluation of the Hessians of the 
+  /// cost function components after the first iteration of each solve() 
+  /// with init_solver=true and updates the block-diagonal approximation 
+  /// w.r.t. (x, u), a, and f by the damped BFGS formula. Only used in 
+  /// OCPSolver. Default is HessianApproximation::GaussNewton.
+  /// @note BFGS reduces the cost per iteration for costly cost Hessians 
+  /// while it can increase the number of iterations.
+  ///
+  HessianApproximation hessian_approximation = HessianApproximation::GaussNewton;
+
   ///
   /// @brief Number of initial inner iterations in which a large regularization 
   /// for the STO problem is added, where the inner iteration means the 
@@ -149,6 +183,36 @@ struct SolverOptions {
   ///
   bool enable_benchmark = false;
 
+  ///
+  /// @brief Wall-clock time budget (milli seconds) of each solve(). 
+  /// Before each iteration, the solver predicts the computational time of the 
+  /// next iteration by the sum of the running averages of the times of its 
+  /// phases (the KKT evaluation, the Riccati recursion, the step size 
+  /// computation, and the integration) and terminates if the iteration would 
+  /// exceed the budget. SolverStatistics::budget_exhausted is then set true. 
+  /// If the iterations are terminated without convergence, i.e., by the 
+  /// budget or by max_iter, and the KKT error of the last evaluated iterate is
+  /// larger than that of an earlier iterate, the earlier one, i.e., the best 
+  /// iterate, is restored together with its slack and dual variables, LQR 
+  /// policies, and KKT error, and SolverStatistics::best_iterate_restored is 
+  /// set true. Otherwise, the latest iterate is kept. The Riccati 
+  /// factorization is not restored. The best iterate is not restored with 
+  /// the switching time optimization. Non-positive value means no time budget. Default is 0.
+  ///
+  double time_budget = 0.0;
+
+  ///
+  /// @brief Saves the solver options to a binary archive.
+  /// @param[in] ar Output archive.
+  ///
+  void save(BinaryOutputArchive& ar) const;
+
+  ///
+  /// @brief Loads the solver options from a binary archive.
+  /// @param[in] ar Input archive.
+  ///
+  void load(BinaryInputArchive& ar);
+
   ///
   /// @brief Displays the solver settings onto a ostream.
   ///
@@ -2,7 +2,6 @@
 #define ROBOTOC_SOLVER_STATISTICS_HPP_
 
 #include <vector>
-#include <deque>
 #include <iostream>
 
 #include "robotoc/core/performance_index.hpp"
@@ -20,6 +19,19 @@ struct SolverStatistics {
   ///
   bool convergence = false;
 
+  ///
+  /// @brief Flags whether the iterations are terminated because the time 
+  /// budget specified by SolverOptions::time_budget is exhausted.
+  ///
+  bool budget_exhausted = false;
+
+  ///
+  /// @brief Flags whether the best iterate in terms of the KKT error is 
+  /// restored as the solution because the iterations are terminated without 
+  /// convergence under the time budget. See SolverOptions::time_budget.
+  ///
+  bool best_iterate_restored = false;
+
   ///
   /// @brief Number of iterations until convergence.
   ///
@@ -43,13 +55,20 @@ struct SolverStatistics {
   ///
   /// @brief Switching times at each iteration.
   ///
-  std::vector<std::deque<double>> ts;
+  std::vector<std::vector<double>> ts;
 
   ///
   /// @brief Iterations where the mesh-refinements are carried out.
   ///
   std::vector<int> mesh_refinement_iter;
 
+  ///
+  /// @brief Ratio of the constraint components skipped by the active-set 
+  /// screening at each iteration. Only stored if the screening is enabled by
+  /// Constraints::setActiveSetScreening().
+  ///
+  std::vector<double> screened_constraints_ratio;
+
   ///
   /// @brief CPU time is stored if SolverOptions::enable_benchmark is true.
   ///
@@ -0,0 +1,221 @@
+#ifndef ROBOTOC_WARM_START_LIBRARY_HPP_
+#define ROBOTOC_WARM_START_LIBRARY_HPP_
+
+#include <vector>
+#include <string>
+#include <limits>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/planner/contact_sequence.hpp"
+#include "robotoc/core/solution.hpp"
+#include "robotoc/ocp/time_discretization.hpp"
+#include "robotoc/solver/ocp_solver.hpp"
+#include "robotoc/utils/binary_archive.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class WarmStartKey
+/// @brief Key of an entry of WarmStartLibrary.
+///
+struct WarmStartKey {
+  ///
+  /// @brief Default constructor.
+  ///
+  WarmStartKey() = default;
+
+  ///
+  /// @brief Constructs the key.
+  /// @param[in] gait Name of the gait, e.g., "trot".
+  /// @param[in] contact_pattern Contact pattern. See
+  /// WarmStartLibrary::contactPattern().
+  /// @param[in] command Command of the gait, e.g., the velocity command.
+  ///
+  WarmStartKey(const std::string& gait,
+               const std::vector<bool>& contact_pattern,
+               const Eigen::VectorXd& command)
+    : gait(gait),
+      contact_pattern(contact_pattern),
+      command(command) {
+  }
+
+  ///
+  /// @brief Name of the gait.
+  ///
+  std::string gait;
+
+  ///
+  /// @brief Contact pattern. The entries are only matched with the keys of
+  /// the same contact pattern.
+  ///
+  std::vector<bool> contact_pattern;
+
+  ///
+  /// @brief Command of the gait, e.g., the velocity command. The nearest
+  /// entry w.r.t. the Euclidean distance of the commands is looked up.
+  ///
+  Eigen::VectorXd command;
+};
+
+
+///
+/// @class WarmStartLibrary
+/// @brief Library of the converged solutions used to warm-start the cold
+/// initialization of OCPSolver, e.g., in MPCTrot::init() or on gait switches.
+/// The entries are indexed by WarmStartKey and are looked up by the nearest
+/// neighbour of the command among those of the same gait and contact
+/// pattern. The solution of the entry is mapped onto the current time
+/// discretization through SolutionInterpolator after aligning the first
+/// discrete events and, for floating-base robots, the planar pose (horizontal
+/// position and yaw angle) of the base.
+///
+class WarmStartLibrary {
+public:
+  ///
+  /// @brief Constructs the library.
+  /// @param[in] robot Robot model.
+  ///
+  WarmStartLibrary(const Robot& robot);
+
+  ///
+  /// @brief Default constructor.
+  ///
+  WarmStartLibrary();
+
+  ///
+  /// @brief Default destructor.
+  ///
+  ~WarmStartLibrary() = default;
+
+  ///
+  /// @brief Default copy constructor.
+  ///
+  WarmStartLibrary(const WarmStartLibrary&) = default;
+
+  ///
+  /// @brief Default copy assign operator.
+  ///
+  WarmStartLibrary& operator=(const WarmStartLibrary&) = default;
+
+  ///
+  /// @brief Default move constructor.
+  ///
+  WarmStartLibrary(WarmStartLibrary&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator.
+  ///
+  WarmStartLibrary& operator=(WarmStartLibrary&&) noexcept = default;
+
+  ///
+  /// @brief Sets the maximum distance of the commands of the matched entry.
+  /// @param[in] max_command_distance Maximum distance. Must be non-negative.
+  /// Default is infinity.
+  ///
+  void setMaxCommandDistance(const double max_command_distance);
+
+  ///
+  /// @brief Adds an entry. The entry of the same gait, contact pattern, and
+  /// command is overwritten.
+  /// @param[in] key Key of the entry.
+  /// @param[in] time_discretization Time discretization of the solution.
+  /// @param[in] s Solution. Size must be at least time_discretization.size().
+  ///
+  void add(const WarmStartKey& key,
+           const TimeDiscretization& time_discretization, const Solution& s);
+
+  ///
+  /// @brief Adds the current solution of the solver as an entry. The entry of
+  /// the same gait, contact pattern, and command is overwritten.
+  /// @param[in] key Key of the entry.
+  /// @param[in] ocp_solver OCP solver, which should be converged.
+  ///
+  void add(const WarmStartKey& key, const OCPSolver& ocp_solver);
+
+  ///
+  /// @brief Finds the nearest entry.
+  /// @param[in] key Key.
+  /// @return Index of the nearest entry. -1 if no entry is matched.
+  ///
+  int findNearest(const WarmStartKey& key) const;
+
+  ///
+  /// @brief Warm-starts the solver by the nearest entry. Discretizes the
+  /// solver at t and sets the solution by
+  /// OCPSolver::interpolateSolution(). Call OCPSolver::solve() with
+  /// init_solver=true afterwards.
+  /// @param[in] key Key.
+  /// @param[in] t Initial time of the horizon.
+  /// @param[in] q Initial configuration. Size must be Robot::dimq().
+  /// @param[in, out] ocp_solver OCP solver.
+  /// @return true if an entry is matched and false if not.
+  ///
+  bool warmStart(const WarmStartKey& key, const double t,
+                 const Eigen::VectorXd& q, OCPSolver& ocp_solver) const;
+
+  ///
+  /// @brief Gets the key of an entry.
+  /// @param[in] index Index of the entry.
+  /// @return const reference to the key.
+  ///
+  const WarmStartKey& key(const int index) const;
+
+  ///
+  /// @brief Gets the number of the entries.
+  /// @return Number of the entries.
+  ///
+  int size() const;
+
+  ///
+  /// @brief Clears all the entries.
+  ///
+  void clear();
+
+  ///
+  /// @brief Saves the entries into a binary file.
+  /// @param[in] filename Name of the file.
+  ///
+  void save(const std::string& filename) const;
+
+  ///
+  /// @brief Loads the entries saved by WarmStartLibrary::save(). The current
+  /// entries are discarded.
+  /// @param[in] filename Name of the file.
+  ///
+  void load(const std::string& filename);
+
+  ///
+  /// @brief Computes the contact pattern of the contact sequence used as
+  /// WarmStartKey::contact_pattern, that is, the concatenated contact
+  /// activities of the first and second contact phases.
+  /// @param[in] contact_sequence Contact sequence.
+  /// @return Contact pattern.
+  ///
+  static std::vector<bool> contactPattern(
+      const ContactSequence& contact_sequence);
+
+private:
+  struct Entry {
+    WarmStartKey key;
+    TimeDiscretization time_discretization;
+    Solution solution;
+  };
+
+  std::vector<Entry> entries_;
+  double max_command_distance_;
+  bool has_floating_base_;
+
+  static bool isSameClass(const WarmStartKey& key, const WarmStartKey& other);
+
+  static int findFirstEventGrid(const TimeDiscretization& time_discretization);
+
+  void alignBasePose(const Eigen::VectorXd& q0, Solution& s) const;
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_WARM_START_LIBRARY_HPP_
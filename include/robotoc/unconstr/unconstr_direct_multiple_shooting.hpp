@@ -8,6 +8,8 @@
 
 #include "robotoc/robot/robot.hpp"
 #include "robotoc/utils/aligned_vector.hpp"
+#include "robotoc/utils/thread_pool.hpp"
+#include "robotoc/utils/parallel_reduction.hpp"
 #include "robotoc/cost/cost_function.hpp"
 #include "robotoc/constraints/constraints.hpp"
 #include "robotoc/core/solution.hpp"
@@ -76,8 +78,11 @@ public:
   /// @brief Sets the number of threads of the parallel computations.
   /// @param[in] nthreads Number of the threads of the parallel computations.
   /// Must be positive. 
+  /// @param[in] enable_thread_pinning If true, the worker threads are pinned 
+  /// to the CPU cores. Default is false.
   ///
-  void setNumThreads(const int nthreads);
+  void setNumThreads(const int nthreads, 
+                     const bool enable_thread_pinning=false);
 
   ///
   /// @brief Initializes the priaml-dual interior point method for inequality 
@@ -186,12 +191,14 @@ public:
                          Direction& d, Solution& s);
 
 private:
-  int nthreads_;
+  ThreadPool thread_pool_;
   UnconstrIntermediateStage intermediate_stage_;
   UnconstrTerminalStage terminal_stage_;
   aligned_vector<UnconstrOCPData> data_;
   PerformanceIndex performance_index_; 
-  Eigen::VectorXd max_primal_step_sizes_, max_dual_step_sizes_;
+  double max_primal_step_size_, max_dual_step_size_;
+  ParallelReduction<PerformanceIndex> performance_index_sum_;
+  ParallelReduction<double> min_primal_step_size_, min_dual_step_size_;
 };
 
 } // namespace robotoc 
@@ -0,0 +1,178 @@
+#ifndef ROBOTOC_BATCHED_INVERSE_KINEMATICS_HPP_
+#define ROBOTOC_BATCHED_INVERSE_KINEMATICS_HPP_
+
+#include <vector>
+#include <string>
+
+#include "Eigen/Core"
+#include "Eigen/Cholesky"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/robot/se3.hpp"
+#include "robotoc/robot/se3_jacobian_inverse.hpp"
+#include "robotoc/utils/aligned_vector.hpp"
+#include "robotoc/utils/thread_pool.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class InverseKinematicsSettings
+/// @brief Settings for the batched inverse kinematics.
+///
+struct InverseKinematicsSettings {
+public:
+  ///
+  /// @brief Maximum number of the Gauss-Newton iterations per frame.
+  ///
+  int max_iter = 50;
+
+  ///
+  /// @brief Tolerance of the norm of the keypoint residual. The iterations
+  /// of each frame terminate if the norm is smaller than this value.
+  ///
+  double tol = 1.0e-08;
+
+  ///
+  /// @brief Damping (Levenberg-Marquardt) of the step of the joint
+  /// configuration.
+  ///
+  double damping = 1.0e-06;
+
+  ///
+  /// @brief Number of the frames of each chunk of the clip. The chunks are
+  /// solved in parallel. Must be positive.
+  ///
+  int chunk_size = 32;
+};
+
+///
+/// @class BatchedInverseKinematics
+/// @brief Batched inverse kinematics that reconstructs the whole-body
+/// configurations from the keypoint trajectories of the base and the
+/// contact frames (feet), e.g., for MPCDance. The clip is divided into 
+/// contiguous chunks of InverseKinematicsSettings::chunk_size frames. The 
+/// first frames of the chunks are first solved sequentially, each 
+/// warm-started from that of the previous chunk. The rest of the frames of 
+/// each chunk are then solved in parallel, each warm-started from the 
+/// solution of its predecessor. The results therefore do not depend on the 
+/// number of the threads.
+///
+class BatchedInverseKinematics {
+public:
+  ///
+  /// @brief Constructs the batched inverse kinematics.
+  /// @param[in] robot Robot model. Must have a floating base.
+  /// @param[in] base_frame_id Id of the frame of the base keypoint.
+  /// @param[in] nthreads Number of the threads. Must be positive. Default is 1.
+  ///
+  BatchedInverseKinematics(const Robot& robot, const int base_frame_id,
+                           const int nthreads=1);
+
+  ///
+  /// @brief Constructs the batched inverse kinematics.
+  /// @param[in] robot Robot model. Must have a floating base.
+  /// @param[in] base_frame_name Name of the frame of the base keypoint.
+  /// @param[in] nthreads Number of the threads. Must be positive. Default is 1.
+  ///
+  BatchedInverseKinematics(const Robot& robot,
+                           const std::string& base_frame_name,
+                           const int nthreads=1);
+
+  ///
+  /// @brief Default constructor.
+  ///
+  BatchedInverseKinematics();
+
+  ///
+  /// @brief Default destructor.
+  ///
+  ~BatchedInverseKinematics() = default;
+
+  ///
+  /// @brief Default copy constructor.
+  ///
+  BatchedInverseKinematics(const BatchedInverseKinematics&) = default;
+
+  ///
+  /// @brief Default copy assign operator.
+  ///
+  BatchedInverseKinematics& operator=(const BatchedInverseKinematics&) = default;
+
+  ///
+  /// @brief Default move constructor.
+  ///
+  BatchedInverseKinematics(BatchedInverseKinematics&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator.
+  ///
+  BatchedInverseKinematics& operator=(BatchedInverseKinematics&&) noexcept = default;
+
+  ///
+  /// @brief Sets the settings.
+  /// @param[in] settings Settings.
+  ///
+  void setSettings(const InverseKinematicsSettings& settings);
+
+  ///
+  /// @brief Sets the number of the threads. Throws std::runtime_error if 
+  /// the robot model is not set, i.e., if this object is default-constructed.
+  /// @param[in] nthreads Number of the threads. Must be positive.
+  ///
+  void setNumThreads(const int nthreads);
+
+  ///
+  /// @brief Solves the inverse kinematics of all the frames of the clip.
+  /// @param[in] q0 Initial guess of the configuration. Size must be
+  /// Robot::dimq().
+  /// @param[in] base_array Targets of the placement of the base frame.
+  /// @param[in] contact_position_arrays Targets of the positions of the
+  /// contact frames, i.e., contact_position_arrays[i][k] is the target of
+  /// the i-th contact frame (the order of Robot::contactFrames()) at the k-th
+  /// frame of the clip. Each array must have the same size as base_array.
+  /// @return Configurations of the frames of the clip.
+  ///
+  std::vector<Eigen::VectorXd> solve(
+      const Eigen::VectorXd& q0, const std::vector<SE3>& base_array,
+      const std::vector<std::vector<Eigen::Vector3d>>& contact_position_arrays);
+
+  ///
+  /// @brief Gets the norms of the keypoint residuals of the frames of the
+  /// clip after the last call of solve().
+  /// @return Norms of the residuals.
+  ///
+  const std::vector<double>& getErrors() const;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+private:
+  struct Workspace {
+    Eigen::MatrixXd J6, Jbase, Jbase_inv, Jc, Jc_reduced, H;
+    Eigen::VectorXd e, ec, dq, g;
+    Eigen::Matrix<double, 6, 6> Jlog6;
+    SE3JacobianInverse se3_jac_inverse;
+    Eigen::LDLT<Eigen::MatrixXd> ldlt;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  aligned_vector<Robot> robots_;
+  aligned_vector<Workspace> workspaces_;
+  ThreadPool thread_pool_;
+  InverseKinematicsSettings settings_;
+  int base_frame_id_;
+  std::vector<int> contact_frames_;
+  std::vector<double> errors_;
+
+  double solveFrame(Robot& robot, Workspace& workspace, const SE3& base_ref,
+                    const std::vector<std::vector<Eigen::Vector3d>>& contact_position_arrays,
+                    const int frame, Eigen::VectorXd& q) const;
+
+  Workspace createWorkspace(const Robot& robot) const;
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_BATCHED_INVERSE_KINEMATICS_HPP_
@@ -0,0 +1,205 @@
+#ifndef ROBOTOC_BINARY_ARCHIVE_HPP_
+#define ROBOTOC_BINARY_ARCHIVE_HPP_
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <string>
+#include <cstdint>
+#include <type_traits>
+
+#include "Eigen/Core"
+
+
+namespace robotoc {
+
+///
+/// @class BinaryOutputArchive
+/// @brief Writes data to an output stream in the compact binary format of
+/// robotoc. The archive begins with a header composed of the magic number and
+/// the format version, which is written on construction. The data is written
+/// in the native byte order without padding, e.g., Eigen matrices are stored
+/// as the number of rows and columns followed by their raw coefficients.
+///
+class BinaryOutputArchive {
+public:
+  ///
+  /// @brief Constructs the archive and writes the header.
+  /// @param[in] os Output stream. Should be opened in the binary mode. The
+  /// stream must outlive the archive.
+  ///
+  explicit BinaryOutputArchive(std::ostream& os);
+
+  ///
+  /// @brief Deleted copy constructor.
+  ///
+  BinaryOutputArchive(const BinaryOutputArchive&) = delete;
+
+  ///
+  /// @brief Deleted copy assign operator.
+  ///
+  BinaryOutputArchive& operator=(const BinaryOutputArchive&) = delete;
+
+  ///
+  /// @brief Writes a value of arithmetic or enum type. A bool is stored as
+  /// a byte and an enum as its underlying integer.
+  /// @param[in] value Value.
+  ///
+  template <typename T, typename std::enable_if<
+                            std::is_arithmetic<T>::value
+                            || std::is_enum<T>::value>::type* = nullptr>
+  void write(const T value);
+
+  ///
+  /// @brief Writes an Eigen matrix or vector.
+  /// @param[in] mat Matrix or vector.
+  ///
+  template <typename MatrixType>
+  void write(const Eigen::MatrixBase<MatrixType>& mat);
+
+  ///
+  /// @brief Writes a string.
+  /// @param[in] str String.
+  ///
+  void write(const std::string& str);
+
+  ///
+  /// @brief Writes a vector of bools.
+  /// @param[in] vec Vector.
+  ///
+  void write(const std::vector<bool>& vec);
+
+  ///
+  /// @brief Writes a vector. The elements must be writable by this archive.
+  /// @param[in] vec Vector.
+  ///
+  template <typename T, typename Allocator>
+  void write(const std::vector<T, Allocator>& vec);
+
+  ///
+  /// @brief Writes a deque. The elements must be writable by this archive.
+  /// @param[in] deq Deque.
+  ///
+  template <typename T, typename Allocator>
+  void write(const std::deque<T, Allocator>& deq);
+
+  ///
+  /// @brief Writes a size or index as a 64-bit integer.
+  /// @param[in] size Size.
+  ///
+  void writeSize(const std::int64_t size);
+
+  ///
+  /// @brief Magic number that identifies the archive.
+  ///
+  static constexpr std::uint32_t kMagicNumber = 0x524f4243;
+
+  ///
+  /// @brief Version of the format written by this archive.
+  ///
+  static constexpr std::uint32_t kVersion = 1;
+
+private:
+  std::ostream& os_;
+
+  void writeBytes(const void* data, const std::size_t size);
+
+};
+
+
+///
+/// @class BinaryInputArchive
+/// @brief Reads data written by BinaryOutputArchive from an input stream. The
+/// header is read and validated on construction. Throws std::runtime_error if
+/// the stream is not a robotoc archive, the format version is newer than
+/// this library, or the stream ends unexpectedly.
+///
+class BinaryInputArchive {
+public:
+  ///
+  /// @brief Constructs the archive and reads the header.
+  /// @param[in] is Input stream. Should be opened in the binary mode. The
+  /// stream must outlive the archive.
+  ///
+  explicit BinaryInputArchive(std::istream& is);
+
+  ///
+  /// @brief Deleted copy constructor.
+  ///
+  BinaryInputArchive(const BinaryInputArchive&) = delete;
+
+  ///
+  /// @brief Deleted copy assign operator.
+  ///
+  BinaryInputArchive& operator=(const BinaryInputArchive&) = delete;
+
+  ///
+  /// @brief Reads a value of arithmetic or enum type.
+  /// @param[out] value Value.
+  ///
+  template <typename T, typename std::enable_if<
+                            std::is_arithmetic<T>::value
+                            || std::is_enum<T>::value>::type* = nullptr>
+  void read(T& value);
+
+  ///
+  /// @brief Reads an Eigen matrix or vector. The object is resized if it is
+  /// dynamic-size. Throws std::runtime_error if the stored size is not
+  /// consistent with a fixed-size object.
+  /// @param[out] mat Matrix or vector.
+  ///
+  template <typename MatrixType>
+  void read(Eigen::PlainObjectBase<MatrixType>& mat);
+
+  ///
+  /// @brief Reads a string.
+  /// @param[out] str String.
+  ///
+  void read(std::string& str);
+
+  ///
+  /// @brief Reads a vector of bools.
+  /// @param[out] vec Vector.
+  ///
+  void read(std::vector<bool>& vec);
+
+  ///
+  /// @brief Reads a vector. The elements must be readable by this archive.
+  /// @param[out] vec Vector.
+  ///
+  template <typename T, typename Allocator>
+  void read(std::vector<T, Allocator>& vec);
+
+  ///
+  /// @brief Reads a deque. The elements must be readable by this archive.
+  /// @param[out] deq Deque.
+  ///
+  template <typename T, typename Allocator>
+  void read(std::deque<T, Allocator>& deq);
+
+  ///
+  /// @brief Reads a size or index written by BinaryOutputArchive::writeSize().
+  /// Throws std::runtime_error if the size is negative.
+  /// @return Size.
+  ///
+  std::int64_t readSize();
+
+  ///
+  /// @brief Gets the format version of the stream.
+  /// @return Format version.
+  ///
+  std::uint32_t version() const;
+
+private:
+  std::istream& is_;
+  std::uint32_t version_;
+
+  void readBytes(void* data, const std::size_t size);
+
+};
+
+} // namespace robotoc
+
+#include "robotoc/utils/binary_archive.hxx"
+
+#endif // ROBOTOC_BINARY_ARCHIVE_HPP_
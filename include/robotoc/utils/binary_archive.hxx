@@ -0,0 +1,117 @@
+#ifndef ROBOTOC_BINARY_ARCHIVE_HXX_
+#define ROBOTOC_BINARY_ARCHIVE_HXX_
+
+#include "robotoc/utils/binary_archive.hpp"
+
+#include <stdexcept>
+
+
+namespace robotoc {
+
+namespace internal {
+
+template <typename T, bool IsEnum=std::is_enum<T>::value>
+struct ArchiveStorageType {
+  using type = T;
+};
+
+template <typename T>
+struct ArchiveStorageType<T, true> {
+  using type = typename std::underlying_type<T>::type;
+};
+
+template <>
+struct ArchiveStorageType<bool, false> {
+  using type = std::uint8_t;
+};
+
+} // namespace internal
+
+
+template <typename T, typename std::enable_if<
+                          std::is_arithmetic<T>::value
+                          || std::is_enum<T>::value>::type*>
+inline void BinaryOutputArchive::write(const T value) {
+  using Storage = typename internal::ArchiveStorageType<T>::type;
+  const Storage stored = static_cast<Storage>(value);
+  writeBytes(&stored, sizeof(Storage));
+}
+
+
+template <typename MatrixType>
+inline void BinaryOutputArchive::write(
+    const Eigen::MatrixBase<MatrixType>& mat) {
+  const typename MatrixType::PlainObject plain = mat;
+  writeSize(plain.rows());
+  writeSize(plain.cols());
+  writeBytes(plain.data(),
+             sizeof(typename MatrixType::Scalar)*plain.size());
+}
+
+
+template <typename T, typename Allocator>
+inline void BinaryOutputArchive::write(const std::vector<T, Allocator>& vec) {
+  writeSize(vec.size());
+  for (const auto& e : vec) {
+    write(e);
+  }
+}
+
+
+template <typename T, typename Allocator>
+inline void BinaryOutputArchive::write(const std::deque<T, Allocator>& deq) {
+  writeSize(deq.size());
+  for (const auto& e : deq) {
+    write(e);
+  }
+}
+
+
+template <typename T, typename std::enable_if<
+                          std::is_arithmetic<T>::value
+                          || std::is_enum<T>::value>::type*>
+inline void BinaryInputArchive::read(T& value) {
+  using Storage = typename internal::ArchiveStorageType<T>::type;
+  Storage stored;
+  readBytes(&stored, sizeof(Storage));
+  value = static_cast<T>(stored);
+}
+
+
+template <typename MatrixType>
+inline void BinaryInputArchive::read(Eigen::PlainObjectBase<MatrixType>& mat) {
+  const std::int64_t rows = readSize();
+  const std::int64_t cols = readSize();
+  if ((MatrixType::RowsAtCompileTime != Eigen::Dynamic
+        && MatrixType::RowsAtCompileTime != rows)
+      || (MatrixType::ColsAtCompileTime != Eigen::Dynamic
+        && MatrixType::ColsAtCompileTime != cols)) {
+    throw std::runtime_error(
+        "[BinaryInputArchive] stored matrix size (" + std::to_string(rows)
+        + " x " + std::to_string(cols) + ") is not consistent with the fixed-size object!");
+  }
+  mat.resize(rows, cols);
+  readBytes(mat.data(), sizeof(typename MatrixType::Scalar)*mat.size());
+}
+
+
+template <typename T, typename Allocator>
+inline void BinaryInputArchive::read(std::vector<T, Allocator>& vec) {
+  vec.resize(readSize());
+  for (auto& e : vec) {
+    read(e);
+  }
+}
+
+
+template <typename T, typename Allocator>
+inline void BinaryInputArchive::read(std::deque<T, Allocator>& deq) {
+  deq.resize(readSize());
+  for (auto& e : deq) {
+    read(e);
+  }
+}
+
+} // namespace robotoc
+
+#endif // ROBOTOC_BINARY_ARCHIVE_HXX_
@@ -0,0 +1,235 @@
+#ifndef ROBOTOC_UTILS_MPC_BENCHMARKER_HPP_
+#define ROBOTOC_UTILS_MPC_BENCHMARKER_HPP_ 
+
+#include <vector>
+#include <iostream>
+#include <functional>
+
+#include "Eigen/Core"
+
+#include "robotoc/utils/penalty_contact_simulator.hpp"
+#include "robotoc/utils/mpc_recorder.hpp"
+
+
+namespace robotoc {
+namespace benchmark {
+
+///
+/// @class ClosedLoopStatistics
+/// @brief Per-tick statistics of a closed-loop MPC benchmark.
+///
+struct ClosedLoopStatistics {
+  ///
+  /// @brief Time step (control period) of the closed loop.
+  ///
+  double time_step = 0;
+
+  ///
+  /// @brief Wall-clock time of updateSolution() of each tick [ms].
+  ///
+  std::vector<double> solve_time;
+
+  ///
+  /// @brief Number of the solver iterations of each tick.
+  ///
+  std::vector<int> iter;
+
+  ///
+  /// @brief l2-norm of the KKT residual after each tick.
+  ///
+  std::vector<double> kkt_error;
+
+  ///
+  /// @brief Error between the simulated state and the state predicted by the
+  /// initial stage of the MPC solution that computed the applied control 
+  /// input, evaluated at the beginning of each tick except the first one.
+  ///
+  std::vector<double> tracking_error;
+
+  ///
+  /// @brief Reserves the statistics.
+  /// @param[in] size Number of the ticks.
+  ///
+  void reserve(const int size);
+
+  ///
+  /// @brief Clears the statistics.
+  ///
+  void clear();
+
+  ///
+  /// @brief Computes a percentile of the solve times by the nearest-rank 
+  /// method.
+  /// @param[in] p Percentile in [0, 100].
+  /// @return The percentile of the solve times [ms]. 
+  ///
+  double solveTimePercentile(const double p) const;
+
+  ///
+  /// @brief Computes the maximum solve time.
+  /// @return The maximum solve time [ms]. 
+  ///
+  double maxSolveTime() const;
+
+  ///
+  /// @brief Displays the summary of the statistics onto a ostream.
+  ///
+  void disp(std::ostream& os) const;
+
+  friend std::ostream& operator<<(std::ostream& os, 
+                                  const ClosedLoopStatistics& statistics);
+};
+
+///
+/// @brief Runs a closed-loop simulation of an MPC, e.g., MPCTrot, MPCCrawl, 
+/// MPCPace, and MPCDance, with PenaltyContactSimulator as the plant and 
+/// measures the per-tick solve latency, the number of iterations, the KKT 
+/// error, and the tracking error. The MPC must be initialized by init() 
+/// beforehand. 
+/// @param[in, out] mpc MPC. 
+/// @param[in, out] simulator Simulator. Its time step is used as the control 
+/// period.
+/// @param[in] t0 Initial time.
+/// @param[in] q0 Initial configuration.
+/// @param[in] v0 Initial generalized velocity.
+/// @param[in] simulation_time Length of the simulation.
+/// @param[in] feedback_delay If true, the control input computed at the 
+/// previous tick is applied to emulate the one-tick delay of the 
+/// computation. Default is false.
+/// @return Statistics of the closed-loop simulation.
+///
+template <typename MPCType>
+ClosedLoopStatistics ClosedLoop(MPCType& mpc, 
+                                PenaltyContactSimulator& simulator,
+                                const double t0, const Eigen::VectorXd& q0, 
+                                const Eigen::VectorXd& v0, 
+                                const double simulation_time, 
+                                const bool feedback_delay=false);
+
+
+///
+/// @class ReplayStatistics
+/// @brief Per-call statistics of the replay of a recorded input stream of 
+/// MPC. Each entry corresponds to a call of updateSolution() in the record.
+///
+struct ReplayStatistics {
+  ///
+  /// @brief Tolerance of the divergence.
+  ///
+  double tolerance = 0;
+
+  ///
+  /// @brief Wall-clock time of updateSolution() in the replay [ms].
+  ///
+  std::vector<double> solve_time;
+
+  ///
+  /// @brief Recorded wall-clock time of updateSolution() [ms].
+  ///
+  std::vector<double> recorded_solve_time;
+
+  ///
+  /// @brief Number of the solver iterations in the replay.
+  ///
+  std::vector<int> iter;
+
+  ///
+  /// @brief Recorded number of the solver iterations.
+  ///
+  std::vector<int> recorded_iter;
+
+  ///
+  /// @brief l-infinity norm of the difference between the initial control 
+  /// input of the replay and the recorded one.
+  ///
+  std::vector<double> divergence;
+
+  ///
+  /// @brief l-infinity norm of the difference between the solution of the 
+  /// initial stage (q, v, a, and the active contact forces) of the replay 
+  /// and the recorded one. Infinity if the dimensions of the contact forces
+  /// differ.
+  ///
+  std::vector<double> solution_divergence;
+
+  ///
+  /// @brief Index of the first call whose divergence of the control input or
+  /// of the solution exceeds the tolerance. -1 if no call diverges.
+  ///
+  int first_divergence = -1;
+
+  ///
+  /// @brief Index of the first call whose number of the solver iterations 
+  /// differs from the recorded one. -1 if the numbers of the iterations of
+  /// all the calls match.
+  ///
+  int first_iter_mismatch = -1;
+
+  ///
+  /// @brief Reserves the statistics.
+  /// @param[in] size Number of the calls.
+  ///
+  void reserve(const int size);
+
+  ///
+  /// @brief Clears the statistics.
+  ///
+  void clear();
+
+  ///
+  /// @brief Checks if no call diverges from the record.
+  /// @return true if the divergences of every call are within the tolerance
+  /// and the numbers of the solver iterations match the record.
+  ///
+  bool isConsistent() const;
+
+  ///
+  /// @brief Computes a percentile of the solve times by the nearest-rank 
+  /// method.
+  /// @param[in] p Percentile in [0, 100].
+  /// @param[in] recorded If true, the percentile of the recorded solve times
+  /// is computed. Default is false.
+  /// @return The percentile of the solve times [ms]. 
+  ///
+  double solveTimePercentile(const double p, const bool recorded=false) const;
+
+  ///
+  /// @brief Displays the summary of the statistics onto a ostream.
+  ///
+  void disp(std::ostream& os) const;
+
+  friend std::ostream& operator<<(std::ostream& os, 
+                                  const ReplayStatistics& statistics);
+};
+
+///
+/// @brief Replays an input stream of MPC recorded by MPCRecorder, e.g., of 
+/// MPCTrot or MPCDance, and measures the per-call solve latency, the 
+/// divergence of the control input and the solution of the initial stage 
+/// from the recorded ones, and the mismatch of the numbers of the solver 
+/// iterations. The record must initialize the 
+/// MPC before the first call of updateSolution(). The MPC must be 
+/// constructed and configured (e.g., by setGaitPattern()) in the same way as
+/// the recorded one.
+/// @param[in, out] mpc MPC. 
+/// @param[in] recorder Recorder holding the input stream, e.g., loaded by 
+/// MPCRecorder::load().
+/// @param[in] apply_command Function that applies a recorded gait or planner
+/// command to the MPC, e.g., to its foot step planner. Must not be empty if 
+/// the record contains commands. Default is empty.
+/// @param[in] tolerance Tolerance of the divergence. Must be non-negative. 
+/// Default is 1.0e-06.
+/// @return Statistics of the replay.
+///
+template <typename MPCType>
+ReplayStatistics Replay(
+    MPCType& mpc, const MPCRecorder& recorder, 
+    const std::function<void(const Eigen::VectorXd&)>& apply_command=nullptr,
+    const double tolerance=1.0e-06);
+
+} // namespace benchmark
+} // namespace robotoc 
+
+#include "robotoc/utils/mpc_benchmarker.hxx"
+
+#endif // ROBOTOC_UTILS_MPC_BENCHMARKER_HPP_
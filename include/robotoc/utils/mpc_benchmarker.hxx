@@ -0,0 +1,346 @@
+#ifndef ROBOTOC_UTILS_MPC_BENCHMARKER_HXX_
+#define ROBOTOC_UTILS_MPC_BENCHMARKER_HXX_ 
+
+#include "robotoc/utils/mpc_benchmarker.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <iomanip>
+#include <cmath>
+#include <limits>
+#include <cassert>
+#include <stdexcept>
+
+#include "robotoc/utils/timer.hpp"
+
+
+namespace robotoc {
+namespace benchmark {
+
+namespace internal {
+
+template <typename T>
+inline double mean(const std::vector<T>& vec) {
+  if (vec.empty()) return 0.0;
+  return std::accumulate(vec.begin(), vec.end(), 0.0) / vec.size();
+}
+
+
+template <typename T>
+inline double max(const std::vector<T>& vec) {
+  if (vec.empty()) return 0.0;
+  return static_cast<double>(*std::max_element(vec.begin(), vec.end()));
+}
+
+
+inline double percentile(const std::vector<double>& vec, const double p) {
+  assert(p >= 0);
+  assert(p <= 100);
+  if (vec.empty()) return 0.0;
+  std::vector<double> sorted(vec);
+  const int rank = std::max(static_cast<int>(std::ceil(0.01*p*sorted.size())), 1);
+  std::nth_element(sorted.begin(), sorted.begin()+rank-1, sorted.end());
+  return sorted[rank-1];
+}
+
+} // namespace internal
+
+
+inline void ClosedLoopStatistics::reserve(const int size) {
+  assert(size >= 0);
+  solve_time.reserve(size);
+  iter.reserve(size);
+  kkt_error.reserve(size);
+  tracking_error.reserve(size);
+}
+
+
+inline void ClosedLoopStatistics::clear() {
+  solve_time.clear();
+  iter.clear();
+  kkt_error.clear();
+  tracking_error.clear();
+}
+
+
+inline double ClosedLoopStatistics::solveTimePercentile(const double p) const {
+  return internal::percentile(solve_time, p);
+}
+
+
+inline double ClosedLoopStatistics::maxSolveTime() const {
+  if (solve_time.empty()) return 0.0;
+  return *std::max_element(solve_time.begin(), solve_time.end());
+}
+
+
+inline void ClosedLoopStatistics::disp(std::ostream& os) const {
+  using internal::mean;
+  using internal::max;
+  const int num_ticks = solve_time.size();
+  const double p99 = solveTimePercentile(99);
+  os << "---------- MPC benchmark : closed loop ----------" << "\n";
+  os << "  No. of ticks: " << num_ticks << "\n";
+  os << "  control period: " << 1.0e03 * time_step << " [ms]" << "\n";
+  os << std::fixed << std::setprecision(3);
+  os << "  solve time p50: " << solveTimePercentile(50) << " [ms]" << "\n";
+  os << "  solve time p99: " << p99 << " [ms]" << "\n";
+  os << "  solve time max: " << maxSolveTime() << " [ms]" << "\n";
+  os << "  solve time mean: " << mean(solve_time) << " [ms]" << "\n";
+  if (p99 > 0) {
+    os << "  real-time headroom (control period / p99): " 
+       << 1.0e03 * time_step / p99 << "\n";
+  }
+  os << "  iterations mean: " << mean(iter) << ", max: " << max(iter) << "\n";
+  os << std::scientific << std::setprecision(3);
+  os << "  KKT error mean: " << mean(kkt_error) << ", max: " << max(kkt_error) << "\n";
+  os << "  tracking error mean: " << mean(tracking_error) 
+     << ", max: " << max(tracking_error) << "\n";
+  os << "-------------------------------------------------" << std::endl;
+  os << std::defaultfloat;
+}
+
+
+inline std::ostream& operator<<(std::ostream& os, 
+                                const ClosedLoopStatistics& statistics) {
+  statistics.disp(os);
+  return os;
+}
+
+
+template <typename MPCType>
+inline ClosedLoopStatistics ClosedLoop(MPCType& mpc, 
+                                       PenaltyContactSimulator& simulator,
+                                       const double t0, 
+                                       const Eigen::VectorXd& q0, 
+                                       const Eigen::VectorXd& v0, 
+                                       const double simulation_time, 
+                                       const bool feedback_delay) {
+  if (simulation_time <= 0) {
+    throw std::out_of_range("[ClosedLoop] invalid argument: simulation_time must be positive!");
+  }
+  const Robot& robot = simulator.robot();
+  const double dt = simulator.timeStep();
+  const int num_ticks = std::max(static_cast<int>(std::round(simulation_time/dt)), 1);
+  ClosedLoopStatistics statistics;
+  statistics.time_step = dt;
+  statistics.reserve(num_ticks);
+  simulator.init(t0, q0, v0);
+  // State of the initial stage of the solution that computed the applied 
+  // control input, from which the state after the tick is predicted.
+  Eigen::VectorXd u(robot.dimu()), q_sol(robot.dimq()), v_sol(robot.dimv()), 
+                  a_sol(robot.dimv()), q_pred(robot.dimq()), 
+                  v_pred(robot.dimv()), qdiff(robot.dimv());
+  double t_sol = t0;
+  auto fetchControlInput = [&](const double t_solution) {
+    u = mpc.getInitialControlInput();
+    const auto& s0 = mpc.getSolution()[0];
+    q_sol = s0.q;
+    v_sol = s0.v;
+    a_sol = s0.a;
+    t_sol = t_solution;
+  };
+  Timer timer;
+  for (int k=0; k<num_ticks; ++k) {
+    const double t = simulator.t();
+    const Eigen::VectorXd& q = simulator.q();
+    const Eigen::VectorXd& v = simulator.v();
+    if (k > 0) {
+      robot.subtractConfiguration(q, q_pred, qdiff);
+      statistics.tracking_error.push_back(
+          std::sqrt(qdiff.squaredNorm() + (v-v_pred).squaredNorm()));
+    }
+    if (feedback_delay) {
+      // The solution before the update is that of the previous tick.
+      fetchControlInput((k > 0) ? t-dt : t);
+    }
+    timer.tick();
+    mpc.updateSolution(t, dt, q, v);
+    timer.tock();
+    statistics.solve_time.push_back(timer.ms());
+    statistics.iter.push_back(mpc.getSolver().getSolverStatistics().iter);
+    statistics.kkt_error.push_back(mpc.KKTError());
+    if (!feedback_delay) {
+      fetchControlInput(t);
+    }
+    const double h = t + dt - t_sol;
+    v_pred = v_sol + h * a_sol;
+    robot.integrateConfiguration(q_sol, v_sol+0.5*h*a_sol, h, q_pred);
+    simulator.step(u);
+  }
+  return statistics;
+}
+
+
+inline void ReplayStatistics::reserve(const int size) {
+  assert(size >= 0);
+  solve_time.reserve(size);
+  recorded_solve_time.reserve(size);
+  iter.reserve(size);
+  recorded_iter.reserve(size);
+  divergence.reserve(size);
+  solution_divergence.reserve(size);
+}
+
+
+inline void ReplayStatistics::clear() {
+  solve_time.clear();
+  recorded_solve_time.clear();
+  iter.clear();
+  recorded_iter.clear();
+  divergence.clear();
+  solution_divergence.clear();
+  first_divergence = -1;
+  first_iter_mismatch = -1;
+}
+
+
+inline bool ReplayStatistics::isConsistent() const {
+  return (first_divergence < 0 && first_iter_mismatch < 0);
+}
+
+
+inline double ReplayStatistics::solveTimePercentile(const double p, 
+                                                    const bool recorded) const {
+  return internal::percentile((recorded ? recorded_solve_time : solve_time), p);
+}
+
+
+inline void ReplayStatistics::disp(std::ostream& os) const {
+  using internal::mean;
+  using internal::max;
+  const int num_calls = solve_time.size();
+  const double p99 = solveTimePercentile(99);
+  const double p99_recorded = solveTimePercentile(99, true);
+  int num_diverged = 0;
+  for (int i=0; i<num_calls; ++i) {
+    if (!(divergence[i] <= tolerance && solution_divergence[i] <= tolerance)) {
+      ++num_diverged;
+    }
+  }
+  int num_iter_mismatches = 0;
+  for (int i=0; i<num_calls; ++i) {
+    if (iter[i] != recorded_iter[i]) ++num_iter_mismatches;
+  }
+  os << "---------- MPC benchmark : replay ----------" << "\n";
+  os << "  No. of calls: " << num_calls << "\n";
+  os << std::fixed << std::setprecision(3);
+  os << "  solve time p50: " << solveTimePercentile(50) << " [ms]"
+     << " (recorded: " << solveTimePercentile(50, true) << " [ms])" << "\n";
+  os << "  solve time p99: " << p99 << " [ms]"
+     << " (recorded: " << p99_recorded << " [ms])" << "\n";
+  os << "  solve time max: " << max(solve_time) << " [ms]"
+     << " (recorded: " << max(recorded_solve_time) << " [ms])" << "\n";
+  os << "  solve time mean: " << mean(solve_time) << " [ms]"
+     << " (recorded: " << mean(recorded_solve_time) << " [ms])" << "\n";
+  if (p99 > 0) {
+    os << "  speedup of p99 (recorded / replay): " << p99_recorded / p99 << "\n";
+  }
+  os << "  iterations mean: " << mean(iter) 
+     << " (recorded: " << mean(recorded_iter) << ")" << "\n";
+  os << "  No. of iteration mismatches: " << num_iter_mismatches;
+  if (first_iter_mismatch >= 0) {
+    os << " (first: " << first_iter_mismatch << ")";
+  }
+  os << "\n";
+  os << std::scientific << std::setprecision(3);
+  os << "  divergence max: " << max(divergence) 
+     << " (solution: " << max(solution_divergence) << ")"
+     << ", tolerance: " << tolerance << "\n";
+  os << "  No. of diverged calls: " << num_diverged;
+  if (first_divergence >= 0) {
+    os << " (first: " << first_divergence << ")";
+  }
+  os << "\n";
+  os << "--------------------------------------------" << std::endl;
+  os << std::defaultfloat;
+}
+
+
+inline std::ostream& operator<<(std::ostream& os, 
+                                const ReplayStatistics& statistics) {
+  statistics.disp(os);
+  return os;
+}
+
+
+template <typename MPCType>
+inline ReplayStatistics Replay(
+    MPCType& mpc, const MPCRecorder& recorder, 
+    const std::function<void(const Eigen::VectorXd&)>& apply_command,
+    const double tolerance) {
+  if (tolerance < 0) {
+    throw std::out_of_range("[Replay] invalid argument: tolerance must be non-negative!");
+  }
+  int num_calls = 0;
+  bool initialized = false;
+  for (const auto& e : recorder.records()) {
+    if (e.type == MPCRecordType::Init) {
+      initialized = true;
+    }
+    else if (e.type == MPCRecordType::UpdateSolution) {
+      if (!initialized) {
+        throw std::invalid_argument("[Replay] invalid argument: record must initialize the MPC before updateSolution()!");
+      }
+      ++num_calls;
+    }
+    else if (e.type == MPCRecordType::Command && !apply_command) {
+      throw std::invalid_argument("[Replay] invalid argument: apply_command must not be empty if the record contains commands!");
+    }
+  }
+  ReplayStatistics statistics;
+  statistics.tolerance = tolerance;
+  statistics.reserve(num_calls);
+  Timer timer;
+  for (const auto& e : recorder.records()) {
+    switch (e.type) {
+      case MPCRecordType::Init:
+        mpc.init(e.t, e.q, e.v, e.solver_options);
+        break;
+      case MPCRecordType::SolverOptions:
+        mpc.setSolverOptions(e.solver_options);
+        break;
+      case MPCRecordType::Command:
+        apply_command(e.command);
+        break;
+      case MPCRecordType::UpdateSolution: {
+        timer.tick();
+        mpc.updateSolution(e.t, e.dt, e.q, e.v);
+        timer.tock();
+        const Eigen::VectorXd& u = mpc.getInitialControlInput();
+        if (u.size() != e.u.size()) {
+          throw std::runtime_error("[Replay] recorded control input is not consistent with the MPC!");
+        }
+        const double divergence = (u.size() > 0) ? (u-e.u).lpNorm<Eigen::Infinity>() : 0.0;
+        const Eigen::VectorXd s = MPCRecorder::initialStageSolution(mpc);
+        double solution_divergence = std::numeric_limits<double>::infinity();
+        if (s.size() == e.s.size()) {
+          solution_divergence = (s.size() > 0) ? (s-e.s).lpNorm<Eigen::Infinity>() : 0.0;
+        }
+        const int call = statistics.divergence.size();
+        // Written as the negation so that a NaN is detected as a divergence.
+        if (!(divergence <= tolerance && solution_divergence <= tolerance) 
+            && statistics.first_divergence < 0) {
+          statistics.first_divergence = call;
+        }
+        const int iter = mpc.getSolver().getSolverStatistics().iter;
+        if (iter != e.iter && statistics.first_iter_mismatch < 0) {
+          statistics.first_iter_mismatch = call;
+        }
+        statistics.solve_time.push_back(timer.ms());
+        statistics.recorded_solve_time.push_back(e.solve_time);
+        statistics.iter.push_back(iter);
+        statistics.recorded_iter.push_back(e.iter);
+        statistics.divergence.push_back(divergence);
+        statistics.solution_divergence.push_back(solution_divergence);
+        break;
+      }
+    }
+  }
+  return statistics;
+}
+
+} // namespace benchmark
+} // namespace robotoc 
+
+#endif // ROBOTOC_UTILS_MPC_BENCHMARKER_HXX_
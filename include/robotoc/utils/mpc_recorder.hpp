@@ -0,0 +1,279 @@
+#ifndef ROBOTOC_UTILS_MPC_RECORDER_HPP_
+#define ROBOTOC_UTILS_MPC_RECORDER_HPP_
+
+#include <vector>
+#include <string>
+
+#include "Eigen/Core"
+
+#include "robotoc/solver/solver_options.hpp"
+#include "robotoc/utils/binary_archive.hpp"
+
+
+namespace robotoc {
+
+///
+/// @enum MPCRecordType
+/// @brief Type of a record of the input stream of MPC.
+///
+enum class MPCRecordType {
+  Init,
+  SolverOptions,
+  Command,
+  UpdateSolution,
+};
+
+///
+/// @class MPCRecord
+/// @brief A record of the input stream of MPC. Only the members related to
+/// the type of the record are used.
+///
+struct MPCRecord {
+  ///
+  /// @brief Type of the record.
+  ///
+  MPCRecordType type = MPCRecordType::UpdateSolution;
+
+  ///
+  /// @brief Initial time (MPCRecordType::Init, MPCRecordType::UpdateSolution).
+  ///
+  double t = 0;
+
+  ///
+  /// @brief Sampling time (MPCRecordType::UpdateSolution).
+  ///
+  double dt = 0;
+
+  ///
+  /// @brief Configuration (MPCRecordType::Init,
+  /// MPCRecordType::UpdateSolution).
+  ///
+  Eigen::VectorXd q;
+
+  ///
+  /// @brief Generalized velocity (MPCRecordType::Init,
+  /// MPCRecordType::UpdateSolution).
+  ///
+  Eigen::VectorXd v;
+
+  ///
+  /// @brief Gait or planner command (MPCRecordType::Command), e.g., the step
+  /// length and the step yaw of the foot step planner. The meaning is
+  /// defined by the application.
+  ///
+  Eigen::VectorXd command;
+
+  ///
+  /// @brief Solver options (MPCRecordType::Init,
+  /// MPCRecordType::SolverOptions).
+  ///
+  SolverOptions solver_options;
+
+  ///
+  /// @brief Recorded initial control input after the call
+  /// (MPCRecordType::Init, MPCRecordType::UpdateSolution).
+  ///
+  Eigen::VectorXd u;
+
+  ///
+  /// @brief Recorded solution of the initial stage after the call, i.e., the
+  /// stack of the configuration, the generalized velocity, the generalized 
+  /// acceleration, and the active contact forces (MPCRecordType::Init, 
+  /// MPCRecordType::UpdateSolution). See MPCRecorder::initialStageSolution().
+  ///
+  Eigen::VectorXd s;
+
+  ///
+  /// @brief Recorded KKT error after the call (MPCRecordType::Init,
+  /// MPCRecordType::UpdateSolution).
+  ///
+  double kkt_error = 0;
+
+  ///
+  /// @brief Recorded wall-clock time of the call [ms] (MPCRecordType::Init,
+  /// MPCRecordType::UpdateSolution).
+  ///
+  double solve_time = 0;
+
+  ///
+  /// @brief Recorded number of the solver iterations of the call
+  /// (MPCRecordType::Init, MPCRecordType::UpdateSolution).
+  ///
+  int iter = 0;
+
+  ///
+  /// @brief Saves the record to a binary archive. Only the members related
+  /// to the type are stored.
+  /// @param[in] ar Output archive.
+  ///
+  void save(BinaryOutputArchive& ar) const;
+
+  ///
+  /// @brief Loads the record from a binary archive.
+  /// @param[in] ar Input archive.
+  ///
+  void load(BinaryInputArchive& ar);
+};
+
+
+///
+/// @class MPCRecorder
+/// @brief Records the input stream of MPC, i.e., the initialization, the
+/// solver options, the gait or planner commands, and the calls of
+/// updateSolution(), together with the outputs and the wall-clock times of
+/// the calls, so that the stream can be saved to a compact binary log and
+/// replayed deterministically by benchmark::Replay(). The MPC classes, e.g.,
+/// MPCTrot and MPCDance, are not modified: the calls are made through the
+/// recorder.
+///
+class MPCRecorder {
+public:
+  ///
+  /// @brief Default constructor.
+  ///
+  MPCRecorder();
+
+  ///
+  /// @brief Default destructor.
+  ///
+  ~MPCRecorder() = default;
+
+  ///
+  /// @brief Default copy constructor.
+  ///
+  MPCRecorder(const MPCRecorder&) = default;
+
+  ///
+  /// @brief Default copy assign operator.
+  ///
+  MPCRecorder& operator=(const MPCRecorder&) = default;
+
+  ///
+  /// @brief Default move constructor.
+  ///
+  MPCRecorder(MPCRecorder&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator.
+  ///
+  MPCRecorder& operator=(MPCRecorder&&) noexcept = default;
+
+  ///
+  /// @brief Initializes the MPC by MPCType::init(t, q, v, solver_options)
+  /// and records the call.
+  /// @param[in, out] mpc MPC, e.g., MPCTrot.
+  /// @param[in] t Initial time.
+  /// @param[in] q Initial configuration.
+  /// @param[in] v Initial generalized velocity.
+  /// @param[in] solver_options Solver options for the initialization.
+  ///
+  template <typename MPCType>
+  void init(MPCType& mpc, const double t, const Eigen::VectorXd& q,
+            const Eigen::VectorXd& v, const SolverOptions& solver_options);
+
+  ///
+  /// @brief Sets the solver options of the MPC and records the call.
+  /// @param[in, out] mpc MPC, e.g., MPCTrot.
+  /// @param[in] solver_options Solver options.
+  ///
+  template <typename MPCType>
+  void setSolverOptions(MPCType& mpc, const SolverOptions& solver_options);
+
+  ///
+  /// @brief Records a gait or planner command. The command must be applied
+  /// to the MPC (e.g., to its foot step planner) by the caller, and is
+  /// applied again in the replay by the command function passed to
+  /// benchmark::Replay().
+  /// @param[in] command Command.
+  ///
+  void recordCommand(const Eigen::VectorXd& command);
+
+  ///
+  /// @brief Updates the solution of the MPC by
+  /// MPCType::updateSolution(t, dt, q, v) and records the call.
+  /// @param[in, out] mpc MPC, e.g., MPCTrot.
+  /// @param[in] t Initial time.
+  /// @param[in] dt Sampling time of MPC. Must be positive.
+  /// @param[in] q Configuration.
+  /// @param[in] v Generalized velocity.
+  ///
+  template <typename MPCType>
+  void updateSolution(MPCType& mpc, const double t, const double dt,
+                      const Eigen::VectorXd& q, const Eigen::VectorXd& v);
+
+  ///
+  /// @brief Stacks the solution of the initial stage of the MPC, i.e., q, v,
+  /// a, and the active contact forces of MPCType::getSolver().getSolution(0).
+  /// @param[in] mpc MPC, e.g., MPCTrot.
+  /// @return The stacked solution.
+  ///
+  template <typename MPCType>
+  static Eigen::VectorXd initialStageSolution(const MPCType& mpc);
+
+  ///
+  /// @brief Gets the records.
+  /// @return const reference to the records in the order of the calls.
+  ///
+  const std::vector<MPCRecord>& records() const {
+    return records_;
+  }
+
+  ///
+  /// @brief Gets the number of the records.
+  /// @return Number of the records.
+  ///
+  int size() const {
+    return records_.size();
+  }
+
+  ///
+  /// @brief Reserves the records.
+  /// @param[in] size Number of the records.
+  ///
+  void reserve(const int size);
+
+  ///
+  /// @brief Clears the records.
+  ///
+  void clear();
+
+  ///
+  /// @brief Saves the records to a binary log. Throws std::runtime_error if
+  /// the file cannot be opened.
+  /// @param[in] filename Name of the log file.
+  ///
+  void save(const std::string& filename) const;
+
+  ///
+  /// @brief Loads the records from a binary log written by save(). The
+  /// current records are replaced. Throws std::runtime_error if the file
+  /// cannot be opened or is not a log of MPCRecorder.
+  /// @param[in] filename Name of the log file.
+  ///
+  void load(const std::string& filename);
+
+  ///
+  /// @brief Saves the records to a binary archive.
+  /// @param[in] ar Output archive.
+  ///
+  void save(BinaryOutputArchive& ar) const;
+
+  ///
+  /// @brief Loads the records from a binary archive.
+  /// @param[in] ar Input archive.
+  ///
+  void load(BinaryInputArchive& ar);
+
+private:
+  std::vector<MPCRecord> records_;
+
+  template <typename MPCType>
+  static void recordOutputs(const MPCType& mpc, MPCRecord& record);
+
+};
+
+} // namespace robotoc
+
+#include "robotoc/utils/mpc_recorder.hxx"
+
+#endif // ROBOTOC_UTILS_MPC_RECORDER_HPP_
@@ -0,0 +1,89 @@
+#ifndef ROBOTOC_UTILS_MPC_RECORDER_HXX_
+#define ROBOTOC_UTILS_MPC_RECORDER_HXX_
+
+#include "robotoc/utils/mpc_recorder.hpp"
+
+#include "robotoc/utils/timer.hpp"
+
+
+namespace robotoc {
+
+template <typename MPCType>
+inline void MPCRecorder::init(MPCType& mpc, const double t,
+                              const Eigen::VectorXd& q,
+                              const Eigen::VectorXd& v,
+                              const SolverOptions& solver_options) {
+  MPCRecord record;
+  record.type = MPCRecordType::Init;
+  record.t = t;
+  record.q = q;
+  record.v = v;
+  record.solver_options = solver_options;
+  Timer timer;
+  timer.tick();
+  mpc.init(t, q, v, solver_options);
+  timer.tock();
+  record.solve_time = timer.ms();
+  recordOutputs(mpc, record);
+  records_.push_back(std::move(record));
+}
+
+
+template <typename MPCType>
+inline void MPCRecorder::setSolverOptions(MPCType& mpc,
+                                          const SolverOptions& solver_options) {
+  MPCRecord record;
+  record.type = MPCRecordType::SolverOptions;
+  record.solver_options = solver_options;
+  mpc.setSolverOptions(solver_options);
+  records_.push_back(std::move(record));
+}
+
+
+template <typename MPCType>
+inline void MPCRecorder::updateSolution(MPCType& mpc, const double t,
+                                        const double dt,
+                                        const Eigen::VectorXd& q,
+                                        const Eigen::VectorXd& v) {
+  MPCRecord record;
+  record.type = MPCRecordType::UpdateSolution;
+  record.t = t;
+  record.dt = dt;
+  record.q = q;
+  record.v = v;
+  Timer timer;
+  timer.tick();
+  mpc.updateSolution(t, dt, q, v);
+  timer.tock();
+  record.solve_time = timer.ms();
+  recordOutputs(mpc, record);
+  records_.push_back(std::move(record));
+}
+
+
+template <typename MPCType>
+inline Eigen::VectorXd MPCRecorder::initialStageSolution(const MPCType& mpc) {
+  const auto& s = mpc.getSolver().getSolution(0);
+  const int dimq = s.q.size();
+  const int dimv = s.v.size();
+  const int dimf = s.dimf();
+  Eigen::VectorXd stack(dimq+2*dimv+dimf);
+  stack.head(dimq) = s.q;
+  stack.segment(dimq, dimv) = s.v;
+  stack.segment(dimq+dimv, dimv) = s.a;
+  stack.tail(dimf) = s.f_stack();
+  return stack;
+}
+
+
+template <typename MPCType>
+inline void MPCRecorder::recordOutputs(const MPCType& mpc, MPCRecord& record) {
+  record.u = mpc.getInitialControlInput();
+  record.s = initialStageSolution(mpc);
+  record.kkt_error = mpc.KKTError();
+  record.iter = mpc.getSolver().getSolverStatistics().iter;
+}
+
+} // namespace robotoc
+
+#endif // ROBOTOC_UTILS_MPC_RECORDER_HXX_
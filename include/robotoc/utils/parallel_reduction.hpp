@@ -0,0 +1,124 @@
+#ifndef ROBOTOC_PARALLEL_REDUCTION_HPP_
+#define ROBOTOC_PARALLEL_REDUCTION_HPP_
+
+#include <vector>
+#include <cstddef>
+
+#include "Eigen/StdVector"
+
+
+namespace robotoc {
+
+///
+/// @class ParallelReduction
+/// @brief Per-thread accumulators of a reduction over the stage-wise parallel
+/// computations, e.g., ThreadPool::parallelFor(). Each thread only updates
+/// its own accumulator through local() and the accumulators are combined
+/// once by reduce() after the parallel loop. The accumulators are separated
+/// by at least a cache line so that the threads do not share cache lines
+/// (false sharing) nor bits of a packed container (data race).
+/// @tparam T Type of the accumulator.
+///
+template <typename T>
+class ParallelReduction {
+public:
+  ///
+  /// @brief Size of a cache line in bytes assumed in the padding.
+  ///
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  ///
+  /// @brief Constructs the accumulators.
+  /// @param[in] nthreads Number of the threads. Must be non-negative.
+  /// @param[in] identity Identity element of the reduction, to which the
+  /// accumulators are initialized. Default is T().
+  ///
+  ParallelReduction(const int nthreads, const T& identity=T());
+
+  ///
+  /// @brief Default constructor. Constructs the accumulator of a single
+  /// thread.
+  ///
+  ParallelReduction();
+
+  ///
+  /// @brief Default destructor.
+  ///
+  ~ParallelReduction() = default;
+
+  ///
+  /// @brief Default copy constructor.
+  ///
+  ParallelReduction(const ParallelReduction&) = default;
+
+  ///
+  /// @brief Default copy assign operator.
+  ///
+  ParallelReduction& operator=(const ParallelReduction&) = default;
+
+  ///
+  /// @brief Default move constructor.
+  ///
+  ParallelReduction(ParallelReduction&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator.
+  ///
+  ParallelReduction& operator=(ParallelReduction&&) noexcept = default;
+
+  ///
+  /// @brief Sets the number of the threads.
+  /// @param[in] nthreads Number of the threads. Must be non-negative.
+  ///
+  void setNumThreads(const int nthreads);
+
+  ///
+  /// @brief Gets the number of the threads.
+  /// @return Number of the threads.
+  ///
+  int nthreads() const;
+
+  ///
+  /// @brief Resets all the accumulators. Call this before the parallel loop.
+  /// @param[in] identity Identity element of the reduction.
+  ///
+  void reset(const T& identity);
+
+  ///
+  /// @brief Gets the accumulator of a thread. Only the thread of thread_id
+  /// may access this in the parallel loop.
+  /// @param[in] thread_id Thread index in [0, nthreads()).
+  /// @return Reference to the accumulator.
+  ///
+  T& local(const int thread_id);
+
+  ///
+  /// @brief const version of ParallelReduction::local().
+  ///
+  const T& local(const int thread_id) const;
+
+  ///
+  /// @brief Combines the accumulators in the order of the thread index.
+  /// Call this after the parallel loop.
+  /// @param[in] init Initial value of the reduction.
+  /// @param[in] op Binary operation called as op(const T&, const T&).
+  /// @return Result of the reduction.
+  ///
+  template <typename BinaryOperation>
+  T reduce(const T& init, const BinaryOperation& op) const;
+
+private:
+  struct Slot {
+    T value;
+    char padding[kCacheLineSize];
+  };
+
+  std::vector<Slot, Eigen::aligned_allocator<Slot>> slots_;
+
+};
+
+} // namespace robotoc
+
+#include "robotoc/utils/parallel_reduction.hxx"
+
+#endif // ROBOTOC_PARALLEL_REDUCTION_HPP_
@@ -0,0 +1,86 @@
+#ifndef ROBOTOC_PARALLEL_REDUCTION_HXX_
+#define ROBOTOC_PARALLEL_REDUCTION_HXX_
+
+#include "robotoc/utils/parallel_reduction.hpp"
+
+#include <stdexcept>
+#include <cassert>
+
+
+namespace robotoc {
+
+template <typename T>
+constexpr std::size_t ParallelReduction<T>::kCacheLineSize;
+
+
+template <typename T>
+inline ParallelReduction<T>::ParallelReduction(const int nthreads,
+                                               const T& identity)
+  : slots_() {
+  if (nthreads < 0) {
+    throw std::out_of_range("[ParallelReduction] invalid argument: nthreads must be non-negative!");
+  }
+  slots_.resize(nthreads);
+  reset(identity);
+}
+
+
+template <typename T>
+inline ParallelReduction<T>::ParallelReduction()
+  : slots_(1) {
+}
+
+
+template <typename T>
+inline void ParallelReduction<T>::setNumThreads(const int nthreads) {
+  if (nthreads < 0) {
+    throw std::out_of_range("[ParallelReduction] invalid argument: nthreads must be non-negative!");
+  }
+  slots_.resize(nthreads);
+}
+
+
+template <typename T>
+inline int ParallelReduction<T>::nthreads() const {
+  return slots_.size();
+}
+
+
+template <typename T>
+inline void ParallelReduction<T>::reset(const T& identity) {
+  for (auto& e : slots_) {
+    e.value = identity;
+  }
+}
+
+
+template <typename T>
+inline T& ParallelReduction<T>::local(const int thread_id) {
+  assert(thread_id >= 0);
+  assert(thread_id < nthreads());
+  return slots_[thread_id].value;
+}
+
+
+template <typename T>
+inline const T& ParallelReduction<T>::local(const int thread_id) const {
+  assert(thread_id >= 0);
+  assert(thread_id < nthreads());
+  return slots_[thread_id].value;
+}
+
+
+template <typename T>
+template <typename BinaryOperation>
+inline T ParallelReduction<T>::reduce(const T& init,
+                                      const BinaryOperation& op) const {
+  T result = init;
+  for (const auto& e : slots_) {
+    result = op(result, e.value);
+  }
+  return result;
+}
+
+} // namespace robotoc
+
+#endif // ROBOTOC_PARALLEL_REDUCTION_HXX_
@@ -0,0 +1,179 @@
+#ifndef ROBOTOC_UTILS_PENALTY_CONTACT_SIMULATOR_HPP_
+#define ROBOTOC_UTILS_PENALTY_CONTACT_SIMULATOR_HPP_
+
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/robot/contact_status.hpp"
+
+
+namespace robotoc {
+
+///
+/// @class PenaltyContactSimulator
+/// @brief A lightweight simulator of a legged robot on a flat ground used as
+/// the plant of the closed-loop benchmarks of MPC. The forward dynamics is
+/// computed by the articulated body algorithm (ABA) and integrated by the
+/// semi-implicit Euler method with substeps. Each contact frame of the robot
+/// model interacts with the ground by a compliant penalty contact, i.e., a
+/// spring-damper in the normal direction and a viscous friction bounded by
+/// the friction cone. The surface contacts additionally receive a rotational
+/// spring-damper about the horizontal axes while penetrating the ground.
+///
+class PenaltyContactSimulator {
+public:
+  using Vector6d = Eigen::Matrix<double, 6, 1>;
+
+  ///
+  /// @brief Constructs the simulator.
+  /// @param[in] robot Robot model.
+  /// @param[in] time_step Time step of the simulation, i.e., the control
+  /// period. Must be positive.
+  /// @param[in] num_substeps Number of the integration substeps per time step.
+  /// Must be positive. Default is 10.
+  ///
+  PenaltyContactSimulator(const Robot& robot, const double time_step,
+                          const int num_substeps=10);
+
+  ///
+  /// @brief Default constructor.
+  ///
+  PenaltyContactSimulator();
+
+  ///
+  /// @brief Default destructor.
+  ///
+  ~PenaltyContactSimulator() = default;
+
+  ///
+  /// @brief Default copy constructor.
+  ///
+  PenaltyContactSimulator(const PenaltyContactSimulator&) = default;
+
+  ///
+  /// @brief Default copy assign operator.
+  ///
+  PenaltyContactSimulator& operator=(const PenaltyContactSimulator&) = default;
+
+  ///
+  /// @brief Default move constructor.
+  ///
+  PenaltyContactSimulator(PenaltyContactSimulator&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator.
+  ///
+  PenaltyContactSimulator& operator=(PenaltyContactSimulator&&) noexcept = default;
+
+  ///
+  /// @brief Sets the parameters of the penalty contacts.
+  /// @param[in] stiffness Normal stiffness [N/m]. Must be positive.
+  /// @param[in] damping Normal damping [Ns/m]. Must be non-negative.
+  /// @param[in] friction_damping Tangential viscous damping [Ns/m]. Must be
+  /// positive.
+  /// @param[in] friction_coefficient Friction coefficient. Must be positive.
+  ///
+  void setContactParameters(const double stiffness, const double damping,
+                            const double friction_damping,
+                            const double friction_coefficient);
+
+  ///
+  /// @brief Sets the parameters of the rotational spring-damper of the
+  /// surface contacts.
+  /// @param[in] stiffness Rotational stiffness [Nm/rad]. Must be non-negative.
+  /// @param[in] damping Rotational damping [Nms/rad]. Must be non-negative.
+  ///
+  void setRotationalContactParameters(const double stiffness,
+                                      const double damping);
+
+  ///
+  /// @brief Sets the height of the flat ground. Default is 0.
+  /// @param[in] ground_height Height of the ground.
+  ///
+  void setGroundHeight(const double ground_height);
+
+  ///
+  /// @brief Initializes the simulation.
+  /// @param[in] t Initial time.
+  /// @param[in] q Initial configuration. Size must be Robot::dimq().
+  /// @param[in] v Initial generalized velocity. Size must be Robot::dimv().
+  ///
+  void init(const double t, const Eigen::VectorXd& q, const Eigen::VectorXd& v);
+
+  ///
+  /// @brief Advances the simulation by a time step with the control input
+  /// held constant.
+  /// @param[in] u Control input torques. Size must be Robot::dimu().
+  ///
+  void step(const Eigen::VectorXd& u);
+
+  ///
+  /// @brief Gets the current time.
+  /// @return The current time.
+  ///
+  double t() const {
+    return t_;
+  }
+
+  ///
+  /// @brief Gets the current configuration.
+  /// @return const reference to the current configuration.
+  ///
+  const Eigen::VectorXd& q() const {
+    return q_;
+  }
+
+  ///
+  /// @brief Gets the current generalized velocity.
+  /// @return const reference to the current generalized velocity.
+  ///
+  const Eigen::VectorXd& v() const {
+    return v_;
+  }
+
+  ///
+  /// @brief Gets the contact forces (or wrenches for the surface contacts)
+  /// of the last substep expressed in the local coordinates of the contact
+  /// frames.
+  /// @return const reference to the contact forces.
+  ///
+  const std::vector<Vector6d>& contactForces() const {
+    return f_;
+  }
+
+  ///
+  /// @brief Gets the time step.
+  /// @return The time step.
+  ///
+  double timeStep() const {
+    return time_step_;
+  }
+
+  ///
+  /// @brief Gets the robot model.
+  /// @return const reference to the robot model.
+  ///
+  const Robot& robot() const {
+    return robot_;
+  }
+
+private:
+  Robot robot_;
+  ContactStatus contact_status_;
+  std::vector<int> contact_frames_;
+  std::vector<Vector6d> f_;
+  Eigen::VectorXd q_, v_, a_, tau_;
+  double t_, time_step_, substep_length_, stiffness_, damping_, friction_damping_,
+         friction_coefficient_, rotational_stiffness_, rotational_damping_,
+         ground_height_;
+  int num_substeps_;
+
+  void computeContactForces();
+
+};
+
+} // namespace robotoc
+
+#endif // ROBOTOC_UTILS_PENALTY_CONTACT_SIMULATOR_HPP_
@@ -0,0 +1,211 @@
+#ifndef ROBOTOC_RING_BUFFER_HPP_
+#define ROBOTOC_RING_BUFFER_HPP_
+
+#include <vector>
+#include <iterator>
+#include <cstddef>
+
+#include "Eigen/StdVector"
+
+
+namespace robotoc {
+
+///
+/// @class RingBuffer
+/// @brief Double-ended queue on a contiguous circular storage. The elements 
+/// are kept constructed in the storage and are overwritten by copy assignment
+/// in push_back(). Therefore, push_back(), pop_back(), and pop_front() do not 
+/// allocate memory unless the size exceeds the capacity, in which case the 
+/// capacity is doubled.
+/// @tparam T Type of the element.
+///
+template <typename T>
+class RingBuffer {
+private:
+  using Storage = std::vector<T, Eigen::aligned_allocator<T>>;
+
+  template <typename BufferType, typename ReferenceType>
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = ReferenceType;
+
+    Iterator(BufferType* buffer, const int index) 
+      : buffer_(buffer), index_(index) {}
+
+    reference operator*() const { return (*buffer_)[index_]; }
+
+    Iterator& operator++() { ++index_; return *this; }
+
+    Iterator operator++(int) { Iterator tmp = *this; ++index_; return tmp; }
+
+    bool operator==(const Iterator& other) const { 
+      return (buffer_ == other.buffer_ && index_ == other.index_); 
+    }
+
+    bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+  private:
+    BufferType* buffer_;
+    int index_;
+  };
+
+public:
+  using value_type = T;
+  using reference = typename Storage::reference;
+  using const_reference = typename Storage::const_reference;
+  using iterator = Iterator<RingBuffer, reference>;
+  using const_iterator = Iterator<const RingBuffer, const_reference>;
+
+  ///
+  /// @brief Constructs the buffer.
+  /// @param[in] capacity Capacity of the buffer. Must be non-negative.
+  /// @param[in] value Value with which the storage is filled, e.g., to 
+  /// allocate the memory of the elements in advance. Default is T().
+  ///
+  RingBuffer(const int capacity, const T& value=T());
+
+  ///
+  /// @brief Default constructor. 
+  ///
+  RingBuffer();
+
+  ///
+  /// @brief Default destructor. 
+  ///
+  ~RingBuffer() = default;
+
+  ///
+  /// @brief Default copy constructor. 
+  ///
+  RingBuffer(const RingBuffer&) = default;
+
+  ///
+  /// @brief Default copy assign operator. 
+  ///
+  RingBuffer& operator=(const RingBuffer&) = default;
+
+  ///
+  /// @brief Default move constructor. 
+  ///
+  RingBuffer(RingBuffer&&) noexcept = default;
+
+  ///
+  /// @brief Default move assign operator. 
+  ///
+  RingBuffer& operator=(RingBuffer&&) noexcept = default;
+
+  ///
+  /// @return Number of the elements.
+  ///
+  int size() const { return size_; }
+
+  ///
+  /// @return true if there is no element and false if not.
+  ///
+  bool empty() const { return (size_ == 0); }
+
+  ///
+  /// @return Capacity of the buffer.
+  ///
+  int capacity() const { return data_.size(); }
+
+  ///
+  /// @brief Increases the capacity. Does nothing if capacity is not larger 
+  /// than the current capacity.
+  /// @param[in] capacity New capacity.
+  /// @param[in] value Value with which the new storage is filled. Default is 
+  /// T().
+  ///
+  void reserve(const int capacity, const T& value=T());
+
+  ///
+  /// @brief Removes all the elements. The capacity is not changed.
+  ///
+  void clear();
+
+  ///
+  /// @brief Appends an element at the back.
+  /// @param[in] value Element.
+  ///
+  void push_back(const T& value);
+
+  ///
+  /// @brief Removes the last element. 
+  ///
+  void pop_back();
+
+  ///
+  /// @brief Removes the first element. 
+  ///
+  void pop_front();
+
+  ///
+  /// @brief Accesses the element.
+  /// @param[in] index Index of the element. Must be non-negative and less 
+  /// than size().
+  ///
+  reference operator[](const int index);
+
+  ///
+  /// @brief Accesses the element.
+  /// @param[in] index Index of the element. Must be non-negative and less 
+  /// than size().
+  ///
+  const_reference operator[](const int index) const;
+
+  ///
+  /// @return The first element.
+  ///
+  reference front() { return (*this)[0]; }
+
+  ///
+  /// @return The first element.
+  ///
+  const_reference front() const { return (*this)[0]; }
+
+  ///
+  /// @return The last element.
+  ///
+  reference back() { return (*this)[size_-1]; }
+
+  ///
+  /// @return The last element.
+  ///
+  const_reference back() const { return (*this)[size_-1]; }
+
+  iterator begin() { return iterator(this, 0); }
+
+  iterator end() { return iterator(this, size_); }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+
+  const_iterator end() const { return const_iterator(this, size_); }
+
+  ///
+  /// @brief Copies the elements into std::vector.
+  /// @return std::vector of the elements.
+  ///
+  std::vector<T> toVector() const {
+    return std::vector<T>(begin(), end());
+  }
+
+private:
+  Storage data_;
+  int head_, size_;
+
+  int storageIndex(const int index) const {
+    const int i = head_ + index;
+    return (i < capacity()) ? i : (i - capacity());
+  }
+
+};
+
+} // namespace robotoc
+
+#include "robotoc/utils/ring_buffer.hxx"
+
+#endif // ROBOTOC_RING_BUFFER_HPP_
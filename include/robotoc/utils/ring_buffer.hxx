@@ -0,0 +1,105 @@
+#ifndef ROBOTOC_RING_BUFFER_HXX_
+#define ROBOTOC_RING_BUFFER_HXX_
+
+#include "robotoc/utils/ring_buffer.hpp"
+
+#include <stdexcept>
+#include <utility>
+#include <algorithm>
+#include <cassert>
+
+
+namespace robotoc {
+
+template <typename T>
+inline RingBuffer<T>::RingBuffer(const int capacity, const T& value)
+  : data_(),
+    head_(0),
+    size_(0) {
+  if (capacity < 0) {
+    throw std::out_of_range("[RingBuffer] invalid argument: capacity must be non-negative!");
+  }
+  data_.resize(capacity, value);
+}
+
+
+template <typename T>
+inline RingBuffer<T>::RingBuffer()
+  : data_(),
+    head_(0),
+    size_(0) {
+}
+
+
+template <typename T>
+inline void RingBuffer<T>::reserve(const int capacity, const T& value) {
+  if (capacity <= this->capacity()) return;
+  Storage data(capacity, value);
+  for (int i=0; i<size_; ++i) {
+    data[i] = std::move(data_[storageIndex(i)]);
+  }
+  data_.swap(data);
+  head_ = 0;
+}
+
+
+template <typename T>
+inline void RingBuffer<T>::clear() {
+  head_ = 0;
+  size_ = 0;
+}
+
+
+template <typename T>
+inline void RingBuffer<T>::push_back(const T& value) {
+  if (size_ == capacity()) {
+    // Copies the value beforehand because it may refer to an element.
+    const T copy(value);
+    reserve(std::max(2*capacity(), 1), copy);
+    data_[storageIndex(size_)] = copy;
+  }
+  else {
+    data_[storageIndex(size_)] = value;
+  }
+  ++size_;
+}
+
+
+template <typename T>
+inline void RingBuffer<T>::pop_back() {
+  assert(size_ > 0);
+  --size_;
+}
+
+
+template <typename T>
+inline void RingBuffer<T>::pop_front() {
+  assert(size_ > 0);
+  head_ = storageIndex(1);
+  --size_;
+  if (size_ == 0) {
+    head_ = 0;
+  }
+}
+
+
+template <typename T>
+inline typename RingBuffer<T>::reference RingBuffer<T>::operator[](
+    const int index) {
+  assert(index >= 0);
+  assert(index < size_);
+  return data_[storageIndex(index)];
+}
+
+
+template <typename T>
+inline typename RingBuffer<T>::const_reference RingBuffer<T>::operator[](
+    const int index) const {
+  assert(index >= 0);
+  assert(index < size_);
+  return data_[storageIndex(index)];
+}
+
+} // namespace robotoc
+
+#endif // ROBOTOC_RING_BUFFER_HXX_
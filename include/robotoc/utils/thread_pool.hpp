@@ -0,0 +1,135 @@
+#ifndef ROBOTOC_THREAD_POOL_HPP_
+#define ROBOTOC_THREAD_POOL_HPP_
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <cstdint>
+
+
+namespace robotoc {
+
+///
+/// @class ThreadPool
+/// @brief Persistent pool of worker threads for the stage-wise parallel
+/// computations. The workers are kept alive over the calls and wait for jobs
+/// by spinning for a while and then parking on a condition variable. The
+/// calling thread works as the thread of index 0. The iterations of
+/// parallelFor() are statically partitioned into contiguous chunks so that
+/// each stage is always processed by the same thread as long as the number
+/// of stages is unchanged.
+///
+class ThreadPool {
+public:
+  ///
+  /// @brief Constructs the thread pool.
+  /// @param[in] nthreads Number of the threads including the calling thread.
+  /// Must be positive.
+  /// @param[in] enable_thread_pinning If true, the i-th worker thread is
+  /// pinned to the i-th CPU core (only supported in Linux). Default is false.
+  ///
+  ThreadPool(const int nthreads, const bool enable_thread_pinning=false);
+
+  ///
+  /// @brief Default constructor. Constructs a pool with a single thread.
+  ///
+  ThreadPool();
+
+  ///
+  /// @brief Destructor. Joins the worker threads.
+  ///
+  ~ThreadPool();
+
+  ///
+  /// @brief Copy constructor. Spawns its own worker threads with the same
+  /// settings as other.
+  ///
+  ThreadPool(const ThreadPool& other);
+
+  ///
+  /// @brief Copy assign operator. Spawns its own worker threads with the same
+  /// settings as other.
+  ///
+  ThreadPool& operator=(const ThreadPool& other);
+
+  ///
+  /// @brief Move constructor.
+  ///
+  ThreadPool(ThreadPool&& other) noexcept;
+
+  ///
+  /// @brief Move assign operator.
+  ///
+  ThreadPool& operator=(ThreadPool&& other) noexcept;
+
+  ///
+  /// @brief Sets the number of the threads. Re-spawns the workers if the
+  /// settings are changed.
+  /// @param[in] nthreads Number of the threads including the calling thread.
+  /// Must be positive.
+  /// @param[in] enable_thread_pinning If true, the worker threads are pinned
+  /// to the CPU cores. Default is false.
+  ///
+  void setNumThreads(const int nthreads,
+                     const bool enable_thread_pinning=false);
+
+  ///
+  /// @brief Gets the number of the threads including the calling thread.
+  /// @return Number of the threads.
+  ///
+  int nthreads() const;
+
+  ///
+  /// @brief Executes f(i, thread_id) for i = 0, ..., size-1 in parallel.
+  /// Returns after all the iterations are finished.
+  /// @param[in] size Number of the iterations.
+  /// @param[in] f Function object called as f(i, thread_id), where
+  /// thread_id is in [0, nthreads()).
+  ///
+  template <typename Function>
+  void parallelFor(const int size, const Function& f);
+
+private:
+  using Task = void (*)(const void*, const int, const int, const int);
+
+  struct SharedState {
+    std::atomic<std::uint64_t> generation{0};
+    std::atomic<int> pending{0};
+    std::atomic<bool> stop{false};
+    std::mutex mtx;
+    std::condition_variable cv;
+    Task task = nullptr;
+    const void* context = nullptr;
+    int size = 0;
+    int nthreads = 1;
+  };
+
+  int nthreads_;
+  bool enable_thread_pinning_;
+  std::unique_ptr<SharedState> state_;
+  std::vector<std::thread> workers_;
+
+  void spawn();
+
+  void join();
+
+  void run(const int size, Task task, const void* context);
+
+  static void work(SharedState* state, const int thread_id);
+
+  static void execute(SharedState* state, const int thread_id);
+
+  template <typename Function>
+  static void invoke(const void* context, const int begin, const int end,
+                     const int thread_id);
+
+};
+
+} // namespace robotoc
+
+#include "robotoc/utils/thread_pool.hxx"
+
+#endif // ROBOTOC_THREAD_POOL_HPP_
@@ -0,0 +1,35 @@
+#ifndef ROBOTOC_THREAD_POOL_HXX_
+#define ROBOTOC_THREAD_POOL_HXX_
+
+#include "robotoc/utils/thread_pool.hpp"
+
+#include <cassert>
+
+
+namespace robotoc {
+
+template <typename Function>
+inline void ThreadPool::parallelFor(const int size, const Function& f) {
+  assert(size >= 0);
+  if (nthreads_ == 1 || size <= 1) {
+    for (int i=0; i<size; ++i) {
+      f(i, 0);
+    }
+    return;
+  }
+  run(size, &ThreadPool::invoke<Function>, static_cast<const void*>(&f));
+}
+
+
+template <typename Function>
+inline void ThreadPool::invoke(const void* context, const int begin,
+                               const int end, const int thread_id) {
+  const Function& f = *static_cast<const Function*>(context);
+  for (int i=begin; i<end; ++i) {
+    f(i, thread_id);
+  }
+}
+
+} // namespace robotoc
+
+#endif // ROBOTOC_THREAD_POOL_HXX_
@@ -0,0 +1,187 @@
+#ifndef ROBOTOC_UTILS_TRACER_HPP_
+#define ROBOTOC_UTILS_TRACER_HPP_
+
+#include <iostream>
+#include <string>
+#include <cstdint>
+
+
+namespace robotoc {
+
+///
+/// @class TraceEvent
+/// @brief Begin or end event of a traced scope.
+///
+struct TraceEvent {
+  ///
+  /// @brief Name of the scope. Must point to a string with the static
+  /// storage duration, e.g., a string literal.
+  ///
+  const char* name = nullptr;
+
+  ///
+  /// @brief Time stamp [ns] measured from the first use of the tracer.
+  ///
+  std::int64_t timestamp = 0;
+
+  ///
+  /// @brief Index of the stage of the scope. -1 if the scope is not of a
+  /// stage.
+  ///
+  int stage = -1;
+
+  ///
+  /// @brief Phase of the event, i.e., 'B' (begin) or 'E' (end).
+  ///
+  char phase = 'B';
+};
+
+
+///
+/// @class Tracer
+/// @brief Collects the begin and end events of the traced scopes of the
+/// solvers, e.g., the iterations of OCPSolver::solve(), the phases of
+/// DirectMultipleShooting, the stage-wise evaluations of the KKT systems,
+/// the Riccati recursions, and the line search trials, and exports them in
+/// the trace event format of Chrome and Perfetto. Each thread writes the
+/// events only to its own ring buffer, so that recording an event does not
+/// take a lock or allocate memory. If a buffer is full, the oldest events
+/// are overwritten. The scopes of robotoc are traced only if robotoc is
+/// built with ENABLE_TRACE, see ROBOTOC_TRACE_SCOPE.
+/// @note The writers never lock the buffers. The internal mutex only guards
+/// the registration and retirement of the buffers of the threads, not the
+/// events. Therefore, setCapacity(), clear(), numEvents(), and
+/// exportChromeTrace(), which read or reset the buffers of all the threads,
+/// must be called only while no thread is inside a traced scope, e.g.,
+/// between the calls of solve(). They throw std::runtime_error if a scope is
+/// open on any thread. This check detects the misuse but cannot exclude a
+/// scope that begins during the call.
+///
+class Tracer {
+public:
+  ///
+  /// @brief Records a begin event on the calling thread.
+  /// @param[in] name Name of the scope. Must point to a string with the
+  /// static storage duration, e.g., a string literal.
+  /// @param[in] stage Index of the stage. Default is -1 (not a stage).
+  ///
+  static void begin(const char* name, const int stage=-1);
+
+  ///
+  /// @brief Records an end event on the calling thread.
+  /// @param[in] name Name of the scope. Must be the same as that of the
+  /// corresponding begin().
+  /// @param[in] stage Index of the stage. Default is -1 (not a stage).
+  ///
+  static void end(const char* name, const int stage=-1);
+
+  ///
+  /// @brief Sets the capacity of the ring buffer of each thread. The
+  /// recorded events are cleared. Must be positive. Default is 65536.
+  /// @param[in] capacity Capacity, i.e., the maximum number of the events
+  /// kept per thread.
+  ///
+  static void setCapacity(const int capacity);
+
+  ///
+  /// @brief Clears the recorded events of all the threads.
+  ///
+  static void clear();
+
+  ///
+  /// @brief Gets the number of the recorded events of all the threads.
+  /// @return Number of the events.
+  ///
+  static int numEvents();
+
+  ///
+  /// @brief Exports the recorded events as a JSON object in the trace event
+  /// format, which can be opened by chrome://tracing or
+  /// https://ui.perfetto.dev. End events whose begin events have been
+  /// overwritten are skipped.
+  /// @param[in] os Output stream.
+  ///
+  static void exportChromeTrace(std::ostream& os);
+
+  ///
+  /// @brief Exports the recorded events to a JSON file in the trace event
+  /// format. Throws std::runtime_error if the file cannot be opened.
+  /// @param[in] filename Name of the JSON file.
+  ///
+  static void exportChromeTrace(const std::string& filename);
+
+  ///
+  /// @brief Checks if the scopes of robotoc are traced, i.e., if robotoc is
+  /// built with ENABLE_TRACE.
+  /// @return true if the scopes are traced and false if not.
+  ///
+  static bool isEnabled();
+};
+
+
+///
+/// @class TraceScope
+/// @brief Records the begin event on construction and the end event on
+/// destruction.
+///
+class TraceScope {
+public:
+  ///
+  /// @brief Records the begin event.
+  /// @param[in] name Name of the scope. Must point to a string with the
+  /// static storage duration, e.g., a string literal.
+  /// @param[in] stage Index of the stage. Default is -1 (not a stage).
+  ///
+  explicit TraceScope(const char* name, const int stage=-1)
+    : name_(name),
+      stage_(stage) {
+    Tracer::begin(name_, stage_);
+  }
+
+  ///
+  /// @brief Records the end event.
+  ///
+  ~TraceScope() {
+    Tracer::end(name_, stage_);
+  }
+
+  ///
+  /// @brief Deleted copy constructor.
+  ///
+  TraceScope(const TraceScope&) = delete;
+
+  ///
+  /// @brief Deleted copy assign operator.
+  ///
+  TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+  const char* name_;
+  int stage_;
+};
+
+} // namespace robotoc
+
+
+#define ROBOTOC_TRACE_CONCAT_IMPL(a, b) a##b
+#define ROBOTOC_TRACE_CONCAT(a, b) ROBOTOC_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef ROBOTOC_ENABLE_TRACE
+///
+/// @brief Traces the enclosing scope. Expands to nothing unless robotoc is
+/// built with ENABLE_TRACE.
+///
+#define ROBOTOC_TRACE_SCOPE(name) \
+  ::robotoc::TraceScope ROBOTOC_TRACE_CONCAT(robotoc_trace_scope_, __LINE__)(name)
+///
+/// @brief Traces the enclosing scope of a stage. Expands to nothing unless
+/// robotoc is built with ENABLE_TRACE.
+///
+#define ROBOTOC_TRACE_STAGE_SCOPE(name, stage) \
+  ::robotoc::TraceScope ROBOTOC_TRACE_CONCAT(robotoc_trace_scope_, __LINE__)(name, stage)
+#else
+#define ROBOTOC_TRACE_SCOPE(name)
+#define ROBOTOC_TRACE_STAGE_SCOPE(name, stage)
+#endif
+
+#endif // ROBOTOC_UTILS_TRACER_HPP_
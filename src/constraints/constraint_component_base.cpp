@@ -27,6 +27,11 @@ ConstraintComponentBase::ConstraintComponentBase(
 }
 
 
+std::shared_ptr<ConstraintComponentBase> ConstraintComponentBase::clone() const {
+  throw std::runtime_error("[ConstraintComponentBase] clone() is not implemented!");
+}
+
+
 double ConstraintComponentBase::getBarrierParam() const {
   return barrier_;
 }
@@ -17,6 +17,8 @@ ConstraintComponentData::ConstraintComponentData(const int dimc,
     ddual(Eigen::VectorXd::Zero(dimc)),
     cond(Eigen::VectorXd::Zero(dimc)),
     log_barrier(0),
+    is_screened(false),
+    num_screened(-1),
     r(),
     J(),
     dimc_(dimc) {
@@ -40,6 +42,8 @@ ConstraintComponentData::ConstraintComponentData()
     ddual(),
     cond(),
     log_barrier(0),
+    is_screened(false),
+    num_screened(-1),
     r(),
     J(),
     dimc_(0) {
@@ -116,4 +120,20 @@ bool ConstraintComponentData::isApprox(
   return true;
 }
 
-} // namespace robotoc
\ No newline at end of file
+void ConstraintComponentData::save(BinaryOutputArchive& ar) const {
+  ar.write(slack);
+  ar.write(dual);
+}
+
+
+void ConstraintComponentData::load(BinaryInputArchive& ar) {
+  ar.read(slack);
+  ar.read(dual);
+  if (slack.size() != dimc_ || dual.size() != dimc_) {
+    throw std::runtime_error(
+        "[ConstraintComponentData] dimension of the loaded data must be " 
+        + std::to_string(dimc_) + "!");
+  }
+}
+
+} // namespace robotoc
@@ -14,7 +14,9 @@ Constraints::Constraints(const double barrier_param,
     acceleration_level_constraints_(),
     impact_level_constraints_(),
     barrier_(barrier_param), 
-    fraction_to_boundary_rule_(fraction_to_boundary_rule) {
+    fraction_to_boundary_rule_(fraction_to_boundary_rule),
+    screening_threshold_(0.0),
+    screening_interval_(10) {
   if (barrier_param <= 0) {
     throw std::out_of_range(
         "[Constraints] invalid argment: 'barrier_param' must be positive!");
@@ -67,6 +69,24 @@ void Constraints::clear() {
 }
 
 
+std::shared_ptr<Constraints> Constraints::clone() const {
+  auto constraints = std::make_shared<Constraints>(*this);
+  for (auto& e : constraints->position_level_constraints_) {
+    e = e->clone();
+  }
+  for (auto& e : constraints->velocity_level_constraints_) {
+    e = e->clone();
+  }
+  for (auto& e : constraints->acceleration_level_constraints_) {
+    e = e->clone();
+  }
+  for (auto& e : constraints->impact_level_constraints_) {
+    e = e->clone();
+  }
+  return constraints;
+}
+
+
 ConstraintsData Constraints::createConstraintsData(const Robot& robot, 
                                                    const int time_stage) const {
   ConstraintsData data(time_stage);
@@ -197,19 +217,22 @@ void Constraints::linearizeConstraints(Robot& robot,
     constraintsimpl::linearizeConstraints(position_level_constraints_, robot, 
                                           contact_status, 
                                           data.position_level_data, s, 
-                                          kkt_residual);
+                                          kkt_residual,
+                                          screening_threshold_, screening_interval_);
   }
   if (data.isVelocityLevelValid()) {
     constraintsimpl::linearizeConstraints(velocity_level_constraints_, robot, 
                                           contact_status, 
                                           data.velocity_level_data, s, 
-                                          kkt_residual);
+                                          kkt_residual,
+                                          screening_threshold_, screening_interval_);
   }
   if (data.isAccelerationLevelValid()) {
     constraintsimpl::linearizeConstraints(acceleration_level_constraints_, robot, 
                                           contact_status, 
                                           data.acceleration_level_data, 
-                                          s, kkt_residual);
+                                          s, kkt_residual,
+                                          screening_threshold_, screening_interval_);
   }
 }
 
@@ -222,7 +245,45 @@ void Constraints::linearizeConstraints(Robot& robot,
   if (data.isImpactLevelValid()) {
     constraintsimpl::linearizeConstraints(impact_level_constraints_, robot, 
                                           impact_status, 
-                                          data.impact_level_data, s, kkt_residual);
+                                          data.impact_level_data, s, kkt_residual,
+                                          screening_threshold_, screening_interval_);
+  }
+}
+
+
+void Constraints::evalKKTResidual(Robot& robot, 
+                                  const ContactStatus& contact_status, 
+                                  ConstraintsData& data, 
+                                  const SplitSolution& s, 
+                                  SplitKKTResidual& kkt_residual) const {
+  if (data.isPositionLevelValid()) {
+    constraintsimpl::evalKKTResidual(position_level_constraints_, robot, 
+                                     contact_status, data.position_level_data, 
+                                     s, kkt_residual);
+  }
+  if (data.isVelocityLevelValid()) {
+    constraintsimpl::evalKKTResidual(velocity_level_constraints_, robot, 
+                                     contact_status, data.velocity_level_data, 
+                                     s, kkt_residual);
+  }
+  if (data.isAccelerationLevelValid()) {
+    constraintsimpl::evalKKTResidual(acceleration_level_constraints_, robot, 
+                                     contact_status, 
+                                     data.acceleration_level_data, 
+                                     s, kkt_residual);
+  }
+}
+
+
+void Constraints::evalKKTResidual(Robot& robot, 
+                                  const ImpactStatus& impact_status, 
+                                  ConstraintsData& data, 
+                                  const SplitSolution& s, 
+                                  SplitKKTResidual& kkt_residual) const {
+  if (data.isImpactLevelValid()) {
+    constraintsimpl::evalKKTResidual(impact_level_constraints_, robot, 
+                                     impact_status, data.impact_level_data, 
+                                     s, kkt_residual);
   }
 }
 
@@ -436,6 +497,26 @@ void Constraints::setFractionToBoundaryRule(
 }
 
 
+void Constraints::setActiveSetScreening(const double threshold, 
+                                        const int revalidation_interval) {
+  if (threshold < 0) {
+    throw std::out_of_range(
+        "[Constraints] invalid argment: 'threshold' must be non-negative!");
+  }
+  if (revalidation_interval <= 0) {
+    throw std::out_of_range(
+        "[Constraints] invalid argment: 'revalidation_interval' must be positive!");
+  }
+  screening_threshold_ = threshold;
+  screening_interval_ = revalidation_interval;
+}
+
+
+bool Constraints::isActiveSetScreeningEnabled() const {
+  return (screening_threshold_ > 0);
+}
+
+
 double Constraints::getBarrierParam() const {
   return barrier_;
 }
@@ -1,5 +1,7 @@
 #include "robotoc/constraints/constraints_data.hpp"
 
+#include <stdexcept>
+
 
 namespace robotoc {
 
@@ -44,4 +46,45 @@ void ConstraintsData::setTimeStage(const int time_stage) {
   }
 }
 
-} // namespace robotoc
\ No newline at end of file
+
+namespace {
+
+void saveLevelData(BinaryOutputArchive& ar, 
+                   const std::vector<ConstraintComponentData>& data) {
+  ar.writeSize(data.size());
+  for (const auto& e : data) {
+    e.save(ar);
+  }
+}
+
+
+void loadLevelData(BinaryInputArchive& ar, 
+                   std::vector<ConstraintComponentData>& data) {
+  if (ar.readSize() != data.size()) {
+    throw std::runtime_error("[ConstraintsData] number of the loaded constraint components must be " 
+                             + std::to_string(data.size()) + "!");
+  }
+  for (auto& e : data) {
+    e.load(ar);
+  }
+}
+
+} // namespace
+
+
+void ConstraintsData::save(BinaryOutputArchive& ar) const {
+  saveLevelData(ar, position_level_data);
+  saveLevelData(ar, velocity_level_data);
+  saveLevelData(ar, acceleration_level_data);
+  saveLevelData(ar, impact_level_data);
+}
+
+
+void ConstraintsData::load(BinaryInputArchive& ar) {
+  loadLevelData(ar, position_level_data);
+  loadLevelData(ar, velocity_level_data);
+  loadLevelData(ar, acceleration_level_data);
+  loadLevelData(ar, impact_level_data);
+}
+
+} // namespace robotoc
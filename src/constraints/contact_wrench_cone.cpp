@@ -61,6 +61,11 @@ void ContactWrenchCone::setRectangular(const double X, const double Y) {
 }
 
 
+std::shared_ptr<ConstraintComponentBase> ContactWrenchCone::clone() const {
+  return std::make_shared<ContactWrenchCone>(*this);
+}
+
+
 KinematicsLevel ContactWrenchCone::kinematicsLevel() const {
   return KinematicsLevel::AccelerationLevel;
 }
@@ -296,6 +301,12 @@ void ContactWrenchCone::computeCone(const double mu, Eigen::MatrixXd& cone) cons
 
 
 void ContactWrenchCone::updateCone(const double mu, Eigen::MatrixXd& cone) const {
+  // The cone is constant within a contact phase. It is therefore only rebuilt 
+  // when the friction coefficient or the rectangle of the surface changes.
+  if (cone.coeff(1, 2) == -mu && cone.coeff(5, 2) == -Y_ 
+      && cone.coeff(7, 2) == -X_) {
+    return;
+  }
   for (int i=1; i<5; ++i) {
     cone.coeffRef(i, 2) = -mu;
   }
@@ -34,6 +34,11 @@ FrictionCone::~FrictionCone() {
 }
 
 
+std::shared_ptr<ConstraintComponentBase> FrictionCone::clone() const {
+  return std::make_shared<FrictionCone>(*this);
+}
+
+
 KinematicsLevel FrictionCone::kinematicsLevel() const {
   return KinematicsLevel::AccelerationLevel;
 }
@@ -60,18 +65,6 @@ void FrictionCone::allocateExtraData(ConstraintComponentData& data) const {
   for (int i=0; i<max_num_contacts_; ++i) {
     data.J.push_back(Eigen::MatrixXd::Zero(5, 3)); // r_dgi_df
   }
-  for (int i=0; i<max_num_contacts_; ++i) {
-    data.J.push_back(Eigen::MatrixXd::Zero(5, 3)); // cone_local
-  }
-  for (int i=0; i<max_num_contacts_; ++i) {
-    Eigen::MatrixXd cone_world = Eigen::MatrixXd::Zero(5, 3);
-    cone_world <<  0,  0, -1, 
-                   1,  0,  0,
-                  -1,  0,  0,
-                   0,  1,  0,
-                   0, -1,  0;
-    data.J.push_back(cone_world); 
-  }
 }
 
 
@@ -85,9 +78,8 @@ bool FrictionCone::isFeasible(Robot& robot, const ContactStatus& contact_status,
       Eigen::VectorXd& fWi = fW(data, i);
       robot.transformFromLocalToWorld(contact_frame_[i], 
                                       s.f[i].template head<3>(), fWi);
-      frictionConeResidual(contact_status.frictionCoefficient(i), fWi, 
-                           contact_status.contactRotation(i), 
-                           data.residual.template segment<5>(idx));
+      data.residual.template segment<5>(idx).noalias() 
+          = contact_status.frictionCone(i) * fWi;
       if (data.residual.maxCoeff() > 0) {
         return false;
       }
@@ -106,9 +98,8 @@ void FrictionCone::setSlack(Robot& robot, const ContactStatus& contact_status,
     Eigen::VectorXd& fWi = fW(data, i);
     robot.transformFromLocalToWorld(contact_frame_[i], 
                                     s.f[i].template head<3>(), fWi);
-    frictionConeResidual(contact_status.frictionCoefficient(i), fWi, 
-                         contact_status.contactRotation(i), 
-                         data.residual.template segment<5>(idx));
+    data.residual.template segment<5>(idx).noalias() 
+        = contact_status.frictionCone(i) * fWi;
     data.slack.template segment<5>(idx)
         = - data.residual.template segment<5>(idx);
   }
@@ -129,9 +120,8 @@ void FrictionCone::evalConstraint(Robot& robot,
       Eigen::VectorXd& fWi = fW(data, i);
       robot.transformFromLocalToWorld(contact_frame_[i], 
                                       s.f[i].template head<3>(), fWi);
-      frictionConeResidual(contact_status.frictionCoefficient(i), fWi, 
-                           contact_status.contactRotation(i), 
-                           data.residual.template segment<5>(idx));
+      data.residual.template segment<5>(idx).noalias() 
+          = contact_status.frictionCone(i) * fWi;
       data.residual.template segment<5>(idx).noalias()
           += data.slack.template segment<5>(idx);
       computeComplementarySlackness<5>(data, idx);
@@ -152,14 +142,8 @@ void FrictionCone::evalDerivatives(Robot& robot,
       const int idx = 5*i;
       // Contact force expressed in the world frame.
       const Eigen::VectorXd& fWi = fW(data, i);
-      // Friction cone in the world frame.
-      Eigen::MatrixXd& cone_world_i = cone_world(data, i);
-      for (int j=0; j<4; ++j) {
-        cone_world_i.coeffRef(j+1, 2) = - (contact_status.frictionCoefficient(i)/std::sqrt(2));
-      }
-      // Friction cone in the local frame of the contact surface.
-      Eigen::MatrixXd& cone_local_i = cone_local(data, i);
-      cone_local_i.noalias() = cone_world_i * contact_status.contactRotation(i).transpose();
+      // Friction cone precomputed for the contact phase.
+      const Eigen::Matrix<double, 5, 3>& cone_i = contact_status.frictionCone(i);
       // Jacobian of the contact force expressed in the world frame fWi 
       // with respect to the configuration q.
       Eigen::MatrixXd& dfWi_dq = dfW_dq(data, i);
@@ -167,13 +151,13 @@ void FrictionCone::evalDerivatives(Robot& robot,
       // Jacobian of the frition cone constraint with respect to the 
       // configuration, i.e., s.q.
       Eigen::MatrixXd& dgi_dq = dg_dq(data, i);
-      dgi_dq.noalias() = cone_local_i * dfWi_dq.template topRows<3>();
+      dgi_dq.noalias() = cone_i * dfWi_dq.template topRows<3>();
       kkt_residual.lq().noalias()
           += dgi_dq.transpose() * data.dual.template segment<5>(idx);
       // Jacobian of the frition cone constraint with respect to the contact
       // force expressed in the local frame, i.e., s.f[i].
       Eigen::MatrixXd& dgi_df = dg_df(data, i);
-      dgi_df.noalias() = cone_local_i * robot.frameRotation(contact_frame_[i]);
+      dgi_df.noalias() = cone_i * robot.frameRotation(contact_frame_[i]);
       kkt_residual.lf().template segment<3>(dimf_stack).noalias()
           += dgi_df.transpose() * data.dual.template segment<5>(idx);
       switch (contact_types_[i]) {
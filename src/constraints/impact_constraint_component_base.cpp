@@ -27,6 +27,11 @@ ImpactConstraintComponentBase::ImpactConstraintComponentBase(
 }
 
 
+std::shared_ptr<ImpactConstraintComponentBase> ImpactConstraintComponentBase::clone() const {
+  throw std::runtime_error("[ImpactConstraintComponentBase] clone() is not implemented!");
+}
+
+
 double ImpactConstraintComponentBase::getBarrierParam() const {
   return barrier_;
 }
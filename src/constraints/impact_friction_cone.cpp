@@ -34,6 +34,11 @@ ImpactFrictionCone::~ImpactFrictionCone() {
 }
 
 
+std::shared_ptr<ImpactConstraintComponentBase> ImpactFrictionCone::clone() const {
+  return std::make_shared<ImpactFrictionCone>(*this);
+}
+
+
 KinematicsLevel ImpactFrictionCone::kinematicsLevel() const {
   return KinematicsLevel::AccelerationLevel;
 }
@@ -61,18 +66,6 @@ void ImpactFrictionCone::allocateExtraData(
   for (int i=0; i<max_num_contacts_; ++i) {
     data.J.push_back(Eigen::MatrixXd::Zero(5, 3)); // r_dgi_df
   }
-  for (int i=0; i<max_num_contacts_; ++i) {
-    data.J.push_back(Eigen::MatrixXd::Zero(5, 3)); // cone_local
-  }
-  for (int i=0; i<max_num_contacts_; ++i) {
-    Eigen::MatrixXd cone_world = Eigen::MatrixXd::Zero(5, 3);
-    cone_world <<  0,  0, -1, 
-                   1,  0,  0,
-                  -1,  0,  0,
-                   0,  1,  0,
-                   0, -1,  0;
-    data.J.push_back(cone_world); 
-  }
 }
 
 
@@ -87,9 +80,8 @@ bool ImpactFrictionCone::isFeasible(Robot& robot,
       Eigen::VectorXd& fWi = fW(data, i);
       robot.transformFromLocalToWorld(contact_frame_[i], 
                                       s.f[i].template head<3>(), fWi);
-      frictionConeResidual(impact_status.frictionCoefficient(i), fWi, 
-                           impact_status.contactRotation(i), 
-                           data.residual.template segment<5>(idx));
+      data.residual.template segment<5>(idx).noalias() 
+          = impact_status.frictionCone(i) * fWi;
       if (data.residual.maxCoeff() > 0) {
         return false;
       }
@@ -109,9 +101,8 @@ void ImpactFrictionCone::setSlack(Robot& robot,
     Eigen::VectorXd& fWi = fW(data, i);
     robot.transformFromLocalToWorld(contact_frame_[i], 
                                     s.f[i].template head<3>(), fWi);
-    frictionConeResidual(impact_status.frictionCoefficient(i), fWi, 
-                         impact_status.contactRotation(i), 
-                         data.residual.template segment<5>(idx));
+    data.residual.template segment<5>(idx).noalias() 
+        = impact_status.frictionCone(i) * fWi;
     data.slack.template segment<5>(idx)
         = - data.residual.template segment<5>(idx);
   }
@@ -132,9 +123,8 @@ void ImpactFrictionCone::evalConstraint(Robot& robot,
       Eigen::VectorXd& fWi = fW(data, i);
       robot.transformFromLocalToWorld(contact_frame_[i], 
                                       s.f[i].template head<3>(), fWi);
-      frictionConeResidual(impact_status.frictionCoefficient(i), fWi, 
-                           impact_status.contactRotation(i), 
-                           data.residual.template segment<5>(idx));
+      data.residual.template segment<5>(idx).noalias() 
+          = impact_status.frictionCone(i) * fWi;
       data.residual.template segment<5>(idx).noalias()
           += data.slack.template segment<5>(idx);
       computeComplementarySlackness<5>(data, idx);
@@ -154,14 +144,8 @@ void ImpactFrictionCone::evalDerivatives(
       const int idx = 5*i;
       // Contact force expressed in the world frame.
       const Eigen::VectorXd& fWi = fW(data, i);
-      // Friction cone in the world frame.
-      Eigen::MatrixXd& cone_world_i = cone_world(data, i);
-      for (int j=0; j<4; ++j) {
-        cone_world_i.coeffRef(j+1, 2) = - (impact_status.frictionCoefficient(i)/std::sqrt(2));
-      }
-      // Friction cone in the local frame of the contact surface.
-      Eigen::MatrixXd& cone_local_i = cone_local(data, i);
-      cone_local_i.noalias() = cone_world_i * impact_status.contactRotation(i).transpose();
+      // Friction cone precomputed for the contact phase.
+      const Eigen::Matrix<double, 5, 3>& cone_i = impact_status.frictionCone(i);
       // Jacobian of the contact force expressed in the world frame fWi 
       // with respect to the configuration q.
       Eigen::MatrixXd& dfWi_dq = dfW_dq(data, i);
@@ -169,13 +153,13 @@ void ImpactFrictionCone::evalDerivatives(
       // Jacobian of the frition cone constraint with respect to the 
       // configuration q.
       Eigen::MatrixXd& dgi_dq = dg_dq(data, i);
-      dgi_dq.noalias() = cone_local_i * dfWi_dq.template topRows<3>();
+      dgi_dq.noalias() = cone_i * dfWi_dq.template topRows<3>();
       kkt_residual.lq().noalias()
           += dgi_dq.transpose() * data.dual.template segment<5>(idx);
       // Jacobian of the frition cone constraint with respect to the contact
       // force expressed in the local frame.
       Eigen::MatrixXd& dgi_df = dg_df(data, i);
-      dgi_df.noalias() = cone_local_i * robot.frameRotation(contact_frame_[i]);
+      dgi_df.noalias() = cone_i * robot.frameRotation(contact_frame_[i]);
       kkt_residual.lf().template segment<3>(dimf_stack).noalias()
           += dgi_df.transpose() * data.dual.template segment<5>(idx);
       switch (contact_types_[i]) {
@@ -60,6 +60,11 @@ void ImpactWrenchCone::setRectangular(const double X, const double Y) {
 }
 
 
+std::shared_ptr<ImpactConstraintComponentBase> ImpactWrenchCone::clone() const {
+  return std::make_shared<ImpactWrenchCone>(*this);
+}
+
+
 KinematicsLevel ImpactWrenchCone::kinematicsLevel() const {
   return KinematicsLevel::AccelerationLevel;
 }
@@ -295,6 +300,12 @@ void ImpactWrenchCone::computeCone(const double mu, Eigen::MatrixXd& cone) const
 
 
 void ImpactWrenchCone::updateCone(const double mu, Eigen::MatrixXd& cone) const {
+  // The cone is constant within a contact phase. It is therefore only rebuilt 
+  // when the friction coefficient or the rectangle of the surface changes.
+  if (cone.coeff(1, 2) == -mu && cone.coeff(5, 2) == -Y_ 
+      && cone.coeff(7, 2) == -X_) {
+    return;
+  }
   for (int i=1; i<5; ++i) {
     cone.coeffRef(i, 2) = -mu;
   }
@@ -22,6 +22,11 @@ JointAccelerationLowerLimit::~JointAccelerationLowerLimit() {
 }
 
 
+std::shared_ptr<ConstraintComponentBase> JointAccelerationLowerLimit::clone() const {
+  return std::make_shared<JointAccelerationLowerLimit>(*this);
+}
+
+
 KinematicsLevel JointAccelerationLowerLimit::kinematicsLevel() const {
   return KinematicsLevel::AccelerationLevel;
 }
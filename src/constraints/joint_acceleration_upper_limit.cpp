@@ -22,6 +22,11 @@ JointAccelerationUpperLimit::~JointAccelerationUpperLimit() {
 }
 
 
+std::shared_ptr<ConstraintComponentBase> JointAccelerationUpperLimit::clone() const {
+  return std::make_shared<JointAccelerationUpperLimit>(*this);
+}
+
+
 KinematicsLevel JointAccelerationUpperLimit::kinematicsLevel() const {
   return KinematicsLevel::AccelerationLevel;
 }
@@ -21,6 +21,11 @@ JointPositionLowerLimit::~JointPositionLowerLimit() {
 }
 
 
+std::shared_ptr<ConstraintComponentBase> JointPositionLowerLimit::clone() const {
+  return std::make_shared<JointPositionLowerLimit>(*this);
+}
+
+
 KinematicsLevel JointPositionLowerLimit::kinematicsLevel() const {
   return KinematicsLevel::PositionLevel;
 }
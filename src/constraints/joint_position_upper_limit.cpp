@@ -21,6 +21,11 @@ JointPositionUpperLimit::~JointPositionUpperLimit() {
 }
 
 
+std::shared_ptr<ConstraintComponentBase> JointPositionUpperLimit::clone() const {
+  return std::make_shared<JointPositionUpperLimit>(*this);
+}
+
+
 KinematicsLevel JointPositionUpperLimit::kinematicsLevel() const {
   return KinematicsLevel::PositionLevel;
 }
@@ -21,6 +21,11 @@ JointTorquesLowerLimit::~JointTorquesLowerLimit() {
 }
 
 
+std::shared_ptr<ConstraintComponentBase> JointTorquesLowerLimit::clone() const {
+  return std::make_shared<JointTorquesLowerLimit>(*this);
+}
+
+
 KinematicsLevel JointTorquesLowerLimit::kinematicsLevel() const {
   return KinematicsLevel::AccelerationLevel;
 }
@@ -21,6 +21,11 @@ JointTorquesUpperLimit::~JointTorquesUpperLimit() {
 }
 
 
+std::shared_ptr<ConstraintComponentBase> JointTorquesUpperLimit::clone() const {
+  return std::make_shared<JointTorquesUpperLimit>(*this);
+}
+
+
 KinematicsLevel JointTorquesUpperLimit::kinematicsLevel() const {
   return KinematicsLevel::AccelerationLevel;
 }
@@ -21,6 +21,11 @@ JointVelocityLowerLimit::~JointVelocityLowerLimit() {
 }
 
 
+std::shared_ptr<ConstraintComponentBase> JointVelocityLowerLimit::clone() const {
+  return std::make_shared<JointVelocityLowerLimit>(*this);
+}
+
+
 KinematicsLevel JointVelocityLowerLimit::kinematicsLevel() const {
   return KinematicsLevel::VelocityLevel;
 }
@@ -21,6 +21,11 @@ JointVelocityUpperLimit::~JointVelocityUpperLimit() {
 }
 
 
+std::shared_ptr<ConstraintComponentBase> JointVelocityUpperLimit::clone() const {
+  return std::make_shared<JointVelocityUpperLimit>(*this);
+}
+
+
 KinematicsLevel JointVelocityUpperLimit::kinematicsLevel() const {
   return KinematicsLevel::VelocityLevel;
 }
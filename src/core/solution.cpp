@@ -3,6 +3,22 @@
 
 namespace robotoc {
 
+void save(BinaryOutputArchive& ar, const Solution& s) {
+  ar.writeSize(s.size());
+  for (const auto& e : s) {
+    e.save(ar);
+  }
+}
+
+
+void load(BinaryInputArchive& ar, Solution& s) {
+  s.resize(ar.readSize());
+  for (auto& e : s) {
+    e.load(ar);
+  }
+}
+
+
 std::ostream& operator<<(std::ostream& os, const Solution& s) {
   os << "Solution:" << "\n";
   for (int i=0; i<s.size(); ++i) {
@@ -1,6 +1,7 @@
 #include "robotoc/core/split_solution.hpp"
 
 #include <random>
+#include <stdexcept>
 
 namespace robotoc {
 
@@ -282,6 +283,61 @@ SplitSolution SplitSolution::Random(const Robot& robot,
 }
 
 
+void SplitSolution::save(BinaryOutputArchive& ar) const {
+  ar.write(has_floating_base_);
+  ar.write(max_num_contacts_);
+  ar.write(contact_types_);
+  ar.write(is_contact_active_);
+  ar.write(dimf_);
+  ar.write(dims_);
+  ar.write(q);
+  ar.write(v);
+  ar.write(a);
+  ar.write(dv);
+  ar.write(u);
+  ar.write(f);
+  ar.write(lmd);
+  ar.write(gmm);
+  ar.write(beta);
+  ar.write(mu);
+  ar.write(nu_passive);
+  ar.write(f_stack_);
+  ar.write(mu_stack_);
+  ar.write(xi_stack_);
+}
+
+
+void SplitSolution::load(BinaryInputArchive& ar) {
+  ar.read(has_floating_base_);
+  ar.read(max_num_contacts_);
+  ar.read(contact_types_);
+  ar.read(is_contact_active_);
+  ar.read(dimf_);
+  ar.read(dims_);
+  ar.read(q);
+  ar.read(v);
+  ar.read(a);
+  ar.read(dv);
+  ar.read(u);
+  ar.read(f);
+  ar.read(lmd);
+  ar.read(gmm);
+  ar.read(beta);
+  ar.read(mu);
+  ar.read(nu_passive);
+  ar.read(f_stack_);
+  ar.read(mu_stack_);
+  ar.read(xi_stack_);
+  if (contact_types_.size() != max_num_contacts_
+      || is_contact_active_.size() != max_num_contacts_
+      || f.size() != max_num_contacts_ || mu.size() != max_num_contacts_
+      || dimf_ > f_stack_.size() || dimf_ > mu_stack_.size() 
+      || dims_ > xi_stack_.size()) {
+    throw std::runtime_error("[SplitSolution] loaded data is not consistent!");
+  }
+}
+
+
 void SplitSolution::disp(std::ostream& os) const {
   os << "SplitSolution:" << "\n";
   os << "  q = " << q.transpose() << "\n";
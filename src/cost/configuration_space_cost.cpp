@@ -11,6 +11,7 @@ ConfigurationSpaceCost::ConfigurationSpaceCost(const Robot& robot)
     dimq_(robot.dimq()),
     dimv_(robot.dimv()),
     dimu_(robot.dimu()),
+    has_floating_base_(robot.hasFloatingBase()),
     q_ref_(Eigen::VectorXd::Zero(robot.dimq())),
     v_ref_(Eigen::VectorXd::Zero(robot.dimv())),
     u_ref_(Eigen::VectorXd::Zero(robot.dimu())),
@@ -52,6 +53,7 @@ ConfigurationSpaceCost::ConfigurationSpaceCost()
     dimq_(0),
     dimv_(0),
     dimu_(0),
+    has_floating_base_(false),
     q_ref_(),
     v_ref_(),
     u_ref_(),
@@ -86,6 +88,7 @@ void ConfigurationSpaceCost::set_ref(
     const std::shared_ptr<ConfigurationSpaceRefBase>& ref) {
   ref_ = ref;
   use_nonconst_ref_ = true;
+  invalidateConstantHessian();
 }
 
 
@@ -95,7 +98,10 @@ void ConfigurationSpaceCost::set_q_ref(const Eigen::VectorXd& q_ref) {
         "[ConfigurationSpaceCost] invalid argument: q_ref.size() must be " + std::to_string(dimq_) + "!");
   }
   q_ref_ = q_ref;
-  use_nonconst_ref_ = false;
+  if (use_nonconst_ref_) {
+    use_nonconst_ref_ = false;
+    invalidateConstantHessian();
+  }
 }
 
 
@@ -128,6 +134,7 @@ void ConfigurationSpaceCost::set_q_weight(const Eigen::VectorXd& q_weight) {
   }
   q_weight_ = q_weight;
   enable_q_cost_ = (!q_weight.isZero());
+  invalidateConstantHessian();
 }
 
 
@@ -142,6 +149,7 @@ void ConfigurationSpaceCost::set_v_weight(const Eigen::VectorXd& v_weight) {
   }
   v_weight_ = v_weight;
   enable_v_cost_ = (!v_weight.isZero());
+  invalidateConstantHessian();
 }
 
 
@@ -156,6 +164,7 @@ void ConfigurationSpaceCost::set_a_weight(const Eigen::VectorXd& a_weight) {
   }
   a_weight_ = a_weight;
   enable_a_cost_ = (!a_weight.isZero());
+  invalidateConstantHessian();
 }
 
 
@@ -170,6 +179,7 @@ void ConfigurationSpaceCost::set_u_weight(const Eigen::VectorXd& u_weight) {
   }
   u_weight_ = u_weight;
   enable_u_cost_ = (!u_weight.isZero());
+  invalidateConstantHessian();
 }
 
 
@@ -185,6 +195,7 @@ void ConfigurationSpaceCost::set_q_weight_terminal(
   }
   q_weight_terminal_ = q_weight_terminal;
   enable_q_cost_terminal_ = (!q_weight_terminal.isZero());
+  invalidateConstantHessian();
 }
 
 
@@ -200,6 +211,7 @@ void ConfigurationSpaceCost::set_v_weight_terminal(
   }
   v_weight_terminal_ = v_weight_terminal;
   enable_v_cost_terminal_ = (!v_weight_terminal.isZero());
+  invalidateConstantHessian();
 }
 
 
@@ -215,6 +227,7 @@ void ConfigurationSpaceCost::set_q_weight_impact(
   }
   q_weight_impact_ = q_weight_impact;
   enable_q_cost_impact_ = (!q_weight_impact.isZero());
+  invalidateConstantHessian();
 }
 
 
@@ -230,6 +243,7 @@ void ConfigurationSpaceCost::set_v_weight_impact(
   }
   v_weight_impact_ = v_weight_impact;
   enable_v_cost_impact_ = (!v_weight_impact.isZero());
+  invalidateConstantHessian();
 }
 
 
@@ -245,6 +259,16 @@ void ConfigurationSpaceCost::set_dv_weight_impact(
   }
   dv_weight_impact_ = dv_weight_impact;
   enable_dv_cost_impact_ = (!dv_weight_impact.isZero());
+  invalidateConstantHessian();
+}
+
+
+bool ConfigurationSpaceCost::hasConstantHessian() const {
+  // The Hessians w.r.t. the configuration depend on the configuration if the 
+  // robot has a floating base and on the time if the reference is time-varying.
+  const bool enable_q_cost = enable_q_cost_ || enable_q_cost_terminal_ 
+                              || enable_q_cost_impact_;
+  return !(enable_q_cost && (has_floating_base_ || use_nonconst_ref_));
 }
 
 
@@ -305,8 +329,7 @@ void ConfigurationSpaceCost::evalStageCostHessian(
     SplitKKTMatrix& kkt_matrix) const {
   if (enable_q_cost_ && isCostConfigActive(grid_info)) {
     if (robot.hasFloatingBase()) {
-      kkt_matrix.Qqq().noalias()
-          += grid_info.dt * data.J_qdiff.transpose() * q_weight_.asDiagonal() * data.J_qdiff;
+      addConfigDiffHessian(grid_info.dt, q_weight_, data, kkt_matrix);
     }
     else {
       kkt_matrix.Qqq().diagonal().noalias() += grid_info.dt * q_weight_;
@@ -365,8 +388,7 @@ void ConfigurationSpaceCost::evalTerminalCostHessian(
     const SplitSolution& s, SplitKKTMatrix& kkt_matrix) const {
   if (enable_q_cost_terminal_ && isCostConfigActive(grid_info)) {
     if (robot.hasFloatingBase()) {
-      kkt_matrix.Qqq().noalias()
-          += data.J_qdiff.transpose() * q_weight_terminal_.asDiagonal() * data.J_qdiff;
+      addConfigDiffHessian(1.0, q_weight_terminal_, data, kkt_matrix);
     }
     else {
       kkt_matrix.Qqq().diagonal().noalias() += q_weight_terminal_;
@@ -426,8 +448,7 @@ void ConfigurationSpaceCost::evalImpactCostHessian(
     SplitKKTMatrix& kkt_matrix) const {
   if (enable_q_cost_impact_ && isCostConfigActive(grid_info)) {
     if (robot.hasFloatingBase()) {
-      kkt_matrix.Qqq().noalias()
-          += data.J_qdiff.transpose() * q_weight_impact_.asDiagonal() * data.J_qdiff;
+      addConfigDiffHessian(1.0, q_weight_impact_, data, kkt_matrix);
     }
     else {
       kkt_matrix.Qqq().diagonal().noalias() += q_weight_impact_;
@@ -0,0 +1,204 @@
+#include "robotoc/cost/consensus_cost.hpp"
+
+#include <stdexcept>
+#include <cmath>
+#include <limits>
+
+
+namespace robotoc {
+
+ConsensusCost::ConsensusCost(const Robot& robot, const double penalty)
+  : CostFunctionComponentBase(),
+    dimq_(robot.dimq()),
+    dimv_(robot.dimv()),
+    penalty_(penalty),
+    times_(),
+    q_targets_(),
+    v_targets_() {
+  if (penalty < 0) {
+    throw std::out_of_range("[ConsensusCost] invalid argument: 'penalty' must be non-negative!");
+  }
+}
+
+
+ConsensusCost::ConsensusCost()
+  : CostFunctionComponentBase(),
+    dimq_(0),
+    dimv_(0),
+    penalty_(0),
+    times_(),
+    q_targets_(),
+    v_targets_() {
+}
+
+
+ConsensusCost::~ConsensusCost() {
+}
+
+
+void ConsensusCost::set_penalty(const double penalty) {
+  if (penalty < 0) {
+    throw std::out_of_range("[ConsensusCost] invalid argument: 'penalty' must be non-negative!");
+  }
+  penalty_ = penalty;
+}
+
+
+void ConsensusCost::set_targets(const std::vector<double>& times, 
+                                const std::vector<Eigen::VectorXd>& q_targets,
+                                const std::vector<Eigen::VectorXd>& v_targets) {
+  if (q_targets.size() != times.size()) {
+    throw std::out_of_range("[ConsensusCost] invalid argument: q_targets.size() must be the same as times.size()!");
+  }
+  if (v_targets.size() != times.size()) {
+    throw std::out_of_range("[ConsensusCost] invalid argument: v_targets.size() must be the same as times.size()!");
+  }
+  for (const auto& e : q_targets) {
+    if (e.size() != dimq_) {
+      throw std::out_of_range("[ConsensusCost] invalid argument: size of each q_target must be " + std::to_string(dimq_) + "!");
+    }
+  }
+  for (const auto& e : v_targets) {
+    if (e.size() != dimv_) {
+      throw std::out_of_range("[ConsensusCost] invalid argument: size of each v_target must be " + std::to_string(dimv_) + "!");
+    }
+  }
+  times_ = times;
+  q_targets_ = q_targets;
+  v_targets_ = v_targets;
+}
+
+
+void ConsensusCost::clear_targets() {
+  times_.clear();
+  q_targets_.clear();
+  v_targets_.clear();
+}
+
+
+int ConsensusCost::findTarget(const GridInfo& grid_info) const {
+  const double eps = std::sqrt(std::numeric_limits<double>::epsilon());
+  for (int i=0; i<times_.size(); ++i) {
+    if (std::abs(grid_info.t-times_[i]) < eps) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+double ConsensusCost::evalStageCost(Robot& robot, 
+                                    const ContactStatus& contact_status, 
+                                    CostFunctionData& data, 
+                                    const GridInfo& grid_info, 
+                                    const SplitSolution& s) const {
+  return evalCost(robot, data, grid_info, s);
+}
+
+
+void ConsensusCost::evalStageCostDerivatives(
+    Robot& robot, const ContactStatus& contact_status, CostFunctionData& data, 
+    const GridInfo& grid_info, const SplitSolution& s, 
+    SplitKKTResidual& kkt_residual) const {
+  evalCostDerivatives(robot, data, grid_info, s, kkt_residual);
+}
+
+
+void ConsensusCost::evalStageCostHessian(
+    Robot& robot, const ContactStatus& contact_status, CostFunctionData& data, 
+    const GridInfo& grid_info, const SplitSolution& s, 
+    SplitKKTMatrix& kkt_matrix) const {
+  evalCostHessian(robot, data, grid_info, s, kkt_matrix);
+}
+
+
+double ConsensusCost::evalTerminalCost(Robot& robot, CostFunctionData& data, 
+                                       const GridInfo& grid_info, 
+                                       const SplitSolution& s) const {
+  return evalCost(robot, data, grid_info, s);
+}
+
+
+void ConsensusCost::evalTerminalCostDerivatives(
+    Robot& robot, CostFunctionData& data, const GridInfo& grid_info, 
+    const SplitSolution& s, SplitKKTResidual& kkt_residual) const {
+  evalCostDerivatives(robot, data, grid_info, s, kkt_residual);
+}
+
+
+void ConsensusCost::evalTerminalCostHessian(
+    Robot& robot, CostFunctionData& data, const GridInfo& grid_info, 
+    const SplitSolution& s, SplitKKTMatrix& kkt_matrix) const {
+  evalCostHessian(robot, data, grid_info, s, kkt_matrix);
+}
+
+
+double ConsensusCost::evalImpactCost(
+    Robot& robot, const ImpactStatus& impact_status, CostFunctionData& data, 
+    const GridInfo& grid_info, const SplitSolution& s) const {
+  return 0;
+}
+
+
+void ConsensusCost::evalImpactCostDerivatives(
+    Robot& robot, const ImpactStatus& impact_status, CostFunctionData& data, 
+    const GridInfo& grid_info, const SplitSolution& s, 
+    SplitKKTResidual& kkt_residual) const {
+  // do nothing
+}
+
+
+void ConsensusCost::evalImpactCostHessian(
+    Robot& robot, const ImpactStatus& impact_status, CostFunctionData& data, 
+    const GridInfo& grid_info, const SplitSolution& s, 
+    SplitKKTMatrix& kkt_matrix) const {
+  // do nothing
+}
+
+
+double ConsensusCost::evalCost(Robot& robot, CostFunctionData& data, 
+                               const GridInfo& grid_info, 
+                               const SplitSolution& s) const {
+  const int target = findTarget(grid_info);
+  if (target < 0) return 0;
+  robot.subtractConfiguration(s.q, q_targets_[target], data.qdiff);
+  return 0.5 * penalty_ * (data.qdiff.squaredNorm() 
+                            + (s.v-v_targets_[target]).squaredNorm());
+}
+
+
+void ConsensusCost::evalCostDerivatives(Robot& robot, CostFunctionData& data, 
+                                        const GridInfo& grid_info, 
+                                        const SplitSolution& s, 
+                                        SplitKKTResidual& kkt_residual) const {
+  const int target = findTarget(grid_info);
+  if (target < 0) return;
+  if (robot.hasFloatingBase()) {
+    robot.dSubtractConfiguration_dqf(s.q, q_targets_[target], data.J_qdiff);
+    kkt_residual.lq().noalias() 
+        += penalty_ * data.J_qdiff.transpose() * data.qdiff;
+  }
+  else {
+    kkt_residual.lq().noalias() += penalty_ * data.qdiff;
+  }
+  kkt_residual.lv().noalias() += penalty_ * (s.v-v_targets_[target]);
+}
+
+
+void ConsensusCost::evalCostHessian(Robot& robot, CostFunctionData& data, 
+                                    const GridInfo& grid_info, 
+                                    const SplitSolution& s, 
+                                    SplitKKTMatrix& kkt_matrix) const {
+  const int target = findTarget(grid_info);
+  if (target < 0) return;
+  if (robot.hasFloatingBase()) {
+    kkt_matrix.Qqq().noalias() 
+        += penalty_ * data.J_qdiff.transpose() * data.J_qdiff;
+  }
+  else {
+    kkt_matrix.Qqq().diagonal().array() += penalty_;
+  }
+  kkt_matrix.Qvv().diagonal().array() += penalty_;
+}
+
+} // namespace robotoc
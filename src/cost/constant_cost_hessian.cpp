@@ -0,0 +1,132 @@
+#include "robotoc/cost/constant_cost_hessian.hpp"
+
+#include <utility>
+
+
+namespace robotoc {
+
+ConstantCostHessian::ConstantCostHessian()
+  : hessian_(),
+    Qxx_(Structure::Zero),
+    Qxu_(Structure::Zero),
+    Quu_(Structure::Zero),
+    Qaa_(Structure::Zero),
+    Qdvdv_(Structure::Zero),
+    revision_(0),
+    mtx_() {
+}
+
+
+ConstantCostHessian::ConstantCostHessian(const ConstantCostHessian& other)
+  : hessian_(other.hessian_),
+    Qxx_(other.Qxx_),
+    Qxu_(other.Qxu_),
+    Quu_(other.Quu_),
+    Qaa_(other.Qaa_),
+    Qdvdv_(other.Qdvdv_),
+    revision_(other.revision_.load()),
+    mtx_() {
+}
+
+
+ConstantCostHessian& ConstantCostHessian::operator=(
+    const ConstantCostHessian& other) {
+  if (this != &other) {
+    hessian_ = other.hessian_;
+    Qxx_ = other.Qxx_;
+    Qxu_ = other.Qxu_;
+    Quu_ = other.Quu_;
+    Qaa_ = other.Qaa_;
+    Qdvdv_ = other.Qdvdv_;
+    revision_.store(other.revision_.load());
+  }
+  return *this;
+}
+
+
+ConstantCostHessian::ConstantCostHessian(ConstantCostHessian&& other) noexcept
+  : hessian_(std::move(other.hessian_)),
+    Qxx_(other.Qxx_),
+    Qxu_(other.Qxu_),
+    Quu_(other.Quu_),
+    Qaa_(other.Qaa_),
+    Qdvdv_(other.Qdvdv_),
+    revision_(other.revision_.load()),
+    mtx_() {
+  other.revision_.store(0);
+}
+
+
+ConstantCostHessian& ConstantCostHessian::operator=(
+    ConstantCostHessian&& other) noexcept {
+  if (this != &other) {
+    hessian_ = std::move(other.hessian_);
+    Qxx_ = other.Qxx_;
+    Qxu_ = other.Qxu_;
+    Quu_ = other.Quu_;
+    Qaa_ = other.Qaa_;
+    Qdvdv_ = other.Qdvdv_;
+    revision_.store(other.revision_.load());
+    other.revision_.store(0);
+  }
+  return *this;
+}
+
+
+SplitKKTMatrix& ConstantCostHessian::workspace(const Robot& robot) {
+  if (hessian_.Qxx.rows() != 2*robot.dimv() 
+        || hessian_.Quu.rows() != robot.dimu()) {
+    hessian_ = SplitKKTMatrix(robot);
+  }
+  hessian_.setContactDimension(0);
+  hessian_.setSwitchingConstraintDimension(0);
+  hessian_.setZero();
+  return hessian_;
+}
+
+
+void ConstantCostHessian::set(const unsigned long long revision) {
+  Qxx_   = detectStructure(hessian_.Qxx);
+  Qxu_   = detectStructure(hessian_.Qxu);
+  Quu_   = detectStructure(hessian_.Quu);
+  Qaa_   = detectStructure(hessian_.Qaa);
+  Qdvdv_ = detectStructure(hessian_.Qdvdv);
+  revision_.store(revision, std::memory_order_release);
+}
+
+
+void ConstantCostHessian::addTo(const double coeff, 
+                                SplitKKTMatrix& kkt_matrix) const {
+  add(Qxx_, coeff, hessian_.Qxx, kkt_matrix.Qxx);
+  add(Qxu_, coeff, hessian_.Qxu, kkt_matrix.Qxu);
+  add(Quu_, coeff, hessian_.Quu, kkt_matrix.Quu);
+  add(Qaa_, coeff, hessian_.Qaa, kkt_matrix.Qaa);
+  add(Qdvdv_, coeff, hessian_.Qdvdv, kkt_matrix.Qdvdv);
+}
+
+
+ConstantCostHessian::Structure ConstantCostHessian::detectStructure(
+    const Eigen::MatrixXd& mat) {
+  if (mat.size() == 0 || mat.isZero(0)) {
+    return Structure::Zero;
+  }
+  else if (mat.rows() == mat.cols() && mat.isDiagonal(0)) {
+    return Structure::Diagonal;
+  }
+  else {
+    return Structure::Dense;
+  }
+}
+
+
+void ConstantCostHessian::add(const Structure structure, const double coeff, 
+                              const Eigen::MatrixXd& src, Eigen::MatrixXd& dst) {
+  if (structure == Structure::Diagonal) {
+    dst.diagonal() += coeff * src.diagonal();
+  }
+  else if (structure == Structure::Dense) {
+    dst.noalias() += coeff * src;
+  }
+}
+
+} // namespace robotoc
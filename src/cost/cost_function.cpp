@@ -3,6 +3,7 @@
 #include <cassert>
 #include <stdexcept>
 #include <iostream>
+#include <algorithm>
 
 
 namespace robotoc {
@@ -12,7 +13,12 @@ CostFunction::CostFunction(const double discount_factor,
   : costs_(),
     discount_factor_(discount_factor),
     discount_time_step_(discount_time_step),
-    discounted_cost_(true) {
+    discounted_cost_(true),
+    constant_hessian_revision_(
+        CostFunctionComponentBase::newConstantHessianRevision()),
+    constant_stage_hessian_(),
+    constant_terminal_hessian_(),
+    constant_impact_hessian_() {
   if (discount_factor <= 0.0) {
     throw std::out_of_range("[CostFunction] invalid argument: 'discount_factor' must be positive!");
   }
@@ -29,7 +35,12 @@ CostFunction::CostFunction()
   : costs_(),
     discount_factor_(1.0),
     discount_time_step_(0.0),
-    discounted_cost_(false) {
+    discounted_cost_(false),
+    constant_hessian_revision_(
+        CostFunctionComponentBase::newConstantHessianRevision()),
+    constant_stage_hessian_(),
+    constant_terminal_hessian_(),
+    constant_impact_hessian_() {
 }
 
 
@@ -70,11 +81,15 @@ double CostFunction::discountTimeStep() const {
 
 void CostFunction::push_back(const CostFunctionComponentBasePtr& cost) {
   costs_.push_back(cost);
+  constant_hessian_revision_ 
+      = CostFunctionComponentBase::newConstantHessianRevision();
 }
 
 
 void CostFunction::clear() {
   costs_.clear();
+  constant_hessian_revision_ 
+      = CostFunctionComponentBase::newConstantHessianRevision();
 }
 
 
@@ -84,6 +99,17 @@ CostFunctionData CostFunction::createCostFunctionData(const Robot& robot) const
 }
 
 
+unsigned long long CostFunction::constantHessianRevision() const {
+  // The revisions are issued in increasing order, so that any change renews 
+  // the maximum.
+  unsigned long long revision = constant_hessian_revision_;
+  for (const auto& e : costs_) {
+    revision = std::max(revision, e->constantHessianRevision());
+  }
+  return revision;
+}
+
+
 double CostFunction::evalStageCost(Robot& robot, 
                                    const ContactStatus& contact_status, 
                                    CostFunctionData& data, 
@@ -138,12 +164,33 @@ double CostFunction::quadratizeStageCost(Robot& robot,
                                          SplitKKTMatrix& kkt_matrix) const {
   assert(grid_info.dt > 0);
   double l = 0;
+  bool has_constant_hessian = false;
   for (const auto e : costs_) {
     l += e->evalStageCost(robot, contact_status, data, grid_info, s);
     e->evalStageCostDerivatives(robot, contact_status, data, grid_info, s,
                                 kkt_residual);
-    e->evalStageCostHessian(robot, contact_status, data, grid_info, s,
-                            kkt_matrix);
+    if (e->hasConstantHessian()) {
+      has_constant_hessian = true;
+    }
+    else {
+      e->evalStageCostHessian(robot, contact_status, data, grid_info, s,
+                              kkt_matrix);
+    }
+  }
+  if (has_constant_hessian) {
+    constant_stage_hessian_.update(robot, constantHessianRevision(), 
+                                   [&](SplitKKTMatrix& hessian) {
+      // Evaluates the Hessians per unit time step.
+      GridInfo grid_info_unit = grid_info;
+      grid_info_unit.dt = 1.0;
+      for (const auto e : costs_) {
+        if (e->hasConstantHessian()) {
+          e->evalStageCostHessian(robot, contact_status, data, grid_info_unit, 
+                                  s, hessian);
+        }
+      }
+    });
+    constant_stage_hessian_.addTo(grid_info.dt, kkt_matrix);
   }
   if (discounted_cost_) {
     const double f = discount(grid_info.t0, grid_info.t);
@@ -205,10 +252,27 @@ double CostFunction::quadratizeTerminalCost(Robot& robot,
                                             SplitKKTResidual& kkt_residual, 
                                             SplitKKTMatrix& kkt_matrix) const {
   double l = 0;
+  bool has_constant_hessian = false;
   for (const auto e : costs_) {
     l += e->evalTerminalCost(robot, data, grid_info, s);
     e->evalTerminalCostDerivatives(robot, data, grid_info, s, kkt_residual);
-    e->evalTerminalCostHessian(robot, data, grid_info, s, kkt_matrix);
+    if (e->hasConstantHessian()) {
+      has_constant_hessian = true;
+    }
+    else {
+      e->evalTerminalCostHessian(robot, data, grid_info, s, kkt_matrix);
+    }
+  }
+  if (has_constant_hessian) {
+    constant_terminal_hessian_.update(robot, constantHessianRevision(), 
+                                      [&](SplitKKTMatrix& hessian) {
+      for (const auto e : costs_) {
+        if (e->hasConstantHessian()) {
+          e->evalTerminalCostHessian(robot, data, grid_info, s, hessian);
+        }
+      }
+    });
+    constant_terminal_hessian_.addTo(1.0, kkt_matrix);
   }
   if (discounted_cost_) {
     const double f = discount(grid_info.t0, grid_info.t);
@@ -270,12 +334,30 @@ double CostFunction::quadratizeImpactCost(Robot& robot,
                                            SplitKKTResidual& kkt_residual, 
                                            SplitKKTMatrix& kkt_matrix) const {
   double l = 0;
+  bool has_constant_hessian = false;
   for (const auto e : costs_) {
     l += e->evalImpactCost(robot, impact_status, data, grid_info, s);
     e->evalImpactCostDerivatives(robot, impact_status, data, grid_info, s, 
                                   kkt_residual);
-    e->evalImpactCostHessian(robot, impact_status, data, grid_info, s, 
-                              kkt_matrix);
+    if (e->hasConstantHessian()) {
+      has_constant_hessian = true;
+    }
+    else {
+      e->evalImpactCostHessian(robot, impact_status, data, grid_info, s, 
+                                kkt_matrix);
+    }
+  }
+  if (has_constant_hessian) {
+    constant_impact_hessian_.update(robot, constantHessianRevision(), 
+                                    [&](SplitKKTMatrix& hessian) {
+      for (const auto e : costs_) {
+        if (e->hasConstantHessian()) {
+          e->evalImpactCostHessian(robot, impact_status, data, grid_info, s, 
+                                    hessian);
+        }
+      }
+    });
+    constant_impact_hessian_.addTo(1.0, kkt_matrix);
   }
   if (discounted_cost_) {
     const double f = discount(grid_info.t0, grid_info.t);
@@ -0,0 +1,178 @@
+#include "robotoc/cost/quasi_newton_cost_hessian.hpp"
+
+#include <limits>
+#include <algorithm>
+#include <cassert>
+
+
+namespace robotoc {
+
+QuasiNewtonCostHessian::QuasiNewtonCostHessian(const Robot& robot)
+  : Bxu_(),
+    Baa_(),
+    Bff_(),
+    q_prev_(),
+    a_prev_(),
+    f_prev_(),
+    lxu_prev_(),
+    la_prev_(),
+    lf_prev_(),
+    sxu_(),
+    Bs_(),
+    dt_prev_(0),
+    dimv_(robot.dimv()),
+    dimu_(robot.dimu()),
+    max_dimf_(robot.max_dimf()),
+    dimf_(0),
+    initialized_(false) {
+}
+
+
+QuasiNewtonCostHessian::QuasiNewtonCostHessian()
+  : Bxu_(),
+    Baa_(),
+    Bff_(),
+    q_prev_(),
+    a_prev_(),
+    f_prev_(),
+    lxu_prev_(),
+    la_prev_(),
+    lf_prev_(),
+    sxu_(),
+    Bs_(),
+    dt_prev_(0),
+    dimv_(0),
+    dimu_(0),
+    max_dimf_(0),
+    dimf_(0),
+    initialized_(false) {
+}
+
+
+void QuasiNewtonCostHessian::reset() {
+  initialized_ = false;
+}
+
+
+void QuasiNewtonCostHessian::init(const double dt, const SplitSolution& s, 
+                                  const SplitKKTResidual& kkt_residual, 
+                                  const SplitKKTMatrix& kkt_matrix) {
+  assert(kkt_matrix.dimf() == s.dimf());
+  const int dimx = 2 * dimv_;
+  if (Bxu_.rows() != dimx+dimu_) {
+    allocate();
+  }
+  dimf_ = s.dimf();
+  Bxu_.topLeftCorner(dimx, dimx) = kkt_matrix.Qxx;
+  Bxu_.topRightCorner(dimx, dimu_) = kkt_matrix.Qxu;
+  Bxu_.bottomLeftCorner(dimu_, dimx) = kkt_matrix.Qxu.transpose();
+  Bxu_.bottomRightCorner(dimu_, dimu_) = kkt_matrix.Quu;
+  Baa_ = kkt_matrix.Qaa;
+  Bff_.topLeftCorner(dimf_, dimf_) = kkt_matrix.Qff();
+  store(dt, s, kkt_residual);
+  initialized_ = true;
+}
+
+
+void QuasiNewtonCostHessian::update(const Robot& robot, const double dt, 
+                                    const SplitSolution& s, 
+                                    const SplitKKTResidual& kkt_residual) {
+  assert(isInitialized(s.dimf()));
+  assert(dt > 0);
+  // The stage cost and its derivatives are proportional to the time step.
+  const double ratio = dt / dt_prev_;
+  if (ratio != 1.0) {
+    Bxu_.array() *= ratio;
+    Baa_.array() *= ratio;
+    Bff_.topLeftCorner(dimf_, dimf_).array() *= ratio;
+  }
+  robot.subtractConfiguration(s.q, q_prev_, sxu_.head(dimv_));
+  sxu_.segment(dimv_, dimv_) = s.v - sxu_.segment(dimv_, dimv_);
+  sxu_.tail(dimu_) = s.u - sxu_.tail(dimu_);
+  lxu_prev_.head(2*dimv_) = kkt_residual.lx - ratio * lxu_prev_.head(2*dimv_);
+  lxu_prev_.tail(dimu_) = kkt_residual.lu - ratio * lxu_prev_.tail(dimu_);
+  dampedBFGSUpdate(sxu_, lxu_prev_, Bxu_, Bs_.head(2*dimv_+dimu_));
+  a_prev_ = s.a - a_prev_;
+  la_prev_ = kkt_residual.la - ratio * la_prev_;
+  dampedBFGSUpdate(a_prev_, la_prev_, Baa_, Bs_.head(dimv_));
+  if (dimf_ > 0) {
+    f_prev_.head(dimf_) = s.f_stack() - f_prev_.head(dimf_);
+    lf_prev_.head(dimf_) = kkt_residual.lf() - ratio * lf_prev_.head(dimf_);
+    dampedBFGSUpdate(f_prev_.head(dimf_), lf_prev_.head(dimf_), 
+                     Bff_.topLeftCorner(dimf_, dimf_), Bs_.head(dimf_));
+  }
+  store(dt, s, kkt_residual);
+}
+
+
+void QuasiNewtonCostHessian::addTo(SplitKKTMatrix& kkt_matrix) const {
+  assert(kkt_matrix.dimf() == dimf_);
+  const int dimx = 2 * dimv_;
+  kkt_matrix.Qxx.noalias() += Bxu_.topLeftCorner(dimx, dimx);
+  kkt_matrix.Qxu.noalias() += Bxu_.topRightCorner(dimx, dimu_);
+  kkt_matrix.Quu.noalias() += Bxu_.bottomRightCorner(dimu_, dimu_);
+  kkt_matrix.Qaa.noalias() += Baa_;
+  kkt_matrix.Qff().noalias() += Bff_.topLeftCorner(dimf_, dimf_);
+}
+
+
+void QuasiNewtonCostHessian::dampedBFGSUpdate(
+    const Eigen::Ref<const Eigen::VectorXd>& s, 
+    const Eigen::Ref<const Eigen::VectorXd>& y, Eigen::Ref<Eigen::MatrixXd> B, 
+    Eigen::Ref<Eigen::VectorXd> Bs) {
+  assert(s.size() == y.size());
+  assert(B.rows() == s.size());
+  assert(B.cols() == s.size());
+  assert(Bs.size() == s.size());
+  constexpr double eps = std::numeric_limits<double>::epsilon();
+  const double ss = s.squaredNorm();
+  if (ss <= eps) return;
+  Bs.noalias() = B * s;
+  const double sBs = s.dot(Bs);
+  const double sy = s.dot(y);
+  if (sBs <= eps * ss) {
+    // B is singular along s, e.g., if the exact Hessian is zero. 
+    if (sy > eps * ss) {
+      B.noalias() += (1.0/sy) * y * y.transpose();
+    }
+    return;
+  }
+  // Powell's damping keeps B positive definite along s.
+  const double theta = (sy >= 0.2*sBs) ? 1.0 : (0.8*sBs/(sBs-sy));
+  const double sr = theta * sy + (1.0-theta) * sBs;
+  B.noalias() -= (1.0/sBs) * Bs * Bs.transpose();
+  Bs = theta * y + (1.0-theta) * Bs;
+  B.noalias() += (1.0/sr) * Bs * Bs.transpose();
+}
+
+
+void QuasiNewtonCostHessian::allocate() {
+  const int dimxu = 2 * dimv_ + dimu_;
+  Bxu_.setZero(dimxu, dimxu);
+  Baa_.setZero(dimv_, dimv_);
+  Bff_.setZero(max_dimf_, max_dimf_);
+  a_prev_.setZero(dimv_);
+  f_prev_.setZero(max_dimf_);
+  lxu_prev_.setZero(dimxu);
+  la_prev_.setZero(dimv_);
+  lf_prev_.setZero(max_dimf_);
+  sxu_.setZero(dimxu);
+  Bs_.setZero(std::max(dimxu, max_dimf_));
+}
+
+
+void QuasiNewtonCostHessian::store(const double dt, const SplitSolution& s, 
+                                   const SplitKKTResidual& kkt_residual) {
+  dt_prev_ = dt;
+  q_prev_ = s.q;
+  sxu_.segment(dimv_, dimv_) = s.v;
+  sxu_.tail(dimu_) = s.u;
+  a_prev_ = s.a;
+  f_prev_.head(dimf_) = s.f_stack();
+  lxu_prev_.head(2*dimv_) = kkt_residual.lx;
+  lxu_prev_.tail(dimu_) = kkt_residual.lu;
+  la_prev_ = kkt_residual.la;
+  lf_prev_.head(dimf_) = kkt_residual.lf();
+}
+
+} // namespace robotoc
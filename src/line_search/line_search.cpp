@@ -4,6 +4,8 @@
 #include <iostream>
 #include <cassert>
 
+#include "robotoc/utils/tracer.hpp"
+
 
 namespace robotoc {
 
@@ -29,6 +31,7 @@ double LineSearch::computeStepSize(
     const TimeDiscretization& time_discretization,
     const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s, 
     const Direction& d, const double max_primal_step_size) {
+  ROBOTOC_TRACE_SCOPE("LineSearch::computeStepSize");
   assert(max_primal_step_size > 0);
   assert(max_primal_step_size <= 1);
   double primal_step_size = max_primal_step_size;
@@ -106,6 +109,7 @@ double LineSearch::lineSearchFilterMethod(
   }
   double primal_step_size = max_primal_step_size;
   while (primal_step_size > settings_.min_step_size) {
+    ROBOTOC_TRACE_SCOPE("LineSearch::trial");
     computeSolutionTrial(robots, time_discretization, s, d, primal_step_size);
     dms.evalOCP(robots, time_discretization, q, v, s_trial_, kkt_residual_);
     const double cost = dms.getEval().cost;
@@ -133,6 +137,7 @@ double LineSearch::meritBacktrackingLineSearch(
   const double directional_derivative =  (1.0 / settings_.eps) * (merit_eps - merit_now);
   double primal_step_size = max_primal_step_size;
   while (primal_step_size > settings_.min_step_size) {
+    ROBOTOC_TRACE_SCOPE("LineSearch::trial");
     computeSolutionTrial(robots, time_discretization, s, d, primal_step_size);
     dms.evalOCP(robots, time_discretization, q, v, s_trial_, kkt_residual_);
     const double merit_next = penalty_param * dms.getEval().cost + dms.getEval().primal_feasibility;
@@ -10,12 +10,14 @@
 
 namespace robotoc {
 
-MPCBipedWalk::MPCBipedWalk(const Robot& robot, const double T, const int N)
+MPCBipedWalk::MPCBipedWalk(const Robot& robot, const double T, const int N,
+                            const double grading_ratio)
   : foot_step_planner_(),
     contact_sequence_(std::make_shared<robotoc::ContactSequence>(robot)),
     cost_(std::make_shared<CostFunction>()),
     constraints_(std::make_shared<Constraints>(1.0e-03, 0.995)),
-    ocp_solver_(OCP(robot, cost_, constraints_, contact_sequence_, T, N), 
+    ocp_solver_(OCP(robot, cost_, constraints_, contact_sequence_, T, N, 0, 
+                    grading_ratio), 
                 SolverOptions()), 
     solver_options_(SolverOptions()),
     cs_standing_(robot.createContactStatus()),
@@ -27,7 +29,7 @@ MPCBipedWalk::MPCBipedWalk(const Robot& robot, const double T, const int N)
     swing_start_time_(0),
     T_(T),
     dt_(T/N),
-    dtm_(T/N),
+    dtm_(ocp_solver_.getTimeDiscretization().nominalTimeStep(N-1)),
     ts_last_(0),
     eps_(std::sqrt(std::numeric_limits<double>::epsilon())),
     N_(N),
@@ -194,7 +196,7 @@ void MPCBipedWalk::updateSolution(const double t, const double dt,
                                  const Eigen::VectorXd& v) {
   assert(dt > 0);
   const bool add_step = addStep(t);
-  const auto ts = contact_sequence_->eventTimes();
+  const auto& ts = contact_sequence_->eventTimes();
   bool remove_step = false;
   if (!ts.empty()) {
     if (ts.front()+eps_ < t+dt) {
@@ -299,7 +301,7 @@ bool MPCBipedWalk::addStep(const double t) {
       else {
         tt += swing_time_;
       }
-      const auto ts = contact_sequence_->eventTimes();
+      const auto& ts = contact_sequence_->eventTimes();
       if (!ts.empty()) {
         if (predict_step_%2 == 0) {
           tt = ts.back() + double_support_time_;
@@ -324,7 +326,7 @@ bool MPCBipedWalk::addStep(const double t) {
     }
     else {
       double tt = ts_last_ + swing_time_;
-      const auto ts = contact_sequence_->eventTimes();
+      const auto& ts = contact_sequence_->eventTimes();
       if (!ts.empty()) {
         tt = ts.back() + swing_time_;
       }
@@ -10,12 +10,14 @@
 
 namespace robotoc {
 
-MPCCrawl::MPCCrawl(const Robot& robot, const double T, const int N)
+MPCCrawl::MPCCrawl(const Robot& robot, const double T, const int N,
+                    const double grading_ratio)
   : foot_step_planner_(),
     contact_sequence_(std::make_shared<robotoc::ContactSequence>(robot)),
     cost_(std::make_shared<CostFunction>()),
     constraints_(std::make_shared<Constraints>(1.0e-03, 0.995)),
-    ocp_solver_(OCP(robot, cost_, constraints_, contact_sequence_, T, N), 
+    ocp_solver_(OCP(robot, cost_, constraints_, contact_sequence_, T, N, 0, 
+                    grading_ratio), 
                 SolverOptions()), 
     solver_options_(SolverOptions()),
     cs_standing_(robot.createContactStatus()),
@@ -29,7 +31,7 @@ MPCCrawl::MPCCrawl(const Robot& robot, const double T, const int N)
     swing_start_time_(0),
     T_(T),
     dt_(T/N),
-    dtm_(T/N),
+    dtm_(ocp_solver_.getTimeDiscretization().nominalTimeStep(N-1)),
     ts_last_(0),
     eps_(std::sqrt(std::numeric_limits<double>::epsilon())),
     N_(N),
@@ -163,7 +165,9 @@ void MPCCrawl::setGaitPattern(const std::shared_ptr<ContactPlannerBase>& foot_st
 
 void MPCCrawl::init(const double t, const Eigen::VectorXd& q, 
                     const Eigen::VectorXd& v, 
-                    const SolverOptions& solver_options) {
+                    const SolverOptions& solver_options,
+                    const std::shared_ptr<WarmStartLibrary>& warm_start_library,
+                    const Eigen::VectorXd& command) {
   if (t >= swing_start_time_) {
     throw std::out_of_range(
         "[MPCCrawl] invalid argument: 't' must be less than " + std::to_string(swing_start_time_) + "!");
@@ -184,8 +188,17 @@ void MPCCrawl::init(const double t, const Eigen::VectorXd& q,
   resetContactPlacements(t, q, v);
   ocp_solver_.setSolution("q", q);
   ocp_solver_.setSolution("v", v);
+  const WarmStartKey warm_start_key("crawl", 
+                                    WarmStartLibrary::contactPattern(*contact_sequence_),
+                                    command);
+  if (warm_start_library) {
+    warm_start_library->warmStart(warm_start_key, t, q, ocp_solver_);
+  }
   ocp_solver_.setSolverOptions(solver_options);
   ocp_solver_.solve(t, q, v, true);
+  if (warm_start_library && ocp_solver_.getSolverStatistics().convergence) {
+    warm_start_library->add(warm_start_key, ocp_solver_);
+  }
   s_ = ocp_solver_.getSolution();
   ts_last_ = swing_start_time_;
 }
@@ -213,7 +226,7 @@ void MPCCrawl::updateSolution(const double t, const double dt,
                               const Eigen::VectorXd& v) {
   assert(dt > 0);
   const bool add_step = addStep(t);
-  const auto ts = contact_sequence_->eventTimes();
+  const auto& ts = contact_sequence_->eventTimes();
   bool remove_step = false;
   if (!ts.empty()) {
     if (ts.front()+eps_ < t+dt) {
@@ -313,7 +326,7 @@ bool MPCCrawl::addStep(const double t) {
       else {
         tt += swing_time_;
       }
-      const auto ts = contact_sequence_->eventTimes();
+      const auto& ts = contact_sequence_->eventTimes();
       if (!ts.empty()) {
         if (predict_step_%2 == 0) {
           tt = ts.back() + stance_time_;
@@ -344,7 +357,7 @@ bool MPCCrawl::addStep(const double t) {
     }
     else {
       double tt = ts_last_ + swing_time_;
-      const auto ts = contact_sequence_->eventTimes();
+      const auto& ts = contact_sequence_->eventTimes();
       if (!ts.empty()) {
         tt = ts.back() + swing_time_;
       }
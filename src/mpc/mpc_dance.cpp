@@ -179,7 +179,9 @@ void MPCDance::setGaitPattern(const std::shared_ptr<ContactPlannerBase>& foot_st
 
 void MPCDance::init(const double t, const Eigen::VectorXd& q, 
                          const Eigen::VectorXd& v, 
-                         const SolverOptions& solver_options) {
+                         const SolverOptions& solver_options,
+                         const std::shared_ptr<WarmStartLibrary>& warm_start_library,
+                         const Eigen::VectorXd& command) {
   total_discrete_events_ = 17;
   current_step_ = 0;
   predict_step_ = 0;
@@ -208,8 +210,17 @@ void MPCDance::init(const double t, const Eigen::VectorXd& q,
   resetContactPlacements(t, q, v);
   ocp_solver_.setSolution("q", q);
   ocp_solver_.setSolution("v", v);
+  const WarmStartKey warm_start_key("dance", 
+                                    WarmStartLibrary::contactPattern(*contact_sequence_),
+                                    command);
+  if (warm_start_library) {
+    warm_start_library->warmStart(warm_start_key, t, q, ocp_solver_);
+  }
   ocp_solver_.setSolverOptions(solver_options);
   ocp_solver_.solve(t, q, v, true);
+  if (warm_start_library && ocp_solver_.getSolverStatistics().convergence) {
+    warm_start_library->add(warm_start_key, ocp_solver_);
+  }
 }
 
 
@@ -235,7 +246,7 @@ void MPCDance::updateSolution(const double t, const double dt,
                                    const Eigen::VectorXd& v) {
   assert(dt > 0);
   const bool add_step = addStep(t);
-  const auto ts = contact_sequence_->eventTimes();
+  const auto& ts = contact_sequence_->eventTimes();
   bool remove_step = false;
   if (!ts.empty()) {
     if (ts.front()+eps_ < t+dt) {
@@ -10,12 +10,14 @@
 
 namespace robotoc {
 
-MPCFlyingTrot::MPCFlyingTrot(const Robot& robot, const double T, const int N)
+MPCFlyingTrot::MPCFlyingTrot(const Robot& robot, const double T, const int N,
+                              const double grading_ratio)
   : foot_step_planner_(),
     contact_sequence_(std::make_shared<robotoc::ContactSequence>(robot)),
     cost_(std::make_shared<CostFunction>()),
     constraints_(std::make_shared<Constraints>(1.0e-03, 0.995)),
-    ocp_solver_(OCP(robot, cost_, constraints_, contact_sequence_, T, N), 
+    ocp_solver_(OCP(robot, cost_, constraints_, contact_sequence_, T, N, 0, 
+                    grading_ratio), 
                 SolverOptions()), 
     solver_options_(SolverOptions()),
     cs_standing_(robot.createContactStatus()),
@@ -28,7 +30,7 @@ MPCFlyingTrot::MPCFlyingTrot(const Robot& robot, const double T, const int N)
     swing_start_time_(0),
     T_(T),
     dt_(T/N),
-    dtm_(T/N),
+    dtm_(ocp_solver_.getTimeDiscretization().nominalTimeStep(N-1)),
     ts_last_(0),
     eps_(std::sqrt(std::numeric_limits<double>::epsilon())),
     N_(N),
@@ -217,7 +219,7 @@ void MPCFlyingTrot::updateSolution(const double t, const double dt,
                                    const Eigen::VectorXd& v) {
   assert(dt > 0);
   const bool add_step = addStep(t);
-  const auto ts = contact_sequence_->eventTimes();
+  const auto& ts = contact_sequence_->eventTimes();
   bool remove_step = false;
   if (!ts.empty()) {
     if (ts.front()+eps_ < t+dt) {
@@ -321,7 +323,7 @@ bool MPCFlyingTrot::addStep(const double t) {
     else {
       tt += stance_time_;
     }
-    const auto ts = contact_sequence_->eventTimes();
+    const auto& ts = contact_sequence_->eventTimes();
     if (!ts.empty()) {
       if (predict_step_%2 == 0) {
         tt = ts.back() + flying_time_;
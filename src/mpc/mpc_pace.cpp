@@ -10,12 +10,14 @@
 
 namespace robotoc {
 
-MPCPace::MPCPace(const Robot& robot, const double T, const int N)
+MPCPace::MPCPace(const Robot& robot, const double T, const int N,
+                  const double grading_ratio)
   : foot_step_planner_(),
     contact_sequence_(std::make_shared<robotoc::ContactSequence>(robot)),
     cost_(std::make_shared<CostFunction>()),
     constraints_(std::make_shared<Constraints>(1.0e-03, 0.995)),
-    ocp_solver_(OCP(robot, cost_, constraints_, contact_sequence_, T, N), 
+    ocp_solver_(OCP(robot, cost_, constraints_, contact_sequence_, T, N, 0, 
+                    grading_ratio), 
                 SolverOptions()), 
     solver_options_(SolverOptions()),
     cs_standing_(robot.createContactStatus()),
@@ -27,7 +29,7 @@ MPCPace::MPCPace(const Robot& robot, const double T, const int N)
     swing_start_time_(0),
     T_(T),
     dt_(T/N),
-    dtm_(T/N),
+    dtm_(ocp_solver_.getTimeDiscretization().nominalTimeStep(N-1)),
     ts_last_(0),
     eps_(std::sqrt(std::numeric_limits<double>::epsilon())),
     N_(N),
@@ -208,7 +210,7 @@ void MPCPace::updateSolution(const double t, const double dt,
                              const Eigen::VectorXd& v) {
   assert(dt > 0);
   const bool add_step = addStep(t);
-  const auto ts = contact_sequence_->eventTimes();
+  const auto& ts = contact_sequence_->eventTimes();
   const auto n =  contact_sequence_->numContactPhases();
   std::cout<<n;
   bool remove_step = false;
@@ -310,7 +312,7 @@ bool MPCPace::addStep(const double t) {
       else {
         tt += swing_time_;
       }
-      const auto ts = contact_sequence_->eventTimes();
+      const auto& ts = contact_sequence_->eventTimes();
       if (!ts.empty()) {
         if (predict_step_%2 == 0) {
           tt = ts.back() + stance_time_;
@@ -335,7 +337,7 @@ bool MPCPace::addStep(const double t) {
     }
     else {
       double tt = ts_last_ + swing_time_;
-      const auto ts = contact_sequence_->eventTimes();
+      const auto& ts = contact_sequence_->eventTimes();
       if (!ts.empty()) {
         tt = ts.back() + swing_time_;
       }
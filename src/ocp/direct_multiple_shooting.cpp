@@ -1,22 +1,47 @@
 #include "robotoc/ocp/direct_multiple_shooting.hpp"
 
-#include <omp.h>
 #include <stdexcept>
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <functional>
+
+#include "robotoc/utils/tracer.hpp"
 
 
 namespace robotoc{
 
+namespace {
+// Names of the trace events of the stage-wise evaluations of the KKT 
+// systems, which distinguish the stages of the different costs.
+inline const char* evalKKTTraceName(const GridType type) {
+  switch (type) {
+    case GridType::Terminal:
+      return "evalKKT/terminal";
+    case GridType::Impact:
+      return "evalKKT/impact";
+    case GridType::Lift:
+      return "evalKKT/lift";
+    default:
+      return "evalKKT/intermediate";
+  }
+}
+} // namespace
+
 DirectMultipleShooting::DirectMultipleShooting(const OCP& ocp, const int nthreads)
   : ocp_data_(),
     intermediate_stage_(ocp.cost, ocp.constraints, ocp.contact_sequence),
     impact_stage_(ocp.cost, ocp.constraints, ocp.contact_sequence),
     terminal_stage_(ocp.cost, ocp.constraints, ocp.contact_sequence),
     performance_index_(),
-    max_primal_step_sizes_(Eigen::VectorXd::Ones(ocp.N+1+ocp.reserved_num_discrete_events)), 
-    max_dual_step_sizes_(Eigen::VectorXd::Ones(ocp.N+1+ocp.reserved_num_discrete_events)),
-    nthreads_(nthreads) {
+    max_primal_step_size_(1.0), 
+    max_dual_step_size_(1.0),
+    lu_block_(Eigen::VectorXd::Zero(ocp.robot.dimu())),
+    is_feasible_(nthreads, true),
+    performance_index_sum_(nthreads),
+    min_primal_step_size_(nthreads, 1.0),
+    min_dual_step_size_(nthreads, 1.0),
+    thread_pool_(nthreads) {
   ocp_data_.resize(ocp.N+1+ocp.reserved_num_discrete_events);
   for (int i=0; i<ocp.N+1+ocp.reserved_num_discrete_events; ++i) {
     ocp_data_[i] = intermediate_stage_.createData(ocp.robot);
@@ -30,17 +55,33 @@ DirectMultipleShooting::DirectMultipleShooting()
     impact_stage_(),
     terminal_stage_(),
     performance_index_(),
-    max_primal_step_sizes_(), 
-    max_dual_step_sizes_(),
-    nthreads_(0) {
+    max_primal_step_size_(1.0), 
+    max_dual_step_size_(1.0),
+    lu_block_(),
+    is_feasible_(),
+    performance_index_sum_(),
+    min_primal_step_size_(),
+    min_dual_step_size_(),
+    thread_pool_() {
 }
 
 
-void DirectMultipleShooting::setNumThreads(const int nthreads) {
+void DirectMultipleShooting::setNumThreads(const int nthreads, 
+                                           const bool enable_thread_pinning) {
   if (nthreads <= 0) {
     throw std::out_of_range("[DirectMultipleShooting] invalid argument: nthreads must be positive!");
   }
-  nthreads_ = nthreads;
+  thread_pool_.setNumThreads(nthreads, enable_thread_pinning);
+  is_feasible_.setNumThreads(nthreads);
+  performance_index_sum_.setNumThreads(nthreads);
+  min_primal_step_size_.setNumThreads(nthreads);
+  min_dual_step_size_.setNumThreads(nthreads);
+}
+
+
+void DirectMultipleShooting::setHessianApproximation(
+    const HessianApproximation hessian_approximation) {
+  intermediate_stage_.setHessianApproximation(hessian_approximation);
 }
 
 
@@ -49,22 +90,21 @@ void DirectMultipleShooting::initConstraints(
     const Solution& s) {
   resizeData(time_discretization);
   const int N = time_discretization.size() - 1;
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<=N; ++i) {
+  thread_pool_.parallelFor(N+1, [&](const int i, const int thread_id) {
     const auto& grid = time_discretization[i];
     if (grid.type == GridType::Terminal) {
-      terminal_stage_.initConstraints(robots[omp_get_thread_num()], 
+      terminal_stage_.initConstraints(robots[thread_id], 
                                       grid, s[i], ocp_data_[i]);
     }
     else if (grid.type == GridType::Impact) {
-      impact_stage_.initConstraints(robots[omp_get_thread_num()], 
+      impact_stage_.initConstraints(robots[thread_id], 
                                     grid, s[i], ocp_data_[i]);
     }
     else {
-      intermediate_stage_.initConstraints(robots[omp_get_thread_num()], 
+      intermediate_stage_.initConstraints(robots[thread_id], 
                                           grid, s[i], ocp_data_[i]);
     }
-  }
+  });
 }
 
 
@@ -73,27 +113,28 @@ bool DirectMultipleShooting::isFeasible(
     const Solution& s) {
   const int N = time_discretization.size() - 1;
   assert(ocp_data_.size() >= N+1);
-  std::vector<bool> is_feasible(N+1, true);
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<=N; ++i) {
+  is_feasible_.reset(true);
+  thread_pool_.parallelFor(N+1, [&](const int i, const int thread_id) {
     const auto& grid = time_discretization[i];
+    bool is_feasible = true;
     if (grid.type == GridType::Terminal) {
-      is_feasible[i] = terminal_stage_.isFeasible(robots[omp_get_thread_num()], 
-                                                  grid, s[i], ocp_data_[i]);
+      is_feasible = terminal_stage_.isFeasible(robots[thread_id], 
+                                               grid, s[i], ocp_data_[i]);
     }
     else if (grid.type == GridType::Impact) {
-      is_feasible[i] = impact_stage_.isFeasible(robots[omp_get_thread_num()], 
-                                                grid, s[i], ocp_data_[i]);
+      is_feasible = impact_stage_.isFeasible(robots[thread_id], 
+                                             grid, s[i], ocp_data_[i]);
     }
     else {
-      is_feasible[i] = intermediate_stage_.isFeasible(robots[omp_get_thread_num()], 
-                                                      grid, s[i], ocp_data_[i]);
+      is_feasible = intermediate_stage_.isFeasible(robots[thread_id], 
+                                                   grid, s[i], ocp_data_[i]);
     }
-  }
-  for (const auto e : is_feasible) {
-    if (!e) return false;
-  }
-  return true;
+    if (!is_feasible) {
+      is_feasible_.local(thread_id) = false;
+    }
+  });
+  return is_feasible_.reduce(true, [](const bool a, const bool b) { 
+                                     return (a && b); });
 }
 
 
@@ -101,28 +142,28 @@ void DirectMultipleShooting::evalOCP(
     aligned_vector<Robot>& robots, const TimeDiscretization& time_discretization, 
     const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s, 
     KKTResidual& kkt_residual) {
+  ROBOTOC_TRACE_SCOPE("DirectMultipleShooting::evalOCP");
   const int N = time_discretization.size() - 1;
   assert(ocp_data_.size() >= N+1);
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<=N; ++i) {
+  performance_index_sum_.reset(PerformanceIndex());
+  thread_pool_.parallelFor(N+1, [&](const int i, const int thread_id) {
     const auto& grid = time_discretization[i];
     if (grid.type == GridType::Terminal) {
-      terminal_stage_.evalOCP(robots[omp_get_thread_num()], grid, s[i],  
+      terminal_stage_.evalOCP(robots[thread_id], grid, s[i],  
                               ocp_data_[i], kkt_residual[i]);
     }
     else if (grid.type == GridType::Impact) {
-      impact_stage_.evalOCP(robots[omp_get_thread_num()], grid, s[i], s[i+1], 
+      impact_stage_.evalOCP(robots[thread_id], grid, s[i], s[i+1], 
                             ocp_data_[i], kkt_residual[i]);
     }
     else {
-      intermediate_stage_.evalOCP(robots[omp_get_thread_num()], grid, s[i], s[i+1], 
+      intermediate_stage_.evalOCP(robots[thread_id], grid, s[i], s[i+1], 
                                   ocp_data_[i], kkt_residual[i]);
     }
-  }
-  performance_index_.setZero();
-  for (int i=0; i<=N; ++i) {
-    performance_index_ += ocp_data_[i].performance_index;
-  }
+    performance_index_sum_.local(thread_id) += ocp_data_[i].performance_index;
+  });
+  performance_index_ = performance_index_sum_.reduce(
+      PerformanceIndex(), std::plus<PerformanceIndex>());
 }
 
 
@@ -130,31 +171,71 @@ void DirectMultipleShooting::evalKKT(
     aligned_vector<Robot>& robots, const TimeDiscretization& time_discretization, 
     const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s, 
     KKTMatrix& kkt_matrix, KKTResidual& kkt_residual) {
+  ROBOTOC_TRACE_SCOPE("DirectMultipleShooting::evalKKT");
   const int N = time_discretization.size() - 1;
   assert(ocp_data_.size() >= N+1);
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<=N; ++i) {
+  performance_index_sum_.reset(PerformanceIndex());
+  thread_pool_.parallelFor(N+1, [&](const int i, const int thread_id) {
     const auto& grid = time_discretization[i];
+    ROBOTOC_TRACE_STAGE_SCOPE(evalKKTTraceName(grid.type), i);
     if (grid.type == GridType::Terminal) {
-      terminal_stage_.evalKKT(robots[omp_get_thread_num()], grid, s[i-1].q, s[i], 
+      terminal_stage_.evalKKT(robots[thread_id], grid, s[i-1].q, s[i], 
                               ocp_data_[i], kkt_matrix[i], kkt_residual[i]);
     }
     else if (grid.type == GridType::Impact) {
-      impact_stage_.evalKKT(robots[omp_get_thread_num()], grid, s[i-1].q, s[i], s[i+1],
+      impact_stage_.evalKKT(robots[thread_id], grid, s[i-1].q, s[i], s[i+1],
                             ocp_data_[i], kkt_matrix[i], kkt_residual[i]);
     }
     else if (i == 0) {
-      intermediate_stage_.evalKKT(robots[omp_get_thread_num()], grid, q, s[i], s[i+1], 
+      intermediate_stage_.evalKKT(robots[thread_id], grid, q, s[i], s[i+1], 
                                   ocp_data_[i], kkt_matrix[i], kkt_residual[i]);
     }
     else {
-      intermediate_stage_.evalKKT(robots[omp_get_thread_num()], grid, s[i-1].q, s[i], s[i+1],
+      intermediate_stage_.evalKKT(robots[thread_id], grid, s[i-1].q, s[i], s[i+1],
                                   ocp_data_[i], kkt_matrix[i], kkt_residual[i]);
     }
+    performance_index_sum_.local(thread_id) += ocp_data_[i].performance_index;
+  });
+  performance_index_ = performance_index_sum_.reduce(
+      PerformanceIndex(), std::plus<PerformanceIndex>());
+  if (time_discretization.moveBlockingSize() > 1) {
+    evalMoveBlockingKKTError(time_discretization);
   }
-  performance_index_.setZero();
-  for (int i=0; i<=N; ++i) {
-    performance_index_ += ocp_data_[i].performance_index;
+}
+
+
+void DirectMultipleShooting::evalKKTResidual(
+    aligned_vector<Robot>& robots, const TimeDiscretization& time_discretization, 
+    const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s, 
+    KKTMatrix& kkt_matrix, KKTResidual& kkt_residual) {
+  ROBOTOC_TRACE_SCOPE("DirectMultipleShooting::evalKKTResidual");
+  const int N = time_discretization.size() - 1;
+  assert(ocp_data_.size() >= N+1);
+  performance_index_sum_.reset(PerformanceIndex());
+  thread_pool_.parallelFor(N+1, [&](const int i, const int thread_id) {
+    const auto& grid = time_discretization[i];
+    if (grid.type == GridType::Terminal) {
+      terminal_stage_.evalKKTResidual(robots[thread_id], grid, s[i-1].q, s[i], 
+                                      ocp_data_[i], kkt_matrix[i], kkt_residual[i]);
+    }
+    else if (grid.type == GridType::Impact) {
+      impact_stage_.evalKKTResidual(robots[thread_id], grid, s[i-1].q, s[i], s[i+1],
+                                    ocp_data_[i], kkt_matrix[i], kkt_residual[i]);
+    }
+    else if (i == 0) {
+      intermediate_stage_.evalKKTResidual(robots[thread_id], grid, q, s[i], s[i+1], 
+                                          ocp_data_[i], kkt_matrix[i], kkt_residual[i]);
+    }
+    else {
+      intermediate_stage_.evalKKTResidual(robots[thread_id], grid, s[i-1].q, s[i], s[i+1],
+                                          ocp_data_[i], kkt_matrix[i], kkt_residual[i]);
+    }
+    performance_index_sum_.local(thread_id) += ocp_data_[i].performance_index;
+  });
+  performance_index_ = performance_index_sum_.reduce(
+      PerformanceIndex(), std::plus<PerformanceIndex>());
+  if (time_discretization.moveBlockingSize() > 1) {
+    evalMoveBlockingKKTError(time_discretization);
   }
 }
 
@@ -171,41 +252,76 @@ const PerformanceIndex& DirectMultipleShooting::getEval() const {
 }
 
 
+void DirectMultipleShooting::setEval(const PerformanceIndex& performance_index) {
+  performance_index_ = performance_index;
+}
+
+
 void DirectMultipleShooting::computeStepSizes(
     const TimeDiscretization& time_discretization, Direction& d) {
+  ROBOTOC_TRACE_SCOPE("DirectMultipleShooting::computeStepSizes");
   const int N = time_discretization.size() - 1;
   assert(ocp_data_.size() >= N+1);
-  max_primal_step_sizes_.fill(1.0);
-  max_dual_step_sizes_.fill(1.0);
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<=N; ++i) {
+  min_primal_step_size_.reset(1.0);
+  min_dual_step_size_.reset(1.0);
+  thread_pool_.parallelFor(N+1, [&](const int i, const int thread_id) {
     const auto& grid = time_discretization[i];
+    double& primal_step_size = min_primal_step_size_.local(thread_id);
+    double& dual_step_size = min_dual_step_size_.local(thread_id);
     if (grid.type == GridType::Terminal) {
       terminal_stage_.expandPrimal(grid, ocp_data_[i], d[i]);
-      max_primal_step_sizes_.coeffRef(i) = terminal_stage_.maxPrimalStepSize(ocp_data_[i]);
-      max_dual_step_sizes_.coeffRef(i) = terminal_stage_.maxDualStepSize(ocp_data_[i]);
+      primal_step_size = std::min(primal_step_size, 
+                                  terminal_stage_.maxPrimalStepSize(ocp_data_[i]));
+      dual_step_size = std::min(dual_step_size, 
+                                terminal_stage_.maxDualStepSize(ocp_data_[i]));
     }
     else if (grid.type == GridType::Impact) {
       impact_stage_.expandPrimal(grid, ocp_data_[i], d[i]);
-      max_primal_step_sizes_.coeffRef(i) = impact_stage_.maxPrimalStepSize(ocp_data_[i]);
-      max_dual_step_sizes_.coeffRef(i) = impact_stage_.maxDualStepSize(ocp_data_[i]);
+      primal_step_size = std::min(primal_step_size, 
+                                  impact_stage_.maxPrimalStepSize(ocp_data_[i]));
+      dual_step_size = std::min(dual_step_size, 
+                                impact_stage_.maxDualStepSize(ocp_data_[i]));
     }
     else {
       intermediate_stage_.expandPrimal(grid, ocp_data_[i], d[i]);
-      max_primal_step_sizes_.coeffRef(i) = intermediate_stage_.maxPrimalStepSize(ocp_data_[i]);
-      max_dual_step_sizes_.coeffRef(i) = intermediate_stage_.maxDualStepSize(ocp_data_[i]);
+      primal_step_size = std::min(primal_step_size, 
+                                  intermediate_stage_.maxPrimalStepSize(ocp_data_[i]));
+      dual_step_size = std::min(dual_step_size, 
+                                intermediate_stage_.maxDualStepSize(ocp_data_[i]));
     }
-  }
+  });
+  auto min = [](const double a, const double b) { return std::min(a, b); };
+  max_primal_step_size_ = min_primal_step_size_.reduce(1.0, min);
+  max_dual_step_size_ = min_dual_step_size_.reduce(1.0, min);
 }
 
 
 double DirectMultipleShooting::maxPrimalStepSize() const {
-  return max_primal_step_sizes_.minCoeff();
+  return max_primal_step_size_;
 }
 
 
 double DirectMultipleShooting::maxDualStepSize() const {
-  return max_dual_step_sizes_.minCoeff();
+  return max_dual_step_size_;
+}
+
+
+double DirectMultipleShooting::screenedConstraintsRatio(
+    const TimeDiscretization& time_discretization) const {
+  const int N = time_discretization.size() - 1;
+  assert(ocp_data_.size() >= N+1);
+  int num_screened = 0;
+  int num_components = 0;
+  // The terminal stage has no inequality constraints.
+  for (int i=0; i<N; ++i) {
+    num_screened += ocp_data_[i].constraints_data.numScreened();
+    num_components += ocp_data_[i].constraints_data.numComponents();
+  }
+  if (num_components == 0) {
+    return 0.0;
+  }
+  return (static_cast<double>(num_screened) 
+            / static_cast<double>(num_components));
 }
 
 
@@ -214,29 +330,60 @@ void DirectMultipleShooting::integrateSolution(
     const TimeDiscretization& time_discretization, 
     const double primal_step_size, const double dual_step_size, 
     const KKTMatrix& kkt_matrix, Direction& d, Solution& s) {
+  ROBOTOC_TRACE_SCOPE("DirectMultipleShooting::integrateSolution");
   const int N = time_discretization.size() - 1;
   assert(ocp_data_.size() >= N+1);
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<=N; ++i) {
+  thread_pool_.parallelFor(N+1, [&](const int i, const int thread_id) {
     const auto& grid = time_discretization[i];
     if (grid.type == GridType::Terminal) {
       terminal_stage_.expandDual(grid, ocp_data_[i], d[i]);
-      terminal_stage_.updatePrimal(robots[omp_get_thread_num()], 
+      terminal_stage_.updatePrimal(robots[thread_id], 
                                    primal_step_size, d[i], s[i], ocp_data_[i]);
       terminal_stage_.updateDual(dual_step_size, ocp_data_[i]);
     }
     else if (grid.type == GridType::Impact) {
       impact_stage_.expandDual(grid, ocp_data_[i], d[i+1], d[i]);
-      impact_stage_.updatePrimal(robots[omp_get_thread_num()], 
+      impact_stage_.updatePrimal(robots[thread_id], 
                                  primal_step_size, d[i], s[i], ocp_data_[i]);
       impact_stage_.updateDual(dual_step_size, ocp_data_[i]);
     }
     else {
       intermediate_stage_.expandDual(grid, ocp_data_[i], d[i+1], d[i]);
-      intermediate_stage_.updatePrimal(robots[omp_get_thread_num()], 
+      intermediate_stage_.updatePrimal(robots[thread_id], 
                                        primal_step_size, d[i], s[i], ocp_data_[i]);
       intermediate_stage_.updateDual(dual_step_size, ocp_data_[i]);
     }
+  });
+}
+
+
+void DirectMultipleShooting::evalMoveBlockingKKTError(
+    const TimeDiscretization& time_discretization) {
+  // The move-blocked stages share the control input with the head of the 
+  // block. The stationarity condition w.r.t. the shared control input is 
+  // therefore the sum of the stage-wise ones over the block.
+  const int N = time_discretization.size() - 1;
+  int i = 0;
+  while (i < N) {
+    if (!time_discretization[i+1].move_blocked) {
+      ++i;
+      continue;
+    }
+    lu_block_.setZero();
+    double kkt_error_diff = 0.0;
+    int j = i;
+    do {
+      lu_block_.noalias() += ocp_data_[j].lu;
+      const double lu_squared_norm = ocp_data_[j].lu.squaredNorm();
+      ocp_data_[j].performance_index.kkt_error -= lu_squared_norm;
+      kkt_error_diff -= lu_squared_norm;
+      ++j;
+    } while (j < N && time_discretization[j].move_blocked);
+    ocp_data_[i].performance_index.kkt_error += lu_block_.squaredNorm();
+    kkt_error_diff += lu_block_.squaredNorm();
+    // The total is already reduced over the stages.
+    performance_index_.kkt_error += kkt_error_diff;
+    i = j;
   }
 }
 
@@ -247,10 +394,56 @@ void DirectMultipleShooting::resizeData(
   while (ocp_data_.size() < N+1) {
     ocp_data_.push_back(ocp_data_.back());
   }
-  if (max_primal_step_sizes_.size() < N+1) {
-    max_primal_step_sizes_.resize(N+1);
-    max_dual_step_sizes_.resize(N+1);
+}
+
+
+
+void DirectMultipleShooting::saveConstraintsData(
+    BinaryOutputArchive& ar, const TimeDiscretization& time_discretization) const {
+  const int N = time_discretization.size() - 1;
+  assert(ocp_data_.size() >= N+1);
+  ar.writeSize(N+1);
+  for (int i=0; i<=N; ++i) {
+    ocp_data_[i].constraints_data.save(ar);
+  }
+}
+
+
+void DirectMultipleShooting::loadConstraintsData(
+    BinaryInputArchive& ar, const TimeDiscretization& time_discretization) {
+  const int N = time_discretization.size() - 1;
+  assert(ocp_data_.size() >= N+1);
+  if (ar.readSize() != N+1) {
+    throw std::runtime_error("[DirectMultipleShooting] number of the loaded stages must be " 
+                             + std::to_string(N+1) + "!");
+  }
+  for (int i=0; i<=N; ++i) {
+    ocp_data_[i].constraints_data.load(ar);
+  }
+}
+
+
+void DirectMultipleShooting::getConstraintsData(
+    const TimeDiscretization& time_discretization, 
+    std::vector<ConstraintsData>& constraints_data) const {
+  const int N = time_discretization.size() - 1;
+  assert(ocp_data_.size() >= N+1);
+  constraints_data.resize(N+1);
+  for (int i=0; i<=N; ++i) {
+    constraints_data[i] = ocp_data_[i].constraints_data;
+  }
+}
+
+
+void DirectMultipleShooting::setConstraintsData(
+    const TimeDiscretization& time_discretization, 
+    const std::vector<ConstraintsData>& constraints_data) {
+  const int N = time_discretization.size() - 1;
+  assert(ocp_data_.size() >= N+1);
+  assert(constraints_data.size() >= N+1);
+  for (int i=0; i<=N; ++i) {
+    ocp_data_[i].constraints_data = constraints_data[i];
   }
 }
 
-} // namespace robotoc
\ No newline at end of file
+} // namespace robotoc
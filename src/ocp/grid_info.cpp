@@ -29,6 +29,44 @@ GridInfo GridInfo::Random() {
 }
 
 
+void GridInfo::save(BinaryOutputArchive& ar) const {
+  ar.write(type);
+  ar.write(t0);
+  ar.write(t);
+  ar.write(dt);
+  ar.write(dt_next);
+  ar.write(phase);
+  ar.write(stage);
+  ar.write(impact_index);
+  ar.write(lift_index);
+  ar.write(stage_in_phase);
+  ar.write(num_grids_in_phase);
+  ar.write(sto);
+  ar.write(sto_next);
+  ar.write(switching_constraint);
+  ar.write(move_blocked);
+}
+
+
+void GridInfo::load(BinaryInputArchive& ar) {
+  ar.read(type);
+  ar.read(t0);
+  ar.read(t);
+  ar.read(dt);
+  ar.read(dt_next);
+  ar.read(phase);
+  ar.read(stage);
+  ar.read(impact_index);
+  ar.read(lift_index);
+  ar.read(stage_in_phase);
+  ar.read(num_grids_in_phase);
+  ar.read(sto);
+  ar.read(sto_next);
+  ar.read(switching_constraint);
+  ar.read(move_blocked);
+}
+
+
 void GridInfo::disp(std::ostream& os) const {
   auto gridTypeToString = [](const GridType& type) {
     switch (type)
@@ -64,7 +102,8 @@ void GridInfo::disp(std::ostream& os) const {
   os << "  num_grids_in_phase: " << num_grids_in_phase << "\n";
   os << "  sto:      " << std::boolalpha << sto << "\n";
   os << "  sto_next: " << std::boolalpha << sto_next << "\n";
-  os << "  switching_constraint: " << std::boolalpha << switching_constraint << std::flush;
+  os << "  switching_constraint: " << std::boolalpha << switching_constraint << "\n";
+  os << "  move_blocked: " << std::boolalpha << move_blocked << std::flush;
 }
 
 
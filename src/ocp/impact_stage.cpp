@@ -122,6 +122,45 @@ void ImpactStage::evalKKT(Robot& robot, const GridInfo& grid_info,
 }
 
 
+void ImpactStage::evalKKTResidual(Robot& robot, const GridInfo& grid_info, 
+                                  const Eigen::VectorXd& q_prev, 
+                                  const SplitSolution& s, 
+                                  const SplitSolution& s_next, OCPData& data, 
+                                  SplitKKTMatrix& kkt_matrix, 
+                                  SplitKKTResidual& kkt_residual) const {
+  assert(grid_info.type == GridType::Impact);
+  assert(q_prev.size() == robot.dimq());
+  // setup computation
+  const auto& impact_status = contact_sequence_->impactStatus(grid_info.impact_index);
+  robot.updateKinematics(s.q, s.v+s.dv);
+  kkt_matrix.setContactDimension(impact_status.dimf());
+  kkt_matrix.setSwitchingConstraintDimension(0);
+  kkt_residual.setContactDimension(impact_status.dimf());
+  kkt_residual.setSwitchingConstraintDimension(0);
+  kkt_matrix.setZero();
+  kkt_residual.setZero();
+  data.performance_index.setZero();
+  // eval cost and constraints
+  data.performance_index.cost 
+      = cost_->linearizeImpactCost(robot, impact_status, data.cost_data,  
+                                   grid_info, s, kkt_residual);
+  constraints_->evalKKTResidual(robot, impact_status, data.constraints_data, 
+                                s, kkt_residual);
+  data.performance_index.cost_barrier = data.constraints_data.logBarrier();
+  // eval dynamics
+  linearizeImpactStateEquation(robot, q_prev, s, s_next, data.state_equation_data, 
+                                kkt_matrix, kkt_residual);
+  linearizeImpactDynamics(robot, impact_status, s, data.contact_dynamics_data, 
+                           kkt_residual);
+  // summarize evaluations
+  data.performance_index.primal_feasibility 
+      = data.primalFeasibility<1>() + kkt_residual.primalFeasibility<1>();
+  data.performance_index.dual_feasibility 
+      = data.dualFeasibility<1>() + kkt_residual.dualFeasibility<1>();
+  data.performance_index.kkt_error = data.KKTError() + kkt_residual.KKTError();
+}
+
+
 void ImpactStage::expandPrimal(const GridInfo& grid_info, OCPData& data, 
                                SplitDirection& d) const {
   assert(grid_info.type == GridType::Impact);
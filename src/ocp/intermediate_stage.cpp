@@ -13,14 +13,22 @@ IntermediateStage::IntermediateStage(const std::shared_ptr<CostFunction>& cost,
                                      const std::shared_ptr<ContactSequence>& contact_sequence)
   : cost_(cost), 
     constraints_(constraints),
-    contact_sequence_(contact_sequence) {
+    contact_sequence_(contact_sequence),
+    hessian_approximation_(HessianApproximation::GaussNewton) {
 }
 
 
 IntermediateStage::IntermediateStage()
   : cost_(), 
     constraints_(),
-    contact_sequence_() {
+    contact_sequence_(),
+    hessian_approximation_(HessianApproximation::GaussNewton) {
+}
+
+
+void IntermediateStage::setHessianApproximation(
+    const HessianApproximation hessian_approximation) {
+  hessian_approximation_ = hessian_approximation;
 }
 
 
@@ -32,6 +40,7 @@ OCPData IntermediateStage::createData(const Robot& robot) const {
   data.state_equation_data = StateEquationData(robot);
   data.contact_dynamics_data = ContactDynamicsData(robot);
   data.switching_constraint_data = SwitchingConstraintData(robot);
+  data.lu = Eigen::VectorXd::Zero(robot.dimu());
   return data;
 }
 
@@ -50,6 +59,7 @@ void IntermediateStage::initConstraints(Robot& robot, const GridInfo& grid_info,
   data.constraints_data = constraints_->createConstraintsData(robot, grid_info.stage);
   const auto& contact_status = contact_sequence_->contactStatus(grid_info.phase);
   constraints_->setSlackAndDual(robot, contact_status, data.constraints_data, s);
+  data.cost_data.quasi_newton_hessian.reset();
 }
 
 
@@ -98,9 +108,23 @@ void IntermediateStage::evalKKT(Robot& robot, const GridInfo& grid_info,
   kkt_residual.setZero();
   data.performance_index.setZero();
   // eval cost and constraints
-  data.performance_index.cost 
-      = cost_->quadratizeStageCost(robot, contact_status, data.cost_data,  
-                                   grid_info, s, kkt_residual, kkt_matrix);
+  auto& quasi_newton_hessian = data.cost_data.quasi_newton_hessian;
+  if (hessian_approximation_ == HessianApproximation::BFGS
+      && quasi_newton_hessian.isInitialized(contact_status.dimf())) {
+    data.performance_index.cost 
+        = cost_->linearizeStageCost(robot, contact_status, data.cost_data,  
+                                    grid_info, s, kkt_residual);
+    quasi_newton_hessian.update(robot, grid_info.dt, s, kkt_residual);
+    quasi_newton_hessian.addTo(kkt_matrix);
+  }
+  else {
+    data.performance_index.cost 
+        = cost_->quadratizeStageCost(robot, contact_status, data.cost_data,  
+                                     grid_info, s, kkt_residual, kkt_matrix);
+    if (hessian_approximation_ == HessianApproximation::BFGS) {
+      quasi_newton_hessian.init(grid_info.dt, s, kkt_residual, kkt_matrix);
+    }
+  }
   kkt_residual.h  = (1.0/grid_info.dt) * data.performance_index.cost;
   kkt_matrix.hx   = (1.0/grid_info.dt) * kkt_residual.lx;
   kkt_matrix.hu   = (1.0/grid_info.dt) * kkt_residual.lu;
@@ -130,6 +154,7 @@ void IntermediateStage::evalKKT(Robot& robot, const GridInfo& grid_info,
   data.performance_index.dual_feasibility 
       = data.dualFeasibility<1>() + kkt_residual.dualFeasibility<1>();
   data.performance_index.kkt_error = data.KKTError() + kkt_residual.KKTError();
+  data.lu = kkt_residual.lu;
   // Forms linear system
   constraints_->condenseSlackAndDual(contact_status, data.constraints_data, 
                                      kkt_matrix, kkt_residual);
@@ -149,6 +174,54 @@ void IntermediateStage::evalKKT(Robot& robot, const GridInfo& grid_info,
 }
 
 
+void IntermediateStage::evalKKTResidual(Robot& robot, const GridInfo& grid_info, 
+                                        const Eigen::VectorXd& q_prev, 
+                                        const SplitSolution& s, 
+                                        const SplitSolution& s_next, 
+                                        OCPData& data, SplitKKTMatrix& kkt_matrix, 
+                                        SplitKKTResidual& kkt_residual) const {
+  assert(grid_info.type == GridType::Intermediate || grid_info.type == GridType::Lift);
+  assert(q_prev.size() == robot.dimq());
+  // setup computation
+  const auto& contact_status = contact_sequence_->contactStatus(grid_info.phase);
+  robot.updateKinematics(s.q, s.v, s.a);
+  kkt_matrix.setContactDimension(contact_status.dimf());
+  kkt_residual.setContactDimension(contact_status.dimf());
+  kkt_matrix.setZero();
+  kkt_residual.setZero();
+  data.performance_index.setZero();
+  // eval cost and constraints
+  data.performance_index.cost 
+      = cost_->linearizeStageCost(robot, contact_status, data.cost_data,  
+                                  grid_info, s, kkt_residual);
+  constraints_->evalKKTResidual(robot, contact_status, data.constraints_data, 
+                                s, kkt_residual);
+  data.performance_index.cost_barrier = data.constraints_data.logBarrier();
+  // eval dynamics
+  linearizeStateEquation(robot, grid_info.dt, q_prev, s, s_next, 
+                         data.state_equation_data, kkt_matrix, kkt_residual);
+  linearizeContactDynamics(robot, contact_status, s, 
+                           data.contact_dynamics_data, kkt_residual);
+  if (grid_info.switching_constraint) {
+    const auto& impact_status = contact_sequence_->impactStatus(grid_info.impact_index+1);
+    linearizeSwitchingConstraint(robot, impact_status, data.switching_constraint_data,
+                                 grid_info.dt, grid_info.dt_next, s, 
+                                 kkt_matrix, kkt_residual);
+  }
+  else {
+    kkt_matrix.setSwitchingConstraintDimension(0);
+    kkt_residual.setSwitchingConstraintDimension(0);
+  }
+  // summarize evaluations
+  data.performance_index.primal_feasibility 
+      = data.primalFeasibility<1>() + kkt_residual.primalFeasibility<1>();
+  data.performance_index.dual_feasibility 
+      = data.dualFeasibility<1>() + kkt_residual.dualFeasibility<1>();
+  data.performance_index.kkt_error = data.KKTError() + kkt_residual.KKTError();
+  data.lu = kkt_residual.lu;
+}
+
+
 void IntermediateStage::expandPrimal(const GridInfo& grid_info, OCPData& data, 
                                      SplitDirection& d) const {
   assert(grid_info.type == GridType::Intermediate || grid_info.type == GridType::Lift);
@@ -10,7 +10,8 @@ OCP::OCP(const Robot& _robot, const std::shared_ptr<CostFunction>& _cost,
          const std::shared_ptr<STOCostFunction>& _sto_cost, 
          const std::shared_ptr<STOConstraints>& _sto_constraints, 
          const std::shared_ptr<ContactSequence>& _contact_sequence,
-         const double _T, const int _N, const int _reserved_num_discrete_events) 
+         const double _T, const int _N, const int _reserved_num_discrete_events,
+         const double _grading_ratio) 
   : robot(_robot),
     cost(_cost),
     constraints(_constraints),
@@ -19,7 +20,8 @@ OCP::OCP(const Robot& _robot, const std::shared_ptr<CostFunction>& _cost,
     contact_sequence(_contact_sequence),
     T(_T),
     N(_N),
-    reserved_num_discrete_events(_reserved_num_discrete_events) {
+    reserved_num_discrete_events(_reserved_num_discrete_events),
+    grading_ratio(_grading_ratio) {
   if (_T <= 0) {
     throw std::out_of_range("[OCP] invalid argument: 'T' must be positive!");
   }
@@ -29,13 +31,17 @@ OCP::OCP(const Robot& _robot, const std::shared_ptr<CostFunction>& _cost,
   if (_reserved_num_discrete_events < 0) {
     throw std::out_of_range("[OCP] invalid argument: 'reserved_num_discrete_events' must be non-negative!");
   }
+  if (_grading_ratio <= 0) {
+    throw std::out_of_range("[OCP] invalid argument: 'grading_ratio' must be positive!");
+  }
 }
 
 
 OCP::OCP(const Robot& _robot, const std::shared_ptr<CostFunction>& _cost, 
          const std::shared_ptr<Constraints>& _constraints, 
          const std::shared_ptr<ContactSequence>& _contact_sequence,
-         const double _T, const int _N, const int _reserved_num_discrete_events) 
+         const double _T, const int _N, const int _reserved_num_discrete_events,
+         const double _grading_ratio) 
   : robot(_robot),
     cost(_cost),
     constraints(_constraints),
@@ -44,7 +50,8 @@ OCP::OCP(const Robot& _robot, const std::shared_ptr<CostFunction>& _cost,
     contact_sequence(_contact_sequence),
     T(_T),
     N(_N),
-    reserved_num_discrete_events(_reserved_num_discrete_events) {
+    reserved_num_discrete_events(_reserved_num_discrete_events),
+    grading_ratio(_grading_ratio) {
   if (_T <= 0) {
     throw std::out_of_range("[OCP] invalid argument: 'T' must be positive!");
   }
@@ -54,6 +61,9 @@ OCP::OCP(const Robot& _robot, const std::shared_ptr<CostFunction>& _cost,
   if (_reserved_num_discrete_events < 0) {
     throw std::out_of_range("[OCP] invalid argument: 'reserved_num_discrete_events' must be non-negative!");
   }
+  if (_grading_ratio <= 0) {
+    throw std::out_of_range("[OCP] invalid argument: 'grading_ratio' must be positive!");
+  }
 }
 
 
@@ -68,7 +78,8 @@ OCP::OCP(const Robot& _robot, const std::shared_ptr<CostFunction>& _cost,
     contact_sequence(nullptr),
     T(_T),
     N(_N),
-    reserved_num_discrete_events(0) {
+    reserved_num_discrete_events(0),
+    grading_ratio(1.0) {
   if (_T <= 0) {
     throw std::out_of_range("[OCP] invalid argument: 'T' must be positive!");
   }
@@ -87,7 +98,8 @@ OCP::OCP()
     contact_sequence(nullptr),
     T(0),
     N(0),
-    reserved_num_discrete_events(0) {
+    reserved_num_discrete_events(0),
+    grading_ratio(1.0) {
 }
 
 
@@ -96,6 +108,7 @@ void OCP::disp(std::ostream& os) const {
   os << "  T: " << T << std::endl;
   os << "  N: " << N << std::endl;
   os << "  reserved_num_discrete_events: " << reserved_num_discrete_events << std::endl;
+  os << "  grading_ratio: " << grading_ratio << std::endl;
   os << robot << std::endl;
 }
 
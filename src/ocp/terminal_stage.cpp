@@ -106,6 +106,36 @@ void TerminalStage::evalKKT(Robot& robot, const GridInfo& grid_info,
 }
 
 
+void TerminalStage::evalKKTResidual(Robot& robot, const GridInfo& grid_info,
+                                    const Eigen::VectorXd& q_prev, 
+                                    const SplitSolution& s, OCPData& data, 
+                                    SplitKKTMatrix& kkt_matrix, 
+                                    SplitKKTResidual& kkt_residual) const {
+  assert(grid_info.type == GridType::Terminal);
+  assert(q_prev.size() == robot.dimq());
+  // setup computation
+  robot.updateKinematics(s.q, s.v);
+  kkt_matrix.setContactDimension(0);
+  kkt_matrix.setSwitchingConstraintDimension(0);
+  kkt_residual.setContactDimension(0);
+  kkt_residual.setSwitchingConstraintDimension(0);
+  kkt_matrix.setZero();
+  kkt_residual.setZero();
+  data.performance_index.setZero();
+  // eval cost
+  data.performance_index.cost 
+      = cost_->linearizeTerminalCost(robot, data.cost_data, grid_info, s, 
+                                     kkt_residual);
+  // eval dynamics
+  linearizeTerminalStateEquation(robot, q_prev, s, data.state_equation_data, 
+                                 kkt_matrix, kkt_residual);
+  // summarize evaluations
+  data.performance_index.dual_feasibility 
+      = data.dualFeasibility<1>() + kkt_residual.dualFeasibility<1>();
+  data.performance_index.kkt_error = data.KKTError() + kkt_residual.KKTError();
+}
+
+
 void TerminalStage::expandPrimal(const GridInfo& grid_info, OCPData& data, 
                                  SplitDirection& d) const {
   assert(grid_info.type == GridType::Terminal);
@@ -2,16 +2,49 @@
 #include "robotoc/utils/numerics.hpp"
 
 #include <iomanip>
+#include <stdexcept>
 
 
 namespace robotoc {
 
+namespace {
+
+// Time from the beginning to the k-th grid of the geometric grids dividing the
+// interval of length T into N steps with the ratio r. k can be fractional.
+inline double gradedTime(const double T, const int N, const double k, 
+                         const double r) {
+  if (r == 1.0) return k * (T / N);
+  return T * (std::pow(r, k) - 1.0) / (std::pow(r, N) - 1.0);
+}
+
+// Inverse of gradedTime(), i.e., the fractional grid index at the time s 
+// from the beginning.
+inline double gradedGridIndex(const double T, const int N, const double s, 
+                              const double r) {
+  if (r == 1.0) return s * (N / T);
+  return std::log(1.0 + s * (std::pow(r, N) - 1.0) / T) / std::log(r);
+}
+
+// Time step of the k-th grid of the geometric grids dividing the interval of 
+// length T into N steps with the ratio r.
+inline double gradedTimeStep(const double T, const int N, const int k, 
+                             const double r) {
+  if (r == 1.0) return T / N;
+  return T * std::pow(r, k) * (r - 1.0) / (std::pow(r, N) - 1.0);
+}
+
+} // namespace
+
+
 TimeDiscretization::TimeDiscretization(const double T, const int N, 
-                                       const int reserved_num_discrete_events) 
+                                       const int reserved_num_discrete_events,
+                                       const double grading_ratio) 
   : T_(T),
+    grading_ratio_(grading_ratio),
     N_(N),
     num_grids_(N),
     reserved_num_discrete_events_(reserved_num_discrete_events),
+    move_blocking_size_(1),
     grid_(N+1+3*reserved_num_discrete_events, GridInfo()), 
     sto_event_(), 
     sto_phase_() {
@@ -24,6 +57,9 @@ TimeDiscretization::TimeDiscretization(const double T, const int N,
   if (reserved_num_discrete_events < 0) {
     throw std::out_of_range("[TimeDiscretization] invalid argument: 'reserved_num_discrete_events' must be non-negative!");
   }
+  if (grading_ratio <= 0) {
+    throw std::out_of_range("[TimeDiscretization] invalid argument: 'grading_ratio' must be positive!");
+  }
   sto_event_.reserve(2*reserved_num_discrete_events+2);
   sto_phase_.reserve(2*reserved_num_discrete_events+2);
 }
@@ -31,15 +67,32 @@ TimeDiscretization::TimeDiscretization(const double T, const int N,
 
 TimeDiscretization::TimeDiscretization()
   : T_(0),
+    grading_ratio_(1.0),
     N_(0),
     num_grids_(0),
     reserved_num_discrete_events_(0),
+    move_blocking_size_(1),
     grid_(), 
     sto_event_(), 
     sto_phase_() {
 }
 
 
+double TimeDiscretization::nominalTimeStep(const int k) const {
+  assert(k >= 0);
+  assert(k < N_);
+  return gradedTimeStep(T_, N_, k, grading_ratio_);
+}
+
+
+void TimeDiscretization::setMoveBlockingSize(const int move_blocking_size) {
+  if (move_blocking_size <= 0) {
+    throw std::out_of_range("[TimeDiscretization] invalid argument: 'move_blocking_size' must be positive!");
+  }
+  move_blocking_size_ = move_blocking_size;
+}
+
+
 void TimeDiscretization::discretize(
     const std::shared_ptr<ContactSequence>& contact_sequence, const double t) {
   const int N = N_ + contact_sequence->numLiftEvents() + 2 * contact_sequence->numImpactEvents() + 1;
@@ -56,11 +109,12 @@ void TimeDiscretization::discretize(
     if (contact_sequence->liftTime(next_lift_index) > t) break;
     ++next_lift_index;
   }
-  const double dt = T_ / N_;
   const double eps = std::sqrt(std::numeric_limits<double>::epsilon());
-  const double margin = 0.5 * dt;
+  const double margin = 0.5 * nominalTimeStep(N_-1);
   int stage = 0;
+  int k = 0;
   double ti = t;
+  double dt = nominalTimeStep(0);
   while (ti+eps < t+T_) {
     const bool has_next_impact = (next_impact_index < contact_sequence->numImpactEvents());
     const bool has_next_lift = (next_lift_index < contact_sequence->numLiftEvents());
@@ -94,6 +148,8 @@ void TimeDiscretization::discretize(
         grid_[stage].type = GridType::Intermediate;
         if (numerics::isApprox(ti+dt, next_impact_time, eps)) {
           ti += dt;
+          ++k;
+          dt = gradedTimeStep(T_, N_, k, grading_ratio_);
           grid_[stage].dt = ti + dt - next_impact_time;
         }
       }
@@ -113,12 +169,16 @@ void TimeDiscretization::discretize(
         grid_[stage].type = GridType::Lift;
         if (numerics::isApprox(ti+dt, next_lift_time, eps)) {
           ti += dt;
+          ++k;
+          dt = gradedTimeStep(T_, N_, k, grading_ratio_);
           grid_[stage].dt = ti + dt - next_lift_time;
         }
       }
     }
     ++stage;
     ti += dt;
+    ++k;
+    dt = gradedTimeStep(T_, N_, k, grading_ratio_);
   }
   grid_[stage].t  = t+T_;
   grid_[stage].dt = 0;
@@ -180,43 +240,61 @@ void TimeDiscretization::discretize(
   }
   grid_[num_grids_].stage_in_phase = 0;
   grid_[num_grids_].num_grids_in_phase = 0;
+
+  setMoveBlockedFlags();
 }
 
 
 void TimeDiscretization::correctTimeSteps(
     const std::shared_ptr<ContactSequence>& contact_sequence, const double t) {
+  // Distributes the grids of a phase between the times t_begin and t_end 
+  // uniformly in the grid index of the geometric grids of the whole horizon, 
+  // i.e., the same grading as discretize(). The grids of the phases whose 
+  // switching times are optimized are distributed uniformly in time because 
+  // the sensitivities of the time steps w.r.t. the switching times assume it.
+  auto distributeGrids = [&](const int begin_stage, const int num_grids,
+                             const double t_begin, const double t_end, 
+                             const bool sto) {
+    const double r = sto ? 1.0 : grading_ratio_;
+    const double k_begin = gradedGridIndex(T_, N_, t_begin-t, r);
+    const double k_end = gradedGridIndex(T_, N_, t_end-t, r);
+    const double dk = (k_end - k_begin) / num_grids;
+    for (int j=0; j<num_grids; ++j) {
+      const double tj = t + gradedTime(T_, N_, k_begin+j*dk, r);
+      const double tj_next = (j < num_grids-1) 
+          ? t + gradedTime(T_, N_, k_begin+(j+1)*dk, r) : t_end;
+      grid_[begin_stage+j].t = (j == 0) ? t_begin : tj;
+      grid_[begin_stage+j].dt = tj_next - grid_[begin_stage+j].t;
+    }
+  };
   int prev_event_stage = 0;
   double prev_event_time = t;
+  bool prev_event_sto = false;
   for (int i=0; i<num_grids_; ++i) {
     if (grid_[i].type == GridType::Impact) {
       const double event_time = contact_sequence->impactTime(grid_[i+1].impact_index);
-      const double dt = (event_time - prev_event_time) / grid_[i-1].num_grids_in_phase;
-      for (int j=prev_event_stage; j<=i-1; ++j) {
-        grid_[j].t = prev_event_time + (j-prev_event_stage) * dt;
-        grid_[j].dt = dt;
-      }
+      const bool event_sto = contact_sequence->isSTOEnabledImpact(grid_[i+1].impact_index);
+      distributeGrids(prev_event_stage, grid_[i-1].num_grids_in_phase, 
+                      prev_event_time, event_time, prev_event_sto||event_sto);
       grid_[i].t = event_time; 
       grid_[i].dt = 0.0; 
       prev_event_time = event_time;
       prev_event_stage = i+1;
+      prev_event_sto = event_sto;
       ++i;
     }
     else if (grid_[i+1].type == GridType::Lift) {
       const double event_time = contact_sequence->liftTime(grid_[i+1].lift_index);
-      const double dt = (event_time - prev_event_time) / grid_[i].num_grids_in_phase;
-      for (int j=prev_event_stage; j<=i; ++j) {
-        grid_[j].t = prev_event_time + (j-prev_event_stage) * dt;
-        grid_[j].dt = dt;
-      }
+      const bool event_sto = contact_sequence->isSTOEnabledLift(grid_[i+1].lift_index);
+      distributeGrids(prev_event_stage, grid_[i].num_grids_in_phase, 
+                      prev_event_time, event_time, prev_event_sto||event_sto);
       prev_event_time = event_time;
       prev_event_stage = i+1;
+      prev_event_sto = event_sto;
     }
     else if (grid_[i+1].type == GridType::Terminal) {
-      const double dt = (t + T_ - prev_event_time) / grid_[i].num_grids_in_phase;
-      for (int j=prev_event_stage; j<=i; ++j) {
-        grid_[j].t = prev_event_time + (j-prev_event_stage) * dt;
-        grid_[j].dt = dt;
-      }
+      distributeGrids(prev_event_stage, grid_[i].num_grids_in_phase, 
+                      prev_event_time, t+T_, prev_event_sto);
     }
   }
   grid_[num_grids_].t = t + T_;
@@ -259,6 +337,84 @@ void TimeDiscretization::correctTimeSteps(
   }
   grid_[num_grids_].sto = false;
   grid_[num_grids_].sto_next = false;
+
+  setMoveBlockedFlags();
+}
+
+
+void TimeDiscretization::shiftTime(const double time_offset) {
+  for (auto& e : grid_) {
+    e.t0 += time_offset;
+    e.t += time_offset;
+  }
+}
+
+
+void TimeDiscretization::setMoveBlockedFlags() {
+  for (int i=0; i<=num_grids_; ++i) {
+    grid_[i].move_blocked = false;
+  }
+  if (move_blocking_size_ <= 1) return;
+
+  // The control input of a stage is blocked with that of the previous stage
+  // only if both are the intermediate stages in the same phase that are not 
+  // involved with the STO and the switching constraint.
+  auto isBlockable = [&](const int i) {
+    return (grid_[i].type == GridType::Intermediate 
+              && !grid_[i].sto && !grid_[i].sto_next 
+              && !grid_[i].switching_constraint);
+  };
+  int num_blocked_stages = 1;
+  for (int i=1; i<num_grids_; ++i) {
+    if (isBlockable(i-1) && isBlockable(i) 
+        && (grid_[i].phase == grid_[i-1].phase)
+        && (num_blocked_stages < move_blocking_size_)) {
+      grid_[i].move_blocked = true;
+      ++num_blocked_stages;
+    }
+    else {
+      num_blocked_stages = 1;
+    }
+  }
+}
+
+
+void TimeDiscretization::save(BinaryOutputArchive& ar) const {
+  ar.write(T_);
+  ar.write(max_dt_);
+  ar.write(eps_);
+  ar.write(grading_ratio_);
+  ar.write(N_);
+  ar.write(num_grids_);
+  ar.write(reserved_num_discrete_events_);
+  ar.write(move_blocking_size_);
+  ar.writeSize(grid_.size());
+  for (const auto& e : grid_) {
+    e.save(ar);
+  }
+  ar.write(sto_event_);
+  ar.write(sto_phase_);
+}
+
+
+void TimeDiscretization::load(BinaryInputArchive& ar) {
+  ar.read(T_);
+  ar.read(max_dt_);
+  ar.read(eps_);
+  ar.read(grading_ratio_);
+  ar.read(N_);
+  ar.read(num_grids_);
+  ar.read(reserved_num_discrete_events_);
+  ar.read(move_blocking_size_);
+  grid_.resize(ar.readSize());
+  for (auto& e : grid_) {
+    e.load(ar);
+  }
+  ar.read(sto_event_);
+  ar.read(sto_phase_);
+  if (num_grids_ < 0 || num_grids_ >= grid_.size()) {
+    throw std::runtime_error("[TimeDiscretization] loaded data is not consistent!");
+  }
 }
 
 
@@ -286,6 +442,7 @@ void TimeDiscretization::disp(std::ostream& os) const {
   os << "Time discretization of optimal control problem (OCP):" << "\n";
   os << "  T: " << T_ << "\n";
   os << "  N: " << N() << "\n";
+  os << "  grading_ratio: " << gradingRatio() << "\n";
   os << "  num_grids: " << size() << "\n";
   os << " -------------------------------------------------------------------------------------------------" << "\n";
   os << "  stage |         type | grid count |      t |     dt | phase | impact | lift |  sto  | sto_next |" << "\n";
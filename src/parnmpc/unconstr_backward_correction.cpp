@@ -1,16 +1,17 @@
 #include "robotoc/parnmpc/unconstr_backward_correction.hpp"
 
-#include <omp.h>
 #include <stdexcept>
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <functional>
 
 
 namespace robotoc {
 
 UnconstrBackwardCorrection::UnconstrBackwardCorrection(const OCP& ocp, 
                                                        const int nthreads)
-  : nthreads_(nthreads),
+  : thread_pool_(nthreads),
     ocp_(ocp),
     intermediate_stage_(ocp.robot, ocp.cost, ocp.constraints),
     terminal_stage_(ocp.robot, ocp.cost, ocp.constraints),
@@ -19,8 +20,11 @@ UnconstrBackwardCorrection::UnconstrBackwardCorrection(const OCP& ocp,
     corrector_(ocp.N, UnconstrSplitBackwardCorrection(ocp.robot)),
     s_new_(ocp.N+1, SplitSolution(ocp.robot)),
     aux_mat_(ocp.N, Eigen::MatrixXd::Zero(2*ocp.robot.dimv(), 2*ocp.robot.dimv())),
-    primal_step_sizes_(Eigen::VectorXd::Zero(ocp.N)),
-    dual_step_sizes_(Eigen::VectorXd::Zero(ocp.N)) {
+    primal_step_size_(1.0),
+    dual_step_size_(1.0),
+    performance_index_sum_(nthreads),
+    min_primal_step_size_(nthreads, 1.0),
+    min_dual_step_size_(nthreads, 1.0) {
   if (nthreads <= 0) {
     throw std::out_of_range("[UnconstrBackwardCorrection] invalid argument: 'nthreads' must be positive!");
   }
@@ -32,7 +36,7 @@ UnconstrBackwardCorrection::UnconstrBackwardCorrection(const OCP& ocp,
 
 
 UnconstrBackwardCorrection::UnconstrBackwardCorrection()
-  : nthreads_(0),
+  : thread_pool_(),
     ocp_(),
     intermediate_stage_(),
     terminal_stage_(),
@@ -41,16 +45,23 @@ UnconstrBackwardCorrection::UnconstrBackwardCorrection()
     corrector_(),
     s_new_(),
     aux_mat_(),
-    primal_step_sizes_(),
-    dual_step_sizes_() {
+    primal_step_size_(1.0),
+    dual_step_size_(1.0),
+    performance_index_sum_(),
+    min_primal_step_size_(),
+    min_dual_step_size_() {
 }
 
 
-void UnconstrBackwardCorrection::setNumThreads(const int nthreads) {
+void UnconstrBackwardCorrection::setNumThreads(const int nthreads, 
+                                               const bool enable_thread_pinning) {
   if (nthreads <= 0) {
     throw std::out_of_range("[UnconstrBackwardCorrection] invalid argument: nthreads must be positive!");
   }
-  nthreads_ = nthreads;
+  thread_pool_.setNumThreads(nthreads, enable_thread_pinning);
+  performance_index_sum_.setNumThreads(nthreads);
+  min_primal_step_size_.setNumThreads(nthreads);
+  min_dual_step_size_.setNumThreads(nthreads);
 }
 
 
@@ -62,10 +73,9 @@ void UnconstrBackwardCorrection::initAuxMat(
   terminal_stage_.evalTerminalCostHessian(robots[0], time_discretization[N], 
                                           s[N-1], data_[N-1], kkt_matrix[N-1], 
                                           kkt_residual[N-1]);
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<N; ++i) {
+  thread_pool_.parallelFor(N, [&](const int i, const int thread_id) {
     aux_mat_[i] = kkt_matrix[N-1].Qxx;
-  }
+  });
   kkt_matrix[N-1].setZero();
   kkt_residual[N-1].setZero();
 }
@@ -75,17 +85,16 @@ void UnconstrBackwardCorrection::initConstraints(
     aligned_vector<Robot>& robots, 
     const std::vector<GridInfo>& time_discretization, const Solution& s) {
   const int N = time_discretization.size() - 1;
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<N; ++i) {
+  thread_pool_.parallelFor(N, [&](const int i, const int thread_id) {
     if (i < N-1) {
-      intermediate_stage_.initConstraints(robots[omp_get_thread_num()], 
+      intermediate_stage_.initConstraints(robots[thread_id], 
                                           time_discretization[i+1], s[i], data_[i]);
     }
     else {
-      terminal_stage_.initConstraints(robots[omp_get_thread_num()], 
+      terminal_stage_.initConstraints(robots[thread_id], 
                                       time_discretization[i+1], s[i], data_[i]);
     }
-  }
+  });
 }
 
 
@@ -95,28 +104,27 @@ void UnconstrBackwardCorrection::evalOCP(
     const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s, 
     KKTResidual& kkt_residual) {
   const int N = time_discretization.size() - 1;
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<N; ++i) {
+  performance_index_sum_.reset(PerformanceIndex());
+  thread_pool_.parallelFor(N, [&](const int i, const int thread_id) {
     if (i == 0) {
-      intermediate_stage_.evalOCP(robots[omp_get_thread_num()], 
+      intermediate_stage_.evalOCP(robots[thread_id], 
                                   time_discretization[i+1], q, v, s[i],  
                                   data_[i], kkt_residual[i]);
     }
     else if (i < N-1) {
-      intermediate_stage_.evalOCP(robots[omp_get_thread_num()], 
+      intermediate_stage_.evalOCP(robots[thread_id], 
                                   time_discretization[i+1], s[i-1].q, s[i-1].v, 
                                   s[i], data_[i], kkt_residual[i]);
     }
     else {
-      terminal_stage_.evalOCP(robots[omp_get_thread_num()], 
+      terminal_stage_.evalOCP(robots[thread_id], 
                               time_discretization[i+1], s[i-1].q, s[i-1].v, 
                               s[i], data_[i], kkt_residual[i]);
     }
-  }
-  performance_index_.setZero();
-  for (int i=0; i<N; ++i) {
-    performance_index_ += data_[i].performance_index;
-  }
+    performance_index_sum_.local(thread_id) += data_[i].performance_index;
+  });
+  performance_index_ = performance_index_sum_.reduce(
+      PerformanceIndex(), std::plus<PerformanceIndex>());
 }
 
 
@@ -126,28 +134,27 @@ void UnconstrBackwardCorrection::evalKKT(
     const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s, 
     KKTMatrix& kkt_matrix, KKTResidual& kkt_residual) {
   const int N = time_discretization.size() - 1;
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<N; ++i) {
+  performance_index_sum_.reset(PerformanceIndex());
+  thread_pool_.parallelFor(N, [&](const int i, const int thread_id) {
     if (i == 0) {
-      intermediate_stage_.evalKKT(robots[omp_get_thread_num()], 
+      intermediate_stage_.evalKKT(robots[thread_id], 
                                   time_discretization[i+1], q, v, s[i], s[i+1], 
                                   data_[i], kkt_matrix[i], kkt_residual[i]);
     }
     else if (i < N-1) {
-      intermediate_stage_.evalKKT(robots[omp_get_thread_num()], 
+      intermediate_stage_.evalKKT(robots[thread_id], 
                                   time_discretization[i+1], s[i-1].q, s[i-1].v, 
                                   s[i], s[i+1], data_[i], kkt_matrix[i], kkt_residual[i]);
     }
     else {
-      terminal_stage_.evalKKT(robots[omp_get_thread_num()], 
+      terminal_stage_.evalKKT(robots[thread_id], 
                               time_discretization[i+1], s[i-1].q, s[i-1].v, 
                               s[i], data_[i], kkt_matrix[i], kkt_residual[i]);
     }
-  }
-  performance_index_.setZero();
-  for (int i=0; i<N; ++i) {
-    performance_index_ += data_[i].performance_index;
-  }
+    performance_index_sum_.local(thread_id) += data_[i].performance_index;
+  });
+  performance_index_ = performance_index_sum_.reduce(
+      PerformanceIndex(), std::plus<PerformanceIndex>());
 }
 
 
@@ -157,34 +164,33 @@ void UnconstrBackwardCorrection::coarseUpdate(
     const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s, 
     KKTMatrix& kkt_matrix, KKTResidual& kkt_residual) {
   const int N = time_discretization.size() - 1;
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<N; ++i) {
+  performance_index_sum_.reset(PerformanceIndex());
+  thread_pool_.parallelFor(N, [&](const int i, const int thread_id) {
     if (i == 0) {
-      intermediate_stage_.evalKKT(robots[omp_get_thread_num()], 
+      intermediate_stage_.evalKKT(robots[thread_id], 
                                   time_discretization[i+1], q, v, s[i], s[i+1], 
                                   data_[i], kkt_matrix[i], kkt_residual[i]);
       corrector_[i].coarseUpdate(aux_mat_[i+1], time_discretization[i+1].dt, 
                                  kkt_matrix[i], kkt_residual[i], s[i], s_new_[i]);
     }
     else if (i < N-1) {
-      intermediate_stage_.evalKKT(robots[omp_get_thread_num()], 
+      intermediate_stage_.evalKKT(robots[thread_id], 
                                   time_discretization[i+1], s[i-1].q, s[i-1].v, 
                                   s[i], s[i+1], data_[i], kkt_matrix[i], kkt_residual[i]);
       corrector_[i].coarseUpdate(aux_mat_[i+1], time_discretization[i+1].dt, 
                                  kkt_matrix[i], kkt_residual[i], s[i], s_new_[i]);
     }
     else {
-      terminal_stage_.evalKKT(robots[omp_get_thread_num()], 
+      terminal_stage_.evalKKT(robots[thread_id], 
                               time_discretization[i+1], s[i-1].q, s[i-1].v, 
                               s[i], data_[i], kkt_matrix[i], kkt_residual[i]);
       corrector_[i].coarseUpdate(time_discretization[i+1].dt, kkt_matrix[i], 
                                  kkt_residual[i], s[i], s_new_[i]);
     }
-  }
-  performance_index_.setZero();
-  for (int i=0; i<N; ++i) {
-    performance_index_ += data_[i].performance_index;
-  }
+    performance_index_sum_.local(thread_id) += data_[i].performance_index;
+  });
+  performance_index_ = performance_index_sum_.reduce(
+      PerformanceIndex(), std::plus<PerformanceIndex>());
 }
 
 
@@ -196,15 +202,17 @@ void UnconstrBackwardCorrection::backwardCorrection(
   for (int i=N-2; i>=0; --i) {
     corrector_[i].backwardCorrectionSerial(s[i+1], s_new_[i+1], s_new_[i]);
   }
-  #pragma omp parallel for num_threads(nthreads_) 
-  for (int i=N-2; i>=0; --i) {
+  thread_pool_.parallelFor(N-1, [&](const int i, const int thread_id) {
     corrector_[i].backwardCorrectionParallel(s_new_[i]);
-  }
+  });
   for (int i=1; i<N; ++i) {
     corrector_[i].forwardCorrectionSerial(s[i-1], s_new_[i-1], s_new_[i]);
   }
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<N; ++i) {
+  min_primal_step_size_.reset(1.0);
+  min_dual_step_size_.reset(1.0);
+  thread_pool_.parallelFor(N, [&](const int i, const int thread_id) {
+    double& primal_step_size = min_primal_step_size_.local(thread_id);
+    double& dual_step_size = min_dual_step_size_.local(thread_id);
     if (i > 0) {
       corrector_[i].forwardCorrectionParallel(s_new_[i]);
       aux_mat_[i] = - corrector_[i].auxMat();
@@ -214,27 +222,34 @@ void UnconstrBackwardCorrection::backwardCorrection(
       intermediate_stage_.expandPrimalAndDual(time_discretization[i+1].dt,  
                                               kkt_matrix[i], kkt_residual[i], 
                                               data_[i], d[i]);
-      primal_step_sizes_.coeffRef(i) = intermediate_stage_.maxPrimalStepSize(data_[i]);
-      dual_step_sizes_.coeffRef(i)  = intermediate_stage_.maxDualStepSize(data_[i]);
+      primal_step_size = std::min(primal_step_size, 
+                                  intermediate_stage_.maxPrimalStepSize(data_[i]));
+      dual_step_size = std::min(dual_step_size, 
+                                intermediate_stage_.maxDualStepSize(data_[i]));
     }
     else {
       terminal_stage_.expandPrimalAndDual(time_discretization[i+1].dt,  
                                           kkt_matrix[i], kkt_residual[i], 
                                           data_[i], d[i]);
-      primal_step_sizes_.coeffRef(i) = terminal_stage_.maxPrimalStepSize(data_[i]);
-      dual_step_sizes_.coeffRef(i)  = terminal_stage_.maxDualStepSize(data_[i]);
+      primal_step_size = std::min(primal_step_size, 
+                                  terminal_stage_.maxPrimalStepSize(data_[i]));
+      dual_step_size = std::min(dual_step_size, 
+                                terminal_stage_.maxDualStepSize(data_[i]));
     }
-  }
+  });
+  auto min = [](const double a, const double b) { return std::min(a, b); };
+  primal_step_size_ = min_primal_step_size_.reduce(1.0, min);
+  dual_step_size_ = min_dual_step_size_.reduce(1.0, min);
 }
 
 
 double UnconstrBackwardCorrection::primalStepSize() const {
-  return primal_step_sizes_.minCoeff();
+  return primal_step_size_;
 }
 
 
 double UnconstrBackwardCorrection::dualStepSize() const {
-  return dual_step_sizes_.minCoeff();
+  return dual_step_size_;
 }
 
 void UnconstrBackwardCorrection::integrateSolution(
@@ -242,21 +257,20 @@ void UnconstrBackwardCorrection::integrateSolution(
     const std::vector<GridInfo>& time_discretization, 
     const double primal_step_size, const double dual_step_size,
     Direction& d, Solution& s) {
-  assert(robots.size() >= nthreads_);
+  assert(robots.size() >= thread_pool_.nthreads());
   const int N = time_discretization.size() - 1;
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<N; ++i) {
+  thread_pool_.parallelFor(N, [&](const int i, const int thread_id) {
     if (i < N-1) {
-      intermediate_stage_.updatePrimal(robots[omp_get_thread_num()], 
+      intermediate_stage_.updatePrimal(robots[thread_id], 
                                        primal_step_size, d[i], s[i], data_[i]);
       intermediate_stage_.updateDual(dual_step_size, data_[i]);
     }
     else {
-      terminal_stage_.updatePrimal(robots[omp_get_thread_num()],  
+      terminal_stage_.updatePrimal(robots[thread_id],  
                                    primal_step_size, d[i], s[i], data_[i]);
       terminal_stage_.updateDual(dual_step_size, data_[i]);
     }
-  }
+  });
 }
 
 } // namespace robotoc
\ No newline at end of file
@@ -12,8 +12,11 @@ ContactSequence::ContactSequence(const Robot& robot,
                                  const int reserved_num_discrete_events)
   : reserved_num_discrete_events_(reserved_num_discrete_events),
     default_contact_status_(robot.createContactStatus()),
-    contact_statuses_(2*reserved_num_discrete_events+1),
-    impact_events_(reserved_num_discrete_events),
+    contact_statuses_(2*reserved_num_discrete_events+1, 
+                      default_contact_status_),
+    impact_events_(reserved_num_discrete_events, 
+                   DiscreteEvent(default_contact_status_, 
+                                 default_contact_status_)),
     event_index_impact_(reserved_num_discrete_events), 
     event_index_lift_(reserved_num_discrete_events),
     event_time_(2*reserved_num_discrete_events),
@@ -322,38 +325,21 @@ void ContactSequence::setFrictionCoefficients(
 }
 
 
-template <typename T> 
-void reserveDeque(std::deque<T>& deq, const int size) {
-  assert(size >= 0);
-  if (deq.empty()) {
-    deq.resize(size);
-  }
-  else {
-    const int current_size = deq.size();
-    if (current_size < size) {
-      while (deq.size() < size) {
-        deq.push_back(deq.back());
-      }
-      while (deq.size() > current_size) {
-        deq.pop_back();
-      }
-    }
-  }
-}
-
-
 void ContactSequence::reserve(const int reserved_num_discrete_events) {
   if (reserved_num_discrete_events_ < reserved_num_discrete_events) {
-    reserveDeque(contact_statuses_, 2*reserved_num_discrete_events+1);
-    reserveDeque(impact_events_, reserved_num_discrete_events);
-    reserveDeque(event_index_impact_, reserved_num_discrete_events);
-    reserveDeque(event_index_lift_, reserved_num_discrete_events);
-    reserveDeque(event_time_, 2*reserved_num_discrete_events);
-    reserveDeque(impact_time_, reserved_num_discrete_events);
-    reserveDeque(lift_time_, reserved_num_discrete_events);
-    reserveDeque(is_impact_event_, 2*reserved_num_discrete_events);
-    reserveDeque(sto_impact_, reserved_num_discrete_events);
-    reserveDeque(sto_lift_, reserved_num_discrete_events);
+    contact_statuses_.reserve(2*reserved_num_discrete_events+1, 
+                              default_contact_status_);
+    impact_events_.reserve(reserved_num_discrete_events, 
+                           DiscreteEvent(default_contact_status_, 
+                                         default_contact_status_));
+    event_index_impact_.reserve(reserved_num_discrete_events);
+    event_index_lift_.reserve(reserved_num_discrete_events);
+    event_time_.reserve(2*reserved_num_discrete_events);
+    impact_time_.reserve(reserved_num_discrete_events);
+    lift_time_.reserve(reserved_num_discrete_events);
+    is_impact_event_.reserve(2*reserved_num_discrete_events);
+    sto_impact_.reserve(reserved_num_discrete_events);
+    sto_lift_.reserve(reserved_num_discrete_events);
     reserved_num_discrete_events_ = reserved_num_discrete_events;
   }
 }
@@ -379,6 +365,54 @@ void ContactSequence::clear() {
 
 
 
+void ContactSequence::save(BinaryOutputArchive& ar) const {
+  ar.write(reserved_num_discrete_events_);
+  default_contact_status_.save(ar);
+  ar.writeSize(numContactPhases());
+  if (numContactPhases() == 0) return;
+  contact_statuses_.front().save(ar);
+  int impact_index = 0;
+  int lift_index = 0;
+  for (int event_index=0; event_index<numDiscreteEvents(); ++event_index) {
+    contact_statuses_[event_index+1].save(ar);
+    ar.write(event_time_[event_index]);
+    if (is_impact_event_[event_index]) {
+      ar.write(isSTOEnabledImpact(impact_index));
+      ++impact_index;
+    }
+    else {
+      ar.write(isSTOEnabledLift(lift_index));
+      ++lift_index;
+    }
+  }
+}
+
+
+void ContactSequence::load(BinaryInputArchive& ar) {
+  int reserved_num_discrete_events;
+  ar.read(reserved_num_discrete_events);
+  default_contact_status_.load(ar);
+  const int num_contact_phases = ar.readSize();
+  if (num_contact_phases == 0) {
+    clear();
+    reserve(reserved_num_discrete_events);
+    return;
+  }
+  ContactStatus contact_status;
+  contact_status.load(ar);
+  init(contact_status);
+  for (int event_index=0; event_index<num_contact_phases-1; ++event_index) {
+    contact_status.load(ar);
+    double event_time;
+    bool sto;
+    ar.read(event_time);
+    ar.read(sto);
+    push_back(contact_status, event_time, sto);
+  }
+  reserve(reserved_num_discrete_events);
+}
+
+
 void ContactSequence::disp(std::ostream& os) const {
   int impact_index = 0;
   int lift_index = 0;
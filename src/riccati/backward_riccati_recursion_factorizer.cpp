@@ -10,6 +10,7 @@ BackwardRiccatiRecursionFactorizer::BackwardRiccatiRecursionFactorizer(
     AtP_(MatrixXdRowMajor::Zero(2*robot.dimv(), 2*robot.dimv())),
     BtP_(MatrixXdRowMajor::Zero(robot.dimu(), 2*robot.dimv())),
     GK_(Eigen::MatrixXd::Zero(robot.dimu(), 2*robot.dimv())), 
+    BtH_(Eigen::MatrixXd::Zero(robot.dimu(), robot.dimu())), 
     Pf_(Eigen::VectorXd::Zero(2*robot.dimv())) {
 }
 
@@ -20,6 +21,7 @@ BackwardRiccatiRecursionFactorizer::BackwardRiccatiRecursionFactorizer()
     AtP_(),
     BtP_(),
     GK_(),
+    BtH_(),
     Pf_() {
 }
 
@@ -33,8 +35,10 @@ void BackwardRiccatiRecursionFactorizer::factorizeKKTMatrix(
     SplitKKTMatrix& kkt_matrix, SplitKKTResidual& kkt_residual) {
   AtP_.noalias() = kkt_matrix.Fxx.transpose() * riccati_next.P;
   BtP_.noalias() = kkt_matrix.Fvu.transpose() * riccati_next.P.bottomRows(dimv_);
-  // Factorize F
-  kkt_matrix.Qxx.noalias() += AtP_ * kkt_matrix.Fxx;
+  // Factorize F (only the lower triangular part is computed)
+  kkt_matrix.Qxx.template triangularView<Eigen::Lower>() += AtP_ * kkt_matrix.Fxx;
+  kkt_matrix.Qxx.template triangularView<Eigen::StrictlyUpper>() 
+      = kkt_matrix.Qxx.transpose();
   // Factorize H
   kkt_matrix.Qxu.noalias() += AtP_.rightCols(dimv_) * kkt_matrix.Fvu;
   // Factorize G
@@ -45,6 +49,23 @@ void BackwardRiccatiRecursionFactorizer::factorizeKKTMatrix(
 }
 
 
+void BackwardRiccatiRecursionFactorizer::factorizeMoveBlocking(
+    const SplitKKTMatrix& kkt_matrix_next, 
+    const SplitKKTResidual& kkt_residual_next, 
+    SplitKKTMatrix& kkt_matrix, SplitKKTResidual& kkt_residual) {
+  BtH_.noalias() = kkt_matrix.Fvu.transpose() * kkt_matrix_next.Qxu.bottomRows(dimv_);
+  // Factorize H
+  kkt_matrix.Qxu.noalias() += kkt_matrix.Fxx.transpose() * kkt_matrix_next.Qxu;
+  // Factorize G
+  kkt_matrix.Quu.noalias() += BtH_;
+  kkt_matrix.Quu.noalias() += BtH_.transpose();
+  kkt_matrix.Quu.noalias() += kkt_matrix_next.Quu;
+  // Factorize vector term
+  kkt_residual.lu.noalias() += kkt_matrix_next.Qxu.transpose() * kkt_residual.Fx;
+  kkt_residual.lu.noalias() += kkt_residual_next.lu;
+}
+
+
 void BackwardRiccatiRecursionFactorizer::factorizeHamiltonian(
     const SplitRiccatiFactorization& riccati_next, 
     const SplitKKTMatrix& kkt_matrix, SplitRiccatiFactorization& riccati,
@@ -70,8 +91,10 @@ void BackwardRiccatiRecursionFactorizer::factorizeKKTMatrix(
     const SplitRiccatiFactorization& riccati_next, 
     SplitKKTMatrix& kkt_matrix) {
   AtP_.noalias() = kkt_matrix.Fxx.transpose() * riccati_next.P;
-  // Factorize F
-  kkt_matrix.Qxx.noalias() += AtP_ * kkt_matrix.Fxx;
+  // Factorize F (only the lower triangular part is computed)
+  kkt_matrix.Qxx.template triangularView<Eigen::Lower>() += AtP_ * kkt_matrix.Fxx;
+  kkt_matrix.Qxx.template triangularView<Eigen::StrictlyUpper>() 
+      = kkt_matrix.Qxx.transpose();
 }
 
 
@@ -80,9 +103,13 @@ void BackwardRiccatiRecursionFactorizer::factorizeRiccatiFactorization(
     const SplitKKTResidual& kkt_residual, const LQRPolicy& lqr_policy, 
     SplitRiccatiFactorization& riccati) {
   GK_.noalias() = kkt_matrix.Quu * lqr_policy.K; 
-  kkt_matrix.Qxx.noalias() -= lqr_policy.K.transpose() * GK_;
-  // Riccati factorization matrix with preserving the symmetry
-  riccati.P = 0.5 * (kkt_matrix.Qxx + kkt_matrix.Qxx.transpose());
+  // Symmetric update of the lower triangular part
+  kkt_matrix.Qxx.template triangularView<Eigen::Lower>() 
+      -= lqr_policy.K.transpose() * GK_;
+  kkt_matrix.Qxx.template triangularView<Eigen::StrictlyUpper>() 
+      = kkt_matrix.Qxx.transpose();
+  // Riccati factorization matrix
+  riccati.P = kkt_matrix.Qxx;
   // Riccati factorization vector
   riccati.s.noalias()  = kkt_matrix.Fxx.transpose() * riccati_next.s;
   riccati.s.noalias() -= AtP_ * kkt_residual.Fx;
@@ -148,8 +175,8 @@ void BackwardRiccatiRecursionFactorizer::factorizeRiccatiFactorization(
     const SplitKKTMatrix& kkt_matrix, 
     const SplitKKTResidual& kkt_residual, 
     SplitRiccatiFactorization& riccati) {
-  // Riccati factorization matrix with preserving the symmetry
-  riccati.P = 0.5 * (kkt_matrix.Qxx + kkt_matrix.Qxx.transpose());
+  // Riccati factorization matrix (Qxx is kept symmetric by factorizeKKTMatrix())
+  riccati.P = kkt_matrix.Qxx;
   // Riccati factorization vector
   riccati.s.noalias()  = kkt_matrix.Fxx.transpose() * riccati_next.s;
   riccati.s.noalias() -= AtP_ * kkt_residual.Fx;
@@ -51,27 +51,30 @@ void RiccatiFactorizer::backwardRiccatiRecursion(
   assert(kkt_matrix.dims() == kkt_residual.dims());
   riccati.setConstraintDimension(kkt_matrix.dims());
   c_riccati_.setConstraintDimension(kkt_matrix.dims());
-  if (kkt_matrix.dims() == 0) {
-    lqr_policy.K.noalias() = - llt_.solve(kkt_matrix.Qxu.transpose());
-    lqr_policy.k.noalias() = - llt_.solve(kkt_residual.lu);
-  }
-  else {
-    // Schur complement
-    c_riccati_.Ginv.noalias() = llt_.solve(Eigen::MatrixXd::Identity(dimu_, dimu_));
-    c_riccati_.DGinv().transpose().noalias() = llt_.solve(kkt_matrix.Phiu().transpose());
-    c_riccati_.S().noalias() = c_riccati_.DGinv() * kkt_matrix.Phiu().transpose();
+  lqr_policy.K.noalias() = - llt_.solve(kkt_matrix.Qxu.transpose());
+  lqr_policy.k.noalias() = - llt_.solve(kkt_residual.lu);
+  if (kkt_matrix.dims() > 0) {
+    // Range-space method only with the triangular solves with the Cholesky 
+    // factor L of Quu: S = D Quu^{-1} D^T = (L^{-1} D^T)^T (L^{-1} D^T)
+    c_riccati_.GinvDt() = kkt_matrix.Phiu().transpose();
+    llt_.matrixL().solveInPlace(c_riccati_.GinvDt());
+    c_riccati_.S().noalias() 
+        = c_riccati_.GinvDt().transpose() * c_riccati_.GinvDt();
+    llt_.matrixU().solveInPlace(c_riccati_.GinvDt());
     llt_s_.compute(c_riccati_.S());
     assert(llt_s_.info() == Eigen::Success);
-    c_riccati_.SinvDGinv().noalias() = llt_s_.solve(c_riccati_.DGinv());
-    c_riccati_.Ginv.noalias() -= c_riccati_.SinvDGinv().transpose() * c_riccati_.DGinv();
-    lqr_policy.K.noalias()  = - c_riccati_.Ginv * kkt_matrix.Qxu.transpose();
-    lqr_policy.K.noalias() -= c_riccati_.SinvDGinv().transpose() * kkt_matrix.Phix();
-    lqr_policy.k.noalias()  = - c_riccati_.Ginv * kkt_residual.lu;
-    lqr_policy.k.noalias() -= c_riccati_.SinvDGinv().transpose() * kkt_residual.P();
-    riccati.M().noalias()  = llt_s_.solve(kkt_matrix.Phix());
-    riccati.M().noalias() -= c_riccati_.SinvDGinv() * kkt_matrix.Qxu.transpose();
-    riccati.m().noalias()  = llt_s_.solve(kkt_residual.P());
-    riccati.m().noalias() -= c_riccati_.SinvDGinv() * kkt_residual.lu;
+    // Multipliers of the switching constraint
+    auto M = riccati.M();
+    M = kkt_matrix.Phix();
+    M.noalias() += kkt_matrix.Phiu() * lqr_policy.K;
+    llt_s_.solveInPlace(M);
+    auto m = riccati.m();
+    m = kkt_residual.P();
+    m.noalias() += kkt_matrix.Phiu() * lqr_policy.k;
+    llt_s_.solveInPlace(m);
+    // Corrects the unconstrained feedback and feedforward terms
+    lqr_policy.K.noalias() -= c_riccati_.GinvDt() * M;
+    lqr_policy.k.noalias() -= c_riccati_.GinvDt() * m;
     assert(!riccati.M().hasNaN());
     assert(!riccati.m().hasNaN());
   }
@@ -81,10 +84,14 @@ void RiccatiFactorizer::backwardRiccatiRecursion(
                                                     kkt_residual, lqr_policy,
                                                     riccati);
   if (kkt_matrix.dims() > 0) {
-    c_riccati_.DtM.noalias()   = kkt_matrix.Phiu().transpose() * riccati.M();
-    c_riccati_.KtDtM.noalias() = lqr_policy.K.transpose() * c_riccati_.DtM;
-    riccati.P.noalias() -= c_riccati_.KtDtM;
-    riccati.P.noalias() -= c_riccati_.KtDtM.transpose();
+    c_riccati_.DtM.noalias() = kkt_matrix.Phiu().transpose() * riccati.M();
+    // Symmetric rank-2k update of the lower triangular part
+    riccati.P.template triangularView<Eigen::Lower>() 
+        -= lqr_policy.K.transpose() * c_riccati_.DtM;
+    riccati.P.template triangularView<Eigen::Lower>() 
+        -= c_riccati_.DtM.transpose() * lqr_policy.K;
+    riccati.P.template triangularView<Eigen::StrictlyUpper>() 
+        = riccati.P.transpose();
     riccati.s.noalias() -= kkt_matrix.Phix().transpose() * riccati.m();
   }
 }
@@ -106,26 +113,27 @@ void RiccatiFactorizer::backwardRiccatiRecursion(
 
   backward_recursion_.factorizeHamiltonian(riccati_next, kkt_matrix, riccati,
                                             has_next_sto_phase);
-  lqr_policy.W.setZero();
+  lqr_policy.T.noalias() = - llt_.solve(riccati.psi_u);
+  if (has_next_sto_phase) {
+    lqr_policy.W.noalias() = - llt_.solve(riccati.phi_u);
+  }
+  else {
+    lqr_policy.W.setZero();
+  }
   if (kkt_matrix.dims() > 0) {
-    lqr_policy.T.noalias()  = - c_riccati_.Ginv * riccati.psi_u;
-    lqr_policy.T.noalias() -= c_riccati_.SinvDGinv().transpose() * kkt_matrix.Phit();
-    if (has_next_sto_phase) {
-      lqr_policy.W.noalias()  = - c_riccati_.Ginv * riccati.phi_u;
-    }
-    riccati.mt().noalias()  = llt_s_.solve(kkt_matrix.Phit());
-    riccati.mt().noalias() -= c_riccati_.SinvDGinv() * riccati.psi_u;
+    auto mt = riccati.mt();
+    mt = kkt_matrix.Phit();
+    mt.noalias() += kkt_matrix.Phiu() * lqr_policy.T;
+    llt_s_.solveInPlace(mt);
+    lqr_policy.T.noalias() -= c_riccati_.GinvDt() * mt;
+    auto mt_next = riccati.mt_next();
     if (has_next_sto_phase) {
-      riccati.mt_next().noalias() = - c_riccati_.SinvDGinv() * riccati.phi_u;
+      mt_next.noalias() = kkt_matrix.Phiu() * lqr_policy.W;
+      llt_s_.solveInPlace(mt_next);
+      lqr_policy.W.noalias() -= c_riccati_.GinvDt() * mt_next;
     }
     else {
-      riccati.mt_next().setZero();
-    }
-  }
-  else {
-    lqr_policy.T.noalias() = - llt_.solve(riccati.psi_u);
-    if (has_next_sto_phase) {
-      lqr_policy.W.noalias() = - llt_.solve(riccati.phi_u);
+      mt_next.setZero();
     }
   }
   backward_recursion_.factorizeSTOFactorization(riccati_next, kkt_matrix, 
@@ -197,6 +205,54 @@ void RiccatiFactorizer::backwardRiccatiRecursion(
 }
 
 
+void RiccatiFactorizer::backwardRiccatiRecursionMoveBlocking(
+    const SplitRiccatiFactorization& riccati_next, 
+    const SplitKKTMatrix& kkt_matrix_next, 
+    const SplitKKTResidual& kkt_residual_next, SplitKKTMatrix& kkt_matrix, 
+    SplitKKTResidual& kkt_residual, SplitRiccatiFactorization& riccati, 
+    LQRPolicy& lqr_policy, const bool move_blocked) {
+  assert(kkt_matrix.dims() == 0);
+  backward_recursion_.factorizeKKTMatrix(riccati_next, kkt_matrix, kkt_residual);
+  backward_recursion_.factorizeMoveBlocking(kkt_matrix_next, kkt_residual_next,
+                                            kkt_matrix, kkt_residual);
+  riccati.setConstraintDimension(0);
+  if (move_blocked) {
+    backward_recursion_.factorizeRiccatiFactorization(riccati_next, kkt_matrix, 
+                                                      kkt_residual, riccati);
+  }
+  else {
+    llt_.compute(kkt_matrix.Quu);
+    assert(llt_.info() == Eigen::Success);
+    lqr_policy.K.noalias() = - llt_.solve(kkt_matrix.Qxu.transpose());
+    lqr_policy.k.noalias() = - llt_.solve(kkt_residual.lu);
+    assert(!lqr_policy.K.hasNaN());
+    assert(!lqr_policy.k.hasNaN());
+    backward_recursion_.factorizeRiccatiFactorization(riccati_next, kkt_matrix, 
+                                                      kkt_residual, lqr_policy,
+                                                      riccati);
+  }
+  riccati.Psi.setZero();
+  riccati.xi = 0.;
+  riccati.chi = 0.;
+  riccati.eta = 0.;
+}
+
+
+void RiccatiFactorizer::backwardRiccatiRecursionMoveBlocking(
+    const SplitRiccatiFactorization& riccati_next, SplitKKTMatrix& kkt_matrix, 
+    SplitKKTResidual& kkt_residual, SplitRiccatiFactorization& riccati) {
+  assert(kkt_matrix.dims() == 0);
+  backward_recursion_.factorizeKKTMatrix(riccati_next, kkt_matrix, kkt_residual);
+  riccati.setConstraintDimension(0);
+  backward_recursion_.factorizeRiccatiFactorization(riccati_next, kkt_matrix, 
+                                                    kkt_residual, riccati);
+  riccati.Psi.setZero();
+  riccati.xi = 0.;
+  riccati.chi = 0.;
+  riccati.eta = 0.;
+}
+
+
 void forwardRiccatiRecursion(const SplitKKTMatrix& kkt_matrix, 
                              const SplitKKTResidual& kkt_residual, 
                              const LQRPolicy& lqr_policy, 
@@ -231,6 +287,20 @@ void forwardRiccatiRecursion(const SplitKKTMatrix& kkt_matrix,
 }
 
 
+void forwardRiccatiRecursionMoveBlocking(const SplitKKTMatrix& kkt_matrix, 
+                                         const SplitKKTResidual& kkt_residual,
+                                         const SplitDirection& d_prev, 
+                                         SplitDirection& d, 
+                                         SplitDirection& d_next) {
+  d.du = d_prev.du;
+  d_next.dx = kkt_residual.Fx;
+  d_next.dx.noalias()   += kkt_matrix.Fxx * d.dx;
+  d_next.dv().noalias() += kkt_matrix.Fvu * d.du;
+  d_next.dts = d.dts;
+  d_next.dts_next = d.dts_next;
+}
+
+
 void computeSwitchingTimeDirection(const STOPolicy& sto_policy, SplitDirection& d, 
                                    const bool has_prev_sto_phase) {
   d.dts_next = sto_policy.dtsdx.dot(d.dx) + sto_policy.dts0;
@@ -262,6 +332,14 @@ void computeCostateDirection(const SplitRiccatiFactorization& riccati,
 }
 
 
+void computeCostateDirectionMoveBlocking(
+    const SplitRiccatiFactorization& riccati, const SplitKKTMatrix& kkt_matrix,
+    SplitDirection& d) {
+  d.dlmdgmm.noalias()  = riccati.P * d.dx - riccati.s;
+  d.dlmdgmm.noalias() += kkt_matrix.Qxu * d.du;
+}
+
+
 void computeLagrangeMultiplierDirection(const SplitRiccatiFactorization& riccati, 
                                         SplitDirection& d, const bool sto, 
                                         const bool has_next_sto_phase) {
@@ -5,6 +5,8 @@
 #include <iostream>
 #include <cassert>
 
+#include "robotoc/utils/tracer.hpp"
+
 namespace robotoc {
 
 RiccatiRecursion::RiccatiRecursion(const OCP& ocp, const double max_dts0)
@@ -32,13 +34,24 @@ void RiccatiRecursion::setRegularization(const double max_dts0) {
 void RiccatiRecursion::backwardRiccatiRecursion(
     const TimeDiscretization& time_discretization, KKTMatrix& kkt_matrix, 
     KKTResidual& kkt_residual, RiccatiFactorization& factorization) {
+  ROBOTOC_TRACE_SCOPE("RiccatiRecursion::backwardRiccatiRecursion");
   resizeData(time_discretization);
   const int N = time_discretization.size() - 1;
   factorization[N].P = kkt_matrix[N].Qxx;
   factorization[N].s = - kkt_residual[N].lx;
   for (int i=N-1; i>=0; --i) {
     const auto& grid = time_discretization[i];
-    if (grid.type == GridType::Impact) {
+    if (time_discretization[i+1].move_blocked) {
+      factorizer_.backwardRiccatiRecursionMoveBlocking(
+          factorization[i+1], kkt_matrix[i+1], kkt_residual[i+1], 
+          kkt_matrix[i], kkt_residual[i], factorization[i], lqr_policy_[i], 
+          grid.move_blocked);
+    }
+    else if (grid.move_blocked) {
+      factorizer_.backwardRiccatiRecursionMoveBlocking(
+          factorization[i+1], kkt_matrix[i], kkt_residual[i], factorization[i]);
+    }
+    else if (grid.type == GridType::Impact) {
       if (time_discretization[i-1].sto || grid.sto) {
         factorizer_.backwardRiccatiRecursionPhaseTransition(
             factorization[i+1], factorization_m_, sto_policy_[i], grid.sto_next);
@@ -77,6 +90,13 @@ void RiccatiRecursion::backwardRiccatiRecursion(
     factorizer_.backwardRiccatiRecursionPhaseTransition(
         factorization[0], factorization_m_, sto_policy_[0], grid.sto_next);
   }
+  // The stages sharing the control input hold the policy of the first stage 
+  // of the block.
+  for (int i=1; i<N; ++i) {
+    if (time_discretization[i].move_blocked) {
+      lqr_policy_[i] = lqr_policy_[i-1];
+    }
+  }
 }
 
 
@@ -84,6 +104,7 @@ void RiccatiRecursion::forwardRiccatiRecursion(
     const TimeDiscretization& time_discretization, const KKTMatrix& kkt_matrix, 
     const KKTResidual& kkt_residual, const RiccatiFactorization& factorization,
     Direction& d) const {
+  ROBOTOC_TRACE_SCOPE("RiccatiRecursion::forwardRiccatiRecursion");
   const int N = time_discretization.size() - 1;
   d[0].dts = 0.0;
   d[0].dts_next = 0.0;
@@ -116,6 +137,11 @@ void RiccatiRecursion::forwardRiccatiRecursion(
                                          d[i], d[i+1], grid.sto, grid.sto_next);
       ::robotoc::computeCostateDirection(factorization[i], d[i], grid.sto, grid.sto_next);
     }
+    else if (grid.move_blocked) {
+      ::robotoc::forwardRiccatiRecursionMoveBlocking(kkt_matrix[i], kkt_residual[i], 
+                                                     d[i-1], d[i], d[i+1]);
+      ::robotoc::computeCostateDirectionMoveBlocking(factorization[i], kkt_matrix[i], d[i]);
+    }
     else {
       ::robotoc::forwardRiccatiRecursion(kkt_matrix[i], kkt_residual[i],  lqr_policy_[i], 
                                          d[i], d[i+1], grid.sto, grid.sto_next);
@@ -136,6 +162,18 @@ const aligned_vector<LQRPolicy>& RiccatiRecursion::getLQRPolicy() const {
 }
 
 
+void RiccatiRecursion::setLQRPolicy(
+    const TimeDiscretization& time_discretization, 
+    const aligned_vector<LQRPolicy>& lqr_policy) {
+  resizeData(time_discretization);
+  const int N = time_discretization.size() - 1;
+  assert(lqr_policy.size() >= N+1);
+  for (int i=0; i<=N; ++i) {
+    lqr_policy_[i] = lqr_policy[i];
+  }
+}
+
+
 void RiccatiRecursion::resizeData(const TimeDiscretization& time_discretization) {
   const int N = time_discretization.size() - 1;
   while (lqr_policy_.size() < N+1) {
@@ -146,4 +184,30 @@ void RiccatiRecursion::resizeData(const TimeDiscretization& time_discretization)
   }
 }
 
-} // namespace robotoc
\ No newline at end of file
+
+
+void RiccatiRecursion::saveLQRPolicy(
+    BinaryOutputArchive& ar, const TimeDiscretization& time_discretization) const {
+  const int N = time_discretization.size() - 1;
+  assert(lqr_policy_.size() >= N+1);
+  ar.writeSize(N+1);
+  for (int i=0; i<=N; ++i) {
+    lqr_policy_[i].save(ar);
+  }
+}
+
+
+void RiccatiRecursion::loadLQRPolicy(
+    BinaryInputArchive& ar, const TimeDiscretization& time_discretization) {
+  resizeData(time_discretization);
+  const int N = time_discretization.size() - 1;
+  if (ar.readSize() != N+1) {
+    throw std::runtime_error("[RiccatiRecursion] number of the loaded stages must be " 
+                             + std::to_string(N+1) + "!");
+  }
+  for (int i=0; i<=N; ++i) {
+    lqr_policy_[i].load(ar);
+  }
+}
+
+} // namespace robotoc
@@ -56,9 +56,13 @@ factorizeRiccatiFactorization(const SplitRiccatiFactorization& riccati_next,
                               SplitRiccatiFactorization& riccati) {
   assert(dt > 0);
   GK_.noalias() = kkt_matrix.Qaa * lqr_policy.K; 
-  kkt_matrix.Qxx.noalias() -= lqr_policy.K.transpose() * GK_;
-  // Riccati factorization matrix with preserving the symmetry
-  riccati.P = 0.5 * (kkt_matrix.Qxx + kkt_matrix.Qxx.transpose());
+  // Symmetric update of the lower triangular part
+  kkt_matrix.Qxx.template triangularView<Eigen::Lower>() 
+      -= lqr_policy.K.transpose() * GK_;
+  kkt_matrix.Qxx.template triangularView<Eigen::StrictlyUpper>() 
+      = kkt_matrix.Qxx.transpose();
+  // Riccati factorization matrix
+  riccati.P = kkt_matrix.Qxx;
   // Riccati factorization vector
   riccati.s = riccati_next.s;
   riccati.sv().noalias() += dt * riccati_next.sq();
@@ -0,0 +1,454 @@
+#ifdef ROBOTOC_WITH_CODEGEN
+#ifndef __linux__
+#error "ENABLE_CODEGEN is only supported on Linux (CppAD::cg::LinuxDynamicLib)."
+#endif
+// The CppAD(CodeGen) support of pinocchio must be included before any other
+// pinocchio header.
+#include "pinocchio/codegen/cppadcg.hpp"
+#include "pinocchio/algorithm/joint-configuration.hpp"
+#include "pinocchio/algorithm/rnea.hpp"
+#include "pinocchio/algorithm/rnea-derivatives.hpp"
+#endif
+
+#include "robotoc/robot/codegen_kernels.hpp"
+
+#include <stdexcept>
+#include <cassert>
+#include <fstream>
+
+
+namespace robotoc {
+
+#ifdef ROBOTOC_WITH_CODEGEN
+
+namespace {
+
+using CGScalar = CppAD::cg::CG<double>;
+using ADScalar = CppAD::AD<CGScalar>;
+using ADModel = pinocchio::ModelTpl<ADScalar>;
+using ADData = pinocchio::DataTpl<ADScalar>;
+using ADForce = pinocchio::ForceTpl<ADScalar>;
+using ADVectorXs = Eigen::Matrix<ADScalar, Eigen::Dynamic, 1>;
+using ADMatrixXs = Eigen::Matrix<ADScalar, Eigen::Dynamic, Eigen::Dynamic>;
+using ADFun = CppAD::ADFun<CGScalar>;
+
+const std::string kRNEA = "rnea";
+const std::string kRNEADerivatives = "rnea_derivatives";
+const std::string kRNEAImpact = "rnea_impact";
+const std::string kRNEAImpactDerivatives = "rnea_impact_derivatives";
+
+// The inputs are [q; v; a; fext] with the velocity and [q; dv; fext] without
+// the velocity (impact), where fext stacks the 6D joint forces of all joints.
+int dimInput(const pinocchio::Model& model, const bool with_velocity) {
+  return model.nq + (with_velocity ? 2*model.nv : model.nv) + 6*model.njoints;
+}
+
+
+void recordRNEA(const pinocchio::Model& model, const bool with_velocity,
+                const bool derivatives, ADFun& fun) {
+  const ADModel ad_model = model.cast<ADScalar>();
+  ADData ad_data(ad_model);
+  const int nq = model.nq;
+  const int nv = model.nv;
+  ADVectorXs ad_x = ADVectorXs::Zero(dimInput(model, with_velocity));
+  ad_x.head(nq) = pinocchio::neutral(ad_model);
+  CppAD::Independent(ad_x);
+  int idx = 0;
+  const ADVectorXs ad_q = ad_x.segment(idx, nq);
+  idx += nq;
+  ADVectorXs ad_v = ADVectorXs::Zero(nv);
+  if (with_velocity) {
+    ad_v = ad_x.segment(idx, nv);
+    idx += nv;
+  }
+  const ADVectorXs ad_a = ad_x.segment(idx, nv);
+  idx += nv;
+  pinocchio::container::aligned_vector<ADForce> ad_fext(model.njoints);
+  for (auto& e : ad_fext) {
+    e = ADForce(ad_x.segment<6>(idx));
+    idx += 6;
+  }
+  ADVectorXs ad_y;
+  if (derivatives) {
+    pinocchio::computeRNEADerivatives(ad_model, ad_data, ad_q, ad_v, ad_a,
+                                      ad_fext);
+    ad_y.resize((with_velocity ? 3 : 2)*nv*nv);
+    int idy = 0;
+    Eigen::Map<ADMatrixXs>(ad_y.data()+idy, nv, nv) = ad_data.dtau_dq;
+    idy += nv*nv;
+    if (with_velocity) {
+      Eigen::Map<ADMatrixXs>(ad_y.data()+idy, nv, nv) = ad_data.dtau_dv;
+      idy += nv*nv;
+    }
+    Eigen::Map<ADMatrixXs>(ad_y.data()+idy, nv, nv) = ad_data.M;
+  }
+  else {
+    ad_y = pinocchio::rnea(ad_model, ad_data, ad_q, ad_v, ad_a, ad_fext);
+  }
+  fun.Dependent(ad_x, ad_y);
+  fun.optimize("no_compare_op");
+}
+
+
+pinocchio::container::aligned_vector<pinocchio::Force> randomForces(
+    const pinocchio::Model& model) {
+  pinocchio::container::aligned_vector<pinocchio::Force> fext(model.njoints);
+  for (auto& e : fext) {
+    e = pinocchio::Force::Random();
+  }
+  return fext;
+}
+
+
+bool isApproxUpper(const Eigen::MatrixXd& mat, const Eigen::MatrixXd& ref) {
+  const Eigen::MatrixXd mat_upper = mat.triangularView<Eigen::Upper>();
+  const Eigen::MatrixXd ref_upper = ref.triangularView<Eigen::Upper>();
+  return mat_upper.isApprox(ref_upper, 1.0e-08);
+}
+
+} // namespace
+
+
+struct CodeGenKernels::Impl {
+  std::shared_ptr<CppAD::cg::DynamicLib<double>> lib;
+  std::unique_ptr<CppAD::cg::GenericModel<double>> rnea, rnea_derivatives,
+                                                   rnea_impact,
+                                                   rnea_impact_derivatives;
+  int nq, nv, njoints;
+  Eigen::VectorXd x, x_impact, y;
+
+  Impl(const std::shared_ptr<CppAD::cg::DynamicLib<double>>& lib,
+       const int nq, const int nv, const int njoints)
+    : lib(lib),
+      rnea(lib->model(kRNEA)),
+      rnea_derivatives(lib->model(kRNEADerivatives)),
+      rnea_impact(lib->model(kRNEAImpact)),
+      rnea_impact_derivatives(lib->model(kRNEAImpactDerivatives)),
+      nq(nq),
+      nv(nv),
+      njoints(njoints),
+      x(Eigen::VectorXd::Zero(nq+2*nv+6*njoints)),
+      x_impact(Eigen::VectorXd::Zero(nq+nv+6*njoints)),
+      y(Eigen::VectorXd::Zero(3*nv*nv)) {
+  }
+
+  bool isConsistent() const {
+    return (rnea->Domain() == x.size() && rnea->Range() == nv
+            && rnea_derivatives->Domain() == x.size()
+            && rnea_derivatives->Range() == 3*nv*nv
+            && rnea_impact->Domain() == x_impact.size()
+            && rnea_impact->Range() == nv
+            && rnea_impact_derivatives->Domain() == x_impact.size()
+            && rnea_impact_derivatives->Range() == 2*nv*nv);
+  }
+
+  void setForces(
+      const pinocchio::container::aligned_vector<pinocchio::Force>& fext,
+      Eigen::VectorXd& x) const {
+    assert(fext.size() == njoints);
+    int idx = x.size() - 6*njoints;
+    for (const auto& e : fext) {
+      x.template segment<6>(idx) = e.toVector();
+      idx += 6;
+    }
+  }
+
+  static void eval(CppAD::cg::GenericModel<double>& kernel,
+                   const Eigen::VectorXd& x, double* y, const int dimy) {
+    kernel.ForwardZero(CppAD::cg::ArrayView<const double>(x.data(), x.size()),
+                       CppAD::cg::ArrayView<double>(y, dimy));
+  }
+};
+
+
+void CodeGenKernels::generate(const pinocchio::Model& model,
+                              const pinocchio::Model& impact_model,
+                              const std::string& library_name,
+                              const std::string& compiler) {
+  if (model.nq != impact_model.nq || model.nv != impact_model.nv
+      || model.njoints != impact_model.njoints) {
+    throw std::invalid_argument("[CodeGenKernels] invalid argument: model and impact_model must have the same dimensions!");
+  }
+  ADFun rnea, rnea_derivatives, rnea_impact, rnea_impact_derivatives;
+  recordRNEA(model, true, false, rnea);
+  recordRNEA(model, true, true, rnea_derivatives);
+  recordRNEA(impact_model, false, false, rnea_impact);
+  recordRNEA(impact_model, false, true, rnea_impact_derivatives);
+  CppAD::cg::ModelCSourceGen<double> rnea_gen(rnea, kRNEA);
+  CppAD::cg::ModelCSourceGen<double> rnea_derivatives_gen(rnea_derivatives,
+                                                          kRNEADerivatives);
+  CppAD::cg::ModelCSourceGen<double> rnea_impact_gen(rnea_impact, kRNEAImpact);
+  CppAD::cg::ModelCSourceGen<double> rnea_impact_derivatives_gen(
+      rnea_impact_derivatives, kRNEAImpactDerivatives);
+  rnea_gen.setCreateForwardZero(true);
+  rnea_derivatives_gen.setCreateForwardZero(true);
+  rnea_impact_gen.setCreateForwardZero(true);
+  rnea_impact_derivatives_gen.setCreateForwardZero(true);
+  CppAD::cg::ModelLibraryCSourceGen<double> lib_gen(
+      rnea_gen, rnea_derivatives_gen, rnea_impact_gen,
+      rnea_impact_derivatives_gen);
+  CppAD::cg::DynamicModelLibraryProcessor<double> processor(lib_gen,
+                                                            library_name);
+  CppAD::cg::GccCompiler<double> gcc(compiler);
+  std::vector<std::string> flags = gcc.getCompileFlags();
+  flags[0] = "-O3";
+  gcc.setCompileFlags(flags);
+  processor.createDynamicLibrary(gcc, false);
+}
+
+
+void CodeGenKernels::load(const pinocchio::Model& model,
+                          const pinocchio::Model& impact_model,
+                          const std::string& library_name) {
+  if (model.nq != impact_model.nq || model.nv != impact_model.nv
+      || model.njoints != impact_model.njoints) {
+    throw std::invalid_argument("[CodeGenKernels] invalid argument: model and impact_model must have the same dimensions!");
+  }
+  const std::string filename
+      = library_name + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+  if (!std::ifstream(filename).good()) {
+    throw std::runtime_error("[CodeGenKernels] cannot find " + filename + "!");
+  }
+  std::shared_ptr<CppAD::cg::DynamicLib<double>> lib(
+      new CppAD::cg::LinuxDynamicLib<double>(filename));
+  std::unique_ptr<Impl> impl(new Impl(lib, model.nq, model.nv, model.njoints));
+  if (!impl->isConsistent()) {
+    throw std::runtime_error("[CodeGenKernels] " + filename + " is not generated for this robot model!");
+  }
+  // Validates all the kernels against pinocchio at a random point with 
+  // random external forces.
+  CodeGenKernels kernels;
+  kernels.impl_ = std::move(impl);
+  const int nv = model.nv;
+  Eigen::VectorXd q(model.nq);
+  pinocchio::integrate(model, pinocchio::neutral(model),
+                       Eigen::VectorXd::Random(nv), q);
+  const Eigen::VectorXd v = Eigen::VectorXd::Random(nv);
+  const Eigen::VectorXd a = Eigen::VectorXd::Random(nv);
+  const auto fext = randomForces(model);
+  Eigen::VectorXd tau(nv);
+  Eigen::MatrixXd dtau_dq(nv, nv), dtau_dv(nv, nv), M(nv, nv);
+  pinocchio::Data data(model);
+  kernels.RNEA(q, v, a, fext, tau);
+  bool is_valid = tau.isApprox(pinocchio::rnea(model, data, q, v, a, fext),
+                               1.0e-08);
+  kernels.RNEADerivatives(q, v, a, fext, dtau_dq, dtau_dv, M);
+  pinocchio::computeRNEADerivatives(model, data, q, v, a, fext);
+  is_valid = is_valid && dtau_dq.isApprox(data.dtau_dq, 1.0e-08)
+                      && dtau_dv.isApprox(data.dtau_dv, 1.0e-08)
+                      && isApproxUpper(M, data.M);
+  pinocchio::Data impact_data(impact_model);
+  const Eigen::VectorXd v_zero = Eigen::VectorXd::Zero(nv);
+  kernels.RNEAImpact(q, a, fext, tau);
+  is_valid = is_valid && tau.isApprox(
+      pinocchio::rnea(impact_model, impact_data, q, v_zero, a, fext), 1.0e-08);
+  kernels.RNEAImpactDerivatives(q, a, fext, dtau_dq, M);
+  pinocchio::computeRNEADerivatives(impact_model, impact_data, q, v_zero, a, 
+                                    fext);
+  is_valid = is_valid && dtau_dq.isApprox(impact_data.dtau_dq, 1.0e-08)
+                      && isApproxUpper(M, impact_data.M);
+  if (!is_valid) {
+    throw std::runtime_error("[CodeGenKernels] " + filename + " is not generated for this robot model!");
+  }
+  impl_ = std::move(kernels.impl_);
+  library_name_ = library_name;
+}
+
+
+CodeGenKernels::CodeGenKernels(const CodeGenKernels& other)
+  : impl_(),
+    library_name_(other.library_name_) {
+  if (other.impl_) {
+    impl_.reset(new Impl(other.impl_->lib, other.impl_->nq, other.impl_->nv,
+                         other.impl_->njoints));
+  }
+}
+
+
+CodeGenKernels& CodeGenKernels::operator=(const CodeGenKernels& other) {
+  if (this != &other) {
+    impl_.reset();
+    if (other.impl_) {
+      impl_.reset(new Impl(other.impl_->lib, other.impl_->nq, other.impl_->nv,
+                           other.impl_->njoints));
+    }
+    library_name_ = other.library_name_;
+  }
+  return *this;
+}
+
+
+void CodeGenKernels::RNEA(
+    const Eigen::Ref<const Eigen::VectorXd>& q,
+    const Eigen::Ref<const Eigen::VectorXd>& v,
+    const Eigen::Ref<const Eigen::VectorXd>& a,
+    const pinocchio::container::aligned_vector<pinocchio::Force>& fext,
+    Eigen::Ref<Eigen::VectorXd> tau) {
+  assert(isLoaded());
+  const int nq = impl_->nq;
+  const int nv = impl_->nv;
+  impl_->x.head(nq) = q;
+  impl_->x.segment(nq, nv) = v;
+  impl_->x.segment(nq+nv, nv) = a;
+  impl_->setForces(fext, impl_->x);
+  Impl::eval(*impl_->rnea, impl_->x, impl_->y.data(), nv);
+  tau = impl_->y.head(nv);
+}
+
+
+void CodeGenKernels::RNEADerivatives(
+    const Eigen::Ref<const Eigen::VectorXd>& q,
+    const Eigen::Ref<const Eigen::VectorXd>& v,
+    const Eigen::Ref<const Eigen::VectorXd>& a,
+    const pinocchio::container::aligned_vector<pinocchio::Force>& fext,
+    Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_dq,
+    Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_dv,
+    Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_da) {
+  assert(isLoaded());
+  const int nq = impl_->nq;
+  const int nv = impl_->nv;
+  impl_->x.head(nq) = q;
+  impl_->x.segment(nq, nv) = v;
+  impl_->x.segment(nq+nv, nv) = a;
+  impl_->setForces(fext, impl_->x);
+  Impl::eval(*impl_->rnea_derivatives, impl_->x, impl_->y.data(), 3*nv*nv);
+  dRNEA_partial_dq = Eigen::Map<const Eigen::MatrixXd>(impl_->y.data(), nv, nv);
+  dRNEA_partial_dv
+      = Eigen::Map<const Eigen::MatrixXd>(impl_->y.data()+nv*nv, nv, nv);
+  dRNEA_partial_da.template triangularView<Eigen::Upper>()
+      = Eigen::Map<const Eigen::MatrixXd>(impl_->y.data()+2*nv*nv, nv, nv);
+}
+
+
+void CodeGenKernels::RNEAImpact(
+    const Eigen::Ref<const Eigen::VectorXd>& q,
+    const Eigen::Ref<const Eigen::VectorXd>& dv,
+    const pinocchio::container::aligned_vector<pinocchio::Force>& fext,
+    Eigen::Ref<Eigen::VectorXd> res) {
+  assert(isLoaded());
+  const int nq = impl_->nq;
+  const int nv = impl_->nv;
+  impl_->x_impact.head(nq) = q;
+  impl_->x_impact.segment(nq, nv) = dv;
+  impl_->setForces(fext, impl_->x_impact);
+  Impl::eval(*impl_->rnea_impact, impl_->x_impact, impl_->y.data(), nv);
+  res = impl_->y.head(nv);
+}
+
+
+void CodeGenKernels::RNEAImpactDerivatives(
+    const Eigen::Ref<const Eigen::VectorXd>& q,
+    const Eigen::Ref<const Eigen::VectorXd>& dv,
+    const pinocchio::container::aligned_vector<pinocchio::Force>& fext,
+    Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_dq,
+    Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_ddv) {
+  assert(isLoaded());
+  const int nq = impl_->nq;
+  const int nv = impl_->nv;
+  impl_->x_impact.head(nq) = q;
+  impl_->x_impact.segment(nq, nv) = dv;
+  impl_->setForces(fext, impl_->x_impact);
+  Impl::eval(*impl_->rnea_impact_derivatives, impl_->x_impact,
+             impl_->y.data(), 2*nv*nv);
+  dRNEA_partial_dq = Eigen::Map<const Eigen::MatrixXd>(impl_->y.data(), nv, nv);
+  dRNEA_partial_ddv.template triangularView<Eigen::Upper>()
+      = Eigen::Map<const Eigen::MatrixXd>(impl_->y.data()+nv*nv, nv, nv);
+}
+
+#else
+
+struct CodeGenKernels::Impl {
+};
+
+
+void CodeGenKernels::generate(const pinocchio::Model& model,
+                              const pinocchio::Model& impact_model,
+                              const std::string& library_name,
+                              const std::string& compiler) {
+  throw std::runtime_error("[CodeGenKernels] robotoc is not built with ENABLE_CODEGEN!");
+}
+
+
+void CodeGenKernels::load(const pinocchio::Model& model,
+                          const pinocchio::Model& impact_model,
+                          const std::string& library_name) {
+  throw std::runtime_error("[CodeGenKernels] robotoc is not built with ENABLE_CODEGEN!");
+}
+
+
+CodeGenKernels::CodeGenKernels(const CodeGenKernels& other)
+  : impl_(),
+    library_name_() {
+}
+
+
+CodeGenKernels& CodeGenKernels::operator=(const CodeGenKernels& other) {
+  return *this;
+}
+
+
+void CodeGenKernels::RNEA(
+    const Eigen::Ref<const Eigen::VectorXd>& q,
+    const Eigen::Ref<const Eigen::VectorXd>& v,
+    const Eigen::Ref<const Eigen::VectorXd>& a,
+    const pinocchio::container::aligned_vector<pinocchio::Force>& fext,
+    Eigen::Ref<Eigen::VectorXd> tau) {
+  assert(isLoaded());
+}
+
+
+void CodeGenKernels::RNEADerivatives(
+    const Eigen::Ref<const Eigen::VectorXd>& q,
+    const Eigen::Ref<const Eigen::VectorXd>& v,
+    const Eigen::Ref<const Eigen::VectorXd>& a,
+    const pinocchio::container::aligned_vector<pinocchio::Force>& fext,
+    Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_dq,
+    Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_dv,
+    Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_da) {
+  assert(isLoaded());
+}
+
+
+void CodeGenKernels::RNEAImpact(
+    const Eigen::Ref<const Eigen::VectorXd>& q,
+    const Eigen::Ref<const Eigen::VectorXd>& dv,
+    const pinocchio::container::aligned_vector<pinocchio::Force>& fext,
+    Eigen::Ref<Eigen::VectorXd> res) {
+  assert(isLoaded());
+}
+
+
+void CodeGenKernels::RNEAImpactDerivatives(
+    const Eigen::Ref<const Eigen::VectorXd>& q,
+    const Eigen::Ref<const Eigen::VectorXd>& dv,
+    const pinocchio::container::aligned_vector<pinocchio::Force>& fext,
+    Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_dq,
+    Eigen::Ref<Eigen::MatrixXd> dRNEA_partial_ddv) {
+  assert(isLoaded());
+}
+
+#endif
+
+
+CodeGenKernels::CodeGenKernels()
+  : impl_(),
+    library_name_() {
+}
+
+
+CodeGenKernels::~CodeGenKernels() {
+}
+
+
+CodeGenKernels::CodeGenKernels(CodeGenKernels&&) noexcept = default;
+
+
+CodeGenKernels& CodeGenKernels::operator=(CodeGenKernels&&) noexcept = default;
+
+
+void CodeGenKernels::unload() {
+  impl_.reset();
+  library_name_.clear();
+}
+
+} // namespace robotoc
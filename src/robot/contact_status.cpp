@@ -1,8 +1,52 @@
 #include "robotoc/robot/contact_status.hpp"
 
+#include <stdexcept>
+
 
 namespace robotoc {
 
+void ContactStatus::save(BinaryOutputArchive& ar) const {
+  ar.write(contact_types_);
+  ar.write(contact_frame_names_);
+  ar.write(is_contact_active_);
+  ar.write(contact_positions_);
+  ar.write(contact_rotations_);
+  ar.write(friction_coefficients_);
+  ar.write(max_contacts_);
+}
+
+
+void ContactStatus::load(BinaryInputArchive& ar) {
+  ar.read(contact_types_);
+  ar.read(contact_frame_names_);
+  ar.read(is_contact_active_);
+  ar.read(contact_positions_);
+  ar.read(contact_rotations_);
+  ar.read(friction_coefficients_);
+  ar.read(max_contacts_);
+  max_num_contacts_ = contact_types_.size();
+  if (contact_frame_names_.size() != max_num_contacts_ 
+      || is_contact_active_.size() != max_num_contacts_
+      || contact_positions_.size() != max_num_contacts_
+      || contact_rotations_.size() != max_num_contacts_
+      || friction_coefficients_.size() != max_num_contacts_) {
+    throw std::runtime_error("[ContactStatus] loaded data is not consistent!");
+  }
+  contact_placements_.clear();
+  friction_cones_.resize(max_num_contacts_);
+  dimf_ = 0;
+  for (int i=0; i<max_num_contacts_; ++i) {
+    contact_placements_.push_back(SE3(contact_rotations_[i], 
+                                      contact_positions_[i]));
+    updateFrictionCone(i);
+    if (is_contact_active_[i]) {
+      dimf_ += (contact_types_[i] == ContactType::SurfaceContact) ? 6 : 3;
+    }
+  }
+  setHasActiveContacts();
+}
+
+
 void ContactStatus::disp(std::ostream& os) const {
   os << "ContactStatus:" << "\n";
   os << "  active contacts: [";
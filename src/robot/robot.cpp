@@ -13,6 +13,7 @@ Robot::Robot(const RobotModelInfo& info)
     impact_data_(),
     fjoint_(),
     dimpact_dv_(),
+    codegen_kernels_(),
     point_contacts_(),
     surface_contacts_(),
     dimq_(0),
@@ -81,6 +82,7 @@ Robot::Robot()
     impact_data_(),
     fjoint_(),
     dimpact_dv_(),
+    codegen_kernels_(),
     point_contacts_(),
     surface_contacts_(),
     dimq_(0),
@@ -456,6 +458,23 @@ void Robot::setUpperJointPositionLimit(
 }
 
 
+void Robot::generateCodeGenKernels(const std::string& library_name, 
+                                   const std::string& compiler) {
+  CodeGenKernels::generate(model_, impact_model_, library_name, compiler);
+  loadCodeGenKernels(library_name);
+}
+
+
+void Robot::loadCodeGenKernels(const std::string& library_name) {
+  codegen_kernels_.load(model_, impact_model_, library_name);
+}
+
+
+bool Robot::hasCodeGenKernels() const {
+  return codegen_kernels_.isLoaded();
+}
+
+
 const RobotModelInfo& Robot::robotModelInfo() const {
   return info_;
 }
@@ -3,6 +3,11 @@
 #include <stdexcept>
 #include <cassert>
 #include <algorithm>
+#include <fstream>
+#include <cmath>
+#include <limits>
+
+#include "robotoc/utils/tracer.hpp"
 
 
 namespace robotoc {
@@ -11,7 +16,8 @@ OCPSolver::OCPSolver(const OCP& ocp,
                      const SolverOptions& solver_options)
   : robots_(solver_options.nthreads, ocp.robot),
     contact_sequence_(ocp.contact_sequence),
-    time_discretization_(ocp.T, ocp.N, ocp.reserved_num_discrete_events),
+    time_discretization_(ocp.T, ocp.N, ocp.reserved_num_discrete_events,
+                         ocp.grading_ratio),
     dms_(ocp, solver_options.nthreads),
     sto_(ocp),
     riccati_recursion_(ocp, solver_options.max_dts_riccati),
@@ -25,7 +31,17 @@ OCPSolver::OCPSolver(const OCP& ocp,
     solution_interpolator_(solver_options.interpolation_order),
     solver_options_(solver_options),
     solver_statistics_(),
-    timer_() {
+    timer_(),
+    budget_timer_(),
+    phase_timer_(),
+    phase_time_average_(),
+    s_prev_(),
+    s_best_(),
+    constraints_data_prev_(),
+    constraints_data_best_(),
+    lqr_policy_best_(),
+    best_performance_index_(),
+    best_kkt_error_(std::numeric_limits<double>::infinity()) {
   if (!ocp.cost) {
     throw std::out_of_range("[OCPSolver] invalid argument: ocp.cost should not be nullptr!");
   }
@@ -44,9 +60,21 @@ OCPSolver::OCPSolver(const OCP& ocp,
   if (ocp.reserved_num_discrete_events< 0) {
     throw std::out_of_range("[OCPSolver] invalid argument: ocp.reserved_num_discrete_events must be non-negative!");
   }
+  if (ocp.grading_ratio <= 0) {
+    throw std::out_of_range("[OCPSolver] invalid argument: ocp.grading_ratio must be positive!");
+  }
   if (solver_options.nthreads <= 0) {
     throw std::out_of_range("[OCPSolver] invalid argument: solver_options.nthreads must be positive!");
   }
+  if (solver_options.move_blocking_size <= 0) {
+    throw std::out_of_range("[OCPSolver] invalid argument: solver_options.move_blocking_size must be positive!");
+  }
+  time_discretization_.setMoveBlockingSize(solver_options.move_blocking_size);
+  dms_.setHessianApproximation(solver_options.hessian_approximation);
+  if (solver_options.enable_thread_pinning) {
+    dms_.setNumThreads(solver_options.nthreads, true);
+  }
+  phase_time_average_.fill(0.0);
   for (auto& e : s_)  { ocp.robot.normalizeConfiguration(e.q); }
   if (ocp.sto_cost && ocp.sto_constraints) {
     solver_options_.discretization_method = DiscretizationMethod::PhaseBased;
@@ -71,7 +99,18 @@ OCPSolver::OCPSolver()
     solution_interpolator_(),
     solver_options_(),
     solver_statistics_(),
-    timer_() {
+    timer_(),
+    budget_timer_(),
+    phase_timer_(),
+    phase_time_average_(),
+    s_prev_(),
+    s_best_(),
+    constraints_data_prev_(),
+    constraints_data_best_(),
+    lqr_policy_best_(),
+    best_performance_index_(),
+    best_kkt_error_(std::numeric_limits<double>::infinity()) {
+  phase_time_average_.fill(0.0);
 }
 
 
@@ -79,13 +118,19 @@ void OCPSolver::setSolverOptions(const SolverOptions& solver_options) {
   if (solver_options.nthreads <= 0) {
     throw std::out_of_range("[OCPSolver] invalid argument: solver_options.nthreads must be positive!");
   }
+  if (solver_options.move_blocking_size <= 0) {
+    throw std::out_of_range("[OCPSolver] invalid argument: solver_options.move_blocking_size must be positive!");
+  }
   while (robots_.size() < solver_options.nthreads) {
     robots_.push_back(robots_.back());
   }
-  dms_.setNumThreads(solver_options.nthreads);
+  dms_.setNumThreads(solver_options.nthreads, 
+                     solver_options.enable_thread_pinning);
   riccati_recursion_.setRegularization(solver_options_.max_dts_riccati);
   solution_interpolator_.setInterpolationOrder(solver_options.interpolation_order);
   line_search_.set(solver_options.line_search_settings);
+  time_discretization_.setMoveBlockingSize(solver_options.move_blocking_size);
+  dms_.setHessianApproximation(solver_options.hessian_approximation);
   solver_options_ = solver_options;
   if (ocp_.sto_cost && ocp_.sto_constraints) {
     solver_options_.discretization_method = DiscretizationMethod::PhaseBased;
@@ -99,6 +144,7 @@ void OCPSolver::discretize(const double t) {
     time_discretization_.correctTimeSteps(contact_sequence_, t);
   }
   resizeData();
+  synchronizeMoveBlockedInputs();
 }
 
 
@@ -115,8 +161,11 @@ void OCPSolver::updateSolution(const double t, const Eigen::VectorXd& q,
   if (solver_options_.discretization_method == DiscretizationMethod::PhaseBased) {
     time_discretization_.correctTimeSteps(contact_sequence_, t);
   }
+  tickBudgetPhase();
   dms_.evalKKT(robots_, time_discretization_, q, v, s_, kkt_matrix_, kkt_residual_);
   sto_.evalKKT(time_discretization_, kkt_matrix_, kkt_residual_);
+  tockBudgetPhase(BudgetPhase::EvalKKT);
+  tickBudgetPhase();
   riccati_recursion_.backwardRiccatiRecursion(time_discretization_, 
                                               kkt_matrix_, kkt_residual_, 
                                               riccati_factorization_);
@@ -124,6 +173,8 @@ void OCPSolver::updateSolution(const double t, const Eigen::VectorXd& q,
   riccati_recursion_.forwardRiccatiRecursion(time_discretization_, 
                                              kkt_matrix_, kkt_residual_, 
                                              riccati_factorization_, d_);
+  tockBudgetPhase(BudgetPhase::Riccati);
+  tickBudgetPhase();
   dms_.computeStepSizes(time_discretization_, d_);
   sto_.computeStepSizes(time_discretization_, d_);
   double primal_step_size = std::min(dms_.maxPrimalStepSize(), 
@@ -137,11 +188,14 @@ void OCPSolver::updateSolution(const double t, const Eigen::VectorXd& q,
                                                     q, v, s_, d_, 
                                                     max_primal_step_size);
   }
+  tockBudgetPhase(BudgetPhase::StepSize);
   solver_statistics_.primal_step_size.push_back(primal_step_size);
   solver_statistics_.dual_step_size.push_back(dual_step_size);
+  tickBudgetPhase();
   dms_.integrateSolution(robots_, time_discretization_, 
                          primal_step_size, dual_step_size, kkt_matrix_, d_, s_);
   sto_.integrateSolution(time_discretization_, primal_step_size, dual_step_size, d_);
+  tockBudgetPhase(BudgetPhase::Integration);
 } 
 
 
@@ -153,13 +207,18 @@ void OCPSolver::solve(const double t, const Eigen::VectorXd& q,
   if (v.size() != robots_[0].dimv()) {
     throw std::out_of_range("[OCPSolver] invalid argument: v.size() must be " + std::to_string(robots_[0].dimv()) + "!");
   }
+  ROBOTOC_TRACE_SCOPE("OCPSolver::solve");
   if (solver_options_.enable_benchmark) {
     timer_.tick();
   }
+  if (solver_options_.time_budget > 0) {
+    budget_timer_.tick();
+  }
   if (init_solver) {
     discretize(t);
     if (solver_options_.enable_solution_interpolation) {
       solution_interpolator_.interpolate(robots_[0], time_discretization_, s_);
+      synchronizeMoveBlockedInputs();
     }
     dms_.initConstraints(robots_, time_discretization_, s_);
     sto_.initConstraints(time_discretization_);
@@ -167,8 +226,20 @@ void OCPSolver::solve(const double t, const Eigen::VectorXd& q,
   }
   solver_statistics_.clear(); 
   solver_statistics_.reserve(solver_options_.max_iter);
+  best_kkt_error_ = std::numeric_limits<double>::infinity();
   int inner_iter = 0;
   for (int iter=0; iter<solver_options_.max_iter; ++iter, ++inner_iter) {
+    ROBOTOC_TRACE_SCOPE("OCPSolver::iteration");
+    if (isBudgetExhausted()) {
+      solver_statistics_.budget_exhausted = true;
+      solver_statistics_.iter = iter;
+      restoreBestIterate();
+      break;
+    }
+    if (solver_options_.time_budget > 0) {
+      s_prev_ = s_;
+      dms_.getConstraintsData(time_discretization_, constraints_data_prev_);
+    }
     if (ocp_.sto_cost && ocp_.sto_constraints) {
       if (inner_iter < solver_options_.initial_sto_reg_iter) {
         sto_.setRegularization(solver_options_.initial_sto_reg);
@@ -176,13 +247,19 @@ void OCPSolver::solve(const double t, const Eigen::VectorXd& q,
       else {
         sto_.setRegularization(0);
       }
-      solver_statistics_.ts.emplace_back(contact_sequence_->eventTimes());
+      const auto& ts = contact_sequence_->eventTimes();
+      solver_statistics_.ts.emplace_back(ts.begin(), ts.end());
     } 
     updateSolution(t, q, v);
     solver_statistics_.performance_index.push_back(dms_.getEval()+sto_.getEval()); 
+    if (ocp_.constraints->isActiveSetScreeningEnabled()) {
+      solver_statistics_.screened_constraints_ratio.push_back(
+          dms_.screenedConstraintsRatio(time_discretization_));
+    }
     const double kkt_error = KKTError();
+    updateBestIterate(kkt_error);
     if ((ocp_.sto_cost && ocp_.sto_constraints) && (kkt_error < solver_options_.kkt_tol_mesh)) {
-      if (time_discretization_.maxTimeStep() > solver_options_.max_dt_mesh) {
+      if (time_discretization_.maxTimeStepInSTOPhases() > solver_options_.max_dt_mesh) {
         if (solver_options_.enable_solution_interpolation) {
           time_discretization_.correctTimeSteps(contact_sequence_, t);
           solution_interpolator_.store(time_discretization_, s_);
@@ -190,11 +267,14 @@ void OCPSolver::solve(const double t, const Eigen::VectorXd& q,
         discretize(t);
         if (solver_options_.enable_solution_interpolation) {
           solution_interpolator_.interpolate(robots_[0], time_discretization_, s_);
+          synchronizeMoveBlockedInputs();
         }
         dms_.initConstraints(robots_, time_discretization_, s_);
         sto_.initConstraints(time_discretization_);
         line_search_.clearHistory();
         inner_iter = 0;
+        // The iterates before the mesh-refinement are not comparable.
+        best_kkt_error_ = std::numeric_limits<double>::infinity();
         solver_statistics_.mesh_refinement_iter.push_back(iter+1); 
       }
       else if (kkt_error < solver_options_.kkt_tol) {
@@ -209,8 +289,9 @@ void OCPSolver::solve(const double t, const Eigen::VectorXd& q,
       break;
     }
   }
-  if (!solver_statistics_.convergence) {
+  if (!solver_statistics_.convergence && !solver_statistics_.budget_exhausted) {
     solver_statistics_.iter = solver_options_.max_iter;
+    restoreBestIterate();
   }
   if (solver_options_.enable_solution_interpolation) {
     if (solver_options_.discretization_method == DiscretizationMethod::PhaseBased) {
@@ -411,6 +492,18 @@ void OCPSolver::setSolution(const std::string& name,
 }
 
 
+void OCPSolver::interpolateSolution(
+    const TimeDiscretization& time_discretization, const Solution& s) {
+  if (s.size() < time_discretization.size()) {
+    throw std::out_of_range("[OCPSolver] invalid argument: s.size() must be at least " 
+                            + std::to_string(time_discretization.size()) + "!");
+  }
+  solution_interpolator_.store(time_discretization, s);
+  solution_interpolator_.interpolate(robots_[0], time_discretization_, s_);
+  synchronizeMoveBlockedInputs();
+}
+
+
 double OCPSolver::KKTError(const double t, const Eigen::VectorXd& q, 
                            const Eigen::VectorXd& v) {
   if (q.size() != robots_[0].dimq()) {
@@ -420,8 +513,15 @@ double OCPSolver::KKTError(const double t, const Eigen::VectorXd& q,
     throw std::out_of_range("[OCPSolver] invalid argument: v.size() must be " + std::to_string(robots_[0].dimv()) + "!");
   }
   resizeData();
-  dms_.evalKKT(robots_, time_discretization_, q, v, s_, kkt_matrix_, kkt_residual_);
-  sto_.evalKKT(time_discretization_, kkt_matrix_, kkt_residual_);
+  if (ocp_.sto_cost && ocp_.sto_constraints) {
+    // The KKT error w.r.t. the switching times needs the condensed KKT system.
+    dms_.evalKKT(robots_, time_discretization_, q, v, s_, kkt_matrix_, kkt_residual_);
+    sto_.evalKKT(time_discretization_, kkt_matrix_, kkt_residual_);
+  }
+  else {
+    dms_.evalKKTResidual(robots_, time_discretization_, q, v, s_, 
+                         kkt_matrix_, kkt_residual_);
+  }
   return KKTError();
 }
 
@@ -443,6 +543,54 @@ void OCPSolver::setRobotProperties(const RobotProperties& properties) {
 }
 
 
+void OCPSolver::saveSolverState(const std::string& filename) const {
+  std::ofstream ofs(filename, std::ios::binary);
+  if (!ofs) {
+    throw std::runtime_error("[OCPSolver] failed to open " + filename + "!");
+  }
+  BinaryOutputArchive ar(ofs);
+  contact_sequence_->save(ar);
+  time_discretization_.save(ar);
+  ar.writeSize(time_discretization_.size());
+  for (int i=0; i<time_discretization_.size(); ++i) {
+    s_[i].save(ar);
+  }
+  dms_.saveConstraintsData(ar, time_discretization_);
+  riccati_recursion_.saveLQRPolicy(ar, time_discretization_);
+}
+
+
+void OCPSolver::loadSolverState(const std::string& filename) {
+  std::ifstream ifs(filename, std::ios::binary);
+  if (!ifs) {
+    throw std::runtime_error("[OCPSolver] failed to open " + filename + "!");
+  }
+  BinaryInputArchive ar(ifs);
+  contact_sequence_->load(ar);
+  time_discretization_.load(ar);
+  resizeData();
+  if (ar.readSize() != time_discretization_.size()) {
+    throw std::runtime_error("[OCPSolver] number of the loaded stages must be "
+                             + std::to_string(time_discretization_.size()) + "!");
+  }
+  for (int i=0; i<time_discretization_.size(); ++i) {
+    s_[i].load(ar);
+    if (s_[i].q.size() != robots_[0].dimq() 
+        || s_[i].v.size() != robots_[0].dimv()) {
+      throw std::runtime_error("[OCPSolver] loaded solution is not consistent with the robot model!");
+    }
+  }
+  dms_.initConstraints(robots_, time_discretization_, s_);
+  sto_.initConstraints(time_discretization_);
+  dms_.loadConstraintsData(ar, time_discretization_);
+  riccati_recursion_.loadLQRPolicy(ar, time_discretization_);
+  line_search_.clearHistory();
+  if (solver_options_.enable_solution_interpolation) {
+    solution_interpolator_.store(time_discretization_, s_);
+  }
+}
+
+
 template <typename T>
 void conservativeReserve(const TimeDiscretization& time_discretization, 
                          aligned_vector<T>& data) {
@@ -482,6 +630,85 @@ void OCPSolver::resizeData() {
 }
 
 
+void OCPSolver::synchronizeMoveBlockedInputs() {
+  if (time_discretization_.moveBlockingSize() <= 1) return;
+  const int N = time_discretization_.size() - 1;
+  for (int i=1; i<N; ++i) {
+    if (time_discretization_[i].move_blocked) {
+      s_[i].u = s_[i-1].u;
+    }
+  }
+}
+
+
+bool OCPSolver::isBudgetExhausted() {
+  if (solver_options_.time_budget <= 0) {
+    return false;
+  }
+  budget_timer_.tock();
+  double predicted_iter_time = 0.0;
+  for (const double e : phase_time_average_) {
+    predicted_iter_time += e;
+  }
+  return (budget_timer_.ms() + predicted_iter_time > solver_options_.time_budget);
+}
+
+
+void OCPSolver::tickBudgetPhase() {
+  if (solver_options_.time_budget > 0) {
+    phase_timer_.tick();
+  }
+}
+
+
+void OCPSolver::tockBudgetPhase(const BudgetPhase phase) {
+  if (solver_options_.time_budget > 0) {
+    phase_timer_.tock();
+    double& average = phase_time_average_[phase];
+    average = (average > 0) ? 0.5 * (average + phase_timer_.ms()) 
+                            : phase_timer_.ms();
+  }
+}
+
+
+void OCPSolver::updateBestIterate(const double kkt_error) {
+  if (solver_options_.time_budget <= 0) return;
+  // The KKT error is evaluated at the iterate before the update, which is 
+  // stored in s_prev_ and constraints_data_prev_. The LQR policies are 
+  // computed at the same iterate.
+  if (kkt_error < best_kkt_error_) {
+    best_kkt_error_ = kkt_error;
+    best_performance_index_ = dms_.getEval();
+    s_best_.swap(s_prev_);
+    constraints_data_best_.swap(constraints_data_prev_);
+    lqr_policy_best_ = riccati_recursion_.getLQRPolicy();
+  }
+}
+
+
+void OCPSolver::restoreBestIterate() {
+  if (solver_options_.time_budget <= 0) return;
+  // The switching times of the best iterate are not stored. 
+  if (ocp_.sto_cost && ocp_.sto_constraints) return;
+  // If the last evaluated iterate is the best one, the latest iterate, i.e., 
+  // the Newton-type step from it, is kept. Otherwise, the iterations have 
+  // increased the KKT error and the best iterate is restored.
+  if (solver_statistics_.performance_index.empty()) return;
+  const auto& last = solver_statistics_.performance_index.back();
+  const double last_kkt_error = std::sqrt(last.kkt_error);
+  if (last_kkt_error > best_kkt_error_) {
+    const int N = time_discretization_.size();
+    for (int i=0; i<N; ++i) {
+      s_[i] = s_best_[i];
+    }
+    dms_.setConstraintsData(time_discretization_, constraints_data_best_);
+    dms_.setEval(best_performance_index_);
+    riccati_recursion_.setLQRPolicy(time_discretization_, lqr_policy_best_);
+    solver_statistics_.best_iterate_restored = true;
+  }
+}
+
+
 void OCPSolver::disp(std::ostream& os) const {
   os << ocp_ << std::endl;
 }
@@ -0,0 +1,387 @@
+#include "robotoc/solver/sliding_window_ocp_solver.hpp"
+
+#include <stdexcept>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <cassert>
+
+
+namespace robotoc {
+
+SlidingWindowOCPSolver::SlidingWindowOCPSolver(
+    const OCP& ocp, const SolverOptions& solver_options, 
+    const SlidingWindowSettings& settings)
+  : ocp_(ocp),
+    robot_(ocp.robot),
+    solver_options_(solver_options),
+    settings_(),
+    window_solvers_(),
+    consensus_costs_(),
+    window_times_(),
+    q0_(),
+    v0_(),
+    zq_(),
+    zv_(),
+    yq_l_(),
+    yv_l_(),
+    yq_r_(),
+    yv_r_(),
+    qdiff_(Eigen::VectorXd::Zero(ocp.robot.dimv())),
+    wq_l_(Eigen::VectorXd::Zero(ocp.robot.dimq())),
+    wq_r_(Eigen::VectorXd::Zero(ocp.robot.dimq())),
+    thread_pool_(),
+    dt_(ocp.T/ocp.N),
+    primal_residual_(0),
+    dual_residual_(0),
+    num_windows_(0),
+    admm_iter_(0) {
+  if (!ocp.cost) {
+    throw std::out_of_range("[SlidingWindowOCPSolver] invalid argument: 'ocp.cost' must not be nullptr!");
+  }
+  if (ocp.sto_cost && ocp.sto_constraints) {
+    throw std::out_of_range("[SlidingWindowOCPSolver] invalid argument: the switching time optimization is not supported!");
+  }
+  if (ocp.grading_ratio != 1.0) {
+    throw std::out_of_range("[SlidingWindowOCPSolver] invalid argument: 'ocp.grading_ratio' must be 1!");
+  }
+  setSettings(settings);
+}
+
+
+SlidingWindowOCPSolver::SlidingWindowOCPSolver()
+  : ocp_(),
+    robot_(),
+    solver_options_(),
+    settings_(),
+    window_solvers_(),
+    consensus_costs_(),
+    window_times_(),
+    q0_(),
+    v0_(),
+    zq_(),
+    zv_(),
+    yq_l_(),
+    yv_l_(),
+    yq_r_(),
+    yv_r_(),
+    qdiff_(),
+    wq_l_(),
+    wq_r_(),
+    thread_pool_(),
+    dt_(0),
+    primal_residual_(0),
+    dual_residual_(0),
+    num_windows_(0),
+    admm_iter_(0) {
+}
+
+
+void SlidingWindowOCPSolver::setSolverOptions(
+    const SolverOptions& solver_options) {
+  for (auto& e : window_solvers_) {
+    e.setSolverOptions(solver_options);
+  }
+  solver_options_ = solver_options;
+  thread_pool_.setNumThreads(
+      std::max(settings_.nthreads/std::max(solver_options_.nthreads, 1), 1));
+}
+
+
+void SlidingWindowOCPSolver::setSettings(const SlidingWindowSettings& settings) {
+  if (settings.num_overlap_grids <= 0) {
+    throw std::out_of_range("[SlidingWindowOCPSolver] invalid argument: 'num_overlap_grids' must be positive!");
+  }
+  if (2*settings.num_overlap_grids >= ocp_.N) {
+    throw std::out_of_range("[SlidingWindowOCPSolver] invalid argument: 'num_overlap_grids' must be smaller than N/2!");
+  }
+  if (settings.max_admm_iter < 0) {
+    throw std::out_of_range("[SlidingWindowOCPSolver] invalid argument: 'max_admm_iter' must be non-negative!");
+  }
+  if (settings.admm_penalty <= 0) {
+    throw std::out_of_range("[SlidingWindowOCPSolver] invalid argument: 'admm_penalty' must be positive!");
+  }
+  if (settings.admm_tol <= 0) {
+    throw std::out_of_range("[SlidingWindowOCPSolver] invalid argument: 'admm_tol' must be positive!");
+  }
+  if (settings.nthreads <= 0) {
+    throw std::out_of_range("[SlidingWindowOCPSolver] invalid argument: 'nthreads' must be positive!");
+  }
+  if (settings.num_overlap_grids != settings_.num_overlap_grids) {
+    // the windows are re-constructed in the next solve().
+    window_solvers_.clear();
+    consensus_costs_.clear();
+  }
+  for (auto& e : consensus_costs_) {
+    e->set_penalty(settings.admm_penalty);
+  }
+  settings_ = settings;
+  // Each window solver runs solver_options_.nthreads threads by itself.
+  thread_pool_.setNumThreads(
+      std::max(settings_.nthreads/std::max(solver_options_.nthreads, 1), 1));
+}
+
+
+void SlidingWindowOCPSolver::solve(const double t, const Eigen::VectorXd& q, 
+                                   const Eigen::VectorXd& v, 
+                                   const double clip_length) {
+  if (q.size() != robot_.dimq()) {
+    throw std::out_of_range("[SlidingWindowOCPSolver] invalid argument: q.size() must be " + std::to_string(robot_.dimq()) + "!");
+  }
+  if (v.size() != robot_.dimv()) {
+    throw std::out_of_range("[SlidingWindowOCPSolver] invalid argument: v.size() must be " + std::to_string(robot_.dimv()) + "!");
+  }
+  const double eps = std::sqrt(std::numeric_limits<double>::epsilon());
+  if (clip_length < ocp_.T-eps) {
+    throw std::out_of_range("[SlidingWindowOCPSolver] invalid argument: 'clip_length' must not be smaller than T!");
+  }
+  const int m = settings_.num_overlap_grids;
+  const double stride = (ocp_.N-m) * dt_;
+  const int num_windows 
+      = 1 + std::max(static_cast<int>(std::ceil((clip_length-ocp_.T)/stride-eps)), 0);
+  resizeWindows(num_windows);
+  for (int k=0; k<num_windows_; ++k) {
+    window_times_[k] = t + k * stride;
+    q0_[k] = q;
+    v0_[k] = v;
+    window_solvers_[k].setSolution("q", q);
+    window_solvers_[k].setSolution("v", v);
+    consensus_costs_[k]->clear_targets();
+  }
+  for (int k=0; k<num_windows_-1; ++k) {
+    for (int j=0; j<m; ++j) {
+      zq_[k][j] = q;
+      zv_[k][j] = v;
+      yq_l_[k][j].setZero();
+      yv_l_[k][j].setZero();
+      yq_r_[k][j].setZero();
+      yv_r_[k][j].setZero();
+    }
+  }
+  admm_iter_ = 0;
+  while (true) {
+    thread_pool_.parallelFor(num_windows_, [&](const int k, const int thread_id) {
+      // The windows are initialized only at the first ADMM iteration and 
+      // are warm-started from their previous iterates after that.
+      window_solvers_[k].solve(window_times_[k], q0_[k], v0_[k], 
+                               (admm_iter_ == 0));
+    });
+    updateConsensus();
+    if (num_windows_ == 1) break;
+    if (admm_iter_ > 0 && primal_residual_ < settings_.admm_tol
+                       && dual_residual_ < settings_.admm_tol) break;
+    if (admm_iter_ >= settings_.max_admm_iter) break;
+    setConsensusTargets();
+    ++admm_iter_;
+  }
+}
+
+
+std::vector<Eigen::VectorXd> SlidingWindowOCPSolver::getSolution(
+    const std::string& name, const std::string& option) const {
+  std::vector<Eigen::VectorXd> sol;
+  for (int k=0; k<num_windows_; ++k) {
+    const auto window_sol = window_solvers_[k].getSolution(name, option);
+    const auto& time_discretization = window_solvers_[k].getTimeDiscretization();
+    for (int i=0; i<window_sol.size(); ++i) {
+      if (isOwnedGrid(k, time_discretization[i].t)) {
+        sol.push_back(window_sol[i]);
+      }
+    }
+  }
+  return sol;
+}
+
+
+std::vector<double> SlidingWindowOCPSolver::getTimes() const {
+  std::vector<double> times;
+  for (int k=0; k<num_windows_; ++k) {
+    const auto& time_discretization = window_solvers_[k].getTimeDiscretization();
+    for (int i=0; i<time_discretization.size(); ++i) {
+      if (isOwnedGrid(k, time_discretization[i].t)) {
+        times.push_back(time_discretization[i].t);
+      }
+    }
+  }
+  return times;
+}
+
+
+const OCPSolver& SlidingWindowOCPSolver::getWindowSolver(const int window) const {
+  assert(window >= 0);
+  assert(window < num_windows_);
+  return window_solvers_[window];
+}
+
+
+int SlidingWindowOCPSolver::numWindows() const {
+  return num_windows_;
+}
+
+
+int SlidingWindowOCPSolver::admmIter() const {
+  return admm_iter_;
+}
+
+
+double SlidingWindowOCPSolver::primalResidual() const {
+  return primal_residual_;
+}
+
+
+double SlidingWindowOCPSolver::dualResidual() const {
+  return dual_residual_;
+}
+
+
+void SlidingWindowOCPSolver::resizeWindows(const int num_windows) {
+  num_windows_ = num_windows;
+  if (window_solvers_.size() == num_windows) return;
+  window_solvers_.clear();
+  consensus_costs_.clear();
+  window_solvers_.reserve(num_windows);
+  for (int k=0; k<num_windows; ++k) {
+    auto consensus_cost = std::make_shared<ConsensusCost>(robot_, 
+                                                          settings_.admm_penalty);
+    // The window solvers run concurrently, so that the constraints and the 
+    // contact sequence are deep-copied for each window and no state is 
+    // shared between them.
+    OCP ocp = ocp_;
+    ocp.cost = std::make_shared<CostFunction>(*ocp_.cost);
+    if (ocp_.constraints) {
+      ocp.constraints = ocp_.constraints->clone();
+    }
+    if (ocp_.contact_sequence) {
+      ocp.contact_sequence 
+          = std::make_shared<ContactSequence>(*ocp_.contact_sequence);
+    }
+    ocp.cost->push_back(consensus_cost);
+    consensus_costs_.push_back(consensus_cost);
+    window_solvers_.emplace_back(ocp, solver_options_);
+  }
+  const int m = settings_.num_overlap_grids;
+  const int num_overlaps = std::max(num_windows-1, 0);
+  const std::vector<Eigen::VectorXd> q_vec(m, Eigen::VectorXd::Zero(robot_.dimq())),
+                                     v_vec(m, Eigen::VectorXd::Zero(robot_.dimv()));
+  zq_.assign(num_overlaps, q_vec);
+  zv_.assign(num_overlaps, v_vec);
+  yq_l_.assign(num_overlaps, v_vec);
+  yv_l_.assign(num_overlaps, v_vec);
+  yq_r_.assign(num_overlaps, v_vec);
+  yv_r_.assign(num_overlaps, v_vec);
+  window_times_.assign(num_windows, 0.0);
+  q0_.assign(num_windows, Eigen::VectorXd::Zero(robot_.dimq()));
+  v0_.assign(num_windows, Eigen::VectorXd::Zero(robot_.dimv()));
+}
+
+
+void SlidingWindowOCPSolver::setConsensusTargets() {
+  const int m = settings_.num_overlap_grids;
+  std::vector<double> times;
+  std::vector<Eigen::VectorXd> q_targets, v_targets;
+  for (int k=0; k<num_windows_; ++k) {
+    times.clear();
+    q_targets.clear();
+    v_targets.clear();
+    // overlap with the previous window
+    if (k > 0) {
+      for (int j=0; j<m; ++j) {
+        times.push_back(window_times_[k]+(j+1)*dt_);
+        q_targets.push_back(Eigen::VectorXd::Zero(robot_.dimq()));
+        robot_.integrateConfiguration(zq_[k-1][j], yq_r_[k-1][j], -1.0, 
+                                      q_targets.back());
+        v_targets.push_back(zv_[k-1][j]-yv_r_[k-1][j]);
+      }
+    }
+    // overlap with the next window
+    if (k < num_windows_-1) {
+      for (int j=0; j<m; ++j) {
+        times.push_back(window_times_[k+1]+(j+1)*dt_);
+        q_targets.push_back(Eigen::VectorXd::Zero(robot_.dimq()));
+        robot_.integrateConfiguration(zq_[k][j], yq_l_[k][j], -1.0, 
+                                      q_targets.back());
+        v_targets.push_back(zv_[k][j]-yv_l_[k][j]);
+      }
+    }
+    consensus_costs_[k]->set_targets(times, q_targets, v_targets);
+  }
+}
+
+
+void SlidingWindowOCPSolver::updateConsensus() {
+  const int m = settings_.num_overlap_grids;
+  primal_residual_ = 0;
+  dual_residual_ = 0;
+  for (int k=0; k<num_windows_-1; ++k) {
+    const double t_next = window_times_[k+1];
+    // The initial state of the next window is taken from this window.
+    const auto& s0 = window_solvers_[k].getSolution(findGrid(k, t_next));
+    robot_.subtractConfiguration(s0.q, q0_[k+1], qdiff_);
+    primal_residual_ = std::max(primal_residual_, 
+                                std::sqrt(qdiff_.squaredNorm()
+                                          +(s0.v-v0_[k+1]).squaredNorm()));
+    q0_[k+1] = s0.q;
+    v0_[k+1] = s0.v;
+    for (int j=0; j<m; ++j) {
+      const double tj = t_next + (j+1) * dt_;
+      const auto& sl = window_solvers_[k].getSolution(findGrid(k, tj));
+      const auto& sr = window_solvers_[k+1].getSolution(findGrid(k+1, tj));
+      // consensus update, i.e., average of the two windows
+      robot_.integrateConfiguration(sl.q, yq_l_[k][j], 1.0, wq_l_);
+      robot_.integrateConfiguration(sr.q, yq_r_[k][j], 1.0, wq_r_);
+      robot_.subtractConfiguration(wq_r_, wq_l_, qdiff_);
+      robot_.integrateConfiguration(qdiff_, 0.5, wq_l_);
+      robot_.subtractConfiguration(wq_l_, zq_[k][j], qdiff_);
+      const double dzv_squared_norm 
+          = (0.5*(sl.v+yv_l_[k][j]+sr.v+yv_r_[k][j])-zv_[k][j]).squaredNorm();
+      dual_residual_ = std::max(dual_residual_, 
+                                settings_.admm_penalty 
+                                  * std::sqrt(qdiff_.squaredNorm()+dzv_squared_norm));
+      zq_[k][j] = wq_l_;
+      zv_[k][j] = 0.5 * (sl.v+yv_l_[k][j]+sr.v+yv_r_[k][j]);
+      // dual update
+      robot_.subtractConfiguration(sl.q, zq_[k][j], qdiff_);
+      yq_l_[k][j].noalias() += qdiff_;
+      yv_l_[k][j].noalias() += sl.v - zv_[k][j];
+      primal_residual_ = std::max(primal_residual_, 
+                                  std::sqrt(qdiff_.squaredNorm()
+                                            +(sl.v-zv_[k][j]).squaredNorm()));
+      robot_.subtractConfiguration(sr.q, zq_[k][j], qdiff_);
+      yq_r_[k][j].noalias() += qdiff_;
+      yv_r_[k][j].noalias() += sr.v - zv_[k][j];
+      primal_residual_ = std::max(primal_residual_, 
+                                  std::sqrt(qdiff_.squaredNorm()
+                                            +(sr.v-zv_[k][j]).squaredNorm()));
+    }
+  }
+}
+
+
+int SlidingWindowOCPSolver::findGrid(const int window, const double t) const {
+  const double eps = std::sqrt(std::numeric_limits<double>::epsilon());
+  const auto& time_discretization = window_solvers_[window].getTimeDiscretization();
+  for (int i=0; i<time_discretization.size(); ++i) {
+    if (time_discretization[i].type == GridType::Impact) continue;
+    if (std::abs(time_discretization[i].t-t) < eps) {
+      return i;
+    }
+  }
+  throw std::runtime_error("[SlidingWindowOCPSolver] grid of the overlapping time is not found!");
+}
+
+
+bool SlidingWindowOCPSolver::isOwnedGrid(const int window, const double t) const {
+  // Each window owns the grids from the middle of the overlap with the 
+  // previous window to the middle of the overlap with the next window.
+  const double eps = std::sqrt(std::numeric_limits<double>::epsilon());
+  const int half_overlap = (settings_.num_overlap_grids+1) / 2;
+  if (window > 0) {
+    if (t < window_times_[window]+half_overlap*dt_-eps) return false;
+  }
+  if (window < num_windows_-1) {
+    if (t >= window_times_[window+1]+half_overlap*dt_-eps) return false;
+  }
+  return true;
+}
+
+} // namespace robotoc
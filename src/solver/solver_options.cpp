@@ -3,9 +3,74 @@
 
 namespace robotoc {
 
+void SolverOptions::save(BinaryOutputArchive& ar) const {
+  ar.write(nthreads);
+  ar.write(enable_thread_pinning);
+  ar.write(max_iter);
+  ar.write(kkt_tol);
+  ar.write(mu_init);
+  ar.write(mu_min);
+  ar.write(kkt_tol_mu);
+  ar.write(mu_linear_decrease_factor);
+  ar.write(mu_superlinear_decrease_power);
+  ar.write(enable_line_search);
+  ar.write(line_search_settings.line_search_method);
+  ar.write(line_search_settings.step_size_reduction_rate);
+  ar.write(line_search_settings.min_step_size);
+  ar.write(line_search_settings.armijo_control_rate);
+  ar.write(line_search_settings.margin_rate);
+  ar.write(line_search_settings.eps);
+  ar.write(discretization_method);
+  ar.write(move_blocking_size);
+  ar.write(hessian_approximation);
+  ar.write(initial_sto_reg_iter);
+  ar.write(initial_sto_reg);
+  ar.write(kkt_tol_mesh);
+  ar.write(max_dt_mesh);
+  ar.write(max_dts_riccati);
+  ar.write(enable_solution_interpolation);
+  ar.write(interpolation_order);
+  ar.write(enable_benchmark);
+  ar.write(time_budget);
+}
+
+
+void SolverOptions::load(BinaryInputArchive& ar) {
+  ar.read(nthreads);
+  ar.read(enable_thread_pinning);
+  ar.read(max_iter);
+  ar.read(kkt_tol);
+  ar.read(mu_init);
+  ar.read(mu_min);
+  ar.read(kkt_tol_mu);
+  ar.read(mu_linear_decrease_factor);
+  ar.read(mu_superlinear_decrease_power);
+  ar.read(enable_line_search);
+  ar.read(line_search_settings.line_search_method);
+  ar.read(line_search_settings.step_size_reduction_rate);
+  ar.read(line_search_settings.min_step_size);
+  ar.read(line_search_settings.armijo_control_rate);
+  ar.read(line_search_settings.margin_rate);
+  ar.read(line_search_settings.eps);
+  ar.read(discretization_method);
+  ar.read(move_blocking_size);
+  ar.read(hessian_approximation);
+  ar.read(initial_sto_reg_iter);
+  ar.read(initial_sto_reg);
+  ar.read(kkt_tol_mesh);
+  ar.read(max_dt_mesh);
+  ar.read(max_dts_riccati);
+  ar.read(enable_solution_interpolation);
+  ar.read(interpolation_order);
+  ar.read(enable_benchmark);
+  ar.read(time_budget);
+}
+
+
 void SolverOptions::disp(std::ostream& os) const {
   os << "Solver options:" << "\n";
   os << "  nthreads: " << nthreads << "\n";
+  os << "  enable_thread_pinning: " << std::boolalpha << enable_thread_pinning << "\n";
   os << "  max_iter: " << max_iter << "\n";
   os << "  kkt_tol: " << kkt_tol << "\n";
   os << "  mu_init: " << mu_init << "\n";
@@ -18,6 +83,10 @@ void SolverOptions::disp(std::ostream& os) const {
   os << "  discretization_method: ";
   if (discretization_method == DiscretizationMethod::GridBased) os << "GridBased" << "\n";
   else os << "PhaseBased" << "\n";
+  os << "  move_blocking_size: " << move_blocking_size << "\n";
+  os << "  hessian_approximation: ";
+  if (hessian_approximation == HessianApproximation::GaussNewton) os << "GaussNewton" << "\n";
+  else os << "BFGS" << "\n";
   os << "  initial_sto_reg_iter: " << initial_sto_reg_iter << "\n";
   os << "  initial_sto_reg: " << initial_sto_reg << "\n";
   os << "  kkt_tol_mesh: " << kkt_tol_mesh << "\n";
@@ -27,7 +96,8 @@ void SolverOptions::disp(std::ostream& os) const {
   os << "  interpolation_order: ";
   if (interpolation_order == InterpolationOrder::Linear) os << "Linear" << "\n";
   else os << "Zero" << "\n";
-  os << "  enable_benchmark: " << std::boolalpha << enable_benchmark << std::flush;
+  os << "  enable_benchmark: " << std::boolalpha << enable_benchmark << "\n";
+  os << "  time_budget: " << time_budget << std::flush;
 }
 
 
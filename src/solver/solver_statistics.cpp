@@ -15,17 +15,21 @@ void SolverStatistics::reserve(const int size) {
   dual_step_size.reserve(size);
   ts.reserve(size);
   mesh_refinement_iter.reserve(size);
+  screened_constraints_ratio.reserve(size);
 }
 
 
 void SolverStatistics::clear() {
   convergence = false;
+  budget_exhausted = false;
+  best_iterate_restored = false;
   iter = 0;
   performance_index.clear();
   primal_step_size.clear();
   dual_step_size.clear();
   ts.clear();
   mesh_refinement_iter.clear();
+  screened_constraints_ratio.clear();
   cpu_time = 0.0;
 }
 
@@ -33,6 +37,8 @@ void SolverStatistics::clear() {
 void SolverStatistics::disp(std::ostream& os) const {
   os << "Solver statistics:" << "\n";
   os << "  convergence: " << std::boolalpha << convergence << "\n";
+  os << "  time budget exhausted: " << std::boolalpha << budget_exhausted << "\n";
+  os << "  best iterate restored: " << std::boolalpha << best_iterate_restored << "\n";
   os << "  total No. of iterations: " << iter << "\n";
   os << "  CPU time: " << std::setprecision(3) << cpu_time << " ms (non-zero if benchmark is enabled) \n";
   os << "  ------------------------------------------------------------------------------------------------------------------ " << "\n";
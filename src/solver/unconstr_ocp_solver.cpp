@@ -38,6 +38,9 @@ UnconstrOCPSolver::UnconstrOCPSolver(const OCP& ocp,
   if (solver_options.nthreads <= 0) {
     throw std::out_of_range("[UnconstrOCPSolver] invalid argument: solver_options.nthreads must be positive!");
   }
+  if (solver_options.enable_thread_pinning) {
+    dms_.setNumThreads(solver_options.nthreads, true);
+  }
   const double dt = ocp.T / ocp.N;
   for (int i=0; i<=ocp.N; ++i) {
     time_discretization_[i].t = dt * i;
@@ -76,7 +79,8 @@ void UnconstrOCPSolver::setSolverOptions(const SolverOptions& solver_options) {
   if (solver_options.nthreads <= 0) {
     throw std::out_of_range("[UnconstrOCPSolver] invalid argument: solver_options.nthreads must be positive!");
   }
-  dms_.setNumThreads(solver_options.nthreads);
+  dms_.setNumThreads(solver_options.nthreads, 
+                     solver_options.enable_thread_pinning);
   solver_options_ = solver_options;
 }
 
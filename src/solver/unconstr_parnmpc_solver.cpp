@@ -35,6 +35,9 @@ UnconstrParNMPCSolver::UnconstrParNMPCSolver(const OCP& ocp,
   if (solver_options.nthreads <= 0) {
     throw std::out_of_range("[UnconstrParNMPCSolver] invalid argument: solver_options.nthreads must be positive!");
   }
+  if (solver_options.enable_thread_pinning) {
+    backward_correction_.setNumThreads(solver_options.nthreads, true);
+  }
   const double dt = ocp.T / ocp.N;
   for (int i=0; i<=ocp.N; ++i) {
     time_discretization_[i].t = dt * i;
@@ -70,7 +73,8 @@ void UnconstrParNMPCSolver::setSolverOptions(const SolverOptions& solver_options
   if (solver_options.nthreads <= 0) {
     throw std::out_of_range("[UnconstrParNMPCSolver] invalid argument: solver_options.nthreads must be positive!");
   }
-  backward_correction_.setNumThreads(solver_options.nthreads);
+  backward_correction_.setNumThreads(solver_options.nthreads, 
+                                     solver_options.enable_thread_pinning);
   solver_options_ = solver_options;
 }
 
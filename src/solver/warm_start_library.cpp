@@ -0,0 +1,230 @@
+#include "robotoc/solver/warm_start_library.hpp"
+
+#include <stdexcept>
+#include <fstream>
+#include <cmath>
+
+#include "Eigen/Geometry"
+
+
+namespace robotoc {
+
+WarmStartLibrary::WarmStartLibrary(const Robot& robot)
+  : entries_(),
+    max_command_distance_(std::numeric_limits<double>::infinity()),
+    has_floating_base_(robot.hasFloatingBase()) {
+}
+
+
+WarmStartLibrary::WarmStartLibrary()
+  : entries_(),
+    max_command_distance_(std::numeric_limits<double>::infinity()),
+    has_floating_base_(false) {
+}
+
+
+void WarmStartLibrary::setMaxCommandDistance(const double max_command_distance) {
+  if (max_command_distance < 0) {
+    throw std::out_of_range("[WarmStartLibrary] invalid argument: max_command_distance must be non-negative!");
+  }
+  max_command_distance_ = max_command_distance;
+}
+
+
+void WarmStartLibrary::add(const WarmStartKey& key,
+                           const TimeDiscretization& time_discretization,
+                           const Solution& s) {
+  if (s.size() < time_discretization.size()) {
+    throw std::out_of_range("[WarmStartLibrary] invalid argument: s.size() must be at least "
+                            + std::to_string(time_discretization.size()) + "!");
+  }
+  Entry entry;
+  entry.key = key;
+  entry.time_discretization = time_discretization;
+  entry.solution = Solution(s.begin(), s.begin()+time_discretization.size());
+  for (auto& e : entries_) {
+    if (isSameClass(e.key, key) && e.key.command.isApprox(key.command)) {
+      e = std::move(entry);
+      return;
+    }
+  }
+  entries_.push_back(std::move(entry));
+}
+
+
+void WarmStartLibrary::add(const WarmStartKey& key,
+                           const OCPSolver& ocp_solver) {
+  add(key, ocp_solver.getTimeDiscretization(), ocp_solver.getSolution());
+}
+
+
+int WarmStartLibrary::findNearest(const WarmStartKey& key) const {
+  int nearest = -1;
+  double min_distance = max_command_distance_;
+  for (int i=0; i<entries_.size(); ++i) {
+    if (!isSameClass(entries_[i].key, key)) continue;
+    const double distance = (entries_[i].key.command - key.command).norm();
+    if (distance <= min_distance) {
+      nearest = i;
+      min_distance = distance;
+    }
+  }
+  return nearest;
+}
+
+
+bool WarmStartLibrary::warmStart(const WarmStartKey& key, const double t,
+                                 const Eigen::VectorXd& q,
+                                 OCPSolver& ocp_solver) const {
+  const int index = findNearest(key);
+  if (index < 0) return false;
+  const auto& entry = entries_[index];
+  if (q.size() != entry.solution[0].q.size()) {
+    throw std::out_of_range("[WarmStartLibrary] invalid argument: q.size() must be "
+                            + std::to_string(entry.solution[0].q.size()) + "!");
+  }
+  ocp_solver.discretize(t);
+  const auto& current_discretization = ocp_solver.getTimeDiscretization();
+  // Aligns the first discrete events, or the initial times if either horizon
+  // has no discrete event.
+  TimeDiscretization time_discretization = entry.time_discretization;
+  const int stored_event = findFirstEventGrid(time_discretization);
+  const int current_event = findFirstEventGrid(current_discretization);
+  if (stored_event >= 0 && current_event >= 0) {
+    time_discretization.shiftTime(current_discretization[current_event].t
+                                  - time_discretization[stored_event].t);
+  }
+  else {
+    time_discretization.shiftTime(current_discretization.front().t
+                                  - time_discretization.front().t);
+  }
+  if (has_floating_base_) {
+    Solution s = entry.solution;
+    alignBasePose(q, s);
+    ocp_solver.interpolateSolution(time_discretization, s);
+  }
+  else {
+    ocp_solver.interpolateSolution(time_discretization, entry.solution);
+  }
+  return true;
+}
+
+
+const WarmStartKey& WarmStartLibrary::key(const int index) const {
+  if (index < 0 || index >= entries_.size()) {
+    throw std::out_of_range("[WarmStartLibrary] invalid argument: index must be in [0, "
+                            + std::to_string(entries_.size()) + ")!");
+  }
+  return entries_[index].key;
+}
+
+
+int WarmStartLibrary::size() const {
+  return entries_.size();
+}
+
+
+void WarmStartLibrary::clear() {
+  entries_.clear();
+}
+
+
+void WarmStartLibrary::save(const std::string& filename) const {
+  std::ofstream ofs(filename, std::ios::binary);
+  if (!ofs) {
+    throw std::runtime_error("[WarmStartLibrary] failed to open " + filename + "!");
+  }
+  BinaryOutputArchive ar(ofs);
+  ar.write(has_floating_base_);
+  ar.writeSize(entries_.size());
+  for (const auto& e : entries_) {
+    ar.write(e.key.gait);
+    ar.write(e.key.contact_pattern);
+    ar.write(e.key.command);
+    e.time_discretization.save(ar);
+    ::robotoc::save(ar, e.solution);
+  }
+}
+
+
+void WarmStartLibrary::load(const std::string& filename) {
+  std::ifstream ifs(filename, std::ios::binary);
+  if (!ifs) {
+    throw std::runtime_error("[WarmStartLibrary] failed to open " + filename + "!");
+  }
+  BinaryInputArchive ar(ifs);
+  ar.read(has_floating_base_);
+  entries_.resize(ar.readSize());
+  for (auto& e : entries_) {
+    ar.read(e.key.gait);
+    ar.read(e.key.contact_pattern);
+    ar.read(e.key.command);
+    e.time_discretization.load(ar);
+    ::robotoc::load(ar, e.solution);
+    if (e.solution.size() < e.time_discretization.size()) {
+      throw std::runtime_error("[WarmStartLibrary] loaded data is not consistent!");
+    }
+  }
+}
+
+
+std::vector<bool> WarmStartLibrary::contactPattern(
+    const ContactSequence& contact_sequence) {
+  std::vector<bool> contact_pattern;
+  const int num_phases = std::min(contact_sequence.numContactPhases(), 2);
+  for (int phase=0; phase<num_phases; ++phase) {
+    const auto is_contact_active
+        = contact_sequence.contactStatus(phase).isContactActive();
+    contact_pattern.insert(contact_pattern.end(), is_contact_active.begin(),
+                           is_contact_active.end());
+  }
+  return contact_pattern;
+}
+
+
+bool WarmStartLibrary::isSameClass(const WarmStartKey& key,
+                                   const WarmStartKey& other) {
+  return (key.gait == other.gait)
+          && (key.contact_pattern == other.contact_pattern)
+          && (key.command.size() == other.command.size());
+}
+
+
+int WarmStartLibrary::findFirstEventGrid(
+    const TimeDiscretization& time_discretization) {
+  for (int i=0; i<time_discretization.size(); ++i) {
+    const auto type = time_discretization[i].type;
+    if (type == GridType::Impact || type == GridType::Lift) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+void WarmStartLibrary::alignBasePose(const Eigen::VectorXd& q0,
+                                     Solution& s) const {
+  // Planar transformation (horizontal translation and yaw rotation) from the
+  // initial base pose of the stored solution to q0. The height, roll, and
+  // pitch of the stored solution are kept.
+  auto yaw = [](const Eigen::Quaterniond& quat) {
+    const Eigen::Matrix3d R = quat.toRotationMatrix();
+    return std::atan2(R(1, 0), R(0, 0));
+  };
+  const Eigen::Vector3d p_stored = s[0].q.template head<3>();
+  const Eigen::Quaterniond quat_stored(s[0].q.template segment<4>(3));
+  const Eigen::Quaterniond quat0(q0.template segment<4>(3));
+  const Eigen::Matrix3d R_yaw
+      = Eigen::AngleAxisd(yaw(quat0)-yaw(quat_stored),
+                          Eigen::Vector3d::UnitZ()).toRotationMatrix();
+  const Eigen::Quaterniond quat_yaw(R_yaw);
+  for (auto& e : s) {
+    const Eigen::Vector3d p = e.q.template head<3>();
+    e.q.template head<2>()
+        = (R_yaw * (p - p_stored)).template head<2>() + q0.template head<2>();
+    const Eigen::Quaterniond quat(e.q.template segment<4>(3));
+    e.q.template segment<4>(3) = (quat_yaw * quat).normalized().coeffs();
+  }
+}
+
+} // namespace robotoc
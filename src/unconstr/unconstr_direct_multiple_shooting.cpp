@@ -1,22 +1,26 @@
 #include "robotoc/unconstr/unconstr_direct_multiple_shooting.hpp"
 
-#include <omp.h>
 #include <stdexcept>
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <functional>
 
 
 namespace robotoc {
 
 UnconstrDirectMultipleShooting::UnconstrDirectMultipleShooting(const OCP& ocp, 
                                                                const int nthreads)
-  : nthreads_(nthreads),
+  : thread_pool_(nthreads),
     intermediate_stage_(ocp.robot, ocp.cost, ocp.constraints),
     terminal_stage_(ocp.robot, ocp.cost, ocp.constraints),
     data_(),
     performance_index_(),
-    max_primal_step_sizes_(Eigen::VectorXd::Zero(ocp.N+1)), 
-    max_dual_step_sizes_(Eigen::VectorXd::Zero(ocp.N+1)) {
+    max_primal_step_size_(1.0), 
+    max_dual_step_size_(1.0),
+    performance_index_sum_(nthreads),
+    min_primal_step_size_(nthreads, 1.0),
+    min_dual_step_size_(nthreads, 1.0) {
   if (nthreads <= 0) {
     throw std::out_of_range("[UnconstrDirectMultipleShooting] invalid argument: nthreads must be positive!");
   }
@@ -28,15 +32,29 @@ UnconstrDirectMultipleShooting::UnconstrDirectMultipleShooting(const OCP& ocp,
 }
 
 
-UnconstrDirectMultipleShooting::UnconstrDirectMultipleShooting() {
+UnconstrDirectMultipleShooting::UnconstrDirectMultipleShooting() 
+  : thread_pool_(),
+    intermediate_stage_(),
+    terminal_stage_(),
+    data_(),
+    performance_index_(),
+    max_primal_step_size_(1.0), 
+    max_dual_step_size_(1.0),
+    performance_index_sum_(),
+    min_primal_step_size_(),
+    min_dual_step_size_() {
 }
 
 
-void UnconstrDirectMultipleShooting::setNumThreads(const int nthreads) {
+void UnconstrDirectMultipleShooting::setNumThreads(const int nthreads, 
+                                                   const bool enable_thread_pinning) {
   if (nthreads <= 0) {
     throw std::out_of_range("[UnconstrDirectMultipleShooting] invalid argument: nthreads must be positive!");
   }
-  nthreads_ = nthreads;
+  thread_pool_.setNumThreads(nthreads, enable_thread_pinning);
+  performance_index_sum_.setNumThreads(nthreads);
+  min_primal_step_size_.setNumThreads(nthreads);
+  min_dual_step_size_.setNumThreads(nthreads);
 }
 
 
@@ -44,17 +62,16 @@ void UnconstrDirectMultipleShooting::initConstraints(
     aligned_vector<Robot>& robots, 
     const std::vector<GridInfo>& time_discretization, const Solution& s) {
   const int N = time_discretization.size() - 1;
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<=N; ++i) {
+  thread_pool_.parallelFor(N+1, [&](const int i, const int thread_id) {
     if (i < N) {
-      intermediate_stage_.initConstraints(robots[omp_get_thread_num()], 
+      intermediate_stage_.initConstraints(robots[thread_id], 
                                           time_discretization[i], s[i], data_[i]);
     }
     else {
-      terminal_stage_.initConstraints(robots[omp_get_thread_num()], 
+      terminal_stage_.initConstraints(robots[thread_id], 
                                       time_discretization[i], s[i], data_[i]);
     }
-  }
+  });
 }
 
 
@@ -63,25 +80,24 @@ void UnconstrDirectMultipleShooting::evalOCP(
     const std::vector<GridInfo>& time_discretization, 
     const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s, 
     KKTResidual& kkt_residual) {
-  assert(robots.size() >= nthreads_);
+  assert(robots.size() >= thread_pool_.nthreads());
   const int N = time_discretization.size() - 1;
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<=N; ++i) {
+  performance_index_sum_.reset(PerformanceIndex());
+  thread_pool_.parallelFor(N+1, [&](const int i, const int thread_id) {
     if (i < N) {
-      intermediate_stage_.evalOCP(robots[omp_get_thread_num()], 
+      intermediate_stage_.evalOCP(robots[thread_id], 
                                   time_discretization[i],  
                                   s[i], s[i+1], data_[i], kkt_residual[i]);
     }
     else {
-      terminal_stage_.evalOCP(robots[omp_get_thread_num()], 
+      terminal_stage_.evalOCP(robots[thread_id], 
                               time_discretization[i], 
                               s[i], data_[i], kkt_residual[i]);
     }
-  }
-  performance_index_.setZero();
-  for (int i=0; i<=N; ++i) {
-    performance_index_ += data_[i].performance_index;
-  }
+    performance_index_sum_.local(thread_id) += data_[i].performance_index;
+  });
+  performance_index_ = performance_index_sum_.reduce(
+      PerformanceIndex(), std::plus<PerformanceIndex>());
 }
 
 
@@ -90,25 +106,24 @@ void UnconstrDirectMultipleShooting::evalKKT(
     const std::vector<GridInfo>& time_discretization, 
     const Eigen::VectorXd& q, const Eigen::VectorXd& v, const Solution& s, 
     KKTMatrix& kkt_matrix, KKTResidual& kkt_residual) {
-  assert(robots.size() >= nthreads_);
+  assert(robots.size() >= thread_pool_.nthreads());
   const int N = time_discretization.size() - 1;
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<=N; ++i) {
+  performance_index_sum_.reset(PerformanceIndex());
+  thread_pool_.parallelFor(N+1, [&](const int i, const int thread_id) {
     if (i < N) {
-      intermediate_stage_.evalKKT(robots[omp_get_thread_num()], 
+      intermediate_stage_.evalKKT(robots[thread_id], 
                                   time_discretization[i], s[i], s[i+1], 
                                   data_[i], kkt_matrix[i], kkt_residual[i]);
     }
     else {
-      terminal_stage_.evalKKT(robots[omp_get_thread_num()], 
+      terminal_stage_.evalKKT(robots[thread_id], 
                               time_discretization[i], s[i], 
                               data_[i], kkt_matrix[i], kkt_residual[i]);
     }
-  }
-  performance_index_.setZero();
-  for (int i=0; i<=N; ++i) {
-    performance_index_ += data_[i].performance_index;
-  }
+    performance_index_sum_.local(thread_id) += data_[i].performance_index;
+  });
+  performance_index_ = performance_index_sum_.reduce(
+      PerformanceIndex(), std::plus<PerformanceIndex>());
 }
 
 
@@ -129,30 +144,34 @@ void UnconstrDirectMultipleShooting::computeStepSizes(
     const std::vector<GridInfo>& time_discretization, KKTMatrix& kkt_matrix, 
     KKTResidual& kkt_residual, Direction& d) {
   const int N = time_discretization.size() - 1;
-  max_primal_step_sizes_.fill(1.0);
-  max_dual_step_sizes_.fill(1.0);
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<=N; ++i) {
+  min_primal_step_size_.reset(1.0);
+  min_dual_step_size_.reset(1.0);
+  thread_pool_.parallelFor(N+1, [&](const int i, const int thread_id) {
     if (i < N) {
       intermediate_stage_.expandPrimalAndDual(time_discretization[i].dt, 
                                               kkt_matrix[i], kkt_residual[i], 
                                               data_[i], d[i]);
-      max_primal_step_sizes_.coeffRef(i) 
-          = intermediate_stage_.maxPrimalStepSize(data_[i]);
-      max_dual_step_sizes_.coeffRef(i)
-          = intermediate_stage_.maxDualStepSize(data_[i]);
+      double& primal_step_size = min_primal_step_size_.local(thread_id);
+      double& dual_step_size = min_dual_step_size_.local(thread_id);
+      primal_step_size = std::min(primal_step_size, 
+                                  intermediate_stage_.maxPrimalStepSize(data_[i]));
+      dual_step_size = std::min(dual_step_size, 
+                                intermediate_stage_.maxDualStepSize(data_[i]));
     }
-  }
+  });
+  auto min = [](const double a, const double b) { return std::min(a, b); };
+  max_primal_step_size_ = min_primal_step_size_.reduce(1.0, min);
+  max_dual_step_size_ = min_dual_step_size_.reduce(1.0, min);
 }
 
 
 double UnconstrDirectMultipleShooting::maxPrimalStepSize() const {
-  return max_primal_step_sizes_.minCoeff();
+  return max_primal_step_size_;
 }
 
 
 double UnconstrDirectMultipleShooting::maxDualStepSize() const {
-  return max_dual_step_sizes_.minCoeff();
+  return max_dual_step_size_;
 }
 
 
@@ -161,21 +180,20 @@ void UnconstrDirectMultipleShooting::integrateSolution(
     const std::vector<GridInfo>& time_discretization, 
     const double primal_step_size, const double dual_step_size,
     Direction& d, Solution& s) {
-  assert(robots.size() >= nthreads_);
+  assert(robots.size() >= thread_pool_.nthreads());
   const int N = time_discretization.size() - 1;
-  #pragma omp parallel for num_threads(nthreads_)
-  for (int i=0; i<=N; ++i) {
+  thread_pool_.parallelFor(N+1, [&](const int i, const int thread_id) {
     if (i < N) {
-      intermediate_stage_.updatePrimal(robots[omp_get_thread_num()], 
+      intermediate_stage_.updatePrimal(robots[thread_id], 
                                        primal_step_size, d[i], s[i], data_[i]);
       intermediate_stage_.updateDual(dual_step_size, data_[i]);
     }
     else {
-      terminal_stage_.updatePrimal(robots[omp_get_thread_num()],  
+      terminal_stage_.updatePrimal(robots[thread_id],  
                                    primal_step_size, d[i], s[i], data_[i]);
       terminal_stage_.updateDual(dual_step_size, data_[i]);
     }
-  }
+  });
 }
 
 } // namespace robotoc
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include "robotoc/utils/batched_inverse_kinematics.hpp"
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
+
+namespace robotoc {
+
+BatchedInverseKinematics::BatchedInverseKinematics(const Robot& robot,
+                                                   const int base_frame_id,
+                                                   const int nthreads)
+  : robots_(),
+    workspaces_(),
+    thread_pool_(nthreads),
+    settings_(),
+    base_frame_id_(base_frame_id),
+    contact_frames_(robot.contactFrames()),
+    errors_() {
+  if (!robot.hasFloatingBase()) {
+    throw std::out_of_range("[BatchedInverseKinematics] invalid argument: robot must have a floating base!");
+  }
+  robots_.resize(nthreads, robot);
+  workspaces_.resize(nthreads, createWorkspace(robot));
+}
+
+
+BatchedInverseKinematics::BatchedInverseKinematics(
+    const Robot& robot, const std::string& base_frame_name, const int nthreads)
+  : BatchedInverseKinematics(robot, robot.frameId(base_frame_name), nthreads) {
+}
+
+
+BatchedInverseKinematics::BatchedInverseKinematics()
+  : robots_(),
+    workspaces_(),
+    thread_pool_(),
+    settings_(),
+    base_frame_id_(0),
+    contact_frames_(),
+    errors_() {
+}
+
+
+void BatchedInverseKinematics::setSettings(
+    const InverseKinematicsSettings& settings) {
+  if (settings.max_iter < 0) {
+    throw std::out_of_range("[BatchedInverseKinematics] invalid argument: settings.max_iter must be non-negative!");
+  }
+  if (settings.tol <= 0) {
+    throw std::out_of_range("[BatchedInverseKinematics] invalid argument: settings.tol must be positive!");
+  }
+  if (settings.damping < 0) {
+    throw std::out_of_range("[BatchedInverseKinematics] invalid argument: settings.damping must be non-negative!");
+  }
+  if (settings.chunk_size <= 0) {
+    throw std::out_of_range("[BatchedInverseKinematics] invalid argument: settings.chunk_size must be positive!");
+  }
+  settings_ = settings;
+}
+
+
+void BatchedInverseKinematics::setNumThreads(const int nthreads) {
+  if (nthreads <= 0) {
+    throw std::out_of_range("[BatchedInverseKinematics] invalid argument: nthreads must be positive!");
+  }
+  if (robots_.empty()) {
+    throw std::runtime_error("[BatchedInverseKinematics] robot model is not set!");
+  }
+  thread_pool_.setNumThreads(nthreads);
+  while (robots_.size() < nthreads) {
+    robots_.push_back(robots_.back());
+    workspaces_.push_back(workspaces_.back());
+  }
+}
+
+
+std::vector<Eigen::VectorXd> BatchedInverseKinematics::solve(
+    const Eigen::VectorXd& q0, const std::vector<SE3>& base_array,
+    const std::vector<std::vector<Eigen::Vector3d>>& contact_position_arrays) {
+  if (robots_.empty()) {
+    throw std::runtime_error("[BatchedInverseKinematics] robot model is not set!");
+  }
+  if (q0.size() != robots_[0].dimq()) {
+    throw std::out_of_range("[BatchedInverseKinematics] invalid argument: q0.size() must be "
+                            + std::to_string(robots_[0].dimq()) + "!");
+  }
+  if (contact_position_arrays.size() != contact_frames_.size()) {
+    throw std::out_of_range("[BatchedInverseKinematics] invalid argument: contact_position_arrays.size() must be "
+                            + std::to_string(contact_frames_.size()) + "!");
+  }
+  const int num_frames = base_array.size();
+  for (const auto& e : contact_position_arrays) {
+    if (e.size() != num_frames) {
+      throw std::out_of_range("[BatchedInverseKinematics] invalid argument: size of each contact position array must be the same as base_array.size()!");
+    }
+  }
+  std::vector<Eigen::VectorXd> q_array(num_frames, q0);
+  errors_.assign(num_frames, 0.0);
+  // The chunks do not depend on the number of the threads so that neither 
+  // do the results.
+  const int chunk_size = settings_.chunk_size;
+  const int num_chunks = (num_frames + chunk_size - 1) / chunk_size;
+  for (int chunk=0; chunk<num_chunks; ++chunk) {
+    const int head = chunk * chunk_size;
+    if (chunk > 0) {
+      q_array[head] = q_array[head-chunk_size];
+    }
+    errors_[head] = solveFrame(robots_[0], workspaces_[0], base_array[head],
+                               contact_position_arrays, head, q_array[head]);
+  }
+  thread_pool_.parallelFor(num_chunks, [&](const int chunk, const int thread_id) {
+    const int begin = chunk * chunk_size;
+    const int end = std::min(begin+chunk_size, num_frames);
+    for (int k=begin+1; k<end; ++k) {
+      q_array[k] = q_array[k-1];
+      errors_[k] = solveFrame(robots_[thread_id], workspaces_[thread_id],
+                              base_array[k], contact_position_arrays, k,
+                              q_array[k]);
+    }
+  });
+  return q_array;
+}
+
+
+const std::vector<double>& BatchedInverseKinematics::getErrors() const {
+  return errors_;
+}
+
+
+double BatchedInverseKinematics::solveFrame(
+    Robot& robot, Workspace& workspace, const SE3& base_ref,
+    const std::vector<std::vector<Eigen::Vector3d>>& contact_position_arrays,
+    const int frame, Eigen::VectorXd& q) const {
+  const int dimu = robot.dimu();
+  const int num_contacts = contact_frames_.size();
+  auto& w = workspace;
+  double error = 0;
+  for (int iter=0; iter<=settings_.max_iter; ++iter) {
+    robot.updateKinematics(q);
+    // residual and Jacobian of the base placement expressed in the local frame
+    const SE3 X_diff = base_ref.inverse() * robot.framePlacement(base_frame_id_);
+    w.e = Log6Map(X_diff);
+    computeJLog6Map(X_diff, w.Jlog6);
+    w.J6.setZero();
+    robot.getFrameJacobian(base_frame_id_, w.J6);
+    w.Jbase.noalias() = w.Jlog6 * w.J6;
+    // residuals and Jacobians of the contact positions in the world frame
+    for (int i=0; i<num_contacts; ++i) {
+      const int frame_id = contact_frames_[i];
+      w.ec.template segment<3>(3*i)
+          = robot.framePosition(frame_id) - contact_position_arrays[i][frame];
+      w.J6.setZero();
+      robot.getFrameJacobian(frame_id, w.J6);
+      w.Jc.middleRows(3*i, 3).noalias()
+          = robot.frameRotation(frame_id) * w.J6.template topRows<3>();
+    }
+    error = std::sqrt(w.e.squaredNorm() + w.ec.squaredNorm());
+    if (error < settings_.tol || iter == settings_.max_iter) break;
+    // Eliminates the floating base by the base task, whose Jacobian w.r.t.
+    // the floating base is block upper triangular, and solves the damped
+    // least squares of the contact tasks w.r.t. the joints.
+    w.se3_jac_inverse.compute(w.Jbase, w.Jbase_inv);
+    w.Jc_reduced = w.Jc.rightCols(dimu);
+    w.Jc_reduced.noalias()
+        -= w.Jc.template leftCols<6>() * (w.Jbase_inv * w.Jbase.rightCols(dimu));
+    w.g = w.ec;
+    w.g.noalias() -= w.Jc.template leftCols<6>() * (w.Jbase_inv * w.e);
+    w.H.noalias() = w.Jc_reduced.transpose() * w.Jc_reduced;
+    w.H.diagonal().array() += settings_.damping;
+    w.ldlt.compute(w.H);
+    w.dq.tail(dimu).noalias() = - w.Jc_reduced.transpose() * w.g;
+    w.dq.tail(dimu) = w.ldlt.solve(w.dq.tail(dimu));
+    w.e.noalias() += w.Jbase.rightCols(dimu) * w.dq.tail(dimu);
+    w.dq.template head<6>().noalias() = - w.Jbase_inv * w.e;
+    robot.integrateConfiguration(w.dq, 1.0, q);
+  }
+  return error;
+}
+
+
+BatchedInverseKinematics::Workspace BatchedInverseKinematics::createWorkspace(
+    const Robot& robot) const {
+  const int dimv = robot.dimv();
+  const int dimu = robot.dimu();
+  const int dimc = 3 * contact_frames_.size();
+  Workspace w;
+  w.J6 = Eigen::MatrixXd::Zero(6, dimv);
+  w.Jbase = Eigen::MatrixXd::Zero(6, dimv);
+  w.Jbase_inv = Eigen::MatrixXd::Zero(6, 6);
+  w.Jc = Eigen::MatrixXd::Zero(dimc, dimv);
+  w.Jc_reduced = Eigen::MatrixXd::Zero(dimc, dimu);
+  w.H = Eigen::MatrixXd::Zero(dimu, dimu);
+  w.e = Eigen::VectorXd::Zero(6);
+  w.ec = Eigen::VectorXd::Zero(dimc);
+  w.dq = Eigen::VectorXd::Zero(dimv);
+  w.g = Eigen::VectorXd::Zero(dimc);
+  w.Jlog6.setZero();
+  w.ldlt = Eigen::LDLT<Eigen::MatrixXd>(dimu);
+  return w;
+}
+
+} // namespace robotoc
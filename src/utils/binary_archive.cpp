@@ -0,0 +1,104 @@
+#include "robotoc/utils/binary_archive.hpp"
+
+#include <stdexcept>
+
+
+namespace robotoc {
+
+constexpr std::uint32_t BinaryOutputArchive::kMagicNumber;
+constexpr std::uint32_t BinaryOutputArchive::kVersion;
+
+
+BinaryOutputArchive::BinaryOutputArchive(std::ostream& os)
+  : os_(os) {
+  write(kMagicNumber);
+  write(kVersion);
+}
+
+
+void BinaryOutputArchive::write(const std::string& str) {
+  writeSize(str.size());
+  writeBytes(str.data(), str.size());
+}
+
+
+void BinaryOutputArchive::write(const std::vector<bool>& vec) {
+  writeSize(vec.size());
+  for (const bool e : vec) {
+    write(e);
+  }
+}
+
+
+void BinaryOutputArchive::writeSize(const std::int64_t size) {
+  write(size);
+}
+
+
+void BinaryOutputArchive::writeBytes(const void* data, const std::size_t size) {
+  os_.write(static_cast<const char*>(data), size);
+  if (!os_) {
+    throw std::runtime_error("[BinaryOutputArchive] failed to write to the stream!");
+  }
+}
+
+
+BinaryInputArchive::BinaryInputArchive(std::istream& is)
+  : is_(is),
+    version_(0) {
+  std::uint32_t magic_number = 0;
+  read(magic_number);
+  if (magic_number != BinaryOutputArchive::kMagicNumber) {
+    throw std::runtime_error("[BinaryInputArchive] stream is not a robotoc binary archive or its byte order is different!");
+  }
+  read(version_);
+  if (version_ == 0 || version_ > BinaryOutputArchive::kVersion) {
+    throw std::runtime_error(
+        "[BinaryInputArchive] unsupported format version ("
+        + std::to_string(version_) + ")! Supported up to version "
+        + std::to_string(BinaryOutputArchive::kVersion) + ".");
+  }
+}
+
+
+void BinaryInputArchive::read(std::string& str) {
+  str.resize(readSize());
+  if (!str.empty()) {
+    readBytes(&str[0], str.size());
+  }
+}
+
+
+void BinaryInputArchive::read(std::vector<bool>& vec) {
+  vec.resize(readSize());
+  for (int i=0; i<vec.size(); ++i) {
+    bool e;
+    read(e);
+    vec[i] = e;
+  }
+}
+
+
+std::int64_t BinaryInputArchive::readSize() {
+  std::int64_t size = 0;
+  read(size);
+  if (size < 0) {
+    throw std::runtime_error("[BinaryInputArchive] stored size must be non-negative!");
+  }
+  return size;
+}
+
+
+std::uint32_t BinaryInputArchive::version() const {
+  return version_;
+}
+
+
+void BinaryInputArchive::readBytes(void* data, const std::size_t size) {
+  is_.read(static_cast<char*>(data), size);
+  if (is_.gcount() != static_cast<std::streamsize>(size)) {
+    throw std::runtime_error("[BinaryInputArchive] unexpected end of the stream!");
+  }
+}
+
+} // namespace robotoc
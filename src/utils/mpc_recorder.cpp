@@ -0,0 +1,145 @@
+#include "robotoc/utils/mpc_recorder.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+
+namespace robotoc {
+
+namespace {
+// Identifies the logs of MPCRecorder among the robotoc binary archives.
+const std::string kMPCLogTag = "robotoc::MPCRecorder";
+} // namespace
+
+
+void MPCRecord::save(BinaryOutputArchive& ar) const {
+  ar.write(type);
+  switch (type) {
+    case MPCRecordType::Init:
+      ar.write(t);
+      ar.write(q);
+      ar.write(v);
+      solver_options.save(ar);
+      break;
+    case MPCRecordType::SolverOptions:
+      solver_options.save(ar);
+      return;
+    case MPCRecordType::Command:
+      ar.write(command);
+      return;
+    case MPCRecordType::UpdateSolution:
+      ar.write(t);
+      ar.write(dt);
+      ar.write(q);
+      ar.write(v);
+      break;
+  }
+  ar.write(u);
+  ar.write(s);
+  ar.write(kkt_error);
+  ar.write(solve_time);
+  ar.write(iter);
+}
+
+
+void MPCRecord::load(BinaryInputArchive& ar) {
+  ar.read(type);
+  switch (type) {
+    case MPCRecordType::Init:
+      ar.read(t);
+      ar.read(q);
+      ar.read(v);
+      solver_options.load(ar);
+      break;
+    case MPCRecordType::SolverOptions:
+      solver_options.load(ar);
+      return;
+    case MPCRecordType::Command:
+      ar.read(command);
+      return;
+    case MPCRecordType::UpdateSolution:
+      ar.read(t);
+      ar.read(dt);
+      ar.read(q);
+      ar.read(v);
+      break;
+    default:
+      throw std::runtime_error("[MPCRecord] invalid type of the record!");
+  }
+  ar.read(u);
+  ar.read(s);
+  ar.read(kkt_error);
+  ar.read(solve_time);
+  ar.read(iter);
+}
+
+
+MPCRecorder::MPCRecorder()
+  : records_() {
+}
+
+
+void MPCRecorder::recordCommand(const Eigen::VectorXd& command) {
+  MPCRecord record;
+  record.type = MPCRecordType::Command;
+  record.command = command;
+  records_.push_back(std::move(record));
+}
+
+
+void MPCRecorder::reserve(const int size) {
+  if (size < 0) {
+    throw std::out_of_range("[MPCRecorder] invalid argument: size must be non-negative!");
+  }
+  records_.reserve(size);
+}
+
+
+void MPCRecorder::clear() {
+  records_.clear();
+}
+
+
+void MPCRecorder::save(const std::string& filename) const {
+  std::ofstream ofs(filename, std::ios::binary);
+  if (!ofs) {
+    throw std::runtime_error("[MPCRecorder] failed to open " + filename + "!");
+  }
+  BinaryOutputArchive ar(ofs);
+  save(ar);
+}
+
+
+void MPCRecorder::load(const std::string& filename) {
+  std::ifstream ifs(filename, std::ios::binary);
+  if (!ifs) {
+    throw std::runtime_error("[MPCRecorder] failed to open " + filename + "!");
+  }
+  BinaryInputArchive ar(ifs);
+  load(ar);
+}
+
+
+void MPCRecorder::save(BinaryOutputArchive& ar) const {
+  ar.write(kMPCLogTag);
+  ar.writeSize(records_.size());
+  for (const auto& e : records_) {
+    e.save(ar);
+  }
+}
+
+
+void MPCRecorder::load(BinaryInputArchive& ar) {
+  std::string tag;
+  ar.read(tag);
+  if (tag != kMPCLogTag) {
+    throw std::runtime_error("[MPCRecorder] archive is not a log of MPCRecorder!");
+  }
+  std::vector<MPCRecord> records(ar.readSize());
+  for (auto& e : records) {
+    e.load(ar);
+  }
+  records_ = std::move(records);
+}
+
+} // namespace robotoc
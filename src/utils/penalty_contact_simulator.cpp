@@ -0,0 +1,181 @@
+#include "robotoc/utils/penalty_contact_simulator.hpp"
+
+#include <string>
+#include <stdexcept>
+#include <cassert>
+
+
+namespace robotoc {
+
+PenaltyContactSimulator::PenaltyContactSimulator(const Robot& robot,
+                                                 const double time_step,
+                                                 const int num_substeps)
+  : robot_(robot),
+    contact_status_(robot.createContactStatus()),
+    contact_frames_(robot.contactFrames()),
+    f_(robot.maxNumContacts(), Vector6d::Zero()),
+    q_(robot.generateFeasibleConfiguration()),
+    v_(Eigen::VectorXd::Zero(robot.dimv())),
+    a_(Eigen::VectorXd::Zero(robot.dimv())),
+    tau_(Eigen::VectorXd::Zero(robot.dimv())),
+    t_(0.0),
+    time_step_(time_step),
+    substep_length_(0.0),
+    stiffness_(2.0e04),
+    damping_(5.0e02),
+    friction_damping_(1.0e03),
+    friction_coefficient_(0.7),
+    rotational_stiffness_(5.0e02),
+    rotational_damping_(2.0e01),
+    ground_height_(0.0),
+    num_substeps_(num_substeps) {
+  if (time_step <= 0) {
+    throw std::out_of_range("[PenaltyContactSimulator] invalid argument: time_step must be positive!");
+  }
+  if (num_substeps <= 0) {
+    throw std::out_of_range("[PenaltyContactSimulator] invalid argument: num_substeps must be positive!");
+  }
+  substep_length_ = time_step / num_substeps;
+  for (int i=0; i<robot.maxNumContacts(); ++i) {
+    contact_status_.activateContact(i);
+  }
+}
+
+
+PenaltyContactSimulator::PenaltyContactSimulator()
+  : robot_(),
+    contact_status_(),
+    contact_frames_(),
+    f_(),
+    q_(),
+    v_(),
+    a_(),
+    tau_(),
+    t_(0.0),
+    time_step_(0.0),
+    substep_length_(0.0),
+    stiffness_(0.0),
+    damping_(0.0),
+    friction_damping_(0.0),
+    friction_coefficient_(0.0),
+    rotational_stiffness_(0.0),
+    rotational_damping_(0.0),
+    ground_height_(0.0),
+    num_substeps_(0) {
+}
+
+
+void PenaltyContactSimulator::setContactParameters(
+    const double stiffness, const double damping,
+    const double friction_damping, const double friction_coefficient) {
+  if (stiffness <= 0) {
+    throw std::out_of_range("[PenaltyContactSimulator] invalid argument: stiffness must be positive!");
+  }
+  if (damping < 0) {
+    throw std::out_of_range("[PenaltyContactSimulator] invalid argument: damping must be non-negative!");
+  }
+  if (friction_damping <= 0) {
+    throw std::out_of_range("[PenaltyContactSimulator] invalid argument: friction_damping must be positive!");
+  }
+  if (friction_coefficient <= 0) {
+    throw std::out_of_range("[PenaltyContactSimulator] invalid argument: friction_coefficient must be positive!");
+  }
+  stiffness_ = stiffness;
+  damping_ = damping;
+  friction_damping_ = friction_damping;
+  friction_coefficient_ = friction_coefficient;
+}
+
+
+void PenaltyContactSimulator::setRotationalContactParameters(
+    const double stiffness, const double damping) {
+  if (stiffness < 0) {
+    throw std::out_of_range("[PenaltyContactSimulator] invalid argument: stiffness must be non-negative!");
+  }
+  if (damping < 0) {
+    throw std::out_of_range("[PenaltyContactSimulator] invalid argument: damping must be non-negative!");
+  }
+  rotational_stiffness_ = stiffness;
+  rotational_damping_ = damping;
+}
+
+
+void PenaltyContactSimulator::setGroundHeight(const double ground_height) {
+  ground_height_ = ground_height;
+}
+
+
+void PenaltyContactSimulator::init(const double t, const Eigen::VectorXd& q,
+                                   const Eigen::VectorXd& v) {
+  if (q.size() != robot_.dimq()) {
+    throw std::invalid_argument("[PenaltyContactSimulator] invalid argument: q.size() must be " + std::to_string(robot_.dimq()) + "!");
+  }
+  if (v.size() != robot_.dimv()) {
+    throw std::invalid_argument("[PenaltyContactSimulator] invalid argument: v.size() must be " + std::to_string(robot_.dimv()) + "!");
+  }
+  t_ = t;
+  q_ = q;
+  v_ = v;
+  a_.setZero();
+  tau_.setZero();
+  for (auto& e : f_) {
+    e.setZero();
+  }
+}
+
+
+void PenaltyContactSimulator::step(const Eigen::VectorXd& u) {
+  assert(u.size() == robot_.dimu());
+  tau_.tail(robot_.dimu()) = u;
+  for (int i=0; i<num_substeps_; ++i) {
+    computeContactForces();
+    robot_.ABA(q_, v_, tau_, a_);
+    v_.noalias() += substep_length_ * a_;
+    robot_.integrateConfiguration(v_, substep_length_, q_);
+    robot_.normalizeConfiguration(q_);
+  }
+  t_ += time_step_;
+}
+
+
+void PenaltyContactSimulator::computeContactForces() {
+  robot_.updateFrameKinematics(q_, v_);
+  const int num_contacts = contact_frames_.size();
+  const int num_point_contacts = robot_.maxNumPointContacts();
+  for (int i=0; i<num_contacts; ++i) {
+    f_[i].setZero();
+    const int frame = contact_frames_[i];
+    const double depth = ground_height_ - robot_.framePosition(frame).coeff(2);
+    if (depth <= 0) {
+      continue;
+    }
+    const Eigen::Vector3d vel = robot_.frameLinearVelocity(frame);
+    const double fn = stiffness_ * depth - damping_ * vel.coeff(2);
+    if (fn <= 0) {
+      continue;
+    }
+    Eigen::Vector3d f_world;
+    f_world.head<2>() = - friction_damping_ * vel.head<2>();
+    const double ft = f_world.head<2>().norm();
+    if (ft > friction_coefficient_ * fn) {
+      f_world.head<2>() *= (friction_coefficient_ * fn / ft);
+    }
+    f_world.coeffRef(2) = fn;
+    const Eigen::Matrix3d& R = robot_.frameRotation(frame);
+    f_[i].head<3>().noalias() = R.transpose() * f_world;
+    if (i >= num_point_contacts) {
+      // Rotational spring-damper that aligns the normal of the surface with
+      // that of the ground.
+      const Eigen::Vector3d omega = robot_.frameAngularVelocity(frame);
+      Eigen::Vector3d m_world = rotational_stiffness_
+                                  * R.col(2).cross(Eigen::Vector3d::UnitZ());
+      m_world.head<2>().noalias()
+          -= rotational_damping_ * omega.head<2>();
+      m_world.coeffRef(2) = 0.0;
+      f_[i].tail<3>().noalias() = R.transpose() * m_world;
+    }
+  }
+  robot_.setContactForces(contact_status_, f_);
+}
+
+} // namespace robotoc
@@ -0,0 +1,209 @@
+#include "robotoc/utils/thread_pool.hpp"
+
+#include <stdexcept>
+#include <utility>
+#include <cassert>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+namespace robotoc {
+
+namespace {
+
+// Number of the busy-wait loops before a worker parks on the condition
+// variable.
+constexpr int kMaxSpinCount = 20000;
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#else
+  std::this_thread::yield();
+#endif
+}
+
+} // namespace
+
+
+ThreadPool::ThreadPool(const int nthreads, const bool enable_thread_pinning)
+  : nthreads_(nthreads),
+    enable_thread_pinning_(enable_thread_pinning),
+    state_(new SharedState()),
+    workers_() {
+  if (nthreads <= 0) {
+    throw std::out_of_range("[ThreadPool] invalid argument: nthreads must be positive!");
+  }
+  spawn();
+}
+
+
+ThreadPool::ThreadPool()
+  : ThreadPool(1) {
+}
+
+
+ThreadPool::~ThreadPool() {
+  join();
+}
+
+
+ThreadPool::ThreadPool(const ThreadPool& other)
+  : ThreadPool(other.nthreads_, other.enable_thread_pinning_) {
+}
+
+
+ThreadPool& ThreadPool::operator=(const ThreadPool& other) {
+  if (this != &other) {
+    setNumThreads(other.nthreads_, other.enable_thread_pinning_);
+  }
+  return *this;
+}
+
+
+ThreadPool::ThreadPool(ThreadPool&& other) noexcept
+  : nthreads_(other.nthreads_),
+    enable_thread_pinning_(other.enable_thread_pinning_),
+    state_(std::move(other.state_)),
+    workers_(std::move(other.workers_)) {
+  other.nthreads_ = 1;
+  other.workers_.clear();
+}
+
+
+ThreadPool& ThreadPool::operator=(ThreadPool&& other) noexcept {
+  if (this != &other) {
+    join();
+    nthreads_ = other.nthreads_;
+    enable_thread_pinning_ = other.enable_thread_pinning_;
+    state_ = std::move(other.state_);
+    workers_ = std::move(other.workers_);
+    other.nthreads_ = 1;
+    other.workers_.clear();
+  }
+  return *this;
+}
+
+
+void ThreadPool::setNumThreads(const int nthreads,
+                               const bool enable_thread_pinning) {
+  if (nthreads <= 0) {
+    throw std::out_of_range("[ThreadPool] invalid argument: nthreads must be positive!");
+  }
+  if (state_ && nthreads == nthreads_
+      && enable_thread_pinning == enable_thread_pinning_) {
+    return;
+  }
+  join();
+  nthreads_ = nthreads;
+  enable_thread_pinning_ = enable_thread_pinning;
+  state_.reset(new SharedState());
+  spawn();
+}
+
+
+int ThreadPool::nthreads() const {
+  return nthreads_;
+}
+
+
+void ThreadPool::spawn() {
+  state_->nthreads = nthreads_;
+  workers_.clear();
+  workers_.reserve(nthreads_-1);
+  for (int i=1; i<nthreads_; ++i) {
+    workers_.emplace_back(&ThreadPool::work, state_.get(), i);
+#ifdef __linux__
+    if (enable_thread_pinning_) {
+      const int ncores = std::thread::hardware_concurrency();
+      if (ncores > 0) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(i%ncores, &cpuset);
+        pthread_setaffinity_np(workers_.back().native_handle(),
+                               sizeof(cpu_set_t), &cpuset);
+      }
+    }
+#endif
+  }
+}
+
+
+void ThreadPool::join() {
+  if (!state_) return;
+  {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    state_->stop.store(true, std::memory_order_release);
+  }
+  state_->cv.notify_all();
+  for (auto& e : workers_) {
+    if (e.joinable()) e.join();
+  }
+  workers_.clear();
+}
+
+
+void ThreadPool::run(const int size, Task task, const void* context) {
+  assert(state_);
+  state_->task = task;
+  state_->context = context;
+  state_->size = size;
+  state_->pending.store(nthreads_-1, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    state_->generation.fetch_add(1, std::memory_order_release);
+  }
+  state_->cv.notify_all();
+  execute(state_.get(), 0);
+  int spin_count = 0;
+  while (state_->pending.load(std::memory_order_acquire) > 0) {
+    if (spin_count < kMaxSpinCount) {
+      cpuRelax();
+      ++spin_count;
+    }
+    else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+
+void ThreadPool::work(SharedState* state, const int thread_id) {
+  std::uint64_t generation = 0;
+  while (true) {
+    int spin_count = 0;
+    while (state->generation.load(std::memory_order_acquire) == generation
+            && !state->stop.load(std::memory_order_acquire)) {
+      if (spin_count < kMaxSpinCount) {
+        cpuRelax();
+        ++spin_count;
+      }
+      else {
+        std::unique_lock<std::mutex> lock(state->mtx);
+        state->cv.wait(lock, [&] {
+          return (state->generation.load(std::memory_order_acquire) != generation
+                  || state->stop.load(std::memory_order_acquire));
+        });
+      }
+    }
+    if (state->stop.load(std::memory_order_acquire)) return;
+    generation = state->generation.load(std::memory_order_acquire);
+    execute(state, thread_id);
+    state->pending.fetch_sub(1, std::memory_order_acq_rel);
+  }
+}
+
+
+void ThreadPool::execute(SharedState* state, const int thread_id) {
+  const long size = state->size;
+  const int begin = static_cast<int>((size*thread_id)/state->nthreads);
+  const int end = static_cast<int>((size*(thread_id+1))/state->nthreads);
+  if (begin < end) {
+    state->task(state->context, begin, end, thread_id);
+  }
+}
+
+} // namespace robotoc
@@ -0,0 +1,263 @@
+#include "robotoc/utils/tracer.hpp"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+#include "robotoc/utils/ring_buffer.hpp"
+
+
+namespace robotoc {
+
+namespace {
+
+constexpr int kDefaultCapacity = 65536;
+
+// Ring buffer of the events of a thread. Only the owning thread writes to the
+// events and to the depth, i.e., the number of the open scopes. The events
+// are written only while the depth is positive. The buffer is retired when
+// the thread exits and is released by the next clear() or setCapacity().
+struct ThreadBuffer {
+  ThreadBuffer(const int id, const int capacity)
+    : events(capacity),
+      depth(0),
+      id(id),
+      retired(false) {}
+
+  void push_back(const TraceEvent& event) {
+    if (events.size() == events.capacity()) {
+      events.pop_front();
+    }
+    events.push_back(event);
+  }
+
+  void addDepth(const int diff) {
+    depth.store(depth.load(std::memory_order_relaxed) + diff,
+                std::memory_order_release);
+  }
+
+  RingBuffer<TraceEvent> events;
+  std::atomic<int> depth;
+  int id;
+  bool retired;
+};
+
+
+struct Registry {
+  Registry()
+    : buffers(),
+      mtx(),
+      epoch(std::chrono::steady_clock::now()),
+      capacity(kDefaultCapacity),
+      next_id(0) {}
+
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  std::mutex mtx;
+  std::chrono::steady_clock::time_point epoch;
+  int capacity, next_id;
+
+  void releaseRetiredBuffers() {
+    std::vector<std::unique_ptr<ThreadBuffer>> active;
+    for (auto& e : buffers) {
+      if (!e->retired) {
+        active.push_back(std::move(e));
+      }
+    }
+    buffers.swap(active);
+  }
+
+  // The buffers are not locked by the writers, so that the readers must not
+  // run concurrently with the traced scopes.
+  void checkNoOpenScope(const std::string& func) const {
+    for (const auto& e : buffers) {
+      if (!e->retired && e->depth.load(std::memory_order_acquire) > 0) {
+        throw std::runtime_error("[Tracer] " + func + " must not be called while a scope is traced!");
+      }
+    }
+  }
+};
+
+
+Registry& registry() {
+  static Registry registry;
+  return registry;
+}
+
+
+// Registers the buffer of the calling thread on its first event and retires
+// it when the thread exits.
+struct ThreadBufferHandle {
+  ThreadBufferHandle()
+    : buffer(nullptr) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mtx);
+    reg.buffers.emplace_back(new ThreadBuffer(reg.next_id++, reg.capacity));
+    buffer = reg.buffers.back().get();
+  }
+
+  ~ThreadBufferHandle() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mtx);
+    buffer->retired = true;
+  }
+
+  ThreadBuffer* buffer;
+};
+
+
+inline ThreadBuffer& threadBuffer() {
+  static thread_local ThreadBufferHandle handle;
+  return *handle.buffer;
+}
+
+
+inline std::int64_t timestamp() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - registry().epoch).count();
+}
+
+
+void writeJSONString(std::ostream& os, const char* str) {
+  os << '"';
+  for (const char* c=str; *c!='\0'; ++c) {
+    if (*c == '"' || *c == '\\') os << '\\';
+    os << *c;
+  }
+  os << '"';
+}
+
+} // namespace
+
+
+void Tracer::begin(const char* name, const int stage) {
+  TraceEvent event;
+  event.name = name;
+  event.timestamp = timestamp();
+  event.stage = stage;
+  event.phase = 'B';
+  ThreadBuffer& buffer = threadBuffer();
+  buffer.addDepth(1);
+  buffer.push_back(event);
+}
+
+
+void Tracer::end(const char* name, const int stage) {
+  TraceEvent event;
+  event.name = name;
+  event.timestamp = timestamp();
+  event.stage = stage;
+  event.phase = 'E';
+  ThreadBuffer& buffer = threadBuffer();
+  buffer.push_back(event);
+  buffer.addDepth(-1);
+}
+
+
+void Tracer::setCapacity(const int capacity) {
+  if (capacity <= 0) {
+    throw std::out_of_range("[Tracer] invalid argument: capacity must be positive!");
+  }
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mtx);
+  reg.checkNoOpenScope("setCapacity()");
+  reg.capacity = capacity;
+  reg.releaseRetiredBuffers();
+  for (auto& e : reg.buffers) {
+    e->events = RingBuffer<TraceEvent>(capacity);
+  }
+}
+
+
+void Tracer::clear() {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mtx);
+  reg.checkNoOpenScope("clear()");
+  reg.releaseRetiredBuffers();
+  for (auto& e : reg.buffers) {
+    e->events.clear();
+  }
+}
+
+
+int Tracer::numEvents() {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mtx);
+  reg.checkNoOpenScope("numEvents()");
+  int num_events = 0;
+  for (const auto& e : reg.buffers) {
+    num_events += e->events.size();
+  }
+  return num_events;
+}
+
+
+void Tracer::exportChromeTrace(std::ostream& os) {
+  Registry& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mtx);
+  reg.checkNoOpenScope("exportChromeTrace()");
+  const auto flags = os.flags();
+  const auto precision = os.precision();
+  os << std::fixed << std::setprecision(3);
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  auto separate = [&]() {
+    if (!first) os << ",";
+    first = false;
+    os << "\n";
+  };
+  for (const auto& buffer : reg.buffers) {
+    separate();
+    os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->id
+       << ",\"args\":{\"name\":\"robotoc thread " << buffer->id << "\"}}";
+    // The end events whose begin events have been overwritten in the ring
+    // buffer are skipped so that the scopes are balanced.
+    int depth = 0;
+    for (const auto& e : buffer->events) {
+      if (e.phase == 'E') {
+        if (depth == 0) continue;
+        --depth;
+      }
+      else {
+        ++depth;
+      }
+      separate();
+      os << "{\"name\":";
+      writeJSONString(os, e.name);
+      os << ",\"cat\":\"robotoc\",\"ph\":\"" << e.phase
+         << "\",\"ts\":" << 1.0e-03 * e.timestamp
+         << ",\"pid\":0,\"tid\":" << buffer->id;
+      if (e.stage >= 0) {
+        os << ",\"args\":{\"stage\":" << e.stage << "}";
+      }
+      os << "}";
+    }
+  }
+  os << "\n]}" << std::endl;
+  os.flags(flags);
+  os.precision(precision);
+}
+
+
+void Tracer::exportChromeTrace(const std::string& filename) {
+  std::ofstream ofs(filename);
+  if (!ofs) {
+    throw std::runtime_error("[Tracer] failed to open " + filename + "!");
+  }
+  exportChromeTrace(ofs);
+}
+
+
+bool Tracer::isEnabled() {
+#ifdef ROBOTOC_ENABLE_TRACE
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace robotoc
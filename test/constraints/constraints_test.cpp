@@ -1,4 +1,5 @@
 #include <memory>
+#include <stdexcept>
 
 #include <gtest/gtest.h>
 #include "Eigen/Core"
@@ -241,6 +242,79 @@ TEST_F(ConstraintsTest, testParams) {
   EXPECT_DOUBLE_EQ(friction_cone->getFractionToBoundaryRule(), 0.8);
 }
 
+
+TEST_F(ConstraintsTest, clone) {
+  auto robot = testhelper::CreateQuadrupedalRobot(0.001);
+  auto friction_cone = std::make_shared<robotoc::FrictionCone>(robot);
+  auto constraints = std::make_shared<Constraints>(0.1, 0.5);
+  constraints->push_back(friction_cone);
+  auto constraints_clone = constraints->clone();
+  EXPECT_DOUBLE_EQ(constraints_clone->getBarrierParam(), 0.1);
+  EXPECT_DOUBLE_EQ(constraints_clone->getFractionToBoundaryRule(), 0.5);
+  constraints_clone->setBarrierParam(0.2);
+  EXPECT_DOUBLE_EQ(constraints_clone->getBarrierParam(), 0.2);
+  EXPECT_DOUBLE_EQ(constraints->getBarrierParam(), 0.1);
+  EXPECT_DOUBLE_EQ(friction_cone->getBarrierParam(), 0.1);
+}
+
+
+TEST_F(ConstraintsTest, activeSetScreening) {
+  auto robot = testhelper::CreateRobotManipulator(0.001);
+  auto contact_status = robot.createContactStatus();
+  auto constraints = createConstraints(robot);
+  EXPECT_FALSE(constraints->isActiveSetScreeningEnabled());
+  EXPECT_THROW(constraints->setActiveSetScreening(-1.0), std::out_of_range);
+  EXPECT_THROW(constraints->setActiveSetScreening(1.0, 0), std::out_of_range);
+  const int time_stage = 0;
+  auto data = constraints->createConstraintsData(robot, time_stage);
+  const SplitSolution s = SplitSolution::Random(robot, contact_status);
+  SplitKKTMatrix kkt_matrix(robot);
+  SplitKKTResidual kkt_residual(robot);
+  constraints->setSlackAndDual(robot, contact_status, data, s);
+  // A large threshold screens all the components after the first evaluation.
+  const int revalidation_interval = 2;
+  constraints->setActiveSetScreening(1.0e10, revalidation_interval);
+  EXPECT_TRUE(constraints->isActiveSetScreeningEnabled());
+  kkt_residual.setZero();
+  constraints->linearizeConstraints(robot, contact_status, data, s, kkt_residual);
+  EXPECT_EQ(data.numScreened(), 0);
+  const SplitKKTResidual kkt_residual_ref = kkt_residual;
+  EXPECT_FALSE(kkt_residual_ref.la.isZero());
+  EXPECT_FALSE(kkt_residual_ref.lu.isZero());
+  for (int i=0; i<revalidation_interval; ++i) {
+    kkt_matrix.setZero();
+    kkt_residual.setZero();
+    constraints->linearizeConstraints(robot, contact_status, data, s, kkt_residual);
+    EXPECT_EQ(data.numScreened(), data.numComponents());
+    // The screened components still contribute to the KKT residual.
+    EXPECT_TRUE(kkt_residual.isApprox(kkt_residual_ref));
+    constraints->condenseSlackAndDual(contact_status, data, kkt_matrix, kkt_residual);
+    EXPECT_TRUE(kkt_matrix.Qaa.isZero());
+    EXPECT_TRUE(kkt_matrix.Quu.isZero());
+    EXPECT_TRUE(kkt_residual.isApprox(kkt_residual_ref));
+    // The evaluation of the KKT residual does not change the screening.
+    kkt_residual.setZero();
+    constraints->evalKKTResidual(robot, contact_status, data, s, kkt_residual);
+    EXPECT_TRUE(kkt_residual.isApprox(kkt_residual_ref));
+    EXPECT_EQ(data.numScreened(), data.numComponents());
+  }
+  // Revalidation.
+  kkt_matrix.setZero();
+  kkt_residual.setZero();
+  constraints->linearizeConstraints(robot, contact_status, data, s, kkt_residual);
+  EXPECT_EQ(data.numScreened(), 0);
+  constraints->condenseSlackAndDual(contact_status, data, kkt_matrix, kkt_residual);
+  EXPECT_FALSE(kkt_matrix.Qaa.isZero());
+  EXPECT_FALSE(kkt_matrix.Quu.isZero());
+  // No components are screened with the screening disabled.
+  constraints->setActiveSetScreening(0.0);
+  EXPECT_FALSE(constraints->isActiveSetScreeningEnabled());
+  for (int i=0; i<revalidation_interval; ++i) {
+    constraints->linearizeConstraints(robot, contact_status, data, s, kkt_residual);
+    EXPECT_EQ(data.numScreened(), 0);
+  }
+}
+
 } // namespace robotoc
 
 
@@ -1,3 +1,5 @@
+#include <sstream>
+
 #include <gtest/gtest.h>
 
 #include "Eigen/Core"
@@ -33,6 +35,9 @@ protected:
   static void test_integrate(const Robot& robot, 
                             const ContactStatus& contact_status, 
                             const ImpactStatus& impact_status);
+  static void test_saveLoad(const Robot& robot, 
+                            const ContactStatus& contact_status, 
+                            const ImpactStatus& impact_status);
 
   double dt;
 };
@@ -282,6 +287,28 @@ void SplitSolutionTest::test_integrate(const Robot& robot,
 }
 
 
+void SplitSolutionTest::test_saveLoad(const Robot& robot, 
+                                      const ContactStatus& contact_status,
+                                      const ImpactStatus& impact_status) {
+  const SplitSolution s = SplitSolution::Random(robot, contact_status, impact_status);
+  std::stringstream ss;
+  BinaryOutputArchive oar(ss);
+  s.save(oar);
+  SplitSolution s_loaded;
+  BinaryInputArchive iar(ss);
+  s_loaded.load(iar);
+  EXPECT_TRUE(s_loaded.isApprox(s));
+  EXPECT_EQ(s_loaded.dimf(), s.dimf());
+  EXPECT_EQ(s_loaded.dims(), s.dims());
+  EXPECT_TRUE(s_loaded.isContactActive() == s.isContactActive());
+  SplitSolution s_from_robot(robot);
+  std::stringstream ss2(ss.str());
+  BinaryInputArchive iar2(ss2);
+  s_from_robot.load(iar2);
+  EXPECT_TRUE(s_from_robot.isApprox(s));
+}
+
+
 TEST_F(SplitSolutionTest, fixedBase) {
   auto robot_without_contacts = testhelper::CreateRobotManipulator();
   test(robot_without_contacts);
@@ -297,6 +324,7 @@ TEST_F(SplitSolutionTest, fixedBase) {
   impact_status.activateImpact(0);
   test(robot, impact_status);
   test(robot, contact_status, impact_status);
+  test_saveLoad(robot, contact_status, impact_status);
 }
 
 
@@ -321,6 +349,7 @@ TEST_F(SplitSolutionTest, floatingBase) {
   }
   test(robot, impact_status);
   test(robot, contact_status, impact_status);
+  test_saveLoad(robot, contact_status, impact_status);
 }
 
 
@@ -345,6 +374,7 @@ TEST_F(SplitSolutionTest, humanoidRobot) {
   }
   test(robot, impact_status);
   test(robot, contact_status, impact_status);
+  test_saveLoad(robot, contact_status, impact_status);
 }
 
 } // namespace robotoc
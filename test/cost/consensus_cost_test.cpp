@@ -0,0 +1,104 @@
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/cost/consensus_cost.hpp"
+#include "robotoc/cost/cost_function_data.hpp"
+#include "robotoc/core/split_solution.hpp"
+#include "robotoc/core/split_kkt_residual.hpp"
+#include "robotoc/core/split_kkt_matrix.hpp"
+
+#include "robot_factory.hpp"
+
+
+namespace robotoc {
+
+class ConsensusCostTest : public ::testing::TestWithParam<Robot> {
+protected:
+  virtual void SetUp() {
+    grid_info = GridInfo::Random();
+    grid_info_inactive = grid_info;
+    grid_info_inactive.t += 0.1;
+    penalty = std::abs(Eigen::VectorXd::Random(1)[0]);
+  }
+
+  virtual void TearDown() {
+  }
+
+  GridInfo grid_info, grid_info_inactive;
+  double penalty;
+};
+
+
+TEST_P(ConsensusCostTest, stageCost) {
+  auto robot = GetParam();
+  const int dimv = robot.dimv();
+  SplitKKTMatrix kkt_mat(robot);
+  SplitKKTResidual kkt_res(robot);
+  kkt_mat.Qxx.setRandom();
+  kkt_res.lx.setRandom();
+  auto kkt_mat_ref = kkt_mat;
+  auto kkt_res_ref = kkt_res;
+  const Eigen::VectorXd q_target = robot.generateFeasibleConfiguration();
+  const Eigen::VectorXd v_target = Eigen::VectorXd::Random(dimv); 
+  auto cost = std::make_shared<ConsensusCost>(robot, penalty);
+  cost->set_targets({grid_info.t}, {q_target}, {v_target});
+  EXPECT_EQ(cost->findTarget(grid_info), 0);
+  EXPECT_EQ(cost->findTarget(grid_info_inactive), -1);
+  CostFunctionData data(robot);
+  const auto contact_status = robot.createContactStatus();
+  const SplitSolution s = SplitSolution::Random(robot);
+  Eigen::VectorXd q_diff = Eigen::VectorXd::Zero(dimv); 
+  robot.subtractConfiguration(s.q, q_target, q_diff);
+  const double cost_ref = 0.5 * penalty * (q_diff.squaredNorm() 
+                                            + (s.v-v_target).squaredNorm());
+  EXPECT_DOUBLE_EQ(cost->evalStageCost(robot, contact_status, data, grid_info, s), cost_ref);
+  EXPECT_DOUBLE_EQ(cost->evalStageCost(robot, contact_status, data, grid_info_inactive, s), 0);
+  cost->evalStageCostDerivatives(robot, contact_status, data, grid_info, s, kkt_res);
+  Eigen::MatrixXd Jq_diff = Eigen::MatrixXd::Identity(dimv, dimv);
+  if (robot.hasFloatingBase()) {
+    robot.dSubtractConfiguration_dqf(s.q, q_target, Jq_diff);
+  }
+  kkt_res_ref.lq() += penalty * Jq_diff.transpose() * q_diff;
+  kkt_res_ref.lv() += penalty * (s.v-v_target);
+  EXPECT_TRUE(kkt_res.isApprox(kkt_res_ref));
+  cost->evalStageCostHessian(robot, contact_status, data, grid_info, s, kkt_mat);
+  kkt_mat_ref.Qqq() += penalty * Jq_diff.transpose() * Jq_diff;
+  kkt_mat_ref.Qvv().diagonal().array() += penalty;
+  EXPECT_TRUE(kkt_mat.isApprox(kkt_mat_ref));
+  EXPECT_DOUBLE_EQ(cost->evalTerminalCost(robot, data, grid_info, s), cost_ref);
+  const auto impact_status = robot.createImpactStatus();
+  EXPECT_DOUBLE_EQ(cost->evalImpactCost(robot, impact_status, data, grid_info, s), 0);
+  cost->clear_targets();
+  EXPECT_EQ(cost->findTarget(grid_info), -1);
+}
+
+
+TEST_P(ConsensusCostTest, invalidArguments) {
+  auto robot = GetParam();
+  EXPECT_THROW(ConsensusCost(robot, -1.0), std::out_of_range);
+  ConsensusCost cost(robot, penalty);
+  const Eigen::VectorXd q_target = robot.generateFeasibleConfiguration();
+  const Eigen::VectorXd v_target = Eigen::VectorXd::Random(robot.dimv()); 
+  EXPECT_THROW(cost.set_targets({0.0, 1.0}, {q_target}, {v_target}), std::out_of_range);
+  EXPECT_THROW(cost.set_targets({0.0}, {q_target}, {q_target}), std::out_of_range);
+  EXPECT_THROW(cost.set_penalty(-1.0), std::out_of_range);
+}
+
+
+INSTANTIATE_TEST_SUITE_P(
+  TestWithMultipleRobots, ConsensusCostTest, 
+  ::testing::Values(testhelper::CreateRobotManipulator(),
+                    testhelper::CreateQuadrupedalRobot())
+);
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,4 +1,5 @@
 #include <memory>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "Eigen/Core"
@@ -10,6 +11,7 @@
 #include "robotoc/core/split_solution.hpp"
 #include "robotoc/core/split_kkt_residual.hpp"
 #include "robotoc/core/split_kkt_matrix.hpp"
+#include "robotoc/utils/thread_pool.hpp"
 
 #include "robot_factory.hpp"
 
@@ -28,6 +30,8 @@ protected:
 
   void testStageCost(Robot& robot);
 
+  void testConstantHessian(Robot& robot);
+
   GridInfo grid_info;
   double dt, t0, t;
 };
@@ -84,15 +88,99 @@ void CostFunctionTest::testStageCost(Robot& robot) {
 }
 
 
+void CostFunctionTest::testConstantHessian(Robot& robot) {
+  const int dimv = robot.dimv();
+  const int dimu = robot.dimu();
+  auto config_cost = std::make_shared<ConfigurationSpaceCost>(robot);
+  config_cost->set_v_weight(Eigen::VectorXd::Random(dimv).array().abs());
+  config_cost->set_a_weight(Eigen::VectorXd::Random(dimv).array().abs());
+  config_cost->set_u_weight(Eigen::VectorXd::Random(dimu).array().abs());
+  config_cost->set_v_weight_terminal(Eigen::VectorXd::Random(dimv).array().abs());
+  config_cost->set_v_weight_impact(Eigen::VectorXd::Random(dimv).array().abs());
+  config_cost->set_dv_weight_impact(Eigen::VectorXd::Random(dimv).array().abs());
+  EXPECT_TRUE(config_cost->hasConstantHessian());
+  auto cost = std::make_shared<CostFunction>();
+  cost->push_back(config_cost);
+  auto contact_status = robot.createContactStatus();
+  contact_status.setRandom();
+  const auto s = SplitSolution::Random(robot, contact_status);
+  auto data = CostFunctionData(robot);
+  auto data_ref = CostFunctionData(robot);
+  auto testStage = [&]() {
+    SplitKKTMatrix kkt_mat(robot), kkt_mat_ref(robot);
+    SplitKKTResidual kkt_res(robot);
+    kkt_mat.Qxx.setRandom();
+    kkt_mat.Quu.setRandom();
+    kkt_mat_ref = kkt_mat;
+    cost->quadratizeStageCost(robot, contact_status, data, grid_info, s, 
+                              kkt_res, kkt_mat);
+    config_cost->evalStageCost(robot, contact_status, data_ref, grid_info, s);
+    config_cost->evalStageCostHessian(robot, contact_status, data_ref, 
+                                      grid_info, s, kkt_mat_ref);
+    EXPECT_TRUE(kkt_mat.isApprox(kkt_mat_ref));
+  };
+  // Builds and reuses the cached Hessian.
+  testStage();
+  grid_info.dt = 0.01 + std::abs(Eigen::VectorXd::Random(1)[0]);
+  testStage();
+  // The cache is invalidated by the change of the weight.
+  config_cost->set_v_weight(Eigen::VectorXd::Random(dimv).array().abs());
+  testStage();
+  SplitKKTMatrix kkt_mat(robot), kkt_mat_ref(robot);
+  SplitKKTResidual kkt_res(robot);
+  kkt_mat.Qxx.setRandom();
+  kkt_mat_ref = kkt_mat;
+  cost->quadratizeTerminalCost(robot, data, grid_info, s, kkt_res, kkt_mat);
+  config_cost->evalTerminalCost(robot, data_ref, grid_info, s);
+  config_cost->evalTerminalCostHessian(robot, data_ref, grid_info, s, 
+                                       kkt_mat_ref);
+  EXPECT_TRUE(kkt_mat.isApprox(kkt_mat_ref));
+  auto impact_status = robot.createImpactStatus();
+  impact_status.setRandom();
+  kkt_mat.Qxx.setRandom();
+  kkt_mat.Qdvdv.setRandom();
+  kkt_mat_ref = kkt_mat;
+  cost->quadratizeImpactCost(robot, impact_status, data, grid_info, s, 
+                             kkt_res, kkt_mat);
+  config_cost->evalImpactCost(robot, impact_status, data_ref, grid_info, s);
+  config_cost->evalImpactCostHessian(robot, impact_status, data_ref, grid_info, 
+                                     s, kkt_mat_ref);
+  EXPECT_TRUE(kkt_mat.isApprox(kkt_mat_ref));
+  // The cache is shared by the stages evaluated concurrently.
+  config_cost->set_a_weight(Eigen::VectorXd::Random(dimv).array().abs());
+  const int num_stages = 16;
+  std::vector<CostFunctionData> stage_data(num_stages, CostFunctionData(robot));
+  std::vector<SplitKKTMatrix> kkt_mats(num_stages, SplitKKTMatrix(robot));
+  std::vector<SplitKKTResidual> kkt_ress(num_stages, SplitKKTResidual(robot));
+  ThreadPool thread_pool(4);
+  thread_pool.parallelFor(num_stages, [&](const int i, const int thread_id) {
+    cost->quadratizeStageCost(robot, contact_status, stage_data[i], grid_info, 
+                              s, kkt_ress[i], kkt_mats[i]);
+  });
+  SplitKKTMatrix kkt_mat_stage_ref(robot);
+  config_cost->evalStageCostHessian(robot, contact_status, data_ref, grid_info, 
+                                    s, kkt_mat_stage_ref);
+  for (int i=0; i<num_stages; ++i) {
+    EXPECT_TRUE(kkt_mats[i].isApprox(kkt_mat_stage_ref));
+  }
+  // The Hessian of the configuration cost of the floating base is not constant.
+  config_cost->set_q_weight(Eigen::VectorXd::Random(dimv).array().abs());
+  EXPECT_EQ(config_cost->hasConstantHessian(), !robot.hasFloatingBase());
+  testStage();
+}
+
+
 TEST_F(CostFunctionTest, fixedBase) {
   auto robot = testhelper::CreateRobotManipulator(dt);
   testStageCost(robot);
+  testConstantHessian(robot);
 }
 
 
 TEST_F(CostFunctionTest, floatingBase) {
   auto robot = testhelper::CreateQuadrupedalRobot(dt);
   testStageCost(robot);
+  testConstantHessian(robot);
 }
 
 } // namespace robotoc
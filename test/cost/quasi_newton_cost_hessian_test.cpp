@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/cost/quasi_newton_cost_hessian.hpp"
+#include "robotoc/core/split_solution.hpp"
+#include "robotoc/core/split_kkt_residual.hpp"
+#include "robotoc/core/split_kkt_matrix.hpp"
+
+#include "robot_factory.hpp"
+
+
+namespace robotoc {
+
+class QuasiNewtonCostHessianTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    srand((unsigned int) time(0));
+    dt = std::abs(Eigen::VectorXd::Random(1)[0]) + 0.01;
+  }
+
+  virtual void TearDown() {
+  }
+
+  void test(const Robot& robot) const;
+
+  double dt;
+};
+
+
+TEST_F(QuasiNewtonCostHessianTest, dampedBFGSUpdate) {
+  const int dim = 10;
+  const Eigen::MatrixXd A = Eigen::MatrixXd::Random(dim, dim);
+  const Eigen::MatrixXd H = A * A.transpose() + Eigen::MatrixXd::Identity(dim, dim);
+  Eigen::MatrixXd B = Eigen::MatrixXd::Identity(dim, dim);
+  Eigen::VectorXd Bs = Eigen::VectorXd::Zero(dim);
+  // Secant condition with the positive curvature.
+  const Eigen::VectorXd s = Eigen::VectorXd::Random(dim);
+  const Eigen::VectorXd y = H * s;
+  QuasiNewtonCostHessian::dampedBFGSUpdate(s, y, B, Bs);
+  EXPECT_TRUE((B*s).isApprox(y));
+  EXPECT_TRUE(B.isApprox(B.transpose()));
+  // Positive definiteness is kept with the negative curvature.
+  const Eigen::VectorXd s2 = Eigen::VectorXd::Random(dim);
+  const Eigen::VectorXd y2 = - s2;
+  QuasiNewtonCostHessian::dampedBFGSUpdate(s2, y2, B, Bs);
+  EXPECT_TRUE(B.isApprox(B.transpose()));
+  EXPECT_TRUE(B.llt().info() == Eigen::Success);
+  // No update with the zero step.
+  const Eigen::MatrixXd B_ref = B;
+  QuasiNewtonCostHessian::dampedBFGSUpdate(Eigen::VectorXd::Zero(dim), y, B, Bs);
+  EXPECT_TRUE(B.isApprox(B_ref));
+}
+
+
+void QuasiNewtonCostHessianTest::test(const Robot& robot) const {
+  const int dimv = robot.dimv();
+  const int dimu = robot.dimu();
+  auto contact_status = robot.createContactStatus();
+  contact_status.setRandom();
+  const int dimf = contact_status.dimf();
+  // Quadratic cost whose Hessian is block-diagonal w.r.t. (x, u), a, and f.
+  const Eigen::MatrixXd Axu = Eigen::MatrixXd::Random(2*dimv+dimu, 2*dimv+dimu);
+  const Eigen::MatrixXd Hxu = Axu * Axu.transpose();
+  const Eigen::MatrixXd Aa = Eigen::MatrixXd::Random(dimv, dimv);
+  const Eigen::MatrixXd Ha = Aa * Aa.transpose();
+  const Eigen::MatrixXd Af = Eigen::MatrixXd::Random(dimf, dimf);
+  const Eigen::MatrixXd Hf = Af * Af.transpose();
+  auto evalCost = [&](const SplitSolution& s, SplitKKTResidual& kkt_residual, 
+                      SplitKKTMatrix& kkt_matrix) {
+    Eigen::VectorXd xu(2*dimv+dimu);
+    xu << s.q.tail(dimv), s.v, s.u;
+    const Eigen::VectorXd lxu = dt * Hxu * xu;
+    kkt_residual.lx = lxu.head(2*dimv);
+    kkt_residual.lu = lxu.tail(dimu);
+    kkt_residual.la = dt * Ha * s.a;
+    kkt_residual.lf() = dt * Hf * s.f_stack();
+    kkt_matrix.Qxx = dt * Hxu.topLeftCorner(2*dimv, 2*dimv);
+    kkt_matrix.Qxu = dt * Hxu.topRightCorner(2*dimv, dimu);
+    kkt_matrix.Quu = dt * Hxu.bottomRightCorner(dimu, dimu);
+    kkt_matrix.Qaa = dt * Ha;
+    kkt_matrix.Qff() = dt * Hf;
+  };
+  SplitKKTResidual kkt_residual(robot);
+  SplitKKTMatrix kkt_matrix(robot), kkt_matrix_ref(robot);
+  kkt_residual.setContactDimension(dimf);
+  kkt_matrix.setContactDimension(dimf);
+  kkt_matrix_ref.setContactDimension(dimf);
+  QuasiNewtonCostHessian hessian(robot);
+  EXPECT_FALSE(hessian.isInitialized(dimf));
+  auto s = SplitSolution::Random(robot, contact_status);
+  evalCost(s, kkt_residual, kkt_matrix_ref);
+  hessian.init(dt, s, kkt_residual, kkt_matrix_ref);
+  EXPECT_TRUE(hessian.isInitialized(dimf));
+  kkt_matrix.setZero();
+  hessian.addTo(kkt_matrix);
+  EXPECT_TRUE(kkt_matrix.isApprox(kkt_matrix_ref));
+  // The exact Hessian satisfies the secant condition and is kept. For 
+  // floating-base robots, the cost is not quadratic w.r.t. the difference of 
+  // the configurations and only the blocks of a and f are checked.
+  s = SplitSolution::Random(robot, contact_status);
+  evalCost(s, kkt_residual, kkt_matrix_ref);
+  hessian.update(robot, dt, s, kkt_residual);
+  kkt_matrix.setZero();
+  hessian.addTo(kkt_matrix);
+  if (!robot.hasFloatingBase()) {
+    EXPECT_TRUE(kkt_matrix.isApprox(kkt_matrix_ref));
+  }
+  EXPECT_TRUE(kkt_matrix.Qaa.isApprox(kkt_matrix_ref.Qaa));
+  EXPECT_TRUE(kkt_matrix.Qff().isApprox(kkt_matrix_ref.Qff()));
+  EXPECT_TRUE(kkt_matrix.Qxx.isApprox(kkt_matrix.Qxx.transpose()));
+  // The approximation is scaled with the time step.
+  const double dt_next = 2.0 * dt;
+  kkt_residual.lx *= 2.0;
+  kkt_residual.lu *= 2.0;
+  kkt_residual.la *= 2.0;
+  kkt_residual.lf() *= 2.0;
+  const Eigen::MatrixXd Qaa = kkt_matrix.Qaa;
+  hessian.update(robot, dt_next, s, kkt_residual);
+  kkt_matrix.setZero();
+  hessian.addTo(kkt_matrix);
+  EXPECT_TRUE(kkt_matrix.Qaa.isApprox(2.0*Qaa));
+  hessian.reset();
+  EXPECT_FALSE(hessian.isInitialized(dimf));
+}
+
+
+TEST_F(QuasiNewtonCostHessianTest, fixedBase) {
+  auto robot = testhelper::CreateRobotManipulator(dt);
+  test(robot);
+}
+
+
+TEST_F(QuasiNewtonCostHessianTest, floatingBase) {
+  auto robot = testhelper::CreateQuadrupedalRobot(dt);
+  test(robot);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -143,6 +143,32 @@ TEST_P(ImpactStageTest, evalKKT) {
 }
 
 
+TEST_P(ImpactStageTest, evalKKTResidual) {
+  auto robot = GetParam();
+  auto cost = testhelper::CreateCost(robot);
+  auto constraints = testhelper::CreateConstraints(robot);
+  auto contact_sequence = testhelper::CreateContactSequence(robot, N, max_num_impact, t0, event_period);
+  const auto impact_status = contact_sequence->impactStatus(grid_info.impact_index);
+  const auto s_prev = SplitSolution::Random(robot);
+  const auto s = SplitSolution::Random(robot, impact_status);
+  const auto s_next = SplitSolution::Random(robot);
+
+  ImpactStage stage(cost, constraints, contact_sequence);
+  auto data = stage.createData(robot);
+  SplitKKTMatrix kkt_matrix(robot);
+  SplitKKTResidual kkt_residual(robot);  
+  stage.initConstraints(robot, grid_info, s, data);
+  stage.evalKKTResidual(robot, grid_info, s_prev.q, s, s_next, data, kkt_matrix, kkt_residual);
+
+  auto data_ref = stage.createData(robot);
+  SplitKKTMatrix kkt_matrix_ref(robot);
+  SplitKKTResidual kkt_residual_ref(robot);  
+  stage.initConstraints(robot, grid_info, s, data_ref);
+  stage.evalKKT(robot, grid_info, s_prev.q, s, s_next, data_ref, kkt_matrix_ref, kkt_residual_ref);
+  EXPECT_TRUE(data.performance_index.isApprox(data_ref.performance_index));
+}
+
+
 INSTANTIATE_TEST_SUITE_P(
   TestWithMultipleRobots, ImpactStageTest, 
   ::testing::Values(testhelper::CreateRobotManipulator(0.01),
@@ -190,6 +190,89 @@ TEST_P(IntermediateStageTest, evalKKT) {
 }
 
 
+TEST_P(IntermediateStageTest, evalKKTResidual) {
+  auto robot = GetParam().first;
+  const bool switching_constraint = GetParam().second;
+  grid_info.switching_constraint = switching_constraint;
+  auto cost = testhelper::CreateCost(robot);
+  auto constraints = testhelper::CreateConstraints(robot);
+  auto contact_sequence = testhelper::CreateContactSequence(robot, N, max_num_impact, t0, event_period);
+  const auto contact_status = contact_sequence->contactStatus(grid_info.phase);
+  auto s_prev = SplitSolution::Random(robot);
+  auto s = SplitSolution::Random(robot, contact_status);
+  if (switching_constraint) {
+    const auto& impact_status = contact_sequence->impactStatus(grid_info.impact_index+1);
+    s.setSwitchingConstraintDimension(impact_status.dimf());
+    s.setRandom(robot);
+  }
+  const auto s_next = SplitSolution::Random(robot);
+
+  IntermediateStage stage(cost, constraints, contact_sequence);
+  auto data = stage.createData(robot);
+  SplitKKTMatrix kkt_matrix(robot);  
+  SplitKKTResidual kkt_residual(robot);  
+  stage.initConstraints(robot, grid_info, s, data);
+  stage.evalKKTResidual(robot, grid_info, s_prev.q, s, s_next, data, kkt_matrix, kkt_residual);
+
+  auto data_ref = stage.createData(robot);
+  SplitKKTMatrix kkt_matrix_ref(robot);  
+  SplitKKTResidual kkt_residual_ref(robot);  
+  stage.initConstraints(robot, grid_info, s, data_ref);
+  stage.evalKKT(robot, grid_info, s_prev.q, s, s_next, data_ref, kkt_matrix_ref, kkt_residual_ref);
+  EXPECT_TRUE(data.performance_index.isApprox(data_ref.performance_index));
+  EXPECT_TRUE(data.lu.isApprox(data_ref.lu));
+}
+
+
+TEST_P(IntermediateStageTest, hessianApproximation) {
+  auto robot = GetParam().first;
+  const bool switching_constraint = GetParam().second;
+  grid_info.switching_constraint = switching_constraint;
+  auto cost = testhelper::CreateCost(robot);
+  auto constraints = testhelper::CreateConstraints(robot);
+  auto contact_sequence = testhelper::CreateContactSequence(robot, N, max_num_impact, t0, event_period);
+  const auto contact_status = contact_sequence->contactStatus(grid_info.phase);
+  const auto s_prev = SplitSolution::Random(robot);
+  auto s = SplitSolution::Random(robot, contact_status);
+  if (switching_constraint) {
+    const auto& impact_status = contact_sequence->impactStatus(grid_info.impact_index+1);
+    s.setSwitchingConstraintDimension(impact_status.dimf());
+    s.setRandom(robot);
+  }
+  const auto s_next = SplitSolution::Random(robot);
+
+  IntermediateStage stage(cost, constraints, contact_sequence);
+  stage.setHessianApproximation(HessianApproximation::BFGS);
+  auto data = stage.createData(robot);
+  SplitKKTMatrix kkt_matrix(robot);  
+  SplitKKTResidual kkt_residual(robot);  
+  stage.initConstraints(robot, grid_info, s, data);
+  EXPECT_FALSE(data.cost_data.quasi_newton_hessian.isInitialized(contact_status.dimf()));
+  stage.evalKKT(robot, grid_info, s_prev.q, s, s_next, data, kkt_matrix, kkt_residual);
+  EXPECT_TRUE(data.cost_data.quasi_newton_hessian.isInitialized(contact_status.dimf()));
+
+  IntermediateStage stage_ref(cost, constraints, contact_sequence);
+  auto data_ref = stage_ref.createData(robot);
+  SplitKKTMatrix kkt_matrix_ref(robot);  
+  SplitKKTResidual kkt_residual_ref(robot);  
+  stage_ref.initConstraints(robot, grid_info, s, data_ref);
+  stage_ref.evalKKT(robot, grid_info, s_prev.q, s, s_next, data_ref, kkt_matrix_ref, kkt_residual_ref);
+  // The first iteration uses the exact Hessian of the cost.
+  EXPECT_TRUE(kkt_matrix.isApprox(kkt_matrix_ref));
+  EXPECT_TRUE(kkt_residual.isApprox(kkt_residual_ref));
+  EXPECT_TRUE(data.performance_index.isApprox(data_ref.performance_index));
+
+  // The KKT error is not affected by the Hessian approximation.
+  s.v.setRandom();
+  s.u.setRandom();
+  s.a.setRandom();
+  stage.evalKKT(robot, grid_info, s_prev.q, s, s_next, data, kkt_matrix, kkt_residual);
+  stage_ref.evalKKT(robot, grid_info, s_prev.q, s, s_next, data_ref, kkt_matrix_ref, kkt_residual_ref);
+  EXPECT_TRUE(data.performance_index.isApprox(data_ref.performance_index));
+  EXPECT_TRUE(data.lu.isApprox(data_ref.lu));
+}
+
+
 INSTANTIATE_TEST_SUITE_P(
   TestWithMultipleRobots, IntermediateStageTest, 
   ::testing::Values(std::make_pair(testhelper::CreateRobotManipulator(), false),
@@ -106,6 +106,30 @@ TEST_P(TerminalStageTest, evalKKT) {
 }
 
 
+TEST_P(TerminalStageTest, evalKKTResidual) {
+  auto robot = GetParam();
+  auto cost = testhelper::CreateCost(robot);
+  auto constraints = testhelper::CreateConstraints(robot);
+  auto contact_sequence = testhelper::CreateContactSequence(robot, N, max_num_impact, t0, event_period);
+  const SplitSolution s = SplitSolution::Random(robot);
+  const SplitSolution s_prev = SplitSolution::Random(robot);
+
+  TerminalStage stage(cost, constraints, contact_sequence);
+  auto data = stage.createData(robot);
+  SplitKKTResidual kkt_residual(robot);  
+  SplitKKTMatrix kkt_matrix(robot);  
+  stage.initConstraints(robot, grid_info, s, data);
+  stage.evalKKTResidual(robot, grid_info, s_prev.q, s, data, kkt_matrix, kkt_residual);
+
+  auto data_ref = stage.createData(robot);
+  SplitKKTResidual kkt_residual_ref(robot);  
+  SplitKKTMatrix kkt_matrix_ref(robot);  
+  stage.initConstraints(robot, grid_info, s, data_ref);
+  stage.evalKKT(robot, grid_info, s_prev.q, s, data_ref, kkt_matrix_ref, kkt_residual_ref);
+  EXPECT_TRUE(data.performance_index.isApprox(data_ref.performance_index));
+}
+
+
 INSTANTIATE_TEST_SUITE_P(
   TestWithMultipleRobots, TerminalStageTest, 
   ::testing::Values(testhelper::CreateRobotManipulator(),
@@ -91,6 +91,152 @@ TEST_P(TimeDiscretizationTest, constructor) {
 }
 
 
+TEST_P(TimeDiscretizationTest, discretizeGraded) {
+  const double grading_ratio = 1.1;
+  TimeDiscretization time_discretization(T, N, max_num_events, grading_ratio);
+  EXPECT_DOUBLE_EQ(time_discretization.gradingRatio(), grading_ratio);
+  double T_nominal = 0;
+  for (int i=0; i<N; ++i) {
+    T_nominal += time_discretization.nominalTimeStep(i);
+  }
+  EXPECT_NEAR(T_nominal, T, min_dt);
+  for (int i=0; i<N-1; ++i) {
+    EXPECT_NEAR(time_discretization.nominalTimeStep(i+1), 
+                grading_ratio*time_discretization.nominalTimeStep(i), min_dt);
+  }
+  const auto robot = GetParam();
+  auto contact_sequence = std::make_shared<ContactSequence>(robot, max_num_events);
+  ContactStatus contact_status = robot.createContactStatus();
+  contact_sequence->init(contact_status);
+  time_discretization.discretize(contact_sequence, t);
+  EXPECT_EQ(time_discretization.size(), N+1);
+  for (int i=0; i<N; ++i) {
+    EXPECT_NEAR(time_discretization[i].dt, time_discretization.nominalTimeStep(i), min_dt);
+    EXPECT_NEAR(time_discretization[i].t+time_discretization[i].dt, 
+                time_discretization[i+1].t, min_dt);
+  }
+  EXPECT_DOUBLE_EQ(time_discretization.front().t, t);
+  EXPECT_DOUBLE_EQ(time_discretization.back().t, t+T);
+  contact_sequence = createContactSequence(robot);
+  time_discretization.discretize(contact_sequence, t);
+  time_discretization.correctTimeSteps(contact_sequence, t);
+  const int size = time_discretization.size();
+  for (int i=0; i<size-1; ++i) {
+    if (time_discretization[i].type == GridType::Impact) {
+      EXPECT_DOUBLE_EQ(time_discretization[i].t, 
+                       contact_sequence->impactTime(time_discretization[i+1].impact_index));
+    }
+    else if (time_discretization[i].type == GridType::Lift) {
+      EXPECT_DOUBLE_EQ(time_discretization[i].t, 
+                       contact_sequence->liftTime(time_discretization[i].lift_index));
+    }
+    if (time_discretization[i].type != GridType::Impact) {
+      EXPECT_TRUE(time_discretization[i].dt > 0);
+      EXPECT_NEAR(time_discretization[i].t+time_discretization[i].dt, 
+                  time_discretization[i+1].t, min_dt);
+    }
+  }
+  EXPECT_DOUBLE_EQ(time_discretization.front().t, t);
+  EXPECT_DOUBLE_EQ(time_discretization.back().t, t+T);
+  EXPECT_THROW(TimeDiscretization(T, N, max_num_events, 0.0), std::out_of_range);
+}
+
+
+TEST_P(TimeDiscretizationTest, correctTimeStepsGraded) {
+  const double grading_ratio = 1.1;
+  TimeDiscretization time_discretization(T, N, max_num_events, grading_ratio);
+  const auto robot = GetParam();
+  // A switching time on the k-th graded grid.
+  const int k = N / 2;
+  double t_switch = t;
+  for (int i=0; i<k; ++i) {
+    t_switch += time_discretization.nominalTimeStep(i);
+  }
+  auto contact_sequence = std::make_shared<ContactSequence>(robot, max_num_events);
+  ContactStatus contact_status = robot.createContactStatus();
+  contact_sequence->init(contact_status);
+  contact_status.activateContact(0);
+  contact_sequence->push_back(contact_status, t_switch);
+  time_discretization.discretize(contact_sequence, t);
+  std::vector<GridInfo> grids;
+  for (int i=0; i<time_discretization.size(); ++i) {
+    grids.push_back(time_discretization[i]);
+  }
+  // The globally graded grids are recovered.
+  time_discretization.correctTimeSteps(contact_sequence, t);
+  ASSERT_EQ(time_discretization.size(), grids.size());
+  for (int i=0; i<time_discretization.size(); ++i) {
+    EXPECT_NEAR(time_discretization[i].t, grids[i].t, min_dt);
+    EXPECT_NEAR(time_discretization[i].dt, grids[i].dt, min_dt);
+  }
+  // The switching time is moved. The grids in each phase are still graded 
+  // with a constant ratio.
+  const double dt_switch = 0.3 * time_discretization.nominalTimeStep(k);
+  contact_sequence->setImpactTime(0, t_switch+dt_switch);
+  time_discretization.correctTimeSteps(contact_sequence, t);
+  double ratio_prev = 0;
+  for (int i=0; i<time_discretization.size()-2; ++i) {
+    const auto& grid = time_discretization[i];
+    const auto& grid_next = time_discretization[i+1];
+    EXPECT_NEAR(grid.t+grid.dt, grid_next.t, min_dt);
+    if (grid.phase == grid_next.phase && grid.type == GridType::Intermediate
+        && grid_next.type == GridType::Intermediate) {
+      const double ratio = grid_next.dt / grid.dt;
+      EXPECT_GT(ratio, 1.0);
+      if (ratio_prev > 0 && grid.stage_in_phase > 0) {
+        EXPECT_NEAR(ratio, ratio_prev, 1.0e-08);
+      }
+      ratio_prev = ratio;
+    }
+    else {
+      ratio_prev = 0;
+    }
+  }
+  EXPECT_DOUBLE_EQ(time_discretization.back().t, t+T);
+}
+
+
+TEST_P(TimeDiscretizationTest, moveBlocking) {
+  const int move_blocking_size = 3;
+  TimeDiscretization time_discretization(T, N, max_num_events);
+  EXPECT_EQ(time_discretization.moveBlockingSize(), 1);
+  EXPECT_THROW(time_discretization.setMoveBlockingSize(0), std::out_of_range);
+  const auto robot = GetParam();
+  const auto contact_sequence = createContactSequence(robot);
+  time_discretization.discretize(contact_sequence, t);
+  for (int i=0; i<time_discretization.size(); ++i) {
+    EXPECT_FALSE(time_discretization[i].move_blocked);
+  }
+  time_discretization.setMoveBlockingSize(move_blocking_size);
+  EXPECT_EQ(time_discretization.moveBlockingSize(), move_blocking_size);
+  time_discretization.discretize(contact_sequence, t);
+  time_discretization.correctTimeSteps(contact_sequence, t);
+  const int size = time_discretization.size();
+  EXPECT_FALSE(time_discretization[0].move_blocked);
+  int num_blocked_stages = 1;
+  bool has_blocked_stage = false;
+  for (int i=1; i<size; ++i) {
+    const auto& grid = time_discretization[i];
+    if (grid.move_blocked) {
+      has_blocked_stage = true;
+      const auto& grid_prev = time_discretization[i-1];
+      EXPECT_EQ(grid.type, GridType::Intermediate);
+      EXPECT_EQ(grid_prev.type, GridType::Intermediate);
+      EXPECT_EQ(grid.phase, grid_prev.phase);
+      EXPECT_FALSE(grid_prev.switching_constraint);
+      EXPECT_FALSE(grid.switching_constraint);
+      ++num_blocked_stages;
+      EXPECT_TRUE(num_blocked_stages <= move_blocking_size);
+    }
+    else {
+      num_blocked_stages = 1;
+    }
+  }
+  EXPECT_TRUE(has_blocked_stage);
+  EXPECT_FALSE(time_discretization.back().move_blocked);
+}
+
+
 // TEST_P(TimeDiscretizationTest, discretizeGridBased) {
 //   TimeDiscretization time_discretization(T, N, max_num_events);
 //   const auto robot = GetParam();
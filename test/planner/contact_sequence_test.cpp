@@ -1,5 +1,7 @@
 #include <vector>
 #include <random>
+#include <sstream>
+#include <deque>
 
 #include <gtest/gtest.h>
 #include "Eigen/Core"
@@ -36,6 +38,8 @@ protected:
   void test_pop_back(const Robot& robot) const;
   void test_pop_front(const Robot& robot) const;
   void test_setContactPlacements(const Robot& robot) const;
+  void test_saveLoad(const Robot& robot) const;
+  void test_rolling(const Robot& robot) const;
 
   int max_num_each_events;
 };
@@ -312,6 +316,106 @@ void ContactSequenceTest::test_setContactPlacements(const Robot& robot) const {
 }
 
 
+void ContactSequenceTest::test_saveLoad(const Robot& robot) const {
+  ContactSequence contact_sequence(robot, max_num_each_events);
+  auto pre_contact_status = robot.createContactStatus();
+  pre_contact_status.setRandom();
+  contact_sequence.init(pre_contact_status);
+  std::vector<DiscreteEvent> discrete_events = createDiscreteEvents(robot, pre_contact_status, 5);
+  std::vector<double> event_times = {0.1, 0.25, 0.5, 0.7, 0.9};
+  std::vector<bool> sto = {true, false, true, true, false};
+  for (int j=0; j<5; ++j) {
+    contact_sequence.push_back(discrete_events[j], event_times[j], sto[j]);
+  }
+  std::stringstream ss;
+  BinaryOutputArchive oar(ss);
+  contact_sequence.save(oar);
+  ContactSequence loaded(robot);
+  BinaryInputArchive iar(ss);
+  loaded.load(iar);
+  EXPECT_EQ(loaded.numContactPhases(), contact_sequence.numContactPhases());
+  EXPECT_EQ(loaded.numImpactEvents(), contact_sequence.numImpactEvents());
+  EXPECT_EQ(loaded.numLiftEvents(), contact_sequence.numLiftEvents());
+  EXPECT_EQ(loaded.reservedNumDiscreteEvents(), max_num_each_events);
+  for (int i=0; i<contact_sequence.numContactPhases(); ++i) {
+    EXPECT_TRUE(loaded.contactStatus(i) == contact_sequence.contactStatus(i));
+  }
+  for (int i=0; i<contact_sequence.numDiscreteEvents(); ++i) {
+    EXPECT_EQ(loaded.eventType(i), contact_sequence.eventType(i));
+    EXPECT_DOUBLE_EQ(loaded.eventTimes()[i], contact_sequence.eventTimes()[i]);
+  }
+  for (int i=0; i<contact_sequence.numImpactEvents(); ++i) {
+    EXPECT_TRUE(loaded.impactStatus(i) == contact_sequence.impactStatus(i));
+    EXPECT_EQ(loaded.isSTOEnabledImpact(i), contact_sequence.isSTOEnabledImpact(i));
+  }
+  for (int i=0; i<contact_sequence.numLiftEvents(); ++i) {
+    EXPECT_EQ(loaded.isSTOEnabledLift(i), contact_sequence.isSTOEnabledLift(i));
+  }
+}
+
+
+void ContactSequenceTest::test_rolling(const Robot& robot) const {
+  // Pushes back and pops front the discrete events as in MPC so that the 
+  // events wrap around the storage.
+  const int reserved_num_discrete_events = 2;
+  ContactSequence contact_sequence(robot, reserved_num_discrete_events);
+  auto contact_status = robot.createContactStatus();
+  contact_status.setRandom();
+  contact_sequence.init(contact_status);
+  std::deque<ContactStatus> contact_statuses = {contact_status};
+  std::deque<double> event_times;
+  std::deque<bool> is_impact;
+  double t = 0;
+  for (int i=0; i<50; ++i) {
+    if (contact_sequence.numDiscreteEvents() < 3) {
+      auto post_contact_status = robot.createContactStatus();
+      DiscreteEvent discrete_event(contact_statuses.back(), post_contact_status);
+      while (!discrete_event.existDiscreteEvent()) {
+        post_contact_status.setRandom();
+        discrete_event.setDiscreteEvent(contact_statuses.back(), post_contact_status);
+      }
+      t += 0.1;
+      contact_sequence.push_back(discrete_event, t);
+      contact_statuses.push_back(discrete_event.postContactStatus());
+      event_times.push_back(t);
+      is_impact.push_back(discrete_event.existImpact());
+    }
+    else {
+      contact_sequence.pop_front();
+      contact_statuses.pop_front();
+      event_times.pop_front();
+      is_impact.pop_front();
+    }
+    ASSERT_EQ(contact_sequence.numContactPhases(), contact_statuses.size());
+    for (int phase=0; phase<contact_statuses.size(); ++phase) {
+      EXPECT_TRUE(contact_sequence.contactStatus(phase) == contact_statuses[phase]);
+    }
+    int impact_index = 0;
+    int lift_index = 0;
+    for (int event_index=0; event_index<event_times.size(); ++event_index) {
+      EXPECT_DOUBLE_EQ(contact_sequence.eventTimes()[event_index], event_times[event_index]);
+      if (is_impact[event_index]) {
+        EXPECT_EQ(contact_sequence.eventType(event_index), DiscreteEventType::Impact);
+        EXPECT_DOUBLE_EQ(contact_sequence.impactTime(impact_index), event_times[event_index]);
+        ++impact_index;
+      }
+      else {
+        EXPECT_EQ(contact_sequence.eventType(event_index), DiscreteEventType::Lift);
+        EXPECT_DOUBLE_EQ(contact_sequence.liftTime(lift_index), event_times[event_index]);
+        ++lift_index;
+      }
+    }
+    EXPECT_EQ(contact_sequence.numImpactEvents(), impact_index);
+    EXPECT_EQ(contact_sequence.numLiftEvents(), lift_index);
+    if (contact_sequence.numImpactEvents() > 0) {
+      contact_sequence.setImpactTime(0, contact_sequence.impactTime(0));
+    }
+    EXPECT_TRUE(contact_sequence.isEventTimeConsistent());
+  }
+  EXPECT_EQ(contact_sequence.reservedNumDiscreteEvents(), 3);
+}
+
+
 TEST_F(ContactSequenceTest, fixedBase) {
   const double dt = 0.001;
   auto robot = testhelper::CreateRobotManipulator(dt);
@@ -321,6 +425,8 @@ TEST_F(ContactSequenceTest, fixedBase) {
   test_pop_back(robot);
   test_pop_front(robot);
   test_setContactPlacements(robot);
+  test_saveLoad(robot);
+  test_rolling(robot);
 }
 
 
@@ -333,6 +439,8 @@ TEST_F(ContactSequenceTest, floatingBase) {
   test_pop_back(robot);
   test_pop_front(robot);
   test_setContactPlacements(robot);
+  test_saveLoad(robot);
+  test_rolling(robot);
 }
 
 } // namespace robotoc
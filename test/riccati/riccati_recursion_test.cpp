@@ -12,6 +12,11 @@
 #include "robotoc/riccati/lqr_policy.hpp"
 #include "robotoc/riccati/riccati_factorizer.hpp"
 #include "robotoc/riccati/riccati_recursion.hpp"
+#include "robotoc/riccati/riccati_factorization.hpp"
+#include "robotoc/core/kkt_matrix.hpp"
+#include "robotoc/core/kkt_residual.hpp"
+#include "robotoc/core/direction.hpp"
+#include "robotoc/ocp/time_discretization.hpp"
 
 #include "test_helper.hpp"
 #include "robot_factory.hpp"
@@ -63,6 +68,77 @@ TEST_P(RiccatiRecursionTest, riccatiRecursion) {
 }
 
 
+TEST_P(RiccatiRecursionTest, moveBlocking) {
+  const auto robot = GetParam();
+  auto cost = testhelper::CreateCost(robot);
+  auto constraints = testhelper::CreateConstraints(robot);
+  const auto contact_sequence = createContactSequence(robot);
+  const int move_blocking_size = 2;
+  TimeDiscretization time_discretization(T, N, 3*max_num_impact);
+  time_discretization.setMoveBlockingSize(move_blocking_size);
+  time_discretization.discretize(contact_sequence, t);
+  OCP ocp(robot, cost, constraints, contact_sequence, T, N, 3*max_num_impact);
+  DirectMultipleShooting dms(ocp, nthreads);
+  aligned_vector<Robot> robots(nthreads, robot);
+  const Eigen::VectorXd q = robot.generateFeasibleConfiguration();
+  const Eigen::VectorXd v = Eigen::VectorXd::Random(robot.dimv());
+  auto s = testhelper::CreateSolution(robot, contact_sequence, time_discretization);
+  const int size = N+1+3*max_num_impact;
+  KKTMatrix kkt_matrix(size, SplitKKTMatrix(robot));
+  KKTResidual kkt_residual(size, SplitKKTResidual(robot));
+  Direction d(size, SplitDirection(robot));
+  RiccatiFactorization factorization(size+1, SplitRiccatiFactorization(robot));
+  dms.initConstraints(robots, time_discretization, s);
+  dms.evalKKT(robots, time_discretization, q, v, s, kkt_matrix, kkt_residual);
+  const auto kkt_matrix_ref = kkt_matrix;
+  const auto kkt_residual_ref = kkt_residual;
+  RiccatiRecursion riccati_recursion(ocp);
+  riccati_recursion.backwardRiccatiRecursion(time_discretization, kkt_matrix, 
+                                             kkt_residual, factorization);
+  dms.computeInitialStateDirection(robots[0], q, v, s, d);
+  riccati_recursion.forwardRiccatiRecursion(time_discretization, kkt_matrix, 
+                                            kkt_residual, factorization, d);
+  // The blocked stages share the control input direction.
+  const int num_grids = time_discretization.size() - 1;
+  int num_blocked_stages = 0;
+  for (int i=1; i<num_grids; ++i) {
+    if (time_discretization[i].move_blocked) {
+      EXPECT_TRUE(d[i].du.isApprox(d[i-1].du));
+      ++num_blocked_stages;
+    }
+  }
+  EXPECT_GT(num_blocked_stages, 0);
+  // The direction satisfies the linearized KKT conditions, in which the 
+  // stationarity conditions w.r.t. the shared control input are summed up 
+  // over each block.
+  const double tol = 1.0e-06;
+  Eigen::VectorXd lu_block = Eigen::VectorXd::Zero(robot.dimu());
+  for (int i=0; i<num_grids; ++i) {
+    const auto& grid = time_discretization[i];
+    if (grid.type == GridType::Impact || grid.switching_constraint) {
+      continue;
+    }
+    const auto& kkt_mat = kkt_matrix_ref[i];
+    const auto& kkt_res = kkt_residual_ref[i];
+    Eigen::VectorXd dx_next = kkt_res.Fx + kkt_mat.Fxx * d[i].dx;
+    dx_next.tail(robot.dimv()).noalias() += kkt_mat.Fvu * d[i].du;
+    EXPECT_LE((dx_next-d[i+1].dx).lpNorm<Eigen::Infinity>(), tol);
+    Eigen::VectorXd lx = kkt_res.lx + kkt_mat.Qxx * d[i].dx 
+                          + kkt_mat.Qxu * d[i].du 
+                          + kkt_mat.Fxx.transpose() * d[i+1].dlmdgmm 
+                          - d[i].dlmdgmm;
+    EXPECT_LE(lx.lpNorm<Eigen::Infinity>(), tol);
+    lu_block.noalias() += kkt_res.lu + kkt_mat.Qxu.transpose() * d[i].dx 
+                          + kkt_mat.Quu * d[i].du 
+                          + kkt_mat.Fvu.transpose() * d[i+1].dgmm();
+    if (!time_discretization[i+1].move_blocked) {
+      EXPECT_LE(lu_block.lpNorm<Eigen::Infinity>(), tol);
+      lu_block.setZero();
+    }
+  }
+}
+
+
 INSTANTIATE_TEST_SUITE_P(
   TestWithMultipleRobots, RiccatiRecursionTest, 
   ::testing::Values(testhelper::CreateRobotManipulator(),
@@ -0,0 +1,154 @@
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+#include "Eigen/Core"
+#include "pinocchio/multibody/model.hpp"
+#include "pinocchio/parsers/urdf.hpp"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/robot/codegen_kernels.hpp"
+
+#include "urdf_factory.hpp"
+
+
+namespace robotoc {
+
+class CodeGenKernelsTest : public ::testing::TestWithParam<RobotModelInfo> {
+protected:
+  using Vector6d = Eigen::Matrix<double, 6, 1>;
+
+  virtual void SetUp() {
+    srand((unsigned int) time(0));
+  }
+
+  virtual void TearDown() {
+  }
+};
+
+
+TEST_P(CodeGenKernelsTest, RNEA) {
+  const auto model_info = GetParam();
+  Robot robot(model_info);
+  Robot robot_ref(model_info);
+  EXPECT_FALSE(robot.hasCodeGenKernels());
+  const std::string library_name = "codegen_kernels_test_" + std::to_string(robot.dimv())
+                                    + "_" + std::to_string(robot.maxNumContacts());
+  robot.generateCodeGenKernels(library_name);
+  EXPECT_TRUE(robot.hasCodeGenKernels());
+  const Robot robot_copy = robot;
+  EXPECT_TRUE(robot_copy.hasCodeGenKernels());
+
+  const Eigen::VectorXd q = robot.generateFeasibleConfiguration();
+  const Eigen::VectorXd v = Eigen::VectorXd::Random(robot.dimv());
+  const Eigen::VectorXd a = Eigen::VectorXd::Random(robot.dimv());
+  std::vector<Vector6d> f(robot.maxNumContacts(), Vector6d::Random());
+  auto contact_status = robot.createContactStatus();
+  contact_status.setRandom();
+  robot.setContactForces(contact_status, f);
+  robot_ref.setContactForces(contact_status, f);
+
+  Eigen::VectorXd tau = Eigen::VectorXd::Zero(robot.dimv());
+  Eigen::VectorXd tau_ref = Eigen::VectorXd::Zero(robot.dimv());
+  robot.RNEA(q, v, a, tau);
+  robot_ref.RNEA(q, v, a, tau_ref);
+  EXPECT_TRUE(tau.isApprox(tau_ref));
+
+  const int dimv = robot.dimv();
+  Eigen::MatrixXd dRNEA_dq = Eigen::MatrixXd::Zero(dimv, dimv);
+  Eigen::MatrixXd dRNEA_dv = Eigen::MatrixXd::Zero(dimv, dimv);
+  Eigen::MatrixXd dRNEA_da = Eigen::MatrixXd::Zero(dimv, dimv);
+  Eigen::MatrixXd dRNEA_dq_ref = dRNEA_dq;
+  Eigen::MatrixXd dRNEA_dv_ref = dRNEA_dv;
+  Eigen::MatrixXd dRNEA_da_ref = dRNEA_da;
+  robot.RNEADerivatives(q, v, a, dRNEA_dq, dRNEA_dv, dRNEA_da);
+  robot_ref.RNEADerivatives(q, v, a, dRNEA_dq_ref, dRNEA_dv_ref, dRNEA_da_ref);
+  EXPECT_TRUE(dRNEA_dq.isApprox(dRNEA_dq_ref));
+  EXPECT_TRUE(dRNEA_dv.isApprox(dRNEA_dv_ref));
+  EXPECT_TRUE(dRNEA_da.isApprox(dRNEA_da_ref));
+
+  auto impact_status = robot.createImpactStatus();
+  impact_status.setRandom();
+  robot.setImpactForces(impact_status, f);
+  robot_ref.setImpactForces(impact_status, f);
+  robot.RNEAImpact(q, a, tau);
+  robot_ref.RNEAImpact(q, a, tau_ref);
+  EXPECT_TRUE(tau.isApprox(tau_ref));
+  robot.RNEAImpactDerivatives(q, a, dRNEA_dq, dRNEA_da);
+  robot_ref.RNEAImpactDerivatives(q, a, dRNEA_dq_ref, dRNEA_da_ref);
+  EXPECT_TRUE(dRNEA_dq.isApprox(dRNEA_dq_ref));
+  EXPECT_TRUE(dRNEA_da.isApprox(dRNEA_da_ref));
+
+  Robot robot_loaded(model_info);
+  robot_loaded.loadCodeGenKernels(library_name);
+  EXPECT_TRUE(robot_loaded.hasCodeGenKernels());
+  EXPECT_THROW(robot_loaded.loadCodeGenKernels(library_name + "_not_found"),
+               std::runtime_error);
+}
+
+
+TEST_F(CodeGenKernelsTest, otherModel) {
+  Robot manipulator(RobotModelInfo::Manipulator(testhelper::RobotManipulatorURDF()));
+  const std::string library_name = "codegen_kernels_test_other_model";
+  manipulator.generateCodeGenKernels(library_name);
+  Robot quadruped(RobotModelInfo::Quadruped(testhelper::QuadrupedURDF(), {}));
+  EXPECT_THROW(quadruped.loadCodeGenKernels(library_name), std::runtime_error);
+  EXPECT_FALSE(quadruped.hasCodeGenKernels());
+}
+
+
+TEST_F(CodeGenKernelsTest, otherImpactModel) {
+  pinocchio::Model model;
+  pinocchio::urdf::buildModel(testhelper::RobotManipulatorURDF(), model);
+  pinocchio::Model impact_model = model;
+  impact_model.gravity.linear().setZero();
+  // The impact kernels are generated with the gravity, which is detected 
+  // only by the validation of the impact kernels.
+  const std::string library_name = "codegen_kernels_test_other_impact_model";
+  CodeGenKernels::generate(model, model, library_name, "/usr/bin/gcc");
+  CodeGenKernels kernels;
+  EXPECT_THROW(kernels.load(model, impact_model, library_name), 
+               std::runtime_error);
+  EXPECT_FALSE(kernels.isLoaded());
+  kernels.load(model, model, library_name);
+  EXPECT_TRUE(kernels.isLoaded());
+}
+
+
+auto manipulatorInfo = [](const bool contact) {
+  auto info = RobotModelInfo::Manipulator(testhelper::RobotManipulatorURDF());
+  if (contact) {
+    info.point_contacts.push_back(ContactModelInfo("iiwa_link_ee_kuka", 0.1));
+  }
+  return info;
+};
+
+
+auto quadrupedInfo = [](const bool contact) {
+  std::vector<ContactModelInfo> point_contacts;
+  if (contact) {
+    point_contacts.push_back(ContactModelInfo("LF_FOOT", 0.1));
+    point_contacts.push_back(ContactModelInfo("LH_FOOT", 0.1));
+    point_contacts.push_back(ContactModelInfo("RF_FOOT", 0.1));
+    point_contacts.push_back(ContactModelInfo("RH_FOOT", 0.1));
+  }
+  return RobotModelInfo::Quadruped(testhelper::QuadrupedURDF(), point_contacts);
+};
+
+
+INSTANTIATE_TEST_SUITE_P(
+  TestWithMultipleRobots, CodeGenKernelsTest,
+  ::testing::Values(manipulatorInfo(false),
+                    manipulatorInfo(true),
+                    quadrupedInfo(false),
+                    quadrupedInfo(true))
+);
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,7 +1,11 @@
 #include <vector>
+#include <cmath>
 
 #include <gtest/gtest.h>
 
+#include "Eigen/Core"
+#include "Eigen/Geometry"
+
 #include "robotoc/robot/contact_status.hpp"
 
 
@@ -234,6 +238,40 @@ TEST_F(ContactStatusTest, deactivate2) {
   }
   checkContactStatusAvtiveByIndexAndByName(contact_status);
 }
+
+
+TEST_F(ContactStatusTest, frictionCone) {
+  ContactStatus contact_status(contact_types, contact_frame_names);
+  const Eigen::Vector3d f_world = Eigen::Vector3d::Random();
+  auto friction_cone_residual = [&](const double mu, const Eigen::Matrix3d& R) {
+    const Eigen::Vector3d f_local = R.transpose() * f_world;
+    Eigen::VectorXd res(5);
+    res << - f_local(2),
+           f_local(0) - mu * f_local(2) / std::sqrt(2),
+         - f_local(0) - mu * f_local(2) / std::sqrt(2),
+           f_local(1) - mu * f_local(2) / std::sqrt(2),
+         - f_local(1) - mu * f_local(2) / std::sqrt(2);
+    return res;
+  };
+  for (int i=0; i<contact_status.maxNumContacts(); ++i) {
+    EXPECT_TRUE((contact_status.frictionCone(i)*f_world).isApprox(
+        friction_cone_residual(0.7, Eigen::Matrix3d::Identity())));
+  }
+  const double mu = std::abs(Eigen::VectorXd::Random(1)[0]) + 0.1;
+  const Eigen::Matrix3d R = Eigen::Quaterniond::UnitRandom().toRotationMatrix();
+  const Eigen::Vector3d p = Eigen::Vector3d::Random();
+  contact_status.setFrictionCoefficient(3, mu);
+  contact_status.setContactPlacement(3, p, R);
+  EXPECT_TRUE((contact_status.frictionCone(3)*f_world).isApprox(
+      friction_cone_residual(mu, R)));
+  contact_status.setContactPlacement(contact_frame_names[5], p, R);
+  EXPECT_TRUE((contact_status.frictionCone(5)*f_world).isApprox(
+      friction_cone_residual(0.7, R)));
+  contact_status.setFrictionCoefficient(contact_frame_names[5], mu);
+  EXPECT_TRUE((contact_status.frictionCone(5)*f_world).isApprox(
+      friction_cone_residual(mu, R)));
+}
+
 } // namespace robotoc
 
 
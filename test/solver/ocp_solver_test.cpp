@@ -1,4 +1,7 @@
 #include <vector>
+#include <limits>
+#include <cstdio>
+#include <cmath>
 
 #include <gtest/gtest.h>
 
@@ -24,6 +27,97 @@
 
 namespace robotoc {
 
+// Terminal cost on the velocity whose reference is switched after the next
+// evaluation of the Hessian, i.e., after the next KKT evaluation. This makes 
+// the iterates after the switch worse than the iterate before it.
+class SwitchingTerminalVelocityCost final : public CostFunctionComponentBase {
+public:
+  SwitchingTerminalVelocityCost(const Robot& robot, const double weight)
+    : CostFunctionComponentBase(),
+      v_ref_(Eigen::VectorXd::Zero(robot.dimv())),
+      v_ref_next_(Eigen::VectorXd::Zero(robot.dimv())),
+      weight_(weight),
+      is_switching_(false) {
+  }
+
+  void set_v_ref(const Eigen::VectorXd& v_ref) {
+    v_ref_ = v_ref;
+    is_switching_ = false;
+  }
+
+  void switch_v_ref(const Eigen::VectorXd& v_ref_next) {
+    v_ref_next_ = v_ref_next;
+    is_switching_ = true;
+  }
+
+  double evalStageCost(Robot& robot, const ContactStatus& contact_status, 
+                       CostFunctionData& data, const GridInfo& grid_info, 
+                       const SplitSolution& s) const override {
+    return 0.0;
+  }
+
+  void evalStageCostDerivatives(Robot& robot, const ContactStatus& contact_status, 
+                                CostFunctionData& data, const GridInfo& grid_info, 
+                                const SplitSolution& s, 
+                                SplitKKTResidual& kkt_residual) const override {
+  }
+
+  void evalStageCostHessian(Robot& robot, const ContactStatus& contact_status, 
+                            CostFunctionData& data, const GridInfo& grid_info, 
+                            const SplitSolution& s, 
+                            SplitKKTMatrix& kkt_matrix) const override {
+  }
+
+  double evalTerminalCost(Robot& robot, CostFunctionData& data, 
+                          const GridInfo& grid_info, 
+                          const SplitSolution& s) const override {
+    return 0.5 * weight_ * (s.v-v_ref_).squaredNorm();
+  }
+
+  void evalTerminalCostDerivatives(Robot& robot, CostFunctionData& data, 
+                                   const GridInfo& grid_info, 
+                                   const SplitSolution& s, 
+                                   SplitKKTResidual& kkt_residual) const override {
+    kkt_residual.lv().noalias() += weight_ * (s.v-v_ref_);
+  }
+
+  void evalTerminalCostHessian(Robot& robot, CostFunctionData& data, 
+                               const GridInfo& grid_info, 
+                               const SplitSolution& s, 
+                               SplitKKTMatrix& kkt_matrix) const override {
+    kkt_matrix.Qvv().diagonal().array() += weight_;
+    if (is_switching_) {
+      v_ref_ = v_ref_next_;
+      is_switching_ = false;
+    }
+  }
+
+  double evalImpactCost(Robot& robot, const ImpactStatus& impact_status, 
+                        CostFunctionData& data, const GridInfo& grid_info, 
+                        const SplitSolution& s) const override {
+    return 0.0;
+  }
+
+  void evalImpactCostDerivatives(Robot& robot, const ImpactStatus& impact_status, 
+                                 CostFunctionData& data, const GridInfo& grid_info, 
+                                 const SplitSolution& s, 
+                                 SplitKKTResidual& kkt_residual) const override {
+  }
+
+  void evalImpactCostHessian(Robot& robot, const ImpactStatus& impact_status, 
+                             CostFunctionData& data, const GridInfo& grid_info, 
+                             const SplitSolution& s, 
+                             SplitKKTMatrix& kkt_matrix) const override {
+  }
+
+private:
+  mutable Eigen::VectorXd v_ref_;
+  Eigen::VectorXd v_ref_next_;
+  double weight_;
+  mutable bool is_switching_;
+};
+
+
 class OCPSolverTest : public ::testing::Test {
 protected:
   virtual void SetUp() {
@@ -135,6 +229,148 @@ TEST_F(OCPSolverTest, test) {
   ocp_solver.solve(t, q, v);
   const auto result = ocp_solver.getSolverStatistics();
   EXPECT_TRUE(result.convergence);
+  EXPECT_FALSE(result.budget_exhausted);
+
+  solver_options.time_budget = std::numeric_limits<double>::min();
+  ocp_solver.setSolverOptions(solver_options);
+  ocp_solver.solve(t, q, v);
+  const auto result_budget = ocp_solver.getSolverStatistics();
+  EXPECT_TRUE(result_budget.budget_exhausted);
+  EXPECT_FALSE(result_budget.convergence);
+  EXPECT_EQ(result_budget.iter, 0);
+  EXPECT_FALSE(result_budget.best_iterate_restored);
+
+  // A budget that is not exhausted does not change the iterates.
+  ocp_solver.discretize(t);
+  ocp_solver.setSolution("q", q);
+  ocp_solver.setSolution("v", v);
+  ocp_solver.setSolution("f", f_init);
+  solver_options.time_budget = -1;
+  ocp_solver.setSolverOptions(solver_options);
+  ocp_solver.solve(t, q, v, true);
+  const auto result_no_budget = ocp_solver.getSolverStatistics();
+  const Eigen::VectorXd u_no_budget = ocp_solver.getSolution(0).u;
+  ocp_solver.discretize(t);
+  ocp_solver.setSolution("q", q);
+  ocp_solver.setSolution("v", v);
+  ocp_solver.setSolution("f", f_init);
+  solver_options.time_budget = 1.0e06;
+  ocp_solver.setSolverOptions(solver_options);
+  ocp_solver.solve(t, q, v, true);
+  const auto result_large_budget = ocp_solver.getSolverStatistics();
+  EXPECT_FALSE(result_large_budget.budget_exhausted);
+  EXPECT_FALSE(result_large_budget.best_iterate_restored);
+  EXPECT_EQ(result_large_budget.convergence, result_no_budget.convergence);
+  EXPECT_EQ(result_large_budget.iter, result_no_budget.iter);
+  EXPECT_TRUE(ocp_solver.getSolution(0).u.isApprox(u_no_budget));
+
+  // The best iterate is restored with its slack and dual variables, LQR 
+  // policies, and KKT error if the iterations are terminated without 
+  // convergence under the time budget. The terminal cost switched after the 
+  // first iteration makes the first iterate, i.e., the converged one, the 
+  // best.
+  auto terminal_cost = std::make_shared<SwitchingTerminalVelocityCost>(robot, 1.0);
+  auto cost_switching = std::make_shared<robotoc::CostFunction>();
+  cost_switching->push_back(config_cost);
+  cost_switching->push_back(local_contact_force_cost);
+  cost_switching->push_back(terminal_cost);
+  robotoc::OCP ocp_switching(robot, cost_switching, constraints, contact_sequence, T, N);
+  solver_options.time_budget = 1.0e06;
+  robotoc::OCPSolver ocp_solver_restore(ocp_switching, solver_options);
+  ocp_solver_restore.discretize(t);
+  ocp_solver_restore.setSolution("q", q);
+  ocp_solver_restore.setSolution("v", v);
+  ocp_solver_restore.setSolution("f", f_init);
+  ocp_solver_restore.solve(t, q, v);
+  ASSERT_TRUE(ocp_solver_restore.getSolverStatistics().convergence);
+  const auto s_converged = ocp_solver_restore.getSolution();
+  auto solver_options_restore = solver_options;
+  solver_options_restore.kkt_tol = 0.0;
+  solver_options_restore.max_iter = 1;
+  ocp_solver_restore.setSolverOptions(solver_options_restore);
+  // The LQR policies at the converged iterate.
+  auto ocp_solver_first = ocp_solver_restore;
+  ocp_solver_first.solve(t, q, v, false);
+  EXPECT_FALSE(ocp_solver_first.getSolverStatistics().best_iterate_restored);
+  solver_options_restore.max_iter = 2;
+  ocp_solver_restore.setSolverOptions(solver_options_restore);
+  terminal_cost->switch_v_ref(Eigen::VectorXd::Constant(robot.dimv(), 1.0));
+  ocp_solver_restore.solve(t, q, v, false);
+  const auto result_restore = ocp_solver_restore.getSolverStatistics();
+  EXPECT_FALSE(result_restore.convergence);
+  EXPECT_FALSE(result_restore.budget_exhausted);
+  ASSERT_EQ(result_restore.performance_index.size(), 2);
+  EXPECT_GT(result_restore.performance_index[1].kkt_error, 
+            result_restore.performance_index[0].kkt_error);
+  EXPECT_TRUE(result_restore.best_iterate_restored);
+  const auto& time_discretization_restore = ocp_solver_restore.getTimeDiscretization();
+  for (int i=0; i<time_discretization_restore.size(); ++i) {
+    EXPECT_TRUE(ocp_solver_restore.getSolution(i).isApprox(s_converged[i]));
+    EXPECT_TRUE(ocp_solver_restore.getLQRPolicy()[i].isApprox(ocp_solver_first.getLQRPolicy()[i]));
+  }
+  const double kkt_error_restored = ocp_solver_restore.KKTError();
+  EXPECT_DOUBLE_EQ(kkt_error_restored, 
+                   std::sqrt(result_restore.performance_index[0].kkt_error));
+  // The KKT error re-evaluated at the restored iterate, which includes the 
+  // restored slack and dual variables, for the cost before the switch.
+  terminal_cost->set_v_ref(Eigen::VectorXd::Zero(robot.dimv()));
+  EXPECT_NEAR(ocp_solver_restore.KKTError(t, q, v), kkt_error_restored, 
+              1.0e-06 + 1.0e-03 * kkt_error_restored);
+
+  // Cache the converged solver state and restart another solver warm.
+  solver_options.time_budget = -1;
+  ocp_solver.setSolverOptions(solver_options);
+  ocp_solver.solve(t, q, v);
+  ASSERT_TRUE(ocp_solver.getSolverStatistics().convergence);
+  const std::string filename = "ocp_solver_test_state.bin";
+  ocp_solver.saveSolverState(filename);
+  auto contact_sequence_warm = std::make_shared<robotoc::ContactSequence>(robot);
+  robotoc::OCP ocp_warm(robot, cost, constraints, contact_sequence_warm, T, N);
+  robotoc::OCPSolver ocp_solver_warm(ocp_warm, solver_options);
+  ocp_solver_warm.loadSolverState(filename);
+  std::remove(filename.c_str());
+  EXPECT_EQ(contact_sequence_warm->numContactPhases(), 
+            contact_sequence->numContactPhases());
+  EXPECT_EQ(ocp_solver_warm.getTimeDiscretization().size(), 
+            ocp_solver.getTimeDiscretization().size());
+  for (int i=0; i<ocp_solver.getTimeDiscretization().size(); ++i) {
+    EXPECT_TRUE(ocp_solver_warm.getSolution(i).isApprox(ocp_solver.getSolution(i)));
+    EXPECT_TRUE(ocp_solver_warm.getLQRPolicy()[i].isApprox(ocp_solver.getLQRPolicy()[i]));
+  }
+  ocp_solver_warm.solve(t, q, v, false);
+  const auto result_warm = ocp_solver_warm.getSolverStatistics();
+  EXPECT_TRUE(result_warm.convergence);
+  EXPECT_LE(result_warm.iter, 1);
+  EXPECT_THROW(ocp_solver_warm.loadSolverState(filename), std::runtime_error);
+
+  // Solve the move-blocked OCP. The blocked stages share the control input.
+  solver_options.move_blocking_size = 3;
+  robotoc::OCPSolver ocp_solver_blocked(ocp, solver_options);
+  ocp_solver_blocked.discretize(t);
+  ocp_solver_blocked.setSolution("q", q);
+  ocp_solver_blocked.setSolution("v", v);
+  ocp_solver_blocked.setSolution("f", f_init);
+  ocp_solver_blocked.solve(t, q, v);
+  const auto result_blocked = ocp_solver_blocked.getSolverStatistics();
+  EXPECT_TRUE(result_blocked.convergence);
+  EXPECT_LE(ocp_solver_blocked.KKTError(), solver_options.kkt_tol);
+  const auto& time_discretization_blocked = ocp_solver_blocked.getTimeDiscretization();
+  int num_blocked_stages = 0;
+  for (int i=1; i<time_discretization_blocked.size()-1; ++i) {
+    if (time_discretization_blocked[i].move_blocked) {
+      EXPECT_TRUE(ocp_solver_blocked.getSolution(i).u.isApprox(
+                      ocp_solver_blocked.getSolution(i-1).u));
+      ++num_blocked_stages;
+    }
+  }
+  EXPECT_GT(num_blocked_stages, 0);
+  // The KKT residual re-evaluated at the solution, in which the stationarity
+  // conditions are summed up over each block, is consistent with the 
+  // convergence.
+  EXPECT_LE(ocp_solver_blocked.KKTError(t, q, v), solver_options.kkt_tol);
+  ocp_solver_blocked.solve(t, q, v, false);
+  EXPECT_TRUE(ocp_solver_blocked.getSolverStatistics().convergence);
+  EXPECT_LE(ocp_solver_blocked.getSolverStatistics().iter, 1);
 }
 
 } // namespace robotoc
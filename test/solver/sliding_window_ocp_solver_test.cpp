@@ -0,0 +1,131 @@
+#include <vector>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "robotoc/solver/sliding_window_ocp_solver.hpp"
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/planner/contact_sequence.hpp"
+#include "robotoc/cost/cost_function.hpp"
+#include "robotoc/cost/configuration_space_cost.hpp"
+#include "robotoc/constraints/constraints.hpp"
+#include "robotoc/constraints/joint_position_lower_limit.hpp"
+#include "robotoc/constraints/joint_position_upper_limit.hpp"
+#include "robotoc/solver/solver_options.hpp"
+
+#include "robot_factory.hpp"
+
+
+namespace robotoc {
+
+class SlidingWindowOCPSolverTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    robot = testhelper::CreateRobotManipulator();
+    auto cost = std::make_shared<CostFunction>();
+    auto config_cost = std::make_shared<ConfigurationSpaceCost>(robot);
+    config_cost->set_q_ref(Eigen::VectorXd::Random(robot.dimq()));
+    config_cost->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 10));
+    config_cost->set_q_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 10));
+    config_cost->set_v_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.1));
+    config_cost->set_a_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+    cost->push_back(config_cost);
+    auto constraints = std::make_shared<Constraints>();
+    constraints->push_back(std::make_shared<JointPositionLowerLimit>(robot));
+    constraints->push_back(std::make_shared<JointPositionUpperLimit>(robot));
+    auto contact_sequence = std::make_shared<ContactSequence>(robot);
+    contact_sequence->init(robot.createContactStatus());
+    ocp = OCP(robot, cost, constraints, contact_sequence, T, N);
+    solver_options = SolverOptions();
+    solver_options.max_iter = 20;
+    settings = SlidingWindowSettings();
+    settings.num_overlap_grids = 4;
+    settings.max_admm_iter = 20;
+    q = robot.generateFeasibleConfiguration();
+    v = Eigen::VectorXd::Zero(robot.dimv());
+  }
+
+  virtual void TearDown() {
+  }
+
+  Robot robot;
+  OCP ocp;
+  SolverOptions solver_options;
+  SlidingWindowSettings settings;
+  Eigen::VectorXd q, v;
+  const double T = 0.5;
+  const int N = 20;
+  const double t = 0.1;
+  const double clip_length = 1.2;
+};
+
+
+TEST_F(SlidingWindowOCPSolverTest, solve) {
+  SlidingWindowOCPSolver solver(ocp, solver_options, settings);
+  solver.solve(t, q, v, clip_length);
+  // stride = (N - num_overlap_grids) * T / N = 0.4
+  EXPECT_EQ(solver.numWindows(), 3);
+  const auto times = solver.getTimes();
+  const auto q_sol = solver.getSolution("q");
+  const auto u_sol = solver.getSolution("u");
+  ASSERT_EQ(times.size(), q_sol.size());
+  ASSERT_EQ(times.size(), u_sol.size());
+  EXPECT_DOUBLE_EQ(times.front(), t);
+  EXPECT_GE(times.back(), t+clip_length);
+  for (int i=1; i<times.size(); ++i) {
+    EXPECT_GT(times[i], times[i-1]);
+  }
+  EXPECT_TRUE(q_sol.front().isApprox(q));
+  const double primal_residual = solver.primalResidual();
+
+  SlidingWindowSettings settings_no_admm = settings;
+  settings_no_admm.max_admm_iter = 0;
+  SlidingWindowOCPSolver solver_no_admm(ocp, solver_options, settings_no_admm);
+  solver_no_admm.solve(t, q, v, clip_length);
+  EXPECT_EQ(solver_no_admm.admmIter(), 0);
+  EXPECT_LT(primal_residual, solver_no_admm.primalResidual());
+}
+
+
+TEST_F(SlidingWindowOCPSolverTest, parallel) {
+  SlidingWindowOCPSolver solver(ocp, solver_options, settings);
+  solver.solve(t, q, v, clip_length);
+  auto settings_parallel = settings;
+  settings_parallel.nthreads = 3;
+  SlidingWindowOCPSolver solver_parallel(ocp, solver_options, settings_parallel);
+  solver_parallel.solve(t, q, v, clip_length);
+  EXPECT_EQ(solver.admmIter(), solver_parallel.admmIter());
+  const auto q_sol = solver.getSolution("q");
+  const auto q_sol_parallel = solver_parallel.getSolution("q");
+  ASSERT_EQ(q_sol.size(), q_sol_parallel.size());
+  for (int i=0; i<q_sol.size(); ++i) {
+    EXPECT_TRUE(q_sol[i].isApprox(q_sol_parallel[i]));
+  }
+}
+
+
+TEST_F(SlidingWindowOCPSolverTest, invalidArguments) {
+  auto settings_invalid = settings;
+  settings_invalid.num_overlap_grids = N/2;
+  EXPECT_THROW(SlidingWindowOCPSolver(ocp, solver_options, settings_invalid), 
+               std::out_of_range);
+  settings_invalid = settings;
+  settings_invalid.admm_penalty = 0;
+  EXPECT_THROW(SlidingWindowOCPSolver(ocp, solver_options, settings_invalid), 
+               std::out_of_range);
+  auto ocp_graded = ocp;
+  ocp_graded.grading_ratio = 1.1;
+  EXPECT_THROW(SlidingWindowOCPSolver(ocp_graded, solver_options, settings), 
+               std::out_of_range);
+  SlidingWindowOCPSolver solver(ocp, solver_options, settings);
+  EXPECT_THROW(solver.solve(t, q, v, 0.5*T), std::out_of_range);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,209 @@
+#include <vector>
+#include <string>
+#include <limits>
+#include <cstdio>
+
+#include <gtest/gtest.h>
+
+#include "robotoc/solver/warm_start_library.hpp"
+#include "robotoc/solver/ocp_solver.hpp"
+#include "robotoc/ocp/ocp.hpp"
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/planner/contact_sequence.hpp"
+#include "robotoc/cost/cost_function.hpp"
+#include "robotoc/cost/configuration_space_cost.hpp"
+#include "robotoc/cost/local_contact_force_cost.hpp"
+#include "robotoc/constraints/constraints.hpp"
+#include "robotoc/constraints/joint_position_lower_limit.hpp"
+#include "robotoc/constraints/joint_position_upper_limit.hpp"
+#include "robotoc/constraints/joint_velocity_lower_limit.hpp"
+#include "robotoc/constraints/joint_velocity_upper_limit.hpp"
+#include "robotoc/constraints/joint_torques_lower_limit.hpp"
+#include "robotoc/constraints/joint_torques_upper_limit.hpp"
+#include "robotoc/constraints/friction_cone.hpp"
+#include "robotoc/solver/solver_options.hpp"
+
+#include "robot_factory.hpp"
+
+
+namespace robotoc {
+
+class WarmStartLibraryTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+  }
+
+  virtual void TearDown() {
+  }
+};
+
+
+TEST_F(WarmStartLibraryTest, test) {
+  const double baumgarte_time_step = 0.5 / 20;
+  auto robot = testhelper::CreateQuadrupedalRobot(baumgarte_time_step);
+  const int LF_foot_id = 12;
+  const int LH_foot_id = 22;
+  const int RF_foot_id = 32;
+  const int RH_foot_id = 42;
+  const std::vector<int> contact_frames = {LF_foot_id, LH_foot_id, RF_foot_id, RH_foot_id}; 
+
+  // Create a cost function.
+  auto cost = std::make_shared<robotoc::CostFunction>();
+  Eigen::VectorXd q_standing(robot.dimq());
+  q_standing << 0, 0, 0.4792, 0, 0, 0, 1, 
+                -0.1,  0.7, -1.0, 
+                -0.1, -0.7,  1.0, 
+                 0.1,  0.7, -1.0, 
+                 0.1, -0.7,  1.0;
+  Eigen::VectorXd v_ref(robot.dimv());
+  v_ref << 0, 0, 0, 0, 0, 0, 
+           0, 0, 0, 
+           0, 0, 0, 
+           0, 0, 0, 
+           0, 0, 0;
+  auto config_cost = std::make_shared<robotoc::ConfigurationSpaceCost>(robot);
+  config_cost->set_q_weight(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_q_ref(q_standing);
+  config_cost->set_q_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 10));
+  config_cost->set_v_weight(Eigen::VectorXd::Constant(robot.dimv(), 1));
+  config_cost->set_v_weight_terminal(Eigen::VectorXd::Constant(robot.dimv(), 1));
+  config_cost->set_a_weight(Eigen::VectorXd::Constant(robot.dimv(), 0.01));
+  cost->push_back(config_cost);
+  auto local_contact_force_cost = std::make_shared<robotoc::LocalContactForceCost>(robot);
+  std::vector<Eigen::Vector3d> f_weight, f_ref;
+  for (int i=0; i<contact_frames.size(); ++i) {
+    Eigen::Vector3d fw; 
+    fw << 0.001, 0.001, 0.001;
+    f_weight.push_back(fw);
+    Eigen::Vector3d fr; 
+    fr << 0, 0, 70;
+    f_ref.push_back(fr);
+  }
+  local_contact_force_cost->set_f_weight(f_weight);
+  local_contact_force_cost->set_f_ref(f_ref);
+  cost->push_back(local_contact_force_cost);
+
+  // Create inequality constraints.
+  auto constraints = std::make_shared<robotoc::Constraints>();
+  auto joint_position_lower = std::make_shared<robotoc::JointPositionLowerLimit>(robot);
+  auto joint_position_upper = std::make_shared<robotoc::JointPositionUpperLimit>(robot);
+  auto joint_velocity_lower = std::make_shared<robotoc::JointVelocityLowerLimit>(robot);
+  auto joint_velocity_upper = std::make_shared<robotoc::JointVelocityUpperLimit>(robot);
+  auto joint_torques_lower  = std::make_shared<robotoc::JointTorquesLowerLimit>(robot);
+  auto joint_torques_upper  = std::make_shared<robotoc::JointTorquesUpperLimit>(robot);
+  auto friction_cone        = std::make_shared<robotoc::FrictionCone>(robot);
+  constraints->push_back(joint_position_lower);
+  constraints->push_back(joint_position_upper);
+  constraints->push_back(joint_velocity_lower);
+  constraints->push_back(joint_velocity_upper);
+  constraints->push_back(joint_torques_lower);
+  constraints->push_back(joint_torques_upper);
+  constraints->push_back(friction_cone);
+
+  // Create the contact sequence
+  auto contact_sequence = std::make_shared<robotoc::ContactSequence>(robot);
+
+  auto contact_status_standing = robot.createContactStatus();
+  contact_status_standing.activateContacts({0, 1, 2, 3});
+  robot.updateFrameKinematics(q_standing);
+  const std::vector<Eigen::Vector3d> contact_positions = {robot.framePosition(LF_foot_id), 
+                                                          robot.framePosition(LH_foot_id),
+                                                          robot.framePosition(RF_foot_id),
+                                                          robot.framePosition(RH_foot_id)};
+  contact_status_standing.setContactPlacements(contact_positions);
+  contact_sequence->init(contact_status_standing);
+
+  // Create OCPSolver
+  const double T = 0.5;
+  const int N = 20;
+  robotoc::OCP ocp(robot, cost, constraints, contact_sequence, T, N);
+  auto solver_options = robotoc::SolverOptions();
+  solver_options.nthreads = 4;
+  robotoc::OCPSolver ocp_solver(ocp, solver_options);
+
+  // Initial time and initial state
+  const double t = 0;
+  const Eigen::VectorXd q = q_standing;
+  const Eigen::VectorXd v = Eigen::VectorXd::Zero(robot.dimv());
+
+  // Cold start
+  auto contact_status_flying = robot.createContactStatus();
+  contact_sequence->push_back(contact_status_flying, 0.2);
+  ocp_solver.discretize(t);
+  ocp_solver.setSolution("q", q);
+  ocp_solver.setSolution("v", v);
+  Eigen::Vector3d f_init;
+  f_init << 0, 0, 0.25*robot.totalWeight();
+  ocp_solver.setSolution("f", f_init);
+  ocp_solver.solve(t, q, v);
+  const auto result_cold = ocp_solver.getSolverStatistics();
+  ASSERT_TRUE(result_cold.convergence);
+
+  // Lookup
+  WarmStartLibrary library(robot);
+  const auto contact_pattern = WarmStartLibrary::contactPattern(*contact_sequence);
+  EXPECT_EQ(contact_pattern.size(), 2*contact_status_standing.maxNumContacts());
+  const Eigen::VectorXd command = Eigen::VectorXd::Zero(3);
+  const WarmStartKey key("jump", contact_pattern, command);
+  EXPECT_EQ(library.findNearest(key), -1);
+  library.add(key, ocp_solver);
+  EXPECT_EQ(library.size(), 1);
+  library.add(key, ocp_solver);
+  EXPECT_EQ(library.size(), 1);
+  library.add(WarmStartKey("jump", contact_pattern, Eigen::VectorXd::Constant(3, 1.0)), 
+              ocp_solver.getTimeDiscretization(), ocp_solver.getSolution());
+  EXPECT_EQ(library.size(), 2);
+  EXPECT_EQ(library.findNearest(WarmStartKey("jump", contact_pattern, Eigen::VectorXd::Constant(3, 0.1))), 0);
+  EXPECT_EQ(library.findNearest(WarmStartKey("jump", contact_pattern, Eigen::VectorXd::Constant(3, 0.9))), 1);
+  EXPECT_EQ(library.findNearest(WarmStartKey("trot", contact_pattern, command)), -1);
+  EXPECT_EQ(library.findNearest(WarmStartKey("jump", std::vector<bool>(contact_pattern.size(), true), command)), -1);
+  library.setMaxCommandDistance(0.1);
+  EXPECT_EQ(library.findNearest(WarmStartKey("jump", contact_pattern, Eigen::VectorXd::Constant(3, 0.5))), -1);
+  EXPECT_THROW(library.setMaxCommandDistance(-1.0), std::out_of_range);
+  library.setMaxCommandDistance(std::numeric_limits<double>::infinity());
+
+  // Warm start at the shifted time and base position
+  const double t_shifted = 1.0;
+  Eigen::VectorXd q_shifted = q;
+  q_shifted(0) += 0.5;
+  q_shifted(1) -= 0.2;
+  std::vector<Eigen::Vector3d> contact_positions_shifted = contact_positions;
+  for (auto& e : contact_positions_shifted) {
+    e += q_shifted.head<3>() - q.head<3>();
+  }
+  contact_status_standing.setContactPlacements(contact_positions_shifted);
+  contact_sequence->init(contact_status_standing);
+  contact_sequence->push_back(contact_status_flying, t_shifted+0.2);
+  config_cost->set_q_ref(q_shifted);
+  EXPECT_TRUE(library.warmStart(key, t_shifted, q_shifted, ocp_solver));
+  EXPECT_TRUE(ocp_solver.getSolution(0).q.head<2>().isApprox(q_shifted.head<2>()));
+  ocp_solver.solve(t_shifted, q_shifted, v);
+  const auto result_warm = ocp_solver.getSolverStatistics();
+  EXPECT_TRUE(result_warm.convergence);
+  EXPECT_LE(result_warm.iter, result_cold.iter);
+
+  // Save and load
+  const std::string filename = "warm_start_library_test.bin";
+  library.save(filename);
+  WarmStartLibrary library_loaded;
+  library_loaded.load(filename);
+  std::remove(filename.c_str());
+  ASSERT_EQ(library_loaded.size(), library.size());
+  for (int i=0; i<library.size(); ++i) {
+    EXPECT_EQ(library_loaded.key(i).gait, library.key(i).gait);
+    EXPECT_TRUE(library_loaded.key(i).contact_pattern == library.key(i).contact_pattern);
+    EXPECT_TRUE(library_loaded.key(i).command.isApprox(library.key(i).command));
+  }
+  EXPECT_THROW(library_loaded.key(library.size()), std::out_of_range);
+  EXPECT_THROW(library_loaded.load(filename), std::runtime_error);
+  library_loaded.clear();
+  EXPECT_EQ(library_loaded.size(), 0);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,127 @@
+#include <vector>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/robot/se3.hpp"
+#include "robotoc/utils/batched_inverse_kinematics.hpp"
+
+#include "robot_factory.hpp"
+
+
+namespace robotoc {
+
+class BatchedInverseKinematicsTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    robot = testhelper::CreateQuadrupedalRobot();
+    base_frame_id = robot.frameId("base");
+    num_frames = 20;
+    q0 = robot.generateFeasibleConfiguration();
+    // Keypoints of a smooth clip generated by the forward kinematics.
+    Eigen::VectorXd v = Eigen::VectorXd::Random(robot.dimv());
+    const std::vector<int> contact_frames = robot.contactFrames();
+    q_ref_array.clear();
+    base_array.clear();
+    contact_position_arrays.assign(contact_frames.size(), 
+                                   std::vector<Eigen::Vector3d>());
+    Eigen::VectorXd q = q0;
+    for (int k=0; k<num_frames; ++k) {
+      robot.integrateConfiguration(v, 0.01, q);
+      robot.updateFrameKinematics(q);
+      q_ref_array.push_back(q);
+      base_array.push_back(robot.framePlacement(base_frame_id));
+      for (int i=0; i<contact_frames.size(); ++i) {
+        contact_position_arrays[i].push_back(robot.framePosition(contact_frames[i]));
+      }
+    }
+  }
+
+  virtual void TearDown() {
+  }
+
+  Robot robot;
+  int base_frame_id, num_frames;
+  Eigen::VectorXd q0;
+  std::vector<Eigen::VectorXd> q_ref_array;
+  std::vector<SE3> base_array;
+  std::vector<std::vector<Eigen::Vector3d>> contact_position_arrays;
+};
+
+
+TEST_F(BatchedInverseKinematicsTest, solve) {
+  for (const int nthreads : {1, 4}) {
+    BatchedInverseKinematics ik(robot, base_frame_id, nthreads);
+    InverseKinematicsSettings settings;
+    settings.max_iter = 100;
+    settings.tol = 1.0e-08;
+    ik.setSettings(settings);
+    const auto q_array = ik.solve(q0, base_array, contact_position_arrays);
+    ASSERT_EQ(q_array.size(), num_frames);
+    ASSERT_EQ(ik.getErrors().size(), num_frames);
+    const std::vector<int> contact_frames = robot.contactFrames();
+    for (int k=0; k<num_frames; ++k) {
+      EXPECT_LT(ik.getErrors()[k], settings.tol);
+      robot.updateFrameKinematics(q_array[k]);
+      EXPECT_TRUE(robot.framePlacement(base_frame_id).isApprox(base_array[k], 1.0e-06));
+      for (int i=0; i<contact_frames.size(); ++i) {
+        EXPECT_TRUE(robot.framePosition(contact_frames[i]).isApprox(
+                        contact_position_arrays[i][k], 1.0e-06));
+      }
+    }
+  }
+}
+
+
+TEST_F(BatchedInverseKinematicsTest, numThreads) {
+  BatchedInverseKinematics ik(robot, "base");
+  InverseKinematicsSettings settings;
+  settings.chunk_size = 6;
+  ik.setSettings(settings);
+  const auto q_array = ik.solve(q0, base_array, contact_position_arrays);
+  // The results are independent of the number of the threads.
+  for (const int nthreads : {2, 3, 4}) {
+    ik.setNumThreads(nthreads);
+    const auto q_array_parallel = ik.solve(q0, base_array, contact_position_arrays);
+    for (int k=0; k<num_frames; ++k) {
+      EXPECT_TRUE(q_array_parallel[k].isApprox(q_array[k]));
+    }
+  }
+  BatchedInverseKinematics ik_default;
+  EXPECT_THROW(ik_default.setNumThreads(2), std::runtime_error);
+}
+
+
+TEST_F(BatchedInverseKinematicsTest, invalidArguments) {
+  const auto manipulator = testhelper::CreateRobotManipulator();
+  EXPECT_THROW(BatchedInverseKinematics(manipulator, 0), std::out_of_range);
+  BatchedInverseKinematics ik(robot, base_frame_id);
+  EXPECT_THROW(ik.setNumThreads(0), std::out_of_range);
+  InverseKinematicsSettings settings;
+  settings.tol = 0;
+  EXPECT_THROW(ik.setSettings(settings), std::out_of_range);
+  settings = InverseKinematicsSettings();
+  settings.chunk_size = 0;
+  EXPECT_THROW(ik.setSettings(settings), std::out_of_range);
+  EXPECT_THROW(ik.solve(Eigen::VectorXd::Zero(robot.dimq()+1), base_array, 
+                        contact_position_arrays), std::out_of_range);
+  auto contact_position_arrays_invalid = contact_position_arrays;
+  contact_position_arrays_invalid.pop_back();
+  EXPECT_THROW(ik.solve(q0, base_array, contact_position_arrays_invalid), 
+               std::out_of_range);
+  contact_position_arrays_invalid = contact_position_arrays;
+  contact_position_arrays_invalid.back().pop_back();
+  EXPECT_THROW(ik.solve(q0, base_array, contact_position_arrays_invalid), 
+               std::out_of_range);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,168 @@
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "Eigen/Core"
+
+#include "robotoc/utils/binary_archive.hpp"
+
+
+namespace robotoc {
+
+class BinaryArchiveTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    srand((unsigned int) time(0));
+  }
+
+  virtual void TearDown() {
+  }
+};
+
+
+enum class TestEnum {
+  A,
+  B,
+  C,
+};
+
+
+TEST_F(BinaryArchiveTest, scalars) {
+  std::stringstream ss;
+  BinaryOutputArchive oar(ss);
+  oar.write(1.5);
+  oar.write(-3);
+  oar.write(true);
+  oar.write(false);
+  oar.write(TestEnum::C);
+  oar.writeSize(42);
+  BinaryInputArchive iar(ss);
+  EXPECT_EQ(iar.version(), BinaryOutputArchive::kVersion);
+  double d = 0;
+  int i = 0;
+  bool b1 = false, b2 = true;
+  TestEnum e = TestEnum::A;
+  iar.read(d);
+  iar.read(i);
+  iar.read(b1);
+  iar.read(b2);
+  iar.read(e);
+  EXPECT_DOUBLE_EQ(d, 1.5);
+  EXPECT_EQ(i, -3);
+  EXPECT_TRUE(b1);
+  EXPECT_FALSE(b2);
+  EXPECT_TRUE(e == TestEnum::C);
+  EXPECT_EQ(iar.readSize(), 42);
+  EXPECT_THROW(iar.read(d), std::runtime_error);
+}
+
+
+TEST_F(BinaryArchiveTest, eigen) {
+  const Eigen::VectorXd vec = Eigen::VectorXd::Random(7);
+  const Eigen::MatrixXd mat = Eigen::MatrixXd::Random(3, 5);
+  using MatrixXdRowMajor
+      = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  const MatrixXdRowMajor mat_row_major = MatrixXdRowMajor::Random(4, 2);
+  const Eigen::Matrix3d mat3 = Eigen::Matrix3d::Random();
+  const Eigen::VectorXd empty;
+  std::stringstream ss;
+  BinaryOutputArchive oar(ss);
+  oar.write(vec);
+  oar.write(mat);
+  oar.write(mat_row_major);
+  oar.write(mat3);
+  oar.write(empty);
+  oar.write(mat.topLeftCorner(2, 3));
+  oar.write(vec);
+  BinaryInputArchive iar(ss);
+  Eigen::VectorXd vec_loaded;
+  Eigen::MatrixXd mat_loaded, block_loaded;
+  MatrixXdRowMajor mat_row_major_loaded;
+  Eigen::Matrix3d mat3_loaded;
+  Eigen::VectorXd empty_loaded = Eigen::VectorXd::Random(3);
+  iar.read(vec_loaded);
+  iar.read(mat_loaded);
+  iar.read(mat_row_major_loaded);
+  iar.read(mat3_loaded);
+  iar.read(empty_loaded);
+  iar.read(block_loaded);
+  EXPECT_TRUE(vec_loaded.isApprox(vec));
+  EXPECT_TRUE(mat_loaded.isApprox(mat));
+  EXPECT_TRUE(mat_row_major_loaded.isApprox(mat_row_major));
+  EXPECT_TRUE(mat3_loaded.isApprox(mat3));
+  EXPECT_EQ(empty_loaded.size(), 0);
+  EXPECT_TRUE(block_loaded.isApprox(mat.topLeftCorner(2, 3)));
+  Eigen::Vector3d vec3;
+  EXPECT_THROW(iar.read(vec3), std::runtime_error);
+}
+
+
+TEST_F(BinaryArchiveTest, containers) {
+  const std::string str = "LF_FOOT";
+  const std::vector<bool> flags = {true, false, false, true, true};
+  const std::vector<double> values = {0.1, -0.2, 0.3};
+  const std::vector<Eigen::Vector3d> vecs = {Eigen::Vector3d::Random(),
+                                             Eigen::Vector3d::Random()};
+  const std::vector<std::string> strs = {"LF_FOOT", "", "RH_FOOT"};
+  const std::deque<double> deq = {1.0, 2.0};
+  std::stringstream ss;
+  BinaryOutputArchive oar(ss);
+  oar.write(str);
+  oar.write(flags);
+  oar.write(values);
+  oar.write(vecs);
+  oar.write(strs);
+  oar.write(deq);
+  BinaryInputArchive iar(ss);
+  std::string str_loaded;
+  std::vector<bool> flags_loaded;
+  std::vector<double> values_loaded;
+  std::vector<Eigen::Vector3d> vecs_loaded;
+  std::vector<std::string> strs_loaded;
+  std::deque<double> deq_loaded;
+  iar.read(str_loaded);
+  iar.read(flags_loaded);
+  iar.read(values_loaded);
+  iar.read(vecs_loaded);
+  iar.read(strs_loaded);
+  iar.read(deq_loaded);
+  EXPECT_EQ(str_loaded, str);
+  EXPECT_TRUE(flags_loaded == flags);
+  EXPECT_TRUE(values_loaded == values);
+  ASSERT_EQ(vecs_loaded.size(), vecs.size());
+  for (int i=0; i<vecs.size(); ++i) {
+    EXPECT_TRUE(vecs_loaded[i].isApprox(vecs[i]));
+  }
+  EXPECT_TRUE(strs_loaded == strs);
+  EXPECT_TRUE(deq_loaded == deq);
+}
+
+
+TEST_F(BinaryArchiveTest, header) {
+  std::stringstream empty;
+  EXPECT_THROW(BinaryInputArchive iar(empty), std::runtime_error);
+  std::stringstream invalid;
+  invalid << "this is not a robotoc archive";
+  EXPECT_THROW(BinaryInputArchive iar(invalid), std::runtime_error);
+  std::stringstream newer;
+  const std::uint32_t magic_number = BinaryOutputArchive::kMagicNumber;
+  const std::uint32_t version = BinaryOutputArchive::kVersion + 1;
+  newer.write(reinterpret_cast<const char*>(&magic_number), sizeof(magic_number));
+  newer.write(reinterpret_cast<const char*>(&version), sizeof(version));
+  EXPECT_THROW(BinaryInputArchive iar(newer), std::runtime_error);
+  std::stringstream valid;
+  BinaryOutputArchive oar(valid);
+  EXPECT_NO_THROW(BinaryInputArchive iar(valid));
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,308 @@
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "Eigen/Core"
+
+#include "robotoc/solver/solver_options.hpp"
+#include "robotoc/utils/binary_archive.hpp"
+#include "robotoc/utils/mpc_recorder.hpp"
+#include "robotoc/utils/mpc_benchmarker.hpp"
+
+
+namespace robotoc {
+
+// A deterministic mock of the interface of the MPC classes used by
+// MPCRecorder and benchmark::Replay().
+class MockMPC {
+public:
+  struct Statistics {
+    int iter = 0;
+  };
+
+  struct SplitSolution {
+    int dimf() const { return f.size(); }
+    const Eigen::VectorXd& f_stack() const { return f; }
+    Eigen::VectorXd q, v, a, f;
+  };
+
+  struct Solver {
+    const Statistics& getSolverStatistics() const { return statistics; }
+    const SplitSolution& getSolution(const int stage) const { return s; }
+    Statistics statistics;
+    SplitSolution s;
+  };
+
+  MockMPC(const int dimu)
+    : u_(Eigen::VectorXd::Zero(dimu)),
+      gain_(1.0),
+      offset_(0.0),
+      a_offset_(0.0),
+      max_iter_(0),
+      iter_offset_(0),
+      solver_() {}
+
+  void init(const double t, const Eigen::VectorXd& q, const Eigen::VectorXd& v,
+            const SolverOptions& solver_options) {
+    max_iter_ = solver_options.max_iter;
+    solver_.statistics.iter = max_iter_;
+    u_.setConstant(t + q.sum() + v.sum());
+    setSolution(q, v);
+  }
+
+  void setSolverOptions(const SolverOptions& solver_options) {
+    max_iter_ = solver_options.max_iter;
+    solver_.statistics.iter = max_iter_;
+  }
+
+  void setCommand(const Eigen::VectorXd& command) {
+    gain_ = command.coeff(0);
+  }
+
+  void updateSolution(const double t, const double dt, const Eigen::VectorXd& q,
+                      const Eigen::VectorXd& v) {
+    u_ = 0.5 * u_;
+    u_.array() += gain_ * (t + dt + q.sum() + v.sum()) + offset_;
+    solver_.statistics.iter = max_iter_ + iter_offset_;
+    setSolution(q, v);
+  }
+
+  const Eigen::VectorXd& getInitialControlInput() const { return u_; }
+
+  double KKTError() const { return u_.norm(); }
+
+  const Solver& getSolver() const { return solver_; }
+
+  void setOffset(const double offset) { offset_ = offset; }
+
+  void setAccelerationOffset(const double a_offset) { a_offset_ = a_offset; }
+
+  void setIterationOffset(const int iter_offset) { iter_offset_ = iter_offset; }
+
+private:
+  Eigen::VectorXd u_;
+  double gain_, offset_, a_offset_;
+  int max_iter_, iter_offset_;
+  Solver solver_;
+
+  void setSolution(const Eigen::VectorXd& q, const Eigen::VectorXd& v) {
+    solver_.s.q = q;
+    solver_.s.v = v;
+    solver_.s.a = gain_ * v;
+    solver_.s.a.array() += a_offset_;
+    solver_.s.f = u_;
+  }
+};
+
+
+class MPCRecorderTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    srand((unsigned int) time(0));
+    dimq = 7;
+    dimv = 6;
+    dimu = 4;
+    num_calls = 20;
+    dt = 0.0025;
+    option_init.max_iter = 10;
+    option_init.hessian_approximation = HessianApproximation::BFGS;
+    option_mpc.max_iter = 2;
+    option_mpc.line_search_settings.min_step_size = 0.1;
+  }
+
+  virtual void TearDown() {
+  }
+
+  MPCRecorder record(MockMPC& mpc) const {
+    MPCRecorder recorder;
+    Eigen::VectorXd command = Eigen::VectorXd::Constant(1, 0.5);
+    recorder.recordCommand(command);
+    mpc.setCommand(command);
+    recorder.init(mpc, 0.0, Eigen::VectorXd::Random(dimq),
+                  Eigen::VectorXd::Random(dimv), option_init);
+    recorder.setSolverOptions(mpc, option_mpc);
+    for (int i=0; i<num_calls; ++i) {
+      if (i == num_calls/2) {
+        command.coeffRef(0) = -0.2;
+        recorder.recordCommand(command);
+        mpc.setCommand(command);
+      }
+      recorder.updateSolution(mpc, i*dt, dt, Eigen::VectorXd::Random(dimq),
+                              Eigen::VectorXd::Random(dimv));
+    }
+    return recorder;
+  }
+
+  int dimq, dimv, dimu, num_calls;
+  double dt;
+  SolverOptions option_init, option_mpc;
+};
+
+
+TEST_F(MPCRecorderTest, record) {
+  MockMPC mpc(dimu);
+  const MPCRecorder recorder = record(mpc);
+  EXPECT_EQ(recorder.size(), num_calls+4);
+  const auto& records = recorder.records();
+  EXPECT_TRUE(records[0].type == MPCRecordType::Command);
+  EXPECT_TRUE(records[1].type == MPCRecordType::Init);
+  EXPECT_EQ(records[1].iter, option_init.max_iter);
+  EXPECT_TRUE(records[2].type == MPCRecordType::SolverOptions);
+  EXPECT_EQ(records[2].solver_options.max_iter, option_mpc.max_iter);
+  const auto& last = records.back();
+  EXPECT_TRUE(last.type == MPCRecordType::UpdateSolution);
+  EXPECT_DOUBLE_EQ(last.t, (num_calls-1)*dt);
+  EXPECT_DOUBLE_EQ(last.dt, dt);
+  EXPECT_TRUE(last.u.isApprox(mpc.getInitialControlInput()));
+  EXPECT_EQ(last.s.size(), dimq+2*dimv+dimu);
+  EXPECT_TRUE(last.s.isApprox(MPCRecorder::initialStageSolution(mpc)));
+  EXPECT_DOUBLE_EQ(last.kkt_error, mpc.KKTError());
+  EXPECT_EQ(last.iter, option_mpc.max_iter);
+  EXPECT_GE(last.solve_time, 0.0);
+}
+
+
+TEST_F(MPCRecorderTest, saveAndLoad) {
+  MockMPC mpc(dimu);
+  const MPCRecorder recorder = record(mpc);
+  std::stringstream ss;
+  BinaryOutputArchive oar(ss);
+  recorder.save(oar);
+  BinaryInputArchive iar(ss);
+  MPCRecorder loaded;
+  loaded.load(iar);
+  ASSERT_EQ(loaded.size(), recorder.size());
+  for (int i=0; i<recorder.size(); ++i) {
+    const auto& e = recorder.records()[i];
+    const auto& e_loaded = loaded.records()[i];
+    EXPECT_TRUE(e_loaded.type == e.type);
+    if (e.type == MPCRecordType::Command) {
+      EXPECT_TRUE(e_loaded.command == e.command);
+      continue;
+    }
+    if (e.type == MPCRecordType::Init || e.type == MPCRecordType::SolverOptions) {
+      EXPECT_EQ(e_loaded.solver_options.max_iter, e.solver_options.max_iter);
+      EXPECT_TRUE(e_loaded.solver_options.hessian_approximation
+                    == e.solver_options.hessian_approximation);
+      EXPECT_DOUBLE_EQ(e_loaded.solver_options.line_search_settings.min_step_size,
+                       e.solver_options.line_search_settings.min_step_size);
+    }
+    if (e.type == MPCRecordType::SolverOptions) {
+      continue;
+    }
+    EXPECT_DOUBLE_EQ(e_loaded.t, e.t);
+    EXPECT_DOUBLE_EQ(e_loaded.dt, e.dt);
+    EXPECT_TRUE(e_loaded.q == e.q);
+    EXPECT_TRUE(e_loaded.v == e.v);
+    EXPECT_TRUE(e_loaded.u == e.u);
+    EXPECT_TRUE(e_loaded.s == e.s);
+    EXPECT_DOUBLE_EQ(e_loaded.kkt_error, e.kkt_error);
+    EXPECT_DOUBLE_EQ(e_loaded.solve_time, e.solve_time);
+    EXPECT_EQ(e_loaded.iter, e.iter);
+  }
+}
+
+
+TEST_F(MPCRecorderTest, invalidArchive) {
+  std::stringstream ss;
+  BinaryOutputArchive oar(ss);
+  oar.write(std::string("not a log"));
+  BinaryInputArchive iar(ss);
+  MPCRecorder recorder;
+  EXPECT_THROW(recorder.load(iar), std::runtime_error);
+  EXPECT_THROW(recorder.load("not_existing_mpc_log.bin"), std::runtime_error);
+}
+
+
+TEST_F(MPCRecorderTest, replay) {
+  MockMPC mpc(dimu);
+  const MPCRecorder recorder = record(mpc);
+  MockMPC mpc_replay(dimu);
+  auto apply_command = [&](const Eigen::VectorXd& command) {
+    mpc_replay.setCommand(command);
+  };
+  const auto statistics = benchmark::Replay(mpc_replay, recorder, apply_command);
+  EXPECT_EQ(statistics.solve_time.size(), num_calls);
+  EXPECT_EQ(statistics.recorded_solve_time.size(), num_calls);
+  EXPECT_TRUE(statistics.isConsistent());
+  for (int i=0; i<num_calls; ++i) {
+    EXPECT_DOUBLE_EQ(statistics.divergence[i], 0.0);
+    EXPECT_DOUBLE_EQ(statistics.solution_divergence[i], 0.0);
+    EXPECT_EQ(statistics.iter[i], statistics.recorded_iter[i]);
+  }
+  EXPECT_EQ(statistics.first_iter_mismatch, -1);
+  EXPECT_TRUE(mpc_replay.getInitialControlInput()
+                == mpc.getInitialControlInput());
+  EXPECT_THROW(benchmark::Replay(mpc_replay, recorder), std::invalid_argument);
+  EXPECT_THROW(benchmark::Replay(mpc_replay, recorder, apply_command, -1.0),
+               std::out_of_range);
+}
+
+
+TEST_F(MPCRecorderTest, divergence) {
+  MockMPC mpc(dimu);
+  const MPCRecorder recorder = record(mpc);
+  MockMPC mpc_replay(dimu);
+  mpc_replay.setOffset(1.0e-03);
+  auto apply_command = [&](const Eigen::VectorXd& command) {
+    mpc_replay.setCommand(command);
+  };
+  const auto statistics = benchmark::Replay(mpc_replay, recorder, apply_command);
+  EXPECT_FALSE(statistics.isConsistent());
+  EXPECT_EQ(statistics.first_divergence, 0);
+  const auto statistics_tol = benchmark::Replay(mpc_replay, recorder,
+                                                apply_command, 1.0);
+  EXPECT_TRUE(statistics_tol.isConsistent());
+}
+
+
+TEST_F(MPCRecorderTest, solutionDivergence) {
+  MockMPC mpc(dimu);
+  const MPCRecorder recorder = record(mpc);
+  MockMPC mpc_replay(dimu);
+  // Only the acceleration diverges and the control input is the same.
+  mpc_replay.setAccelerationOffset(1.0e-03);
+  auto apply_command = [&](const Eigen::VectorXd& command) {
+    mpc_replay.setCommand(command);
+  };
+  const auto statistics = benchmark::Replay(mpc_replay, recorder, apply_command);
+  EXPECT_FALSE(statistics.isConsistent());
+  EXPECT_EQ(statistics.first_divergence, 0);
+  EXPECT_DOUBLE_EQ(statistics.divergence[0], 0.0);
+  EXPECT_GT(statistics.solution_divergence[0], 0.0);
+}
+
+
+TEST_F(MPCRecorderTest, iterationMismatch) {
+  MockMPC mpc(dimu);
+  const MPCRecorder recorder = record(mpc);
+  MockMPC mpc_replay(dimu);
+  mpc_replay.setIterationOffset(1);
+  auto apply_command = [&](const Eigen::VectorXd& command) {
+    mpc_replay.setCommand(command);
+  };
+  const auto statistics = benchmark::Replay(mpc_replay, recorder, apply_command);
+  EXPECT_EQ(statistics.first_divergence, -1);
+  EXPECT_EQ(statistics.first_iter_mismatch, 0);
+  EXPECT_FALSE(statistics.isConsistent());
+}
+
+
+TEST_F(MPCRecorderTest, replayWithoutInit) {
+  MockMPC mpc(dimu);
+  MPCRecorder recorder;
+  recorder.updateSolution(mpc, 0.0, dt, Eigen::VectorXd::Random(dimq),
+                          Eigen::VectorXd::Random(dimv));
+  EXPECT_THROW(benchmark::Replay(mpc, recorder), std::invalid_argument);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,90 @@
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "robotoc/utils/thread_pool.hpp"
+#include "robotoc/utils/parallel_reduction.hpp"
+
+
+namespace robotoc {
+
+class ParallelReductionTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+  }
+
+  virtual void TearDown() {
+  }
+};
+
+
+TEST_F(ParallelReductionTest, reduce) {
+  const int nthreads = 4;
+  const int size = 103;
+  ThreadPool thread_pool(nthreads);
+  ParallelReduction<bool> all(nthreads, true);
+  ParallelReduction<double> sum(nthreads, 0.0), min(nthreads, 1.0);
+  EXPECT_EQ(all.nthreads(), nthreads);
+  std::vector<double> values(size);
+  for (int i=0; i<size; ++i) {
+    values[i] = 1.0 / (i+1);
+  }
+  for (int k=0; k<20; ++k) {
+    const int infeasible = k % size;
+    all.reset(true);
+    sum.reset(0.0);
+    min.reset(1.0);
+    thread_pool.parallelFor(size, [&](const int i, const int thread_id) {
+      if (i == infeasible) {
+        all.local(thread_id) = false;
+      }
+      sum.local(thread_id) += values[i];
+      min.local(thread_id) = std::min(min.local(thread_id), values[i]);
+    });
+    EXPECT_FALSE(all.reduce(true, std::logical_and<bool>()));
+    double sum_ref = 0.0;
+    for (const auto e : values) {
+      sum_ref += e;
+    }
+    EXPECT_NEAR(sum.reduce(0.0, std::plus<double>()), sum_ref, 1.0e-12);
+    EXPECT_DOUBLE_EQ(min.reduce(1.0, [](const double a, const double b) { 
+                                        return std::min(a, b); }), 
+                     values.back());
+  }
+  all.reset(true);
+  EXPECT_TRUE(all.reduce(true, std::logical_and<bool>()));
+}
+
+
+TEST_F(ParallelReductionTest, padding) {
+  ParallelReduction<double> reduction(3);
+  for (int i=0; i<2; ++i) {
+    const char* begin = reinterpret_cast<const char*>(&reduction.local(i));
+    const char* next = reinterpret_cast<const char*>(&reduction.local(i+1));
+    EXPECT_GE(next-begin, 
+              sizeof(double)+ParallelReduction<double>::kCacheLineSize);
+  }
+}
+
+
+TEST_F(ParallelReductionTest, setNumThreads) {
+  ParallelReduction<int> reduction(2, 1);
+  EXPECT_EQ(reduction.reduce(0, std::plus<int>()), 2);
+  reduction.setNumThreads(5);
+  reduction.reset(1);
+  EXPECT_EQ(reduction.nthreads(), 5);
+  EXPECT_EQ(reduction.reduce(0, std::plus<int>()), 5);
+  EXPECT_THROW(reduction.setNumThreads(-1), std::out_of_range);
+  EXPECT_THROW(ParallelReduction<int>(-1), std::out_of_range);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
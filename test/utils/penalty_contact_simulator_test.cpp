@@ -0,0 +1,100 @@
+#include <vector>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "Eigen/Core"
+
+#include "robotoc/robot/robot.hpp"
+#include "robotoc/utils/penalty_contact_simulator.hpp"
+
+#include "robot_factory.hpp"
+
+
+namespace robotoc {
+
+class PenaltyContactSimulatorTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    robot = testhelper::CreateQuadrupedalRobot();
+    time_step = 0.0025;
+    q0 = robot.generateFeasibleConfiguration();
+    v0 = Eigen::VectorXd::Zero(robot.dimv());
+  }
+
+  virtual void TearDown() {
+  }
+
+  Robot robot;
+  double time_step;
+  Eigen::VectorXd q0, v0;
+};
+
+
+TEST_F(PenaltyContactSimulatorTest, freeFall) {
+  PenaltyContactSimulator simulator(robot, time_step, 10);
+  simulator.setGroundHeight(-1.0e03);
+  simulator.init(0.0, q0, v0);
+  const Eigen::VectorXd u = Eigen::VectorXd::Zero(robot.dimu());
+  simulator.step(u);
+  EXPECT_DOUBLE_EQ(simulator.t(), time_step);
+  for (const auto& f : simulator.contactForces()) {
+    EXPECT_TRUE(f.isZero());
+  }
+  // The kinematics without the contacts is compared with the ABA of the
+  // robot model integrated by the same substeps.
+  Eigen::VectorXd q = q0, v = v0, a = Eigen::VectorXd::Zero(robot.dimv());
+  const auto contact_status = robot.createContactStatus();
+  robot.setContactForces(contact_status,
+                         std::vector<Robot::Vector6d>(robot.maxNumContacts(),
+                                                      Robot::Vector6d::Zero()));
+  for (int i=0; i<10; ++i) {
+    robot.ABA(q, v, Eigen::VectorXd::Zero(robot.dimv()), a);
+    v += (time_step/10) * a;
+    robot.integrateConfiguration(v, time_step/10, q);
+    robot.normalizeConfiguration(q);
+  }
+  EXPECT_TRUE(simulator.q().isApprox(q));
+  EXPECT_TRUE(simulator.v().isApprox(v));
+  EXPECT_LT(simulator.v().coeff(2), 0.0);
+}
+
+
+TEST_F(PenaltyContactSimulatorTest, contactForces) {
+  PenaltyContactSimulator simulator(robot, time_step, 1);
+  const double mu = 0.5;
+  simulator.setContactParameters(1.0e04, 1.0e02, 1.0e03, mu);
+  simulator.setGroundHeight(1.0e03);
+  const Eigen::VectorXd v = Eigen::VectorXd::Random(robot.dimv());
+  simulator.init(0.0, q0, v);
+  simulator.step(Eigen::VectorXd::Zero(robot.dimu()));
+  robot.updateFrameKinematics(q0, v);
+  const std::vector<int> contact_frames = robot.contactFrames();
+  for (int i=0; i<contact_frames.size(); ++i) {
+    const Eigen::Vector3d f_world = robot.frameRotation(contact_frames[i])
+                                      * simulator.contactForces()[i].head<3>();
+    EXPECT_GT(f_world.coeff(2), 0.0);
+    EXPECT_LE(f_world.head<2>().norm(), mu*f_world.coeff(2)+1.0e-08);
+  }
+}
+
+
+TEST_F(PenaltyContactSimulatorTest, invalidArguments) {
+  EXPECT_THROW(PenaltyContactSimulator(robot, 0.0), std::out_of_range);
+  EXPECT_THROW(PenaltyContactSimulator(robot, time_step, 0), std::out_of_range);
+  PenaltyContactSimulator simulator(robot, time_step);
+  EXPECT_THROW(simulator.setContactParameters(0.0, 1.0, 1.0, 0.7), std::out_of_range);
+  EXPECT_THROW(simulator.setContactParameters(1.0, -1.0, 1.0, 0.7), std::out_of_range);
+  EXPECT_THROW(simulator.setContactParameters(1.0, 1.0, 0.0, 0.7), std::out_of_range);
+  EXPECT_THROW(simulator.setContactParameters(1.0, 1.0, 1.0, 0.0), std::out_of_range);
+  EXPECT_THROW(simulator.setRotationalContactParameters(-1.0, 1.0), std::out_of_range);
+  EXPECT_THROW(simulator.init(0.0, v0, v0), std::invalid_argument);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
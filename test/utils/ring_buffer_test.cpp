@@ -0,0 +1,105 @@
+#include <vector>
+#include <deque>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "Eigen/Core"
+
+#include "robotoc/utils/ring_buffer.hpp"
+
+
+namespace robotoc {
+
+class RingBufferTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    srand((unsigned int) time(0));
+  }
+
+  virtual void TearDown() {
+  }
+};
+
+
+TEST_F(RingBufferTest, pushAndPop) {
+  RingBuffer<int> buffer(4);
+  std::deque<int> ref;
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.capacity(), 4);
+  for (int i=0; i<1000; ++i) {
+    const int op = rand() % 3;
+    if (op == 0 || ref.empty()) {
+      buffer.push_back(i);
+      ref.push_back(i);
+    }
+    else if (op == 1) {
+      buffer.pop_front();
+      ref.pop_front();
+    }
+    else {
+      buffer.pop_back();
+      ref.pop_back();
+    }
+    ASSERT_EQ(buffer.size(), ref.size());
+    for (int j=0; j<ref.size(); ++j) {
+      EXPECT_EQ(buffer[j], ref[j]);
+    }
+    if (!ref.empty()) {
+      EXPECT_EQ(buffer.front(), ref.front());
+      EXPECT_EQ(buffer.back(), ref.back());
+    }
+  }
+  EXPECT_TRUE(buffer.toVector() == std::vector<int>(ref.begin(), ref.end()));
+  buffer.clear();
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_THROW(RingBuffer<int>(-1), std::out_of_range);
+}
+
+
+TEST_F(RingBufferTest, capacity) {
+  RingBuffer<double> buffer(2);
+  buffer.push_back(1.0);
+  buffer.push_back(2.0);
+  buffer.pop_front();
+  buffer.push_back(3.0);
+  // The elements wrap around the storage.
+  EXPECT_EQ(buffer.capacity(), 2);
+  EXPECT_DOUBLE_EQ(buffer[0], 2.0);
+  EXPECT_DOUBLE_EQ(buffer[1], 3.0);
+  // The capacity is doubled.
+  buffer.push_back(buffer.front());
+  EXPECT_EQ(buffer.capacity(), 4);
+  EXPECT_EQ(buffer.size(), 3);
+  EXPECT_DOUBLE_EQ(buffer[2], 2.0);
+  buffer.reserve(10);
+  EXPECT_EQ(buffer.capacity(), 10);
+  EXPECT_TRUE(buffer.toVector() == std::vector<double>({2.0, 3.0, 2.0}));
+  buffer.reserve(5);
+  EXPECT_EQ(buffer.capacity(), 10);
+  for (auto& e : buffer) { e += 1.0; }
+  EXPECT_TRUE(buffer.toVector() == std::vector<double>({3.0, 4.0, 3.0}));
+}
+
+
+TEST_F(RingBufferTest, elements) {
+  RingBuffer<bool> flags(1);
+  flags.push_back(true);
+  flags.push_back(false);
+  flags.pop_front();
+  flags.push_back(true);
+  EXPECT_FALSE(flags[0]);
+  EXPECT_TRUE(flags[1]);
+  const Eigen::VectorXd vec = Eigen::VectorXd::Random(5);
+  RingBuffer<Eigen::VectorXd> vecs(3, Eigen::VectorXd::Zero(5));
+  vecs.push_back(vec);
+  EXPECT_TRUE(vecs.front().isApprox(vec));
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,72 @@
+#include <vector>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "robotoc/utils/thread_pool.hpp"
+
+
+namespace robotoc {
+
+class ThreadPoolTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+  }
+
+  virtual void TearDown() {
+  }
+};
+
+
+TEST_F(ThreadPoolTest, parallelFor) {
+  const int nthreads = 4;
+  const int size = 37;
+  ThreadPool thread_pool(nthreads);
+  EXPECT_EQ(thread_pool.nthreads(), nthreads);
+  std::vector<int> count(size, 0), thread_ids(size, -1), thread_ids_prev(size, -1);
+  for (int k=0; k<100; ++k) {
+    thread_pool.parallelFor(size, [&](const int i, const int thread_id) {
+      count[i] += 1;
+      thread_ids[i] = thread_id;
+    });
+    for (int i=0; i<size; ++i) {
+      EXPECT_EQ(count[i], k+1);
+      EXPECT_GE(thread_ids[i], 0);
+      EXPECT_LT(thread_ids[i], nthreads);
+      if (k > 0) {
+        EXPECT_EQ(thread_ids[i], thread_ids_prev[i]);
+      }
+    }
+    thread_ids_prev = thread_ids;
+  }
+}
+
+
+TEST_F(ThreadPoolTest, copyAndMove) {
+  ThreadPool thread_pool(3);
+  ThreadPool thread_pool_copy(thread_pool);
+  EXPECT_EQ(thread_pool_copy.nthreads(), 3);
+  ThreadPool thread_pool_move(std::move(thread_pool_copy));
+  EXPECT_EQ(thread_pool_move.nthreads(), 3);
+  std::vector<int> count(10, 0);
+  thread_pool_move.parallelFor(10, [&](const int i, const int thread_id) {
+    count[i] += 1;
+  });
+  thread_pool_move.setNumThreads(2);
+  EXPECT_EQ(thread_pool_move.nthreads(), 2);
+  thread_pool_move.parallelFor(10, [&](const int i, const int thread_id) {
+    count[i] += 1;
+  });
+  for (const auto e : count) {
+    EXPECT_EQ(e, 2);
+  }
+  EXPECT_THROW(ThreadPool(0), std::out_of_range);
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
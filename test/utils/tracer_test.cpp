@@ -0,0 +1,137 @@
+#include <sstream>
+#include <string>
+#include <thread>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "robotoc/utils/tracer.hpp"
+#include "robotoc/utils/thread_pool.hpp"
+
+
+namespace robotoc {
+
+class TracerTest : public ::testing::Test {
+protected:
+  virtual void SetUp() {
+    Tracer::setCapacity(1024);
+  }
+
+  virtual void TearDown() {
+    Tracer::clear();
+  }
+
+  static int count(const std::string& str, const std::string& sub) {
+    int n = 0;
+    for (auto pos=str.find(sub); pos!=std::string::npos; pos=str.find(sub, pos+1)) {
+      ++n;
+    }
+    return n;
+  }
+};
+
+
+TEST_F(TracerTest, scope) {
+  {
+    TraceScope scope("outer");
+    Tracer::begin("inner", 3);
+    Tracer::end("inner", 3);
+  }
+  EXPECT_EQ(Tracer::numEvents(), 4);
+  std::stringstream ss;
+  Tracer::exportChromeTrace(ss);
+  const std::string json = ss.str();
+  EXPECT_EQ(json.front(), '{');
+  EXPECT_NE(json.find("\"traceEvents\":["), std::string::npos);
+  EXPECT_EQ(count(json, "\"name\":\"outer\""), 2);
+  EXPECT_EQ(count(json, "\"name\":\"inner\""), 2);
+  EXPECT_EQ(count(json, "\"ph\":\"B\""), 2);
+  EXPECT_EQ(count(json, "\"ph\":\"E\""), 2);
+  EXPECT_EQ(count(json, "\"args\":{\"stage\":3}"), 2);
+  Tracer::clear();
+  EXPECT_EQ(Tracer::numEvents(), 0);
+}
+
+
+TEST_F(TracerTest, threads) {
+  const int nthreads = 4;
+  const int size = 20;
+  ThreadPool thread_pool(nthreads);
+  thread_pool.parallelFor(size, [&](const int i, const int thread_id) {
+    TraceScope scope("stage", i);
+  });
+  std::thread thread([]() {
+    TraceScope scope("thread");
+  });
+  thread.join();
+  EXPECT_EQ(Tracer::numEvents(), 2*size+2);
+  std::stringstream ss;
+  Tracer::exportChromeTrace(ss);
+  const std::string json = ss.str();
+  EXPECT_EQ(count(json, "\"name\":\"stage\""), 2*size);
+  EXPECT_EQ(count(json, "\"name\":\"thread\""), 2);
+  EXPECT_GE(count(json, "\"name\":\"thread_name\""), nthreads+1);
+  // The buffer of the exited thread is released by clear().
+  Tracer::clear();
+  EXPECT_EQ(Tracer::numEvents(), 0);
+}
+
+
+TEST_F(TracerTest, overwrite) {
+  const int capacity = 8;
+  Tracer::setCapacity(capacity);
+  Tracer::begin("overwritten");
+  for (int i=0; i<capacity; ++i) {
+    TraceScope scope("kept");
+  }
+  Tracer::end("overwritten");
+  EXPECT_EQ(Tracer::numEvents(), capacity);
+  std::stringstream ss;
+  Tracer::exportChromeTrace(ss);
+  const std::string json = ss.str();
+  // The end events whose begin events are overwritten are not exported.
+  EXPECT_EQ(count(json, "\"name\":\"overwritten\""), 0);
+  EXPECT_EQ(count(json, "\"ph\":\"B\""), count(json, "\"ph\":\"E\""));
+  EXPECT_THROW(Tracer::setCapacity(0), std::out_of_range);
+}
+
+
+TEST_F(TracerTest, openScope) {
+  {
+    TraceScope scope("open");
+    std::stringstream ss;
+    EXPECT_THROW(Tracer::setCapacity(16), std::runtime_error);
+    EXPECT_THROW(Tracer::clear(), std::runtime_error);
+    EXPECT_THROW(Tracer::numEvents(), std::runtime_error);
+    EXPECT_THROW(Tracer::exportChromeTrace(ss), std::runtime_error);
+  }
+  std::thread thread([]() {
+    TraceScope scope("thread");
+  });
+  thread.join();
+  EXPECT_EQ(Tracer::numEvents(), 4);
+  Tracer::clear();
+  EXPECT_EQ(Tracer::numEvents(), 0);
+}
+
+
+TEST_F(TracerTest, macros) {
+  {
+    ROBOTOC_TRACE_SCOPE("macro");
+    ROBOTOC_TRACE_STAGE_SCOPE("macro_stage", 0);
+  }
+  if (Tracer::isEnabled()) {
+    EXPECT_EQ(Tracer::numEvents(), 4);
+  }
+  else {
+    EXPECT_EQ(Tracer::numEvents(), 0);
+  }
+}
+
+} // namespace robotoc
+
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}